@@ -0,0 +1,513 @@
+#ifndef BPLUSTREE_MULTIMAP_H
+#define BPLUSTREE_MULTIMAP_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief Whether PostingList delta-encodes values of T
+ *
+ * Integral types up to 64 bits other than bool are stored as varints of the
+ * zigzag-encoded difference to the previous value.
+ */
+template<typename T>
+struct IsDeltaEncodable
+    : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                       sizeof(T) <= sizeof(uint64_t)> {};
+
+} // namespace detail
+
+/**
+ * @brief The values stored under one key of a BPlusMultiMap, in insertion order
+ *
+ * This general form keeps the values in a std::vector. Integral values use
+ * the compressed specialization below.
+ *
+ * @tparam ValueType The type of values
+ */
+template<typename ValueType, bool Compressed = detail::IsDeltaEncodable<ValueType>::value>
+class PostingList {
+private:
+    std::vector<ValueType> items;
+
+public:
+    using value_type = ValueType;
+    using const_iterator = typename std::vector<ValueType>::const_iterator;
+
+    /**
+     * @brief Appends a value
+     *
+     * Time complexity: amortized O(1)
+     */
+    void push_back(const ValueType& value) { items.push_back(value); }
+
+    /**
+     * @brief Removes the first occurrence of a value
+     *
+     * @return true if the value was found
+     *
+     * Time complexity: O(size())
+     */
+    bool erase(const ValueType& value) {
+        auto it = std::find(items.begin(), items.end(), value);
+        if (it == items.end()) return false;
+        items.erase(it);
+        return true;
+    }
+
+    size_t size() const noexcept { return items.size(); }
+    bool empty() const noexcept { return items.empty(); }
+    const_iterator begin() const noexcept { return items.begin(); }
+    const_iterator end() const noexcept { return items.end(); }
+
+    /**
+     * @brief Returns the bytes used beyond sizeof(PostingList)
+     */
+    size_t heapBytes() const noexcept { return items.capacity() * sizeof(ValueType); }
+};
+
+/**
+ * @brief Compressed posting list for integral values
+ *
+ * Each value is stored as a LEB128 varint of the zigzag-encoded difference
+ * to the previous value, so runs of nearby values take one or two bytes
+ * each. Up to INLINE_BYTES of encoded data live inside the list itself;
+ * only longer lists allocate.
+ *
+ * @tparam ValueType An integral type of at most 64 bits
+ */
+template<typename ValueType>
+class PostingList<ValueType, true> {
+public:
+    /**
+     * @brief Encoded bytes stored without a heap allocation
+     */
+    static constexpr size_t INLINE_BYTES = 16;
+
+private:
+    unsigned char inlineBytes[INLINE_BYTES];
+    std::vector<unsigned char> spilled;  // Holds every byte once the inline buffer overflows
+    uint32_t byteCount = 0;
+    uint32_t valueCount = 0;
+    ValueType last = ValueType();        // Last value, the base of the next delta
+
+    const unsigned char* data() const noexcept { return spilled.empty() ? inlineBytes : spilled.data(); }
+
+    static uint64_t zigzag(uint64_t delta) noexcept {
+        return (delta << 1) ^ (0 - (delta >> 63));
+    }
+    static uint64_t unzigzag(uint64_t encoded) noexcept {
+        return (encoded >> 1) ^ (0 - (encoded & 1));
+    }
+
+    void appendByte(unsigned char byte) {
+        if (spilled.empty() && byteCount < INLINE_BYTES) {
+            inlineBytes[byteCount++] = byte;
+            return;
+        }
+        if (spilled.empty()) {
+            spilled.assign(inlineBytes, inlineBytes + byteCount);
+        }
+        spilled.push_back(byte);
+        byteCount++;
+    }
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * @brief Forward iterator decoding the values on the fly
+     */
+    class const_iterator {
+    private:
+        const unsigned char* position = nullptr;  // Next encoded value; nullptr at the end
+        const unsigned char* finish = nullptr;
+        ValueType current = ValueType();
+
+        friend class PostingList;
+        const_iterator(const unsigned char* begin, const unsigned char* end) : position(begin), finish(end) {
+            advance();
+        }
+
+        void advance() {
+            if (position == finish) {
+                position = nullptr;
+                finish = nullptr;
+                return;
+            }
+            uint64_t encoded = 0;
+            unsigned shift = 0;
+            unsigned char byte;
+            do {
+                byte = *position++;
+                encoded |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            current = static_cast<ValueType>(static_cast<uint64_t>(current) + unzigzag(encoded));
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ValueType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ValueType*;
+        using reference = const ValueType&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        const_iterator& operator++() {
+            advance();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            advance();
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+    };
+
+    PostingList() = default;
+    PostingList(const PostingList& other)
+        : spilled(other.spilled), byteCount(other.byteCount), valueCount(other.valueCount), last(other.last) {
+        if (spilled.empty()) std::memcpy(inlineBytes, other.inlineBytes, byteCount);
+    }
+    PostingList& operator=(const PostingList& other) {
+        spilled = other.spilled;
+        byteCount = other.byteCount;
+        valueCount = other.valueCount;
+        last = other.last;
+        if (spilled.empty()) std::memcpy(inlineBytes, other.inlineBytes, byteCount);
+        return *this;
+    }
+    PostingList(PostingList&& other) noexcept
+        : spilled(std::move(other.spilled)), byteCount(other.byteCount), valueCount(other.valueCount),
+          last(other.last) {
+        if (spilled.empty()) std::memcpy(inlineBytes, other.inlineBytes, byteCount);
+        other.spilled.clear();
+        other.byteCount = 0;
+        other.valueCount = 0;
+        other.last = ValueType();
+    }
+    PostingList& operator=(PostingList&& other) noexcept {
+        if (this != &other) {
+            spilled = std::move(other.spilled);
+            byteCount = other.byteCount;
+            valueCount = other.valueCount;
+            last = other.last;
+            if (spilled.empty()) std::memcpy(inlineBytes, other.inlineBytes, byteCount);
+            other.spilled.clear();
+            other.byteCount = 0;
+            other.valueCount = 0;
+            other.last = ValueType();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends a value
+     *
+     * Time complexity: O(1) amortized
+     */
+    void push_back(const ValueType& value) {
+        uint64_t encoded = zigzag(static_cast<uint64_t>(value) - static_cast<uint64_t>(last));
+        while (encoded >= 0x80) {
+            appendByte(static_cast<unsigned char>(encoded | 0x80));
+            encoded >>= 7;
+        }
+        appendByte(static_cast<unsigned char>(encoded));
+        last = value;
+        valueCount++;
+    }
+
+    /**
+     * @brief Removes the first occurrence of a value
+     *
+     * The remaining values are re-encoded.
+     *
+     * @return true if the value was found
+     *
+     * Time complexity: O(size())
+     */
+    bool erase(const ValueType& value) {
+        auto found = std::find(begin(), end(), value);
+        if (found == end()) return false;
+
+        PostingList rebuilt;
+        for (auto it = begin(); it != end(); ++it) {
+            if (it == found) continue;
+            rebuilt.push_back(*it);
+        }
+        *this = std::move(rebuilt);
+        return true;
+    }
+
+    size_t size() const noexcept { return valueCount; }
+    bool empty() const noexcept { return valueCount == 0; }
+    const_iterator begin() const { return const_iterator(data(), data() + byteCount); }
+    const_iterator end() const { return const_iterator(); }
+
+    /**
+     * @brief Returns the number of encoded bytes
+     */
+    size_t encodedBytes() const noexcept { return byteCount; }
+
+    /**
+     * @brief Returns the bytes used beyond sizeof(PostingList)
+     */
+    size_t heapBytes() const noexcept { return spilled.capacity(); }
+};
+
+/**
+ * @brief Ordered multimap on top of BPlusTree, storing each key's values in a posting list
+ *
+ * Every distinct key occupies one tree entry whose value is a PostingList of
+ * all values inserted under it, in insertion order. Integral values are
+ * delta-encoded and short lists need no heap allocation. count() and
+ * equal_range() read the stored list in place, so neither copies the values.
+ *
+ * Usage example:
+ * @code
+ * BPlusMultiMap<std::string, int> index;
+ * index.insert("apple", 3);
+ * index.insert("apple", 7);
+ * size_t n = index.count("apple");            // 2
+ * auto range = index.equal_range("apple");
+ * for (auto it = range.first; it != range.second; ++it) { ... }   // 3, 7
+ * @endcode
+ *
+ * @tparam KeyType The type of keys
+ * @tparam ValueType The type of values
+ * @tparam Allocator Allocator of the underlying tree
+ */
+template<typename KeyType, typename ValueType,
+         typename Allocator = std::allocator<std::pair<const KeyType, PostingList<ValueType>>>>
+class BPlusMultiMap {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using posting_list = PostingList<ValueType>;
+    using value_iterator = typename posting_list::const_iterator;
+    using tree_type = BPlusTree<KeyType, posting_list, Allocator>;
+
+private:
+    tree_type tree;
+    size_t valueCount;  // Values over all keys
+
+public:
+    /**
+     * @brief Constructs an empty multimap
+     *
+     * @param order The order of the underlying tree
+     * @param alloc The allocator of the underlying tree
+     */
+    explicit BPlusMultiMap(size_t order = DEFAULT_ORDER, const Allocator& alloc = Allocator())
+        : tree(order, alloc), valueCount(0) {}
+
+    /**
+     * @brief Adds a value under a key, after any values already there
+     *
+     * Time complexity: O(log n), one descent
+     */
+    void insert(const KeyType& key, const ValueType& value) {
+        bool inserted = false;
+        auto slot = tree.findOrInsertSlot(key, inserted);
+        try {
+            slot.first->values[slot.second].push_back(value);
+        } catch (...) {
+            if (inserted) tree.remove(key);
+            throw;
+        }
+        valueCount++;
+    }
+
+    /**
+     * @brief Removes every value stored under a key
+     *
+     * @return The number of values removed
+     */
+    size_t remove(const KeyType& key) {
+        const posting_list* list = tree.findValueSlot(key);
+        if (!list) return 0;
+        size_t removed = list->size();
+        tree.remove(key);
+        valueCount -= removed;
+        return removed;
+    }
+
+    /**
+     * @brief Removes the first occurrence of a value under a key
+     *
+     * The key disappears with its last value.
+     *
+     * @return true if the pair was found
+     *
+     * Time complexity: O(log n + m) for m values under the key
+     */
+    bool remove(const KeyType& key, const ValueType& value) {
+        auto slot = tree.findSlotForWrite(key);
+        if (!slot.first) return false;
+
+        posting_list& list = slot.first->values[slot.second];
+        if (!list.erase(value)) return false;
+        valueCount--;
+        if (list.empty()) tree.remove(key);
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of values stored under a key
+     *
+     * Time complexity: O(log n)
+     */
+    size_t count(const KeyType& key) const {
+        const posting_list* list = tree.findValueSlot(key);
+        return list ? list->size() : 0;
+    }
+
+    /**
+     * @brief Checks if a key has at least one value
+     */
+    bool contains(const KeyType& key) const { return tree.findValueSlot(key) != nullptr; }
+
+    /**
+     * @brief Returns the values stored under a key as an iterator range
+     *
+     * The iterators read the posting list inside the tree and are invalidated
+     * by any modification of the multimap.
+     *
+     * Time complexity: O(log n)
+     */
+    std::pair<value_iterator, value_iterator> equal_range(const KeyType& key) const {
+        const posting_list* list = tree.findValueSlot(key);
+        if (!list) return {value_iterator(), value_iterator()};
+        return {list->begin(), list->end()};
+    }
+
+    /**
+     * @brief Returns a copy of the values stored under a key
+     */
+    std::vector<ValueType> values(const KeyType& key) const {
+        auto range = equal_range(key);
+        return std::vector<ValueType>(range.first, range.second);
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every pair, in key order then insertion order
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        for (auto* leaf = tree.getFirstLeaf(); leaf; leaf = leaf->next) {
+            for (size_t i = 0; i < leaf->numKeys; ++i) {
+                for (const ValueType& value : leaf->values[i]) {
+                    fn(leaf->keys[i], value);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Returns every pair with key in [start, end]
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        if (end < start || !tree.root) return result;
+
+        // Posting lists are read in place rather than copied through tree iterators
+        auto* leaf = tree.findLeaf(start);
+        for (size_t i = leaf->findKeyPosition(start); leaf; leaf = leaf->next, i = 0) {
+            for (; i < leaf->numKeys; ++i) {
+                if (end < leaf->keys[i]) return result;
+                for (const ValueType& value : leaf->values[i]) {
+                    result.emplace_back(leaf->keys[i], value);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Replaces the contents with the pairs of a key-sorted sequence
+     *
+     * Unlike BPlusTree::bulkLoad(), duplicate keys keep every value, in
+     * sequence order.
+     *
+     * @param first, last Pairs sorted by key
+     *
+     * Time complexity: O(n)
+     */
+    template<typename InputIterator>
+    void bulkLoad(InputIterator first, InputIterator last) {
+        std::vector<std::pair<KeyType, posting_list>> grouped;
+        size_t total = 0;
+        for (; first != last; ++first) {
+            if (grouped.empty() || !(grouped.back().first == first->first)) {
+                grouped.emplace_back(first->first, posting_list());
+            }
+            grouped.back().second.push_back(first->second);
+            total++;
+        }
+        tree.bulkLoad(std::make_move_iterator(grouped.begin()), std::make_move_iterator(grouped.end()));
+        valueCount = total;
+    }
+
+    /**
+     * @brief Returns the number of (key, value) pairs
+     *
+     * Time complexity: O(1)
+     */
+    size_t size() const noexcept { return valueCount; }
+
+    /**
+     * @brief Returns the number of distinct keys
+     *
+     * Time complexity: O(n/B)
+     */
+    size_t keyCount() const noexcept { return tree.size(); }
+
+    /**
+     * @brief Checks if the multimap holds no pairs
+     */
+    bool isEmpty() const noexcept { return valueCount == 0; }
+
+    /**
+     * @brief Returns the underlying tree of posting lists
+     */
+    const tree_type& postings() const noexcept { return tree; }
+
+    /**
+     * @brief Validates the tree and the pair count
+     */
+    bool validate() const {
+        if (!tree.validate()) return false;
+        size_t total = 0;
+        for (auto* leaf = tree.getFirstLeaf(); leaf; leaf = leaf->next) {
+            for (size_t i = 0; i < leaf->numKeys; ++i) {
+                if (leaf->values[i].empty()) return false;
+                total += leaf->values[i].size();
+            }
+        }
+        return total == valueCount;
+    }
+};
+
+} // namespace bptree
+
+#endif // BPLUSTREE_MULTIMAP_H
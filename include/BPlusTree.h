@@ -3,7 +3,9 @@
 
 #include "Node.h"
 #include "Config.h"
+#include "EpochReclamation.h"
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -16,6 +18,13 @@
 #include <stdexcept>
 #include <type_traits>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <atomic>
+#include <set>
+#include <optional>
+#include <random>
 
 namespace bptree {
 
@@ -43,6 +52,19 @@ struct Statistics {
     std::size_t internalMergeCount = 0;   ///< Number of internal node merges
     std::size_t redistributeCount = 0;    ///< Number of redistribute operations
 
+    // Snapshot counters
+    std::size_t cowCopyCount = 0;         ///< Nodes copied to preserve a live snapshot
+
+    // Scan counters
+    std::size_t zoneMapSkipCount = 0;     ///< Leaves scanWhere() skipped without reading entries
+
+    // Buffer pool counters (DiskBPlusTree)
+    std::size_t pageHitCount = 0;         ///< Page requests served from the buffer pool
+    std::size_t pageMissCount = 0;        ///< Page requests that read the page from disk
+    std::size_t pageEvictionCount = 0;    ///< Frames reused for another page
+    std::size_t pageWriteCount = 0;       ///< Dirty pages written back to disk
+    std::size_t pagePrefetchCount = 0;    ///< Pages read ahead of a scan in a batch
+
     /**
      * @brief Returns total number of nodes in the tree
      */
@@ -64,6 +86,16 @@ struct Statistics {
         return leafMergeCount + internalMergeCount;
     }
 
+    /**
+     * @brief Returns the fraction of page requests served from the buffer pool
+     *
+     * A request for a page that a read-ahead batch already loaded is a hit.
+     */
+    double pageHitRate() const noexcept {
+        std::size_t requests = pageHitCount + pageMissCount;
+        return requests ? static_cast<double>(pageHitCount) / static_cast<double>(requests) : 0.0;
+    }
+
     /**
      * @brief Resets all statistics counters to zero
      */
@@ -79,6 +111,135 @@ struct Statistics {
         leafMergeCount = 0;
         internalMergeCount = 0;
         redistributeCount = 0;
+        cowCopyCount = 0;
+        zoneMapSkipCount = 0;
+        pageHitCount = 0;
+        pageMissCount = 0;
+        pageEvictionCount = 0;
+        pageWriteCount = 0;
+        pagePrefetchCount = 0;
+    }
+};
+
+/**
+ * @brief Estimated number of keys in a range, from BPlusTree::estimateRange()
+ *
+ * minCount and maxCount are guaranteed: they follow from the node fill
+ * bounds of the B+ tree, not from sampling.
+ */
+struct RangeEstimate {
+    std::size_t count = 0;       ///< Estimated number of keys in the range
+    std::size_t minCount = 0;    ///< The range holds at least this many keys
+    std::size_t maxCount = 0;    ///< The range holds at most this many keys
+    double selectivity = 0.0;    ///< count as a fraction of the estimated tree size
+};
+
+/**
+ * @brief Resolution rule for keys present in both trees during mergeFrom()
+ */
+enum class ConflictPolicy {
+    KEEP_EXISTING,  ///< Keep the value already stored in the destination tree
+    OVERWRITE       ///< Replace it with the value from the tree being merged in
+};
+
+/**
+ * @brief Comparison a ScanPredicate applies to each key or value
+ */
+enum class CompareOp {
+    ANY,            ///< Matches everything
+    EQUAL,          ///< x == operand
+    NOT_EQUAL,      ///< !(x == operand)
+    LESS,           ///< x < operand
+    LESS_EQUAL,     ///< x <= operand
+    GREATER,        ///< x > operand
+    GREATER_EQUAL,  ///< x >= operand
+    BETWEEN         ///< operand <= x <= upper
+};
+
+/**
+ * @brief Simple comparison predicate evaluated by BPlusTree::scanWhere()
+ *
+ * Only operator< and operator== of T are used. evaluate() runs one
+ * branch-free loop per comparison, which compilers vectorize for arithmetic
+ * types, and mayMatchRange() decides from a [min, max] zone whether any
+ * value inside it can match.
+ *
+ * @tparam T The key or value type the predicate is applied to
+ */
+template<typename T>
+struct ScanPredicate {
+    CompareOp op = CompareOp::ANY;  ///< The comparison
+    T operand{};                    ///< Comparison operand, or lower bound for BETWEEN
+    T upper{};                      ///< Upper bound for BETWEEN
+
+    static ScanPredicate any() { return ScanPredicate(); }
+    static ScanPredicate equal(const T& v) { return ScanPredicate{CompareOp::EQUAL, v, T()}; }
+    static ScanPredicate notEqual(const T& v) { return ScanPredicate{CompareOp::NOT_EQUAL, v, T()}; }
+    static ScanPredicate less(const T& v) { return ScanPredicate{CompareOp::LESS, v, T()}; }
+    static ScanPredicate lessEqual(const T& v) { return ScanPredicate{CompareOp::LESS_EQUAL, v, T()}; }
+    static ScanPredicate greater(const T& v) { return ScanPredicate{CompareOp::GREATER, v, T()}; }
+    static ScanPredicate greaterEqual(const T& v) { return ScanPredicate{CompareOp::GREATER_EQUAL, v, T()}; }
+    static ScanPredicate between(const T& lo, const T& hi) { return ScanPredicate{CompareOp::BETWEEN, lo, hi}; }
+
+    /**
+     * @brief Checks a single value
+     */
+    bool matches(const T& x) const {
+        unsigned char result = 1;
+        evaluate(&x, 1, &result);
+        return result != 0;
+    }
+
+    /**
+     * @brief Clears mask[i] for every data[i] that does not match
+     *
+     * Time complexity: O(count)
+     */
+    void evaluate(const T* data, size_t count, unsigned char* mask) const {
+        switch (op) {
+            case CompareOp::ANY:
+                break;
+            case CompareOp::EQUAL:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(data[i] == operand);
+                break;
+            case CompareOp::NOT_EQUAL:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(!(data[i] == operand));
+                break;
+            case CompareOp::LESS:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(data[i] < operand);
+                break;
+            case CompareOp::LESS_EQUAL:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(!(operand < data[i]));
+                break;
+            case CompareOp::GREATER:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(operand < data[i]);
+                break;
+            case CompareOp::GREATER_EQUAL:
+                for (size_t i = 0; i < count; ++i) mask[i] &= static_cast<unsigned char>(!(data[i] < operand));
+                break;
+            case CompareOp::BETWEEN:
+                for (size_t i = 0; i < count; ++i) {
+                    mask[i] &= static_cast<unsigned char>(!(data[i] < operand) & !(upper < data[i]));
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Checks whether some x with min <= x <= max may match
+     */
+    bool mayMatchRange(const T& min, const T& max) const {
+        switch (op) {
+            case CompareOp::EQUAL:         return !(operand < min) && !(max < operand);
+            case CompareOp::NOT_EQUAL:     return !(min == operand && max == operand);
+            case CompareOp::LESS:          return min < operand;
+            case CompareOp::LESS_EQUAL:    return !(operand < min);
+            case CompareOp::GREATER:       return operand < max;
+            case CompareOp::GREATER_EQUAL: return !(max < operand);
+            case CompareOp::BETWEEN:       return !(max < operand) && !(upper < min);
+            case CompareOp::ANY:           break;
+        }
+        return true;
     }
 };
 
@@ -115,6 +276,7 @@ public:
 private:
     leaf_node_type* current_leaf;  ///< Pointer to current leaf node
     size_t index;                  ///< Current index within the leaf node
+    size_t prefetch_distance;      ///< Leaves to prefetch ahead on entering a leaf
     mutable value_type cached_pair; ///< Mutable cache for dereference operations
 
     template<typename K, typename V, typename A>
@@ -124,15 +286,17 @@ private:
      * @brief Private constructor for creating iterators
      * @param leaf Pointer to a leaf node
      * @param idx Index within the leaf node
+     * @param distance Leaves to prefetch ahead on entering a leaf
      */
-    BPlusTreeIterator(leaf_node_type* leaf, size_t idx)
-        : current_leaf(leaf), index(idx), cached_pair() {}
+    BPlusTreeIterator(leaf_node_type* leaf, size_t idx, size_t distance = DEFAULT_PREFETCH_DISTANCE)
+        : current_leaf(leaf), index(idx), prefetch_distance(distance), cached_pair() {}
 
 public:
     /**
      * @brief Default constructor creates an end iterator
      */
-    BPlusTreeIterator() : current_leaf(nullptr), index(0), cached_pair() {}
+    BPlusTreeIterator()
+        : current_leaf(nullptr), index(0), prefetch_distance(DEFAULT_PREFETCH_DISTANCE), cached_pair() {}
 
     /**
      * @brief Copy constructor
@@ -144,16 +308,26 @@ public:
      */
     BPlusTreeIterator& operator=(const BPlusTreeIterator& other) = default;
 
+    /**
+     * @brief Move constructor and assignment, which do not copy the cached pair
+     */
+    BPlusTreeIterator(BPlusTreeIterator&& other) = default;
+    BPlusTreeIterator& operator=(BPlusTreeIterator&& other) = default;
+
     /**
      * @brief Conversion from non-const to const iterator
      */
     template<bool WasConst = IsConst>
     BPlusTreeIterator(const BPlusTreeIterator<KeyType, ValueType, false>& other,
                       typename std::enable_if<WasConst>::type* = nullptr)
-        : current_leaf(other.current_leaf), index(other.index), cached_pair() {}
+        : current_leaf(other.current_leaf), index(other.index),
+          prefetch_distance(other.prefetch_distance), cached_pair() {}
 
     /**
      * @brief Pre-increment operator (++it)
+     *
+     * Entering a leaf prefetches the leaves after it (see LeafNode::prefetchAhead()).
+     *
      * @return Reference to this iterator after incrementing
      */
     BPlusTreeIterator& operator++() {
@@ -165,6 +339,7 @@ public:
                 // Move to next leaf node
                 current_leaf = current_leaf->next;
                 index = 0;
+                current_leaf->prefetchAhead(prefetch_distance);
             }
             // else: stay at end position (index == numKeys on last leaf)
         }
@@ -232,7 +407,8 @@ public:
      * @return true if iterators point to the same position
      */
     bool operator==(const BPlusTreeIterator& other) const {
-        return current_leaf == other.current_leaf && index == other.index;
+        // Non-short-circuit &: loop end checks compile to a single branch
+        return (current_leaf == other.current_leaf) & (index == other.index);
     }
 
     /**
@@ -367,6 +543,206 @@ public:
     friend class BPlusTreeReverseIterator;
 };
 
+namespace detail {
+
+/**
+ * @brief Versions of the live snapshots of one tree
+ *
+ * Shared between a tree and its snapshot handles so that a handle can be
+ * released from any thread. The writer polls it to decide which nodes are
+ * still shared and which retired nodes can be freed.
+ */
+struct SnapshotRegistry {
+    std::mutex mutex;                      ///< Guards versions
+    std::multiset<size_t> versions;        ///< Versions of live snapshots
+    std::atomic<size_t> activeCount{0};    ///< Number of live snapshots (lock-free fast path)
+
+    void acquire(size_t version) {
+        std::lock_guard<std::mutex> lock(mutex);
+        versions.insert(version);
+        activeCount.fetch_add(1, std::memory_order_release);
+    }
+
+    void release(size_t version) {
+        std::lock_guard<std::mutex> lock(mutex);
+        versions.erase(versions.find(version));
+        activeCount.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Read-only, snapshot-isolated view of a B+ tree at one version
+ *
+ * Obtained from BPlusTree::snapshot(). The view keeps seeing the entries the
+ * tree held when it was taken, however the tree is modified afterwards: the
+ * writer copies every node on a root-to-leaf path before changing it (path
+ * copying) and defers freeing replaced nodes until no snapshot can reach them.
+ *
+ * A snapshot may be read from any thread while the owning thread keeps
+ * writing; writers never wait for readers. Reads navigate from the snapshot's
+ * root only and never follow leaf sibling or parent links, which belong to the
+ * live tree. A snapshot must be released (destroyed or release()d) before its
+ * tree is destroyed or move-assigned.
+ *
+ * @tparam KeyType The type of keys in the tree
+ * @tparam ValueType The type of values in the tree
+ */
+template<typename KeyType, typename ValueType>
+class BPlusTreeSnapshot {
+private:
+    const Node<KeyType, ValueType>* root;                  ///< Root of the captured version
+    std::shared_ptr<detail::SnapshotRegistry> registry;    ///< Registry of the owning tree
+    size_t snapshotVersion;                                ///< Version this view captured
+
+    template<typename K, typename V, typename A>
+    friend class BPlusTree;
+
+    BPlusTreeSnapshot(const Node<KeyType, ValueType>* r,
+                      std::shared_ptr<detail::SnapshotRegistry> reg, size_t version)
+        : root(r), registry(std::move(reg)), snapshotVersion(version) {}
+
+    void collectRange(const Node<KeyType, ValueType>* node, const KeyType& start,
+                      const KeyType& end, std::vector<std::pair<KeyType, ValueType>>& result) const {
+        if (node->isLeaf()) {
+            const LeafNode<KeyType, ValueType>* leaf =
+                static_cast<const LeafNode<KeyType, ValueType>*>(node);
+            for (size_t i = leaf->findKeyPosition(start); i < leaf->numKeys && !(end < leaf->keys[i]); ++i) {
+                result.emplace_back(leaf->keys[i], leaf->values[i]);
+            }
+            return;
+        }
+
+        const InternalNode<KeyType, ValueType>* internal =
+            static_cast<const InternalNode<KeyType, ValueType>*>(node);
+        size_t first = internal->findChildIndex(start);
+        size_t last = internal->findChildIndex(end);
+        for (size_t i = first; i <= last; ++i) {
+            collectRange(internal->children[i], start, end, result);
+        }
+    }
+
+public:
+    /**
+     * @brief Creates an empty, unattached snapshot
+     */
+    BPlusTreeSnapshot() : root(nullptr), registry(), snapshotVersion(0) {}
+
+    /**
+     * @brief Releases the snapshot
+     */
+    ~BPlusTreeSnapshot() { release(); }
+
+    BPlusTreeSnapshot(const BPlusTreeSnapshot&) = delete;
+    BPlusTreeSnapshot& operator=(const BPlusTreeSnapshot&) = delete;
+
+    BPlusTreeSnapshot(BPlusTreeSnapshot&& other) noexcept
+        : root(other.root), registry(std::move(other.registry)),
+          snapshotVersion(other.snapshotVersion) {
+        other.root = nullptr;
+    }
+
+    BPlusTreeSnapshot& operator=(BPlusTreeSnapshot&& other) noexcept {
+        if (this != &other) {
+            release();
+            root = other.root;
+            registry = std::move(other.registry);
+            snapshotVersion = other.snapshotVersion;
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Releases the snapshot early, letting the tree reclaim nodes it pinned
+     *
+     * The snapshot becomes empty. Safe to call more than once.
+     */
+    void release() noexcept {
+        if (registry) {
+            registry->release(snapshotVersion);
+            registry.reset();
+        }
+        root = nullptr;
+    }
+
+    /**
+     * @brief Returns the tree version captured by this snapshot
+     */
+    size_t version() const noexcept { return snapshotVersion; }
+
+    /**
+     * @brief Checks if the captured version holds no entries
+     */
+    bool isEmpty() const noexcept { return root == nullptr; }
+
+    /**
+     * @brief Searches for a key in the captured version
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if the key is found
+     * @return true if the key was present when the snapshot was taken
+     *
+     * Time complexity: O(log n)
+     */
+    bool search(const KeyType& key, ValueType& value) const {
+        const Node<KeyType, ValueType>* current = root;
+        if (!current) return false;
+        while (current->isInternal()) {
+            const InternalNode<KeyType, ValueType>* internal =
+                static_cast<const InternalNode<KeyType, ValueType>*>(current);
+            current = internal->children[internal->findChildIndex(key)];
+        }
+        return static_cast<const LeafNode<KeyType, ValueType>*>(current)->findValue(key, value);
+    }
+
+    /**
+     * @brief Returns all entries of the captured version with keys in [start, end]
+     *
+     * Repeated calls return identical results regardless of concurrent writes.
+     *
+     * @param start The lower bound of the range (inclusive)
+     * @param end The upper bound of the range (inclusive)
+     * @return Key-value pairs in the range, sorted by key
+     *
+     * Time complexity: O(log n + k) where k is the result size
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start,
+                                                           const KeyType& end) const {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        if (root && !(end < start)) {
+            collectRange(root, start, end, result);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of entries in the captured version
+     *
+     * Time complexity: O(n/B) where B is keys per leaf
+     */
+    size_t size() const noexcept {
+        if (!root) return 0;
+        size_t count = 0;
+        std::vector<const Node<KeyType, ValueType>*> stack(1, root);
+        while (!stack.empty()) {
+            const Node<KeyType, ValueType>* node = stack.back();
+            stack.pop_back();
+            if (node->isLeaf()) {
+                count += node->numKeys;
+            } else {
+                const InternalNode<KeyType, ValueType>* internal =
+                    static_cast<const InternalNode<KeyType, ValueType>*>(node);
+                for (size_t i = 0; i <= node->numKeys; ++i) {
+                    stack.push_back(internal->children[i]);
+                }
+            }
+        }
+        return count;
+    }
+};
+
 /**
  * @brief B+ Tree implementation with exception safety guarantees
  *
@@ -413,6 +789,7 @@ public:
     using const_iterator = BPlusTreeIterator<KeyType, ValueType, true>;
     using reverse_iterator = BPlusTreeReverseIterator<KeyType, ValueType, false>;
     using const_reverse_iterator = BPlusTreeReverseIterator<KeyType, ValueType, true>;
+    using snapshot_type = BPlusTreeSnapshot<KeyType, ValueType>;
 
 private:
     // Allocator type aliases using rebind for node types
@@ -422,9 +799,17 @@ private:
     using InternalNodeAllocTraits = std::allocator_traits<InternalNodeAllocator>;
 
     Node<KeyType, ValueType>* root;
+    LeafNode<KeyType, ValueType>* headLeaf;  // First leaf of the chain, nullptr when empty
+    LeafNode<KeyType, ValueType>* tailLeaf;  // Last leaf of the chain, nullptr when empty
     size_t order;      // m
     size_t maxKeys;    // m - 1
     size_t minKeys;    // ⌈m/2⌉ - 1
+    size_t prefetchDistance;  // Leaves that scans prefetch ahead (see setPrefetchDistance())
+
+    // Deferred freeing for latch-free readers (see setEpochManager()). Retired
+    // nodes are reclaimed through this tree; moves re-point them at the new one.
+    EpochManager* epochs;                          // nullptr: nodes are freed immediately
+    EpochManager::Participant* epochParticipant;   // Writer's registration with epochs
 
     // Allocators for node types
     LeafNodeAllocator leaf_allocator;
@@ -433,6 +818,13 @@ private:
     // Statistics tracking
     mutable Statistics stats;
 
+    // Copy-on-write snapshot state (see snapshot())
+    std::shared_ptr<detail::SnapshotRegistry> snapshots;  // Created by the first snapshot()
+    size_t writeVersion;        // Version stamped on nodes created from now on
+    size_t sharedVersion;       // Nodes with version <= this are shared with a snapshot
+    bool hasSharedNodes;        // Whether any snapshot is live (sharedVersion is meaningful)
+    std::vector<std::pair<Node<KeyType, ValueType>*, size_t>> retiredNodes;  // (node, retire version)
+
     // Helper functions
     LeafNode<KeyType, ValueType>* findLeaf(const KeyType& key);
     const LeafNode<KeyType, ValueType>* findLeaf(const KeyType& key) const;
@@ -452,11 +844,13 @@ private:
     void printNode(const Node<KeyType, ValueType>* node, int level) const;
     bool validateNode(const Node<KeyType, ValueType>* node, int level, int& leafLevel) const;
 
-    // Helper methods for iterators
-    LeafNode<KeyType, ValueType>* getFirstLeaf();
-    const LeafNode<KeyType, ValueType>* getFirstLeaf() const;
-    LeafNode<KeyType, ValueType>* getLastLeaf();
-    const LeafNode<KeyType, ValueType>* getLastLeaf() const;
+    // Ends of the leaf chain for iterators. Updates that add, free or copy an end
+    // leaf maintain them; bulk rebuilds call resetLeafEnds() once the root is set.
+    LeafNode<KeyType, ValueType>* getFirstLeaf() noexcept { return headLeaf; }
+    const LeafNode<KeyType, ValueType>* getFirstLeaf() const noexcept { return headLeaf; }
+    LeafNode<KeyType, ValueType>* getLastLeaf() noexcept { return tailLeaf; }
+    const LeafNode<KeyType, ValueType>* getLastLeaf() const noexcept { return tailLeaf; }
+    void resetLeafEnds() noexcept;
 
     // Allocator helper methods for node allocation/deallocation
     LeafNode<KeyType, ValueType>* allocateLeafNode();
@@ -464,6 +858,101 @@ private:
     InternalNode<KeyType, ValueType>* allocateInternalNode();
     void deallocateInternalNode(InternalNode<KeyType, ValueType>* node);
 
+    // Bottom-up construction helpers shared by bulkLoad() and mergeFrom()
+    Node<KeyType, ValueType>* buildInternalLevels(std::vector<Node<KeyType, ValueType>*> currentLevel);
+    Node<KeyType, ValueType>* buildFromLeaves(std::vector<LeafNode<KeyType, ValueType>*>& leaves);
+    void repairUnderfullLeaves(std::vector<LeafNode<KeyType, ValueType>*>& leaves);
+    std::vector<LeafNode<KeyType, ValueType>*> collectLeaves();
+    void destroyInternalNodes(Node<KeyType, ValueType>* node);
+    LeafNode<KeyType, ValueType>* privateLeaf(LeafNode<KeyType, ValueType>* leaf);
+
+    // Copy-on-write helpers for snapshots
+    bool isShared(const Node<KeyType, ValueType>* node) const noexcept {
+        return hasSharedNodes && node->version <= sharedVersion;
+    }
+    void refreshSnapshotState();
+    void freeRetiredNodes(bool all, size_t oldestVersion);
+    Node<KeyType, ValueType>* makeWritable(Node<KeyType, ValueType>* node);
+    LeafNode<KeyType, ValueType>* findLeafForWrite(const KeyType& key);
+    LeafNode<KeyType, ValueType>* findLeafForWrite(const KeyType& key, const KeyType*& lower,
+                                                   const KeyType*& upper);
+    LeafNode<KeyType, ValueType>* cloneLeafNode(const LeafNode<KeyType, ValueType>* source);
+    InternalNode<KeyType, ValueType>* cloneInternalNode(const InternalNode<KeyType, ValueType>* source);
+    void freeLeafNode(LeafNode<KeyType, ValueType>* node);
+    void freeInternalNode(InternalNode<KeyType, ValueType>* node);
+    static void reclaimLeafNode(void* node, void* tree);
+    static void reclaimInternalNode(void* node, void* tree);
+
+    // Parallel scans: disjoint subtrees covering a key range, run by worker threads
+    struct ScanTask {
+        const Node<KeyType, ValueType>* subtree;
+        bool checkLow;   // Subtree may hold keys below the range
+        bool checkHigh;  // Subtree may hold keys above the range
+    };
+    std::vector<ScanTask> collectScanTasks(const KeyType* low, const KeyType* high, size_t target) const;
+    template<typename Visit>
+    void scanSubtree(const ScanTask& task, const KeyType* low, const KeyType* high, Visit& visit) const;
+    template<typename Function>
+    void parallelScan(const KeyType* low, const KeyType* high, Function& fn, size_t threads) const;
+    template<typename T, typename Accumulate, typename Combine>
+    T parallelFold(const KeyType* low, const KeyType* high, T identity, Accumulate& accumulate,
+                   Combine& combine, size_t threads) const;
+    template<typename RunTask>
+    static void runWorkStealing(size_t taskCount, size_t threads, RunTask& runTask);
+
+    // Single-descent access to a key's value slot, used by the upsert family,
+    // BPlusMultiMap and SmallBPlusTree. The slot stays valid until the next modification of the tree.
+    template<typename K, typename V, typename A>
+    friend class BPlusMultiMap;
+    template<typename K, typename V, size_t N, typename A>
+    friend class SmallBPlusTree;
+    // ShardedBPlusTree walks a shard's leaves to find its median key
+    template<typename K, typename V, typename A>
+    friend class ShardedBPlusTree;
+    template<typename K, typename MakeValue>
+    std::pair<LeafNode<KeyType, ValueType>*, size_t> findOrInsertSlot(K&& key, bool& inserted, MakeValue&& make);
+    std::pair<LeafNode<KeyType, ValueType>*, size_t> findOrInsertSlot(const KeyType& key, bool& inserted) {
+        return findOrInsertSlot(key, inserted, []() { return ValueType(); });
+    }
+    std::pair<LeafNode<KeyType, ValueType>*, size_t> findSlotForWrite(const KeyType& key);
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> tryEmplaceImpl(K&& key, Args&&... args);
+    template<typename K, typename M>
+    std::pair<iterator, bool> insertOrAssignImpl(K&& key, M&& value);
+    const ValueType* findValueSlot(const KeyType& key) const;
+
+    // Range estimation: per-height samples and subtrees left to extrapolate
+    struct EstimateState {
+        std::vector<double> fanoutSum;      // Children (internal) or keys (leaves) of nodes read, per height
+        std::vector<size_t> fanoutNodes;    // Nodes read, per height
+        std::vector<size_t> frontier;       // Unread subtrees inside the range, per height
+        size_t exact = 0;                   // Keys counted in leaves that were read
+    };
+    void sampleNode(const Node<KeyType, ValueType>* node, size_t height, EstimateState& state) const;
+    void estimateCovered(const InternalNode<KeyType, ValueType>* parent, size_t first, size_t last,
+                         size_t childHeight, size_t refine, EstimateState& state) const;
+
+    // Random sampling: pieces of a range drawn in proportion to their weight.
+    // Leaf slices cut by a bound are exact; whole subtrees weigh their capacity.
+    struct SamplePiece {
+        const Node<KeyType, ValueType>* node;
+        size_t from;    // In-range slots [from, to) of an exact leaf piece
+        size_t to;
+        bool exact;
+        double weight;
+    };
+    void collectSamplePieces(const KeyType* low, const KeyType* high, std::vector<SamplePiece>& pieces) const;
+    template<typename URNG>
+    void sampleSubtree(const Node<KeyType, ValueType>* node, size_t draws, URNG& rng,
+                       std::vector<std::pair<KeyType, ValueType>>& out) const;
+    template<typename URNG>
+    std::vector<std::pair<KeyType, ValueType>> sampleImpl(const KeyType* low, const KeyType* high,
+                                                          size_t k, URNG& rng) const;
+
+    // Leapfrog cursor movement used by the set operations
+    void seekForward(const LeafNode<KeyType, ValueType>*& leaf, size_t& pos,
+                     const KeyType& key) const;
+
 public:
     /**
      * @brief Constructs a B+ Tree with the specified order and allocator
@@ -504,24 +993,51 @@ public:
     /**
      * @brief Deleted copy constructor
      *
-     * Copying a tree is expensive and usually unintended. Use move semantics instead.
+     * Copying a tree is expensive and usually unintended. Use move semantics,
+     * or clone() for an explicit copy.
      */
     BPlusTree(const BPlusTree&) = delete;
 
     /**
      * @brief Deleted copy assignment operator
      *
-     * Copying a tree is expensive and usually unintended. Use move semantics instead.
+     * Copying a tree is expensive and usually unintended. Use move semantics,
+     * or clone() for an explicit copy.
      */
     BPlusTree& operator=(const BPlusTree&) = delete;
 
+    /**
+     * @brief Returns a deep copy of the tree with the same shape
+     *
+     * Copies node by node, top level first, instead of re-inserting entries:
+     * no key is compared and no node is split. Each copy is linked to its
+     * parent (and, for leaves, to its neighbours) by position within its
+     * level, so no old-to-new node map is needed. Key and value arrays are
+     * copy-constructed, which is a memcpy for trivially copyable types.
+     *
+     * With numThreads > 1 the nodes of each level are copied in parallel;
+     * node allocation is serialized, so the allocator need not be thread-safe.
+     * The clone has this tree's order, prefetch distance and a copy of its
+     * allocator. Its statistics start fresh apart from the node counts.
+     *
+     * @param numThreads Threads used for copying (1 copies on the calling thread)
+     * @return An independent tree with the same entries and structure
+     *
+     * Time complexity: O(n) where n is the number of nodes
+     * Exception safety: Strong guarantee
+     */
+    BPlusTree clone(size_t numThreads = 1) const;
+
     /**
      * @brief Move constructor for efficient transfer of ownership
      *
      * @param other The tree to move from. After the move, other will be in a valid
      *              but empty state.
      *
-     * Time complexity: O(1)
+     * An attached epoch manager moves along with the nodes retired for it, so
+     * this never waits for latch-free readers.
+     *
+     * Time complexity: O(1) plus O(r) for r retired nodes not yet reclaimed
      * Exception safety: No-throw guarantee (noexcept) if allocator move is noexcept
      */
     BPlusTree(BPlusTree&& other) noexcept(
@@ -533,6 +1049,11 @@ public:
      *
      * Allocator propagation follows std::allocator_traits::propagate_on_container_move_assignment.
      *
+     * other's epoch manager and retired nodes move as in the move constructor.
+     * If this tree has an epoch manager attached, it is detached first, which
+     * waits for pinned readers (see setEpochManager()). A moved-from tree has
+     * none, so std::swap and container reallocation never wait.
+     *
      * @param other The tree to move from. After the move, other will be in a valid
      *              but empty state.
      * @return Reference to this tree
@@ -557,6 +1078,53 @@ public:
      */
     bool search(const KeyType& key, ValueType& value) const;
 
+    /**
+     * @brief Looks up many keys, calling callback(key, value) for each
+     *
+     * value points at the stored value, or is nullptr if the key is absent.
+     * Keys may come in any order, but ascending keys are fastest: a key on the
+     * current leaf or its successor is found without descending from the root.
+     *
+     * @param first, last Range of keys to look up
+     * @param callback Called once per key, in input order
+     *
+     * Time complexity: O(k log n) in general; O(log n + k + n/B) for k sorted keys
+     * Exception safety: Whatever callback throws is propagated
+     */
+    template<typename InputIterator, typename Callback>
+    void searchBatch(InputIterator first, InputIterator last, Callback callback) const;
+
+    /**
+     * @brief Applies a batch of insertions and removals in place
+     *
+     * Each change is a pair whose second member is either a value to insert or
+     * assign, or empty to remove the key: std::optional<ValueType> and
+     * const ValueType* both work. Changes take effect in input order. A change
+     * that lands on the same leaf as the one before it reuses that leaf instead
+     * of descending from the root, so a sorted batch only writes (and, while a
+     * snapshot is live, copies) the leaves it changes and the paths above them.
+     *
+     * @param first, last Range of changes; any order works, ascending keys are fastest
+     * @param callback Called as callback(existed) after each change, where
+     *                 existed tells whether the key was present before it
+     *
+     * Time complexity: O(k + L (log n + B)) for k sorted changes landing on L leaves
+     * Exception safety: Basic guarantee - the changes before the one that throws
+     *                   stay applied and the ones after it are not applied
+     */
+    template<typename InputIterator, typename Callback>
+    void applyBatch(InputIterator first, InputIterator last, Callback callback);
+
+    /**
+     * @brief Applies a batch of insertions and removals in place
+     *
+     * Same as applyBatch(first, last, callback) without a callback.
+     */
+    template<typename InputIterator>
+    void applyBatch(InputIterator first, InputIterator last) {
+        applyBatch(first, last, [](bool) {});
+    }
+
     /**
      * @brief Inserts a key-value pair into the tree
      *
@@ -588,6 +1156,106 @@ public:
      */
     bool remove(const KeyType& key);
 
+    // ==================== Single-Descent Updates ====================
+
+    /**
+     * @brief Inserts a key-value pair by moving them into the tree
+     *
+     * Like insert(const KeyType&, const ValueType&), but neither the key nor
+     * the value is copied.
+     *
+     * Time complexity: O(log n)
+     * Exception safety: Basic guarantee
+     */
+    void insert(KeyType&& key, ValueType&& value);
+
+    /**
+     * @brief Inserts a value constructed from args unless the key is present
+     *
+     * The value is only constructed when the key is absent.
+     *
+     * @return Iterator to the key's entry, and true if it was inserted
+     *
+     * Time complexity: O(log n), one descent
+     * Exception safety: Strong guarantee if constructing the value throws
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const KeyType& key, Args&&... args) {
+        return tryEmplaceImpl(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Moving overload of try_emplace(); the key is only moved from if inserted
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(KeyType&& key, Args&&... args) {
+        return tryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs a (key, value) pair from args and inserts it unless the key is present
+     *
+     * As with std::map::emplace(), the pair is constructed before the lookup.
+     *
+     * @return Iterator to the key's entry, and true if it was inserted
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        std::pair<KeyType, ValueType> entry(std::forward<Args>(args)...);
+        return tryEmplaceImpl(std::move(entry.first), std::move(entry.second));
+    }
+
+    /**
+     * @brief Inserts a value, or assigns it if the key is present
+     *
+     * @return Iterator to the key's entry, and true if it was inserted
+     *
+     * Time complexity: O(log n), one descent
+     */
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const KeyType& key, M&& value) {
+        return insertOrAssignImpl(key, std::forward<M>(value));
+    }
+
+    /**
+     * @brief Moving overload of insert_or_assign()
+     */
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(KeyType&& key, M&& value) {
+        return insertOrAssignImpl(std::move(key), std::forward<M>(value));
+    }
+
+    /**
+     * @brief Applies fn to the key's value in place, inserting ValueType() first if absent
+     *
+     * Replaces a search() followed by an insert() with one descent, e.g. to
+     * count occurrences:
+     * @code
+     * counts.upsert(word, [](int& count) { ++count; });
+     * @endcode
+     *
+     * @param key The key to update or insert
+     * @param fn Callable as fn(ValueType&)
+     * @return true if the key was inserted
+     *
+     * Time complexity: O(log n), one descent
+     * Exception safety: If fn throws, a just-inserted key is removed again
+     */
+    template<typename Function>
+    bool upsert(const KeyType& key, Function fn);
+
+    /**
+     * @brief Applies fn to the key's value in place if the key is present
+     *
+     * @param key The key to update
+     * @param fn Callable as fn(ValueType&)
+     * @return true if the key was found
+     *
+     * Time complexity: O(log n), one descent
+     */
+    template<typename Function>
+    bool update(const KeyType& key, Function fn);
+
     /**
      * @brief Performs a range query to retrieve all key-value pairs in a range
      *
@@ -652,37 +1320,113 @@ public:
      */
     bool isEmpty() const { return root == nullptr; }
 
-    // ==================== Statistics Methods ====================
+    // ==================== Snapshot Methods ====================
 
     /**
-     * @brief Returns a copy of the current statistics
+     * @brief Takes a snapshot-isolated, read-only view of the current contents
      *
-     * @return Statistics object containing all tracked metrics
+     * Taking a snapshot is O(1): it records the current version and marks every
+     * existing node as shared. Subsequent insert()/remove() calls copy each shared
+     * node on the modified root-to-leaf path (plus any sibling they rebalance with)
+     * before changing it, so a write costs O(log n) extra node copies while any
+     * snapshot is live. Nodes replaced this way are retired and freed once every
+     * snapshot that can reach them has been released (checked on each write).
+     *
+     * snapshot() must be called by the thread that writes to the tree; the
+     * returned handle may then be read from any thread. With no live snapshot,
+     * writes take the regular in-place path. Values modified in place through a
+     * non-const iterator bypass copy-on-write and are visible to snapshots.
+     *
+     * @return A snapshot handle that must be released before this tree is
+     *         destroyed or move-assigned
      *
      * Time complexity: O(1)
-     * Exception safety: No-throw guarantee
+     * Exception safety: Strong guarantee
+     *
+     * @code
+     * auto snap = tree.snapshot();
+     * std::thread reader([&snap] { auto rows = snap.rangeQuery(0, 1000); });
+     * tree.insert(42, value);   // not visible through snap
+     * reader.join();
+     * @endcode
      */
-    Statistics getStatistics() const noexcept { return stats; }
+    snapshot_type snapshot();
+
+    // ==================== Memory Reclamation Methods ====================
 
     /**
-     * @brief Returns a const reference to the current statistics
+     * @brief Sets how many leaves ahead scans prefetch
      *
-     * @return Const reference to the Statistics object
+     * Iterators created afterwards and rangeQuery() prefetch the node this
+     * many leaves ahead of the one they enter, and the key and value arrays
+     * of the leaf before it (see LeafNode::prefetchAhead()). Larger distances
+     * hide more memory latency on trees that do not fit in cache; 0 turns
+     * prefetching off.
      *
-     * Time complexity: O(1)
-     * Exception safety: No-throw guarantee
+     * @param distance Leaves to prefetch ahead (default DEFAULT_PREFETCH_DISTANCE)
      */
-    const Statistics& statistics() const noexcept { return stats; }
+    void setPrefetchDistance(size_t distance) noexcept { prefetchDistance = distance; }
 
     /**
-     * @brief Resets all statistics counters to zero
+     * @brief Returns how many leaves ahead scans prefetch
+     */
+    size_t getPrefetchDistance() const noexcept { return prefetchDistance; }
+
+    /**
+     * @brief Routes node frees through an epoch-based reclamation manager
      *
-     * Note: This only resets operation counters (insert, remove, search,
-     * split, merge, redistribute). Node counts are NOT reset as they
-     * represent the current tree state.
+     * Once attached, nodes released by merges, root collapses, bulkLoad() and
+     * mergeFrom() are retired to the manager instead of being freed, so threads
+     * that pinned an epoch before the release may keep reading them. The tree
+     * registers itself as one participant; calls that modify the tree act on
+     * its behalf and must not run concurrently with each other. Detaching
+     * (nullptr or another manager) waits until every node retired so far has
+     * been reclaimed. The manager must outlive the attachment.
      *
-     * Time complexity: O(1)
-     * Exception safety: No-throw guarantee
+     * Without a manager, the deallocation path costs a single null check.
+     *
+     * @param manager The manager to use, or nullptr to free nodes immediately again
+     *
+     * Time complexity: O(1) to attach; detaching waits for pinned readers
+     */
+    void setEpochManager(EpochManager* manager);
+
+    /**
+     * @brief Returns the attached epoch manager, or nullptr
+     */
+    EpochManager* epochManager() const noexcept { return epochs; }
+
+    // ==================== Statistics Methods ====================
+
+    /**
+     * @brief Returns a copy of the current statistics
+     *
+     * @return Statistics object containing all tracked metrics
+     *
+     * Time complexity: O(1)
+     * Exception safety: No-throw guarantee
+     */
+    Statistics getStatistics() const noexcept { return stats; }
+
+    /**
+     * @brief Returns a const reference to the current statistics
+     *
+     * @return Const reference to the Statistics object
+     *
+     * Time complexity: O(1)
+     * Exception safety: No-throw guarantee
+     */
+    const Statistics& statistics() const noexcept { return stats; }
+
+    /**
+     * @brief Resets all statistics counters to zero
+     *
+     * Note: This only resets operation counters (insert, remove, search,
+     * split, merge, redistribute). Node counts are NOT reset as they
+     * represent the current tree state.
+     *
+     * Time complexity: O(1)
+     * Exception safety: No-throw guarantee
      */
     void resetStatistics() noexcept {
         // Preserve node counts as they reflect actual tree state
@@ -727,6 +1471,74 @@ public:
      */
     double averageInternalFillFactor() const noexcept;
 
+    /**
+     * @brief Estimates how many keys lie in [low, high] without scanning leaves
+     *
+     * Walks the two root-to-leaf paths for low and high. The boundary leaves
+     * are counted exactly; every subtree strictly between the paths is counted
+     * as the average subtree size at its height, extrapolated from the fanout
+     * and leaf fill of the nodes the walk read. Each refinement level reads
+     * one more level of those subtrees, counting their children exactly (the
+     * work grows by about the fanout per level). With refine >= height() the
+     * count is exact.
+     *
+     * @param low The lower bound of the range (inclusive)
+     * @param high The upper bound of the range (inclusive)
+     * @param refine Levels below the paths to read instead of extrapolate
+     * @return The estimate with guaranteed bounds and selectivity
+     *
+     * Time complexity: O(height * order) for refine == 0
+     * Exception safety: Strong guarantee
+     */
+    RangeEstimate estimateRange(const KeyType& low, const KeyType& high, size_t refine = 0) const;
+
+    /**
+     * @brief Estimates how many keys lie in [low, high] (see estimateRange())
+     */
+    size_t estimateCount(const KeyType& low, const KeyType& high, size_t refine = 0) const {
+        return estimateRange(low, high, refine).count;
+    }
+
+    /**
+     * @brief Draws k entries uniformly at random, with replacement
+     *
+     * Each draw descends from the root picking a child slot uniformly out of
+     * order slots (a key slot out of maxKeys in a leaf) and is rejected when
+     * the slot is empty, so every entry is equally likely whatever the node
+     * fill. Draws are batched: one pass descends each node once for all the
+     * draws routed through it, and rejected draws are retried in the next pass.
+     *
+     * @param k The number of samples
+     * @param rng A uniform random bit generator, such as std::mt19937
+     * @return k entries in random order, or none if the tree is empty
+     *
+     * Time complexity: O(k * height / acceptance) expected, where acceptance
+     * is the tree size over its capacity (roughly the fill factor per level,
+     * multiplied down the tree)
+     * Exception safety: Strong guarantee
+     */
+    template<typename URNG>
+    std::vector<std::pair<KeyType, ValueType>> sample(size_t k, URNG& rng) const;
+
+    /**
+     * @brief Draws k entries uniformly at random from [low, high], with replacement
+     *
+     * The range is split as in estimateRange(): the two boundary leaves are
+     * sampled exactly and the subtrees between them by rejection descent.
+     *
+     * @param low The lower bound of the range (inclusive)
+     * @param high The upper bound of the range (inclusive)
+     * @param k The number of samples
+     * @param rng A uniform random bit generator, such as std::mt19937
+     * @return k entries in random order, or none if the range is empty
+     *
+     * Time complexity: O(height * order + k * height / acceptance) expected
+     * Exception safety: Strong guarantee
+     */
+    template<typename URNG>
+    std::vector<std::pair<KeyType, ValueType>> sampleRange(const KeyType& low, const KeyType& high,
+                                                           size_t k, URNG& rng) const;
+
     /**
      * @brief Efficiently constructs the tree from sorted data using bulk loading
      *
@@ -789,6 +1601,267 @@ public:
         bulkLoad(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
     }
 
+    /**
+     * @brief Merges all entries of another tree into this one in linear time
+     *
+     * Performs a two-way merge of both leaf chains, packing the merged stream
+     * into freshly allocated leaves and building the internal levels bottom-up
+     * (the same construction bulkLoad() uses). The cost is O(n + m) instead of
+     * the O(m log(n + m)) of inserting the other tree's entries one by one.
+     *
+     * The other tree is consumed: its keys and values are moved into this tree
+     * and all of its nodes are released, leaving it empty.
+     *
+     * With numThreads > 1 the key space is split into that many partitions at
+     * leaf boundaries of the larger tree, and each partition is merged on its
+     * own thread. The allocator must then be safe to call from several threads.
+     *
+     * @param other The tree to merge in (left empty afterwards)
+     * @param policy Which value survives when a key exists in both trees
+     * @param numThreads Number of key partitions to merge concurrently (default 1)
+     *
+     * Time complexity: O(n + m) where n and m are the sizes of the two trees
+     * Space complexity: O((n + m) / B) for the leaf chain bookkeeping
+     * Exception safety: Basic guarantee - both trees remain structurally valid,
+     *                   but entries already merged are left in a moved-from state
+     *
+     * @code
+     * BPlusTree<int, int> base, delta;
+     * // ... populate both ...
+     * base.mergeFrom(std::move(delta), ConflictPolicy::OVERWRITE);
+     * @endcode
+     */
+    void mergeFrom(BPlusTree&& other, ConflictPolicy policy = ConflictPolicy::OVERWRITE,
+                   size_t numThreads = 1);
+
+    /**
+     * @brief Moves all entries with keys >= key into a new tree
+     *
+     * Leaves are handed over to the new tree as they are; only the leaf holding
+     * the split key is divided. Both trees then get fresh internal levels built
+     * bottom-up, so the cost is linear in the number of leaves, not entries.
+     * This is the inverse of mergeFrom() for disjoint key ranges.
+     *
+     * The returned tree has this tree's order and a copy of its allocator, which
+     * must compare equal to this one since leaves change owner.
+     *
+     * @param key The smallest key to move
+     * @return A tree with the entries >= key; this tree keeps the entries < key
+     *
+     * Time complexity: O(n/B + B) where B is keys per leaf
+     * Exception safety: Basic guarantee
+     *
+     * @code
+     * BPlusTree<int, int> upper = tree.splitAt(1000);   // tree keeps keys < 1000
+     * tree.mergeFrom(std::move(upper));                // and back again
+     * @endcode
+     */
+    BPlusTree splitAt(const KeyType& key);
+
+    /**
+     * @brief Builds a tree holding this tree's entries with a sorted batch of changes applied
+     *
+     * Walks this tree's leaf chain and the batch together once and packs the
+     * merged stream into fresh leaves, building the internal levels bottom-up
+     * like mergeFrom(). Each batch element is a pair of a key and a
+     * std::optional value: a value inserts or replaces the key, nullopt
+     * erases it. This tree is not modified, so other threads may keep
+     * reading it while the merged tree is built.
+     *
+     * @tparam InputIterator Iterator over pairs (key, std::optional<ValueType>),
+     *         sorted by key with unique keys
+     * @param first Iterator to the first change
+     * @param last Iterator to one past the last change
+     * @return A new tree with this tree's order and allocator
+     *
+     * Time complexity: O(n + m) for n entries and m changes
+     * Exception safety: Strong guarantee - this tree is not modified
+     *
+     * @code
+     * std::map<int, std::optional<int>> changes = {{1, 10}, {2, std::nullopt}};
+     * tree = tree.mergedWith(changes.begin(), changes.end());
+     * @endcode
+     */
+    template<typename InputIterator>
+    BPlusTree mergedWith(InputIterator first, InputIterator last) const;
+
+    // ==================== Set Operations ====================
+
+    /**
+     * @brief Streams the keys present in both this tree and another tree
+     *
+     * Uses a leapfrog join: whichever side is behind jumps forward to the other
+     * side's current key. A jump stays inside the current leaf when the target is
+     * not beyond the leaf's maximum key, moves to the next leaf when that leaf's
+     * maximum covers the target, and otherwise re-descends from the root. Runs of
+     * non-matching leaves are therefore skipped without being scanned, giving
+     * O(k log(n/k)) behaviour when one side is much smaller or the overlap is tiny.
+     *
+     * @tparam Callback Callable as callback(const KeyType&, const ValueType& thisValue,
+     *                  const ValueType& otherValue)
+     * @param other The tree to intersect with
+     * @param callback Invoked once per common key, in ascending key order
+     *
+     * Time complexity: O(k log(n/k)) where k is the number of alternations between the trees
+     * Exception safety: Strong guarantee - neither tree is modified
+     */
+    template<typename Callback>
+    void intersect(const BPlusTree& other, Callback callback) const;
+
+    /**
+     * @brief Builds a tree holding the keys present in both trees
+     *
+     * Values are taken from this tree. The result is bulk loaded and uses this
+     * tree's order and allocator.
+     *
+     * @param other The tree to intersect with
+     * @return A new tree with the common keys
+     *
+     * @see intersect(const BPlusTree&, Callback) for the streaming variant
+     */
+    BPlusTree intersect(const BPlusTree& other) const;
+
+    /**
+     * @brief Streams the entries of this tree whose keys are absent from another tree
+     *
+     * For every leaf of this tree, the other tree's cursor leapfrogs to the leaf's
+     * minimum key. If the next key of the other tree lies beyond the leaf's maximum,
+     * the whole leaf is emitted without per-key probing.
+     *
+     * @tparam Callback Callable as callback(const KeyType&, const ValueType&)
+     * @param other The tree whose keys are subtracted
+     * @param callback Invoked once per surviving entry, in ascending key order
+     *
+     * Time complexity: O(n + k log(m/k)) where k is the number of probes into other
+     * Exception safety: Strong guarantee - neither tree is modified
+     */
+    template<typename Callback>
+    void difference(const BPlusTree& other, Callback callback) const;
+
+    /**
+     * @brief Builds a tree holding the entries of this tree whose keys are absent from other
+     *
+     * @param other The tree whose keys are subtracted
+     * @return A new bulk-loaded tree with this tree's order and allocator
+     *
+     * @see difference(const BPlusTree&, Callback) for the streaming variant
+     */
+    BPlusTree difference(const BPlusTree& other) const;
+
+    // ==================== Parallel Scan Methods ====================
+
+    /**
+     * @brief Calls fn(key, value) for every entry with key in [low, high], using several threads
+     *
+     * The range is cut into disjoint subtrees by descending from the root
+     * (about eight per thread), without walking the leaf chain. Each thread
+     * takes subtrees from its own share and, when that runs out, steals half
+     * of the largest remaining share of another thread.
+     *
+     * fn is called concurrently from several threads and in no particular
+     * order, so it must be thread-safe. The tree must not be modified during
+     * the scan.
+     *
+     * @param low The lower bound of the range (inclusive)
+     * @param high The upper bound of the range (inclusive)
+     * @param fn Callable as fn(const KeyType&, const ValueType&)
+     * @param threads Number of threads including the caller; 0 uses the hardware concurrency
+     *
+     * Time complexity: O(k/t + t log n) for k entries in range and t threads
+     * Exception safety: The first exception thrown by fn is rethrown after all threads stop
+     */
+    template<typename Function>
+    void parallelForEach(const KeyType& low, const KeyType& high, Function fn, size_t threads = 0) const {
+        if (high < low) return;
+        parallelScan(&low, &high, fn, threads);
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every entry, using several threads
+     *
+     * @see parallelForEach(const KeyType&, const KeyType&, Function, size_t)
+     */
+    template<typename Function>
+    void parallelForEach(Function fn, size_t threads = 0) const {
+        parallelScan(nullptr, nullptr, fn, threads);
+    }
+
+    /**
+     * @brief Aggregates the entries with key in [low, high] using several threads
+     *
+     * Each subtree is folded from identity with accumulate(acc, key, value);
+     * the partial results are then combined in key order with
+     * combine(left, right), so combine needs to be associative but not
+     * commutative.
+     *
+     * Example: sum of the values in a range
+     * @code
+     * long total = tree.parallelReduce(100, 200, 0L,
+     *     [](long acc, const int&, const int& v) { return acc + v; },
+     *     [](long a, long b) { return a + b; });
+     * @endcode
+     *
+     * @param identity The neutral element of combine
+     * @param accumulate Callable as T(T, const KeyType&, const ValueType&)
+     * @param combine Callable as T(T, T)
+     * @param threads Number of threads including the caller; 0 uses the hardware concurrency
+     * @return The combined result, or identity if the range is empty
+     *
+     * Time complexity: O(k/t + t log n) for k entries in range and t threads
+     * Exception safety: The first exception thrown by accumulate is rethrown after all threads stop
+     */
+    template<typename T, typename Accumulate, typename Combine>
+    T parallelReduce(const KeyType& low, const KeyType& high, T identity, Accumulate accumulate,
+                     Combine combine, size_t threads = 0) const {
+        if (high < low) return identity;
+        return parallelFold(&low, &high, std::move(identity), accumulate, combine, threads);
+    }
+
+    /**
+     * @brief Aggregates every entry using several threads
+     *
+     * @see parallelReduce(const KeyType&, const KeyType&, T, Accumulate, Combine, size_t)
+     */
+    template<typename T, typename Accumulate, typename Combine>
+    T parallelReduce(T identity, Accumulate accumulate, Combine combine, size_t threads = 0) const {
+        return parallelFold(nullptr, nullptr, std::move(identity), accumulate, combine, threads);
+    }
+
+    // ==================== Filtered Scan Methods ====================
+
+    /**
+     * @brief Streams the entries with key in [low, high] that satisfy both predicates
+     *
+     * Predicates are evaluated over a leaf's keys[] and values[] arrays at
+     * once, producing a selection mask before any entry is passed to sink.
+     * A leaf is skipped without touching its entries when its key range or
+     * its value zone map (the min/max of its values, kept up to date by
+     * insert, remove, split and merge) cannot satisfy the predicates; such
+     * leaves are counted in Statistics::zoneMapSkipCount. Only value types
+     * enabled by ZoneMapTraits (arithmetic types by default) have zone maps;
+     * for others, value predicates are still evaluated on every leaf in range.
+     *
+     * Example: values above 100 among keys 1000..2000
+     * @code
+     * tree.scanWhere(1000, 2000, ScanPredicate<int>::any(), ScanPredicate<int>::greater(100),
+     *                [](const int& key, const int& value) { ... });
+     * @endcode
+     *
+     * @param low The lower bound of the key range (inclusive)
+     * @param high The upper bound of the key range (inclusive)
+     * @param keyPredicate Additional filter on keys
+     * @param valuePredicate Filter on values
+     * @param sink Callable as sink(const KeyType&, const ValueType&), called in key order
+     * @return The number of entries passed to sink
+     * @throws std::invalid_argument If valuePredicate is not ANY and ValueType has no operator<
+     *
+     * Time complexity: O(log n + L*B) for L leaves in range that are not skipped
+     * Exception safety: Whatever sink throws is propagated; the tree is unchanged
+     */
+    template<typename Sink>
+    size_t scanWhere(const KeyType& low, const KeyType& high, const ScanPredicate<KeyType>& keyPredicate,
+                     const ScanPredicate<ValueType>& valuePredicate, Sink sink) const;
+
     // ==================== Persistence Methods ====================
 
     /**
@@ -869,12 +1942,11 @@ public:
      * @return Iterator pointing to the first (smallest) key-value pair,
      *         or end() if the tree is empty
      *
-     * Time complexity: O(log n) to find the first leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     iterator begin() {
-        LeafNode<KeyType, ValueType>* first = getFirstLeaf();
-        return first && first->numKeys > 0 ? iterator(first, 0) : end();
+        return headLeaf && headLeaf->numKeys > 0 ? iterator(headLeaf, 0, prefetchDistance) : end();
     }
 
     /**
@@ -883,12 +1955,11 @@ public:
      * @return Const iterator pointing to the first (smallest) key-value pair,
      *         or end() if the tree is empty
      *
-     * Time complexity: O(log n) to find the first leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     const_iterator begin() const {
-        const LeafNode<KeyType, ValueType>* first = getFirstLeaf();
-        return first && first->numKeys > 0 ? const_iterator(first, 0) : end();
+        return headLeaf && headLeaf->numKeys > 0 ? const_iterator(headLeaf, 0, prefetchDistance) : end();
     }
 
     /**
@@ -897,7 +1968,7 @@ public:
      * @return Const iterator pointing to the first (smallest) key-value pair,
      *         or cend() if the tree is empty
      *
-     * Time complexity: O(log n) to find the first leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     const_iterator cbegin() const {
@@ -909,13 +1980,11 @@ public:
      *
      * @return Iterator representing the end of the container
      *
-     * Time complexity: O(log n) to find the last leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     iterator end() {
-        if (!root) return iterator(nullptr, 0);
-        LeafNode<KeyType, ValueType>* last = getLastLeaf();
-        return iterator(last, last ? last->numKeys : 0);
+        return iterator(tailLeaf, tailLeaf ? tailLeaf->numKeys : 0);
     }
 
     /**
@@ -923,13 +1992,11 @@ public:
      *
      * @return Const iterator representing the end of the container
      *
-     * Time complexity: O(log n) to find the last leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     const_iterator end() const {
-        if (!root) return const_iterator(nullptr, 0);
-        const LeafNode<KeyType, ValueType>* last = getLastLeaf();
-        return const_iterator(last, last ? last->numKeys : 0);
+        return const_iterator(tailLeaf, tailLeaf ? tailLeaf->numKeys : 0);
     }
 
     /**
@@ -950,14 +2017,12 @@ public:
      * @return Reverse iterator pointing to the last (largest) key-value pair,
      *         or rend() if the tree is empty
      *
-     * Time complexity: O(log n) to find the last leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     reverse_iterator rbegin() {
-        if (!root) return reverse_iterator(nullptr, 0);
-        LeafNode<KeyType, ValueType>* last = getLastLeaf();
-        return last && last->numKeys > 0 ?
-               reverse_iterator(last, last->numKeys - 1) :
+        return tailLeaf && tailLeaf->numKeys > 0 ?
+               reverse_iterator(tailLeaf, tailLeaf->numKeys - 1) :
                reverse_iterator(nullptr, 0);
     }
 
@@ -967,14 +2032,12 @@ public:
      * @return Const reverse iterator pointing to the last (largest) key-value pair,
      *         or rend() if the tree is empty
      *
-     * Time complexity: O(log n) to find the last leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     const_reverse_iterator rbegin() const {
-        if (!root) return const_reverse_iterator(nullptr, 0);
-        const LeafNode<KeyType, ValueType>* last = getLastLeaf();
-        return last && last->numKeys > 0 ?
-               const_reverse_iterator(last, last->numKeys - 1) :
+        return tailLeaf && tailLeaf->numKeys > 0 ?
+               const_reverse_iterator(tailLeaf, tailLeaf->numKeys - 1) :
                const_reverse_iterator(nullptr, 0);
     }
 
@@ -984,7 +2047,7 @@ public:
      * @return Const reverse iterator pointing to the last (largest) key-value pair,
      *         or crend() if the tree is empty
      *
-     * Time complexity: O(log n) to find the last leaf
+     * Time complexity: O(1)
      * Exception safety: No-throw guarantee
      */
     const_reverse_iterator crbegin() const {
@@ -1026,12 +2089,113 @@ public:
     const_reverse_iterator crend() const {
         return rend();
     }
+
+    /**
+     * @brief Returns the entry with the smallest key
+     *
+     * @return Copy of the first key-value pair
+     * @pre The tree is not empty
+     *
+     * Time complexity: O(1)
+     * Exception safety: Strong guarantee
+     */
+    std::pair<KeyType, ValueType> front() const {
+        assert(headLeaf && "front() called on an empty tree");
+        return {headLeaf->keys[0], headLeaf->values[0]};
+    }
+
+    /**
+     * @brief Returns the entry with the largest key
+     *
+     * @return Copy of the last key-value pair
+     * @pre The tree is not empty
+     *
+     * Time complexity: O(1)
+     * Exception safety: Strong guarantee
+     */
+    std::pair<KeyType, ValueType> back() const {
+        assert(tailLeaf && "back() called on an empty tree");
+        return {tailLeaf->keys[tailLeaf->numKeys - 1], tailLeaf->values[tailLeaf->numKeys - 1]};
+    }
+
+    /**
+     * @brief Returns an iterator to the first element whose key is not less than key
+     *
+     * @param key The key to search for
+     * @return Iterator to the first element with key >= key, or end() if none exists
+     *
+     * Time complexity: O(log n)
+     * Exception safety: No-throw guarantee
+     */
+    iterator lower_bound(const KeyType& key) {
+        if (!root) return end();
+        LeafNode<KeyType, ValueType>* leaf = findLeaf(key);
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos == leaf->numKeys && leaf->next) {
+            // Key is past this leaf's maximum; the next leaf starts the answer
+            return iterator(leaf->next, 0, prefetchDistance);
+        }
+        return iterator(leaf, pos, prefetchDistance);
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element whose key is not less than key
+     *
+     * @param key The key to search for
+     * @return Const iterator to the first element with key >= key, or end() if none exists
+     *
+     * Time complexity: O(log n)
+     * Exception safety: No-throw guarantee
+     */
+    const_iterator lower_bound(const KeyType& key) const {
+        if (!root) return end();
+        const LeafNode<KeyType, ValueType>* leaf = findLeaf(key);
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos == leaf->numKeys && leaf->next) {
+            return const_iterator(leaf->next, 0, prefetchDistance);
+        }
+        return const_iterator(leaf, pos, prefetchDistance);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element whose key is greater than key
+     *
+     * @param key The key to search for
+     * @return Iterator to the first element with key > key, or end() if none exists
+     *
+     * Time complexity: O(log n)
+     * Exception safety: No-throw guarantee
+     */
+    iterator upper_bound(const KeyType& key) {
+        iterator it = lower_bound(key);
+        if (it != end() && it->first == key) ++it;
+        return it;
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element whose key is greater than key
+     *
+     * @param key The key to search for
+     * @return Const iterator to the first element with key > key, or end() if none exists
+     *
+     * Time complexity: O(log n)
+     * Exception safety: No-throw guarantee
+     */
+    const_iterator upper_bound(const KeyType& key) const {
+        const_iterator it = lower_bound(key);
+        if (it != end() && it->first == key) ++it;
+        return it;
+    }
 };
 
 // Constructor
 template<typename KeyType, typename ValueType, typename Allocator>
 BPlusTree<KeyType, ValueType, Allocator>::BPlusTree(size_t ord, const Allocator& alloc)
-    : root(nullptr), order(ord), leaf_allocator(alloc), internal_allocator(alloc) {
+    : root(nullptr), headLeaf(nullptr), tailLeaf(nullptr), order(ord),
+      prefetchDistance(DEFAULT_PREFETCH_DISTANCE),
+      epochs(nullptr), epochParticipant(nullptr),
+      leaf_allocator(alloc), internal_allocator(alloc),
+      snapshots(), writeVersion(0), sharedVersion(0), hasSharedNodes(false) {
     if (order < MIN_ORDER) {
         order = MIN_ORDER;
     }
@@ -1042,7 +2206,12 @@ BPlusTree<KeyType, ValueType, Allocator>::BPlusTree(size_t ord, const Allocator&
 // Destructor
 template<typename KeyType, typename ValueType, typename Allocator>
 BPlusTree<KeyType, ValueType, Allocator>::~BPlusTree() {
+    // Snapshots must not outlive the tree, so nothing is shared any more
+    assert((!snapshots || snapshots->activeCount.load() == 0) && "Snapshot outlives its tree");
+    hasSharedNodes = false;
+    setEpochManager(nullptr);
     destroyTree(root);
+    freeRetiredNodes(true, 0);
 }
 
 // Move constructor
@@ -1050,15 +2219,31 @@ template<typename KeyType, typename ValueType, typename Allocator>
 BPlusTree<KeyType, ValueType, Allocator>::BPlusTree(BPlusTree&& other) noexcept(
     std::is_nothrow_move_constructible<LeafNodeAllocator>::value &&
     std::is_nothrow_move_constructible<InternalNodeAllocator>::value)
-    : root(other.root), order(other.order), maxKeys(other.maxKeys), minKeys(other.minKeys),
+    : root(other.root), headLeaf(other.headLeaf), tailLeaf(other.tailLeaf),
+      order(other.order), maxKeys(other.maxKeys), minKeys(other.minKeys),
+      prefetchDistance(other.prefetchDistance),
+      epochs(other.epochs), epochParticipant(other.epochParticipant),
       leaf_allocator(std::move(other.leaf_allocator)),
       internal_allocator(std::move(other.internal_allocator)),
-      stats(other.stats) {
+      stats(other.stats), snapshots(std::move(other.snapshots)),
+      writeVersion(other.writeVersion), sharedVersion(other.sharedVersion),
+      hasSharedNodes(other.hasSharedNodes), retiredNodes(std::move(other.retiredNodes)) {
+    if (epochs) {
+        // Retired nodes are freed through the tree that retired them
+        epochs->rebindContext(*epochParticipant, &other, this);
+    }
+
     other.root = nullptr;
+    other.headLeaf = nullptr;
+    other.tailLeaf = nullptr;
     other.order = DEFAULT_ORDER;
     other.maxKeys = DEFAULT_ORDER - 1;
     other.minKeys = (DEFAULT_ORDER + 1) / 2 - 1;
     other.stats.reset();
+    other.hasSharedNodes = false;
+    other.retiredNodes.clear();
+    other.epochs = nullptr;
+    other.epochParticipant = nullptr;
 }
 
 // Move assignment operator
@@ -1068,8 +2253,20 @@ BPlusTree<KeyType, ValueType, Allocator>::operator=(BPlusTree&& other) noexcept(
     std::allocator_traits<LeafNodeAllocator>::propagate_on_container_move_assignment::value ||
     std::allocator_traits<LeafNodeAllocator>::is_always_equal::value) {
     if (this != &other) {
-        // Clean up existing tree (stats will be updated via deallocate methods)
+        // Clean up existing tree (stats will be updated via deallocate methods).
+        // Snapshots must have been released, so every node can be freed now.
+        assert((!snapshots || snapshots->activeCount.load() == 0) && "Snapshot outlives its tree");
+        hasSharedNodes = false;
+        setEpochManager(nullptr);
         destroyTree(root);
+        freeRetiredNodes(true, 0);
+
+        // Nodes retired by other are freed through this tree from now on
+        epochs = other.epochs;
+        epochParticipant = other.epochParticipant;
+        if (epochs) {
+            epochs->rebindContext(*epochParticipant, &other, this);
+        }
 
         // Handle allocator propagation
         using PropagateAlloc = typename std::allocator_traits<LeafNodeAllocator>::propagate_on_container_move_assignment;
@@ -1080,17 +2277,31 @@ BPlusTree<KeyType, ValueType, Allocator>::operator=(BPlusTree&& other) noexcept(
 
         // Move data from other
         root = other.root;
+        headLeaf = other.headLeaf;
+        tailLeaf = other.tailLeaf;
         order = other.order;
         maxKeys = other.maxKeys;
         minKeys = other.minKeys;
+        prefetchDistance = other.prefetchDistance;
         stats = other.stats;
+        snapshots = std::move(other.snapshots);
+        writeVersion = other.writeVersion;
+        sharedVersion = other.sharedVersion;
+        hasSharedNodes = other.hasSharedNodes;
+        retiredNodes = std::move(other.retiredNodes);
 
         // Reset other to empty state
         other.root = nullptr;
+        other.headLeaf = nullptr;
+        other.tailLeaf = nullptr;
         other.order = DEFAULT_ORDER;
         other.maxKeys = DEFAULT_ORDER - 1;
         other.minKeys = (DEFAULT_ORDER + 1) / 2 - 1;
         other.stats.reset();
+        other.hasSharedNodes = false;
+        other.retiredNodes.clear();
+        other.epochs = nullptr;
+        other.epochParticipant = nullptr;
     }
     return *this;
 }
@@ -1130,6 +2341,42 @@ bool BPlusTree<KeyType, ValueType, Allocator>::search(const KeyType& key, ValueT
     return found;
 }
 
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename InputIterator, typename Callback>
+void BPlusTree<KeyType, ValueType, Allocator>::searchBatch(InputIterator first, InputIterator last,
+                                                           Callback callback) const {
+    auto covers = [](const LeafNode<KeyType, ValueType>* leaf, const KeyType& key) {
+        return leaf->numKeys > 0 && !(key < leaf->keys[0]) && !(leaf->keys[leaf->numKeys - 1] < key);
+    };
+
+    const LeafNode<KeyType, ValueType>* leaf = nullptr;
+    for (; first != last; ++first) {
+        const KeyType& key = *first;
+        stats.searchCount++;
+        if (!root) {
+            callback(key, static_cast<const ValueType*>(nullptr));
+            continue;
+        }
+
+        // Stay on the current leaf or step to its successor before descending again
+        if (!leaf || !covers(leaf, key)) {
+            if (leaf && leaf->next && covers(leaf->next, key)) {
+                leaf = leaf->next;
+            } else {
+                leaf = findLeaf(key);
+            }
+        }
+
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+            stats.searchHitCount++;
+            callback(key, static_cast<const ValueType*>(&leaf->values[pos]));
+        } else {
+            callback(key, static_cast<const ValueType*>(nullptr));
+        }
+    }
+}
+
 template<typename KeyType, typename ValueType, typename Allocator>
 LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::findLeaf(const KeyType& key) {
     Node<KeyType, ValueType>* current = root;
@@ -1166,24 +2413,27 @@ const LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::fi
 template<typename KeyType, typename ValueType, typename Allocator>
 void BPlusTree<KeyType, ValueType, Allocator>::insert(const KeyType& key, const ValueType& value) {
     stats.insertCount++;
+    refreshSnapshotState();
 
     // Empty tree case
     if (!root) {
         root = allocateLeafNode();
         assert(root->isLeaf() && "Root should be a leaf node");
         LeafNode<KeyType, ValueType>* leaf = static_cast<LeafNode<KeyType, ValueType>*>(root);
+        headLeaf = tailLeaf = leaf;
         leaf->insertAt(0, key, value);
         return;
     }
 
-    // Find the appropriate leaf node
-    LeafNode<KeyType, ValueType>* leaf = findLeaf(key);
+    // Find the appropriate leaf node (copying the path if a snapshot shares it)
+    LeafNode<KeyType, ValueType>* leaf = findLeafForWrite(key);
 
     // Check for duplicate key
     size_t pos = leaf->findKeyPosition(key);
     if (pos < leaf->numKeys && leaf->keys[pos] == key) {
         // Update existing value
         leaf->values[pos] = value;
+        leaf->widenZone(value);
         return;
     }
 
@@ -1196,30 +2446,253 @@ void BPlusTree<KeyType, ValueType, Allocator>::insert(const KeyType& key, const
     }
 }
 
+// Finds key's slot, or inserts make() under it; make is only called when inserting
 template<typename KeyType, typename ValueType, typename Allocator>
-void BPlusTree<KeyType, ValueType, Allocator>::splitLeaf(LeafNode<KeyType, ValueType>* leaf) {
-    stats.leafSplitCount++;
-
-    // Create new leaf node
-    LeafNode<KeyType, ValueType>* newLeaf = nullptr;
+template<typename K, typename MakeValue>
+std::pair<LeafNode<KeyType, ValueType>*, size_t>
+BPlusTree<KeyType, ValueType, Allocator>::findOrInsertSlot(K&& key, bool& inserted, MakeValue&& make) {
+    stats.insertCount++;
+    refreshSnapshotState();
 
-    try {
-        newLeaf = allocateLeafNode();
+    if (!root) {
+        ValueType value = make();
+        LeafNode<KeyType, ValueType>* leaf = allocateLeafNode();
+        try {
+            leaf->insertAt(0, KeyType(std::forward<K>(key)), std::move(value));
+        } catch (...) {
+            deallocateLeafNode(leaf);
+            throw;
+        }
+        root = leaf;
+        headLeaf = tailLeaf = leaf;
+        inserted = true;
+        return {leaf, 0};
+    }
 
-        // Calculate split point
-        size_t splitPoint = (maxKeys + 1) / 2;
+    LeafNode<KeyType, ValueType>* leaf = findLeafForWrite(key);
+    size_t pos = leaf->findKeyPosition(key);
+    if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+        inserted = false;
+        return {leaf, pos};
+    }
 
-        // Move second half of keys and values to new leaf using direct indexing
-        size_t newLeafIndex = 0;
-        for (size_t i = splitPoint; i < leaf->numKeys; i++) {
-            newLeaf->keys[newLeafIndex] = std::move(leaf->keys[i]);
-            newLeaf->values[newLeafIndex] = std::move(leaf->values[i]);
-            newLeafIndex++;
+    ValueType value = make();
+    leaf->insertAt(pos, KeyType(std::forward<K>(key)), std::move(value));
+    inserted = true;
+    if (leaf->isFull()) {
+        splitLeaf(leaf);
+        // The upper half of the entries moved to the new right sibling
+        if (pos >= leaf->numKeys) {
+            pos -= leaf->numKeys;
+            leaf = leaf->next;
+        }
+    }
+    return {leaf, pos};
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::insert(KeyType&& key, ValueType&& value) {
+    bool inserted = false;
+    auto slot = findOrInsertSlot(std::move(key), inserted, [&value]() { return std::move(value); });
+    if (!inserted) {
+        slot.first->values[slot.second] = std::move(value);
+        slot.first->widenZone(slot.first->values[slot.second]);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename K, typename... Args>
+std::pair<typename BPlusTree<KeyType, ValueType, Allocator>::iterator, bool>
+BPlusTree<KeyType, ValueType, Allocator>::tryEmplaceImpl(K&& key, Args&&... args) {
+    bool inserted = false;
+    auto slot = findOrInsertSlot(std::forward<K>(key), inserted, [&]() {
+        return ValueType(std::forward<Args>(args)...);
+    });
+    return {iterator(slot.first, slot.second, prefetchDistance), inserted};
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename K, typename M>
+std::pair<typename BPlusTree<KeyType, ValueType, Allocator>::iterator, bool>
+BPlusTree<KeyType, ValueType, Allocator>::insertOrAssignImpl(K&& key, M&& value) {
+    bool inserted = false;
+    auto slot = findOrInsertSlot(std::forward<K>(key), inserted, [&value]() {
+        return ValueType(std::forward<M>(value));
+    });
+    if (!inserted) {
+        slot.first->values[slot.second] = std::forward<M>(value);
+        slot.first->widenZone(slot.first->values[slot.second]);
+    }
+    return {iterator(slot.first, slot.second, prefetchDistance), inserted};
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Function>
+bool BPlusTree<KeyType, ValueType, Allocator>::upsert(const KeyType& key, Function fn) {
+    bool inserted = false;
+    auto slot = findOrInsertSlot(key, inserted);
+    try {
+        fn(slot.first->values[slot.second]);
+    } catch (...) {
+        // fn may have changed the value before throwing
+        slot.first->widenZoneNoThrow(slot.first->values[slot.second]);
+        if (inserted) remove(key);
+        throw;
+    }
+    slot.first->widenZone(slot.first->values[slot.second]);
+    return inserted;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Function>
+bool BPlusTree<KeyType, ValueType, Allocator>::update(const KeyType& key, Function fn) {
+    auto slot = findSlotForWrite(key);
+    if (!slot.first) return false;
+    try {
+        fn(slot.first->values[slot.second]);
+    } catch (...) {
+        // fn may have changed the value before throwing
+        slot.first->widenZoneNoThrow(slot.first->values[slot.second]);
+        throw;
+    }
+    slot.first->widenZone(slot.first->values[slot.second]);
+    return true;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+std::pair<LeafNode<KeyType, ValueType>*, size_t>
+BPlusTree<KeyType, ValueType, Allocator>::findSlotForWrite(const KeyType& key) {
+    if (!root) return {nullptr, 0};
+    refreshSnapshotState();
+
+    LeafNode<KeyType, ValueType>* leaf = findLeafForWrite(key);
+    size_t pos = leaf->findKeyPosition(key);
+    if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+        return {leaf, pos};
+    }
+    return {nullptr, 0};
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename InputIterator, typename Callback>
+void BPlusTree<KeyType, ValueType, Allocator>::applyBatch(InputIterator first, InputIterator last,
+                                                          Callback callback) {
+    refreshSnapshotState();
+
+    // Leaf of the previous change and the separators around it; reset by any split or merge
+    LeafNode<KeyType, ValueType>* leaf = nullptr;
+    const KeyType* lower = nullptr;
+    const KeyType* upper = nullptr;
+
+    for (; first != last; ++first) {
+        const auto& change = *first;
+        const KeyType& key = change.first;
+
+        if (!root) {
+            if (change.second) {
+                stats.insertCount++;
+                LeafNode<KeyType, ValueType>* created = allocateLeafNode();
+                try {
+                    created->insertAt(0, key, *change.second);
+                } catch (...) {
+                    deallocateLeafNode(created);
+                    throw;
+                }
+                root = created;
+                headLeaf = tailLeaf = created;
+                leaf = created;
+                lower = upper = nullptr;
+            }
+            callback(false);
+            continue;
+        }
+
+        // Stay on the current leaf while the key falls between its separators
+        if (!leaf || (lower && key < *lower) || (upper && !(key < *upper))) {
+            leaf = findLeafForWrite(key, lower, upper);
+        }
+
+        size_t pos = leaf->findKeyPosition(key);
+        bool existed = pos < leaf->numKeys && leaf->keys[pos] == key;
+        if (change.second) {
+            stats.insertCount++;
+            if (existed) {
+                try {
+                    leaf->values[pos] = *change.second;
+                } catch (...) {
+                    leaf->widenZoneNoThrow(leaf->values[pos]);
+                    throw;
+                }
+                leaf->widenZone(leaf->values[pos]);
+            } else {
+                // Copy first so a throwing copy leaves the leaf untouched
+                KeyType newKey(key);
+                ValueType newValue(*change.second);
+                leaf->insertAt(pos, std::move(newKey), std::move(newValue));
+                if (leaf->isFull()) {
+                    splitLeaf(leaf);
+                    leaf = nullptr;
+                }
+            }
+        } else if (existed) {
+            stats.removeCount++;
+            leaf->removeAt(pos);
+            if (leaf == root) {
+                if (leaf->numKeys == 0) {
+                    deallocateLeafNode(leaf);
+                    root = nullptr;
+                    headLeaf = tailLeaf = nullptr;
+                    leaf = nullptr;
+                }
+            } else if (leaf->isUnderflow(minKeys)) {
+                deleteEntry(leaf);
+                leaf = nullptr;
+            }
+        }
+        callback(existed);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+const ValueType* BPlusTree<KeyType, ValueType, Allocator>::findValueSlot(const KeyType& key) const {
+    stats.searchCount++;
+    if (!root) return nullptr;
+
+    const LeafNode<KeyType, ValueType>* leaf = findLeaf(key);
+    size_t pos = leaf->findKeyPosition(key);
+    if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+        stats.searchHitCount++;
+        return &leaf->values[pos];
+    }
+    return nullptr;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::splitLeaf(LeafNode<KeyType, ValueType>* leaf) {
+    stats.leafSplitCount++;
+
+    // Create new leaf node
+    LeafNode<KeyType, ValueType>* newLeaf = nullptr;
+
+    try {
+        newLeaf = allocateLeafNode();
+
+        // Calculate split point
+        size_t splitPoint = (maxKeys + 1) / 2;
+
+        // Move second half of keys and values to new leaf using direct indexing
+        size_t newLeafIndex = 0;
+        for (size_t i = splitPoint; i < leaf->numKeys; i++) {
+            newLeaf->keys[newLeafIndex] = std::move(leaf->keys[i]);
+            newLeaf->values[newLeafIndex] = std::move(leaf->values[i]);
+            newLeafIndex++;
         }
         newLeaf->numKeys = newLeafIndex;
 
         // Adjust original leaf - just update count, no need to resize
         leaf->numKeys = splitPoint;
+        leaf->rebuildZone();
+        newLeaf->rebuildZone();
 
         // Update linked list
         newLeaf->next = leaf->next;
@@ -1232,6 +2705,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::splitLeaf(LeafNode<KeyType, Value
         // Insert into parent (promote the first key of new leaf)
         KeyType promoteKey = newLeaf->keys[0];
         insertIntoParent(leaf, promoteKey, newLeaf);
+        if (leaf == tailLeaf) tailLeaf = newLeaf;
     } catch (...) {
         // If an exception occurs, clean up the new leaf
         if (newLeaf) deallocateLeafNode(newLeaf);
@@ -1359,6 +2833,12 @@ bool BPlusTree<KeyType, ValueType, Allocator>::remove(const KeyType& key) {
 
     stats.removeCount++;
 
+    // Copy the path before modifying nodes that a snapshot may share
+    refreshSnapshotState();
+    if (hasSharedNodes) {
+        leaf = findLeafForWrite(key);
+    }
+
     // Remove the key
     leaf->removeAt(pos);
 
@@ -1368,6 +2848,7 @@ bool BPlusTree<KeyType, ValueType, Allocator>::remove(const KeyType& key) {
         if (leaf->numKeys == 0) {
             deallocateLeafNode(leaf);
             root = nullptr;
+            headLeaf = tailLeaf = nullptr;
         }
         return true;
     }
@@ -1392,11 +2873,13 @@ void BPlusTree<KeyType, ValueType, Allocator>::deleteEntry(Node<KeyType, ValueTy
                     root->parent = nullptr;
                 } else {
                     root = nullptr;
+                    headLeaf = tailLeaf = nullptr;
                 }
                 deallocateInternalNode(internal);
             } else {
                 deallocateLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
                 root = nullptr;
+                headLeaf = tailLeaf = nullptr;
             }
         }
         return;
@@ -1420,7 +2903,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::deleteEntry(Node<KeyType, ValueTy
         // Add assertion to ensure sibling is valid
         assert(leftSibling && "Left sibling should not be null");
         if (leftSibling->numKeys > minKeys) {
-            redistributeNodes(node, leftSibling, nodeIndex - 1, true);
+            redistributeNodes(node, makeWritable(leftSibling), nodeIndex - 1, true);
             return;
         }
     }
@@ -1431,7 +2914,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::deleteEntry(Node<KeyType, ValueTy
         // Add assertion to ensure sibling is valid
         assert(rightSibling && "Right sibling should not be null");
         if (rightSibling->numKeys > minKeys) {
-            redistributeNodes(node, rightSibling, nodeIndex, false);
+            redistributeNodes(node, makeWritable(rightSibling), nodeIndex, false);
             return;
         }
     }
@@ -1440,11 +2923,11 @@ void BPlusTree<KeyType, ValueType, Allocator>::deleteEntry(Node<KeyType, ValueTy
     if (nodeIndex > 0) {
         Node<KeyType, ValueType>* leftSibling = parent->children[nodeIndex - 1];
         assert(leftSibling && "Left sibling should not be null");
-        mergeNodes(leftSibling, node, nodeIndex - 1, true);
+        mergeNodes(makeWritable(leftSibling), node, nodeIndex - 1, true);
     } else {
         Node<KeyType, ValueType>* rightSibling = parent->children[nodeIndex + 1];
         assert(rightSibling && "Right sibling should not be null");
-        mergeNodes(node, rightSibling, nodeIndex, false);
+        mergeNodes(node, makeWritable(rightSibling), nodeIndex, false);
     }
 }
 
@@ -1495,6 +2978,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::mergeNodes(
             leftIndex++;
         }
         leftLeaf->numKeys = leftIndex;
+        leftLeaf->rebuildZone();
 
         // Step 2: Update the doubly-linked list to remove right leaf
         // This maintains sequential access capability across leaf nodes
@@ -1502,6 +2986,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::mergeNodes(
         if (rightLeaf->next) {
             rightLeaf->next->prev = leftLeaf;
         }
+        if (rightLeaf == tailLeaf) tailLeaf = leftLeaf;
 
         // Step 3: Delete the now-empty right leaf
         deallocateLeafNode(rightLeaf);
@@ -1631,6 +3116,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::redistributeNodes(
             leaf->values[0] = std::move(siblingLeaf->values[siblingLeaf->numKeys - 1]);
             leaf->numKeys++;
             siblingLeaf->numKeys--;
+            leaf->rebuildZone();
 
             // Step 3: Update parent separator key to be node's new first key
             // This maintains the invariant that parent key equals first key of right child
@@ -1643,6 +3129,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::redistributeNodes(
             leaf->keys[leaf->numKeys] = std::move(siblingLeaf->keys[0]);
             leaf->values[leaf->numKeys] = std::move(siblingLeaf->values[0]);
             leaf->numKeys++;
+            leaf->rebuildZone();
 
             // Step 2: Shift all entries in right sibling one position to the left
             // to fill the gap left by the borrowed key
@@ -1748,6 +3235,7 @@ std::vector<std::pair<KeyType, ValueType>> BPlusTree<KeyType, ValueType, Allocat
 
     // Traverse leaves and collect results
     while (leaf) {
+        leaf->prefetchAhead(prefetchDistance);
         for (size_t i = 0; i < leaf->numKeys; i++) {
             if (leaf->keys[i] >= start && leaf->keys[i] <= end) {
                 result.emplace_back(leaf->keys[i], leaf->values[i]);
@@ -1841,6 +3329,262 @@ double BPlusTree<KeyType, ValueType, Allocator>::averageLeafFillFactor() const n
            (static_cast<double>(stats.leafNodeCount) * static_cast<double>(maxKeys));
 }
 
+// Records a node's fanout (or a leaf's key count) for its height
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::sampleNode(const Node<KeyType, ValueType>* node, size_t height,
+                                                          EstimateState& state) const {
+    state.fanoutSum[height] += static_cast<double>(node->isLeaf() ? node->numKeys : node->numKeys + 1);
+    state.fanoutNodes[height]++;
+}
+
+// Accounts for parent->children[first, last), which lie entirely inside the range
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::estimateCovered(const InternalNode<KeyType, ValueType>* parent,
+                                                               size_t first, size_t last, size_t childHeight,
+                                                               size_t refine, EstimateState& state) const {
+    if (first >= last) return;
+    if (refine == 0) {
+        state.frontier[childHeight] += last - first;
+        return;
+    }
+    for (size_t i = first; i < last; ++i) {
+        const Node<KeyType, ValueType>* child = parent->children[i];
+        sampleNode(child, childHeight, state);
+        if (child->isLeaf()) {
+            state.exact += child->numKeys;
+        } else {
+            estimateCovered(static_cast<const InternalNode<KeyType, ValueType>*>(child), 0,
+                            child->numKeys + 1, childHeight - 1, refine - 1, state);
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+RangeEstimate BPlusTree<KeyType, ValueType, Allocator>::estimateRange(const KeyType& low, const KeyType& high,
+                                                                      size_t refine) const {
+    RangeEstimate result;
+    if (!root || high < low) return result;
+
+    size_t levels = height();
+    EstimateState state;
+    state.fanoutSum.assign(levels, 0.0);
+    state.fanoutNodes.assign(levels, 0);
+    state.frontier.assign(levels, 0);
+
+    // Walk both paths; children strictly between them are inside the range
+    const Node<KeyType, ValueType>* left = root;
+    const Node<KeyType, ValueType>* right = root;
+    for (size_t height = levels - 1; height > 0; --height) {
+        const auto* l = static_cast<const InternalNode<KeyType, ValueType>*>(left);
+        const auto* r = static_cast<const InternalNode<KeyType, ValueType>*>(right);
+        size_t li = l->findChildIndex(low);
+        size_t ri = r->findChildIndex(high);
+        sampleNode(l, height, state);
+        if (l == r) {
+            estimateCovered(l, li + 1, ri, height - 1, refine, state);
+        } else {
+            sampleNode(r, height, state);
+            estimateCovered(l, li + 1, l->numKeys + 1, height - 1, refine, state);
+            estimateCovered(r, 0, ri, height - 1, refine, state);
+        }
+        left = l->children[li];
+        right = r->children[ri];
+    }
+
+    // The boundary leaves are counted exactly
+    const auto* leftLeaf = static_cast<const LeafNode<KeyType, ValueType>*>(left);
+    const auto* rightLeaf = static_cast<const LeafNode<KeyType, ValueType>*>(right);
+    size_t from = leftLeaf->findKeyPosition(low);
+    size_t to = rightLeaf->findKeyPosition(high);
+    if (to < rightLeaf->numKeys && rightLeaf->keys[to] == high) to++;
+    sampleNode(leftLeaf, 0, state);
+    if (leftLeaf == rightLeaf) {
+        state.exact += to > from ? to - from : 0;
+    } else {
+        sampleNode(rightLeaf, 0, state);
+        state.exact += (leftLeaf->numKeys - from) + to;
+    }
+
+    // Average, smallest and largest subtree sizes per height
+    double estimate = static_cast<double>(state.exact);
+    double smallest = estimate;
+    double largest = estimate;
+    double average = 1.0;
+    double minSize = 1.0;
+    double maxSize = 1.0;
+    for (size_t height = 0; height < levels; ++height) {
+        average *= state.fanoutSum[height] / static_cast<double>(state.fanoutNodes[height]);
+        minSize *= static_cast<double>(height == 0 ? minKeys : minKeys + 1);
+        maxSize *= static_cast<double>(height == 0 ? maxKeys : order);
+        double unread = static_cast<double>(state.frontier[height]);
+        estimate += unread * average;
+        smallest += unread * minSize;
+        largest += unread * maxSize;
+        if (height + 2 == levels) {
+            // The root's children make up the whole tree
+            double total = static_cast<double>(root->numKeys + 1) * average;
+            result.selectivity = total > 0 ? estimate / total : 0.0;
+        }
+    }
+    if (levels == 1) {
+        result.selectivity = root->numKeys ? estimate / static_cast<double>(root->numKeys) : 0.0;
+    }
+
+    result.minCount = static_cast<size_t>(smallest);
+    result.maxCount = static_cast<size_t>(std::min(largest, static_cast<double>(SIZE_MAX)));
+    result.count = std::min(std::max(static_cast<size_t>(estimate + 0.5), result.minCount), result.maxCount);
+    result.selectivity = std::min(result.selectivity, 1.0);
+    return result;
+}
+
+// Splits [low, high] into exact boundary-leaf slices and whole subtrees in between.
+// A null bound leaves that side open.
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::collectSamplePieces(const KeyType* low, const KeyType* high,
+                                                                   std::vector<SamplePiece>& pieces) const {
+    if (!root || (low && high && *high < *low)) return;
+
+    // A subtree of height h has at most maxKeys * order^h entries
+    size_t levels = height();
+    std::vector<double> capacity(levels, static_cast<double>(maxKeys));
+    for (size_t h = 1; h < levels; ++h) {
+        capacity[h] = capacity[h - 1] * static_cast<double>(order);
+    }
+    auto addSubtrees = [&](const InternalNode<KeyType, ValueType>* parent, size_t first, size_t last,
+                           size_t childHeight) {
+        for (size_t i = first; i < last; ++i) {
+            pieces.push_back({parent->children[i], 0, 0, false, capacity[childHeight]});
+        }
+    };
+
+    const Node<KeyType, ValueType>* left = root;
+    const Node<KeyType, ValueType>* right = root;
+    for (size_t h = levels - 1; h > 0; --h) {
+        const auto* l = static_cast<const InternalNode<KeyType, ValueType>*>(left);
+        const auto* r = static_cast<const InternalNode<KeyType, ValueType>*>(right);
+        size_t li = low ? l->findChildIndex(*low) : 0;
+        size_t ri = high ? r->findChildIndex(*high) : r->numKeys;
+        if (l == r) {
+            addSubtrees(l, li + 1, ri, h - 1);
+        } else {
+            addSubtrees(l, li + 1, l->numKeys + 1, h - 1);
+            addSubtrees(r, 0, ri, h - 1);
+        }
+        left = l->children[li];
+        right = r->children[ri];
+    }
+
+    const auto* leftLeaf = static_cast<const LeafNode<KeyType, ValueType>*>(left);
+    const auto* rightLeaf = static_cast<const LeafNode<KeyType, ValueType>*>(right);
+    size_t from = low ? leftLeaf->findKeyPosition(*low) : 0;
+    size_t to = rightLeaf->numKeys;
+    if (high) {
+        to = rightLeaf->findKeyPosition(*high);
+        if (to < rightLeaf->numKeys && rightLeaf->keys[to] == *high) to++;
+    }
+    if (leftLeaf == rightLeaf) {
+        if (from < to) pieces.push_back({leftLeaf, from, to, true, static_cast<double>(to - from)});
+    } else {
+        if (from < leftLeaf->numKeys) {
+            pieces.push_back({leftLeaf, from, leftLeaf->numKeys, true,
+                              static_cast<double>(leftLeaf->numKeys - from)});
+        }
+        if (to > 0) pieces.push_back({rightLeaf, 0, to, true, static_cast<double>(to)});
+    }
+}
+
+// Routes draws down a subtree by uniform slot choice, dropping draws that land on empty slots
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename URNG>
+void BPlusTree<KeyType, ValueType, Allocator>::sampleSubtree(const Node<KeyType, ValueType>* node, size_t draws,
+                                                             URNG& rng,
+                                                             std::vector<std::pair<KeyType, ValueType>>& out) const {
+    if (node->isLeaf()) {
+        const auto* leaf = static_cast<const LeafNode<KeyType, ValueType>*>(node);
+        std::uniform_int_distribution<size_t> slot(0, maxKeys - 1);
+        for (size_t i = 0; i < draws; ++i) {
+            size_t pos = slot(rng);
+            if (pos < leaf->numKeys) out.emplace_back(leaf->keys[pos], leaf->values[pos]);
+        }
+        return;
+    }
+    const auto* internal = static_cast<const InternalNode<KeyType, ValueType>*>(node);
+    std::uniform_int_distribution<size_t> slot(0, order - 1);
+    std::vector<size_t> routed(internal->numKeys + 1, 0);
+    for (size_t i = 0; i < draws; ++i) {
+        size_t child = slot(rng);
+        if (child <= internal->numKeys) routed[child]++;
+    }
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        if (routed[i]) sampleSubtree(internal->children[i], routed[i], rng, out);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename URNG>
+std::vector<std::pair<KeyType, ValueType>>
+BPlusTree<KeyType, ValueType, Allocator>::sampleImpl(const KeyType* low, const KeyType* high, size_t k,
+                                                     URNG& rng) const {
+    std::vector<std::pair<KeyType, ValueType>> result;
+    std::vector<SamplePiece> pieces;
+    if (k == 0) return result;
+    collectSamplePieces(low, high, pieces);
+    if (pieces.empty()) return result;
+
+    std::vector<double> cumulative;
+    double total = 0.0;
+    for (const auto& piece : pieces) {
+        total += piece.weight;
+        cumulative.push_back(total);
+    }
+    std::uniform_real_distribution<double> pick(0.0, total);
+    std::vector<size_t> draws(pieces.size());
+    result.reserve(k);
+
+    // Each pass spends the missing draws; accepted ones never exceed what is missing
+    while (result.size() < k) {
+        std::fill(draws.begin(), draws.end(), 0);
+        for (size_t i = result.size(); i < k; ++i) {
+            size_t piece = static_cast<size_t>(
+                std::upper_bound(cumulative.begin(), cumulative.end(), pick(rng)) - cumulative.begin());
+            draws[std::min(piece, pieces.size() - 1)]++;
+        }
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            if (draws[i] == 0) continue;
+            const SamplePiece& piece = pieces[i];
+            if (piece.exact) {
+                const auto* leaf = static_cast<const LeafNode<KeyType, ValueType>*>(piece.node);
+                std::uniform_int_distribution<size_t> slot(piece.from, piece.to - 1);
+                for (size_t d = 0; d < draws[i]; ++d) {
+                    size_t pos = slot(rng);
+                    result.emplace_back(leaf->keys[pos], leaf->values[pos]);
+                }
+            } else {
+                sampleSubtree(piece.node, draws[i], rng, result);
+            }
+        }
+    }
+
+    // Draws come out grouped by subtree; shuffle so that any prefix is a sample too
+    std::shuffle(result.begin(), result.end(), rng);
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename URNG>
+std::vector<std::pair<KeyType, ValueType>> BPlusTree<KeyType, ValueType, Allocator>::sample(size_t k,
+                                                                                          URNG& rng) const {
+    return sampleImpl(nullptr, nullptr, k, rng);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename URNG>
+std::vector<std::pair<KeyType, ValueType>>
+BPlusTree<KeyType, ValueType, Allocator>::sampleRange(const KeyType& low, const KeyType& high, size_t k,
+                                                      URNG& rng) const {
+    return sampleImpl(&low, &high, k, rng);
+}
+
 template<typename KeyType, typename ValueType, typename Allocator>
 double BPlusTree<KeyType, ValueType, Allocator>::averageInternalFillFactor() const noexcept {
     if (!root || stats.internalNodeCount == 0) return 0.0;
@@ -1872,7 +3616,25 @@ double BPlusTree<KeyType, ValueType, Allocator>::averageInternalFillFactor() con
 
 template<typename KeyType, typename ValueType, typename Allocator>
 bool BPlusTree<KeyType, ValueType, Allocator>::validate() const {
-    if (!root) return true;
+    if (!root) {
+        if (headLeaf || tailLeaf) {
+            std::cerr << "Leaf chain ends set on an empty tree" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // The cached chain ends must be the outermost leaves
+    const Node<KeyType, ValueType>* first = root;
+    const Node<KeyType, ValueType>* last = root;
+    while (first->isInternal()) {
+        first = static_cast<const InternalNode<KeyType, ValueType>*>(first)->children[0];
+        last = static_cast<const InternalNode<KeyType, ValueType>*>(last)->children[last->numKeys];
+    }
+    if (first != headLeaf || last != tailLeaf || headLeaf->prev || tailLeaf->next) {
+        std::cerr << "Leaf chain ends out of date" << std::endl;
+        return false;
+    }
 
     int leafLevel = -1;
     return validateNode(root, 0, leafLevel);
@@ -1907,6 +3669,19 @@ bool BPlusTree<KeyType, ValueType, Allocator>::validateNode(const Node<KeyType,
             std::cerr << "Leaves at different levels" << std::endl;
             return false;
         }
+
+        // A valid zone map must bound every value
+        if constexpr (LeafNode<KeyType, ValueType>::HAS_ZONE_MAP) {
+            const LeafNode<KeyType, ValueType>* leaf = static_cast<const LeafNode<KeyType, ValueType>*>(node);
+            if (leaf->zoneValid) {
+                for (size_t i = 0; i < leaf->numKeys; i++) {
+                    if (leaf->values[i] < leaf->zoneMin || leaf->zoneMax < leaf->values[i]) {
+                        std::cerr << "Value outside leaf zone map" << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
     } else {
         assert(node->isInternal() && "Expected internal node");
         const InternalNode<KeyType, ValueType>* internal =
@@ -1924,81 +3699,37 @@ bool BPlusTree<KeyType, ValueType, Allocator>::validateNode(const Node<KeyType,
     return true;
 }
 
-// Helper methods for iterators
-template<typename KeyType, typename ValueType, typename Allocator>
-LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::getFirstLeaf() {
-    if (!root) return nullptr;
-
-    Node<KeyType, ValueType>* current = root;
-    while (current->isInternal()) {
-        assert(current->isInternal() && "Expected internal node");
-        InternalNode<KeyType, ValueType>* internal =
-            static_cast<InternalNode<KeyType, ValueType>*>(current);
-        current = internal->children[0];
-    }
-
-    assert(current->isLeaf() && "Expected leaf node");
-    return static_cast<LeafNode<KeyType, ValueType>*>(current);
-}
-
-template<typename KeyType, typename ValueType, typename Allocator>
-const LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::getFirstLeaf() const {
-    if (!root) return nullptr;
-
-    const Node<KeyType, ValueType>* current = root;
-    while (current->isInternal()) {
-        assert(current->isInternal() && "Expected internal node");
-        const InternalNode<KeyType, ValueType>* internal =
-            static_cast<const InternalNode<KeyType, ValueType>*>(current);
-        current = internal->children[0];
-    }
-
-    assert(current->isLeaf() && "Expected leaf node");
-    return static_cast<const LeafNode<KeyType, ValueType>*>(current);
-}
-
+// Recomputes the leaf chain ends by descending the outermost paths
 template<typename KeyType, typename ValueType, typename Allocator>
-LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::getLastLeaf() {
-    if (!root) return nullptr;
-
-    Node<KeyType, ValueType>* current = root;
-    while (current->isInternal()) {
-        assert(current->isInternal() && "Expected internal node");
-        InternalNode<KeyType, ValueType>* internal =
-            static_cast<InternalNode<KeyType, ValueType>*>(current);
-        // Last child is at index numKeys
-        current = internal->children[current->numKeys];
+void BPlusTree<KeyType, ValueType, Allocator>::resetLeafEnds() noexcept {
+    if (!root) {
+        headLeaf = tailLeaf = nullptr;
+        return;
     }
 
-    assert(current->isLeaf() && "Expected leaf node");
-    return static_cast<LeafNode<KeyType, ValueType>*>(current);
-}
-
-template<typename KeyType, typename ValueType, typename Allocator>
-const LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::getLastLeaf() const {
-    if (!root) return nullptr;
-
-    const Node<KeyType, ValueType>* current = root;
-    while (current->isInternal()) {
-        assert(current->isInternal() && "Expected internal node");
-        const InternalNode<KeyType, ValueType>* internal =
-            static_cast<const InternalNode<KeyType, ValueType>*>(current);
+    Node<KeyType, ValueType>* first = root;
+    Node<KeyType, ValueType>* last = root;
+    while (first->isInternal()) {
+        first = static_cast<InternalNode<KeyType, ValueType>*>(first)->children[0];
         // Last child is at index numKeys
-        current = internal->children[current->numKeys];
+        last = static_cast<InternalNode<KeyType, ValueType>*>(last)->children[last->numKeys];
     }
 
-    assert(current->isLeaf() && "Expected leaf node");
-    return static_cast<const LeafNode<KeyType, ValueType>*>(current);
+    assert(first->isLeaf() && last->isLeaf() && "Expected leaf nodes");
+    headLeaf = static_cast<LeafNode<KeyType, ValueType>*>(first);
+    tailLeaf = static_cast<LeafNode<KeyType, ValueType>*>(last);
 }
 
 // Bulk loading implementation
 template<typename KeyType, typename ValueType, typename Allocator>
 template<typename InputIterator>
 void BPlusTree<KeyType, ValueType, Allocator>::bulkLoad(InputIterator first, InputIterator last) {
-    // Clear existing tree if any
+    // Clear existing tree if any (nodes shared with snapshots are retired, not freed)
+    refreshSnapshotState();
     if (root) {
         destroyTree(root);
         root = nullptr;
+        resetLeafEnds();
     }
 
     // Handle empty input
@@ -2074,6 +3805,7 @@ void BPlusTree<KeyType, ValueType, Allocator>::bulkLoad(InputIterator first, Inp
                 newLeaf->numKeys++;
                 elementIndex++;
             }
+            newLeaf->rebuildZone();
 
             prevLeaf = newLeaf;
         }
@@ -2081,93 +3813,1069 @@ void BPlusTree<KeyType, ValueType, Allocator>::bulkLoad(InputIterator first, Inp
         // If we only have one leaf, it becomes the root
         if (leaves.size() == 1) {
             root = leaves[0];
+            resetLeafEnds();
             return;
         }
 
         // Step 4: Build internal node levels from bottom up
-        std::vector<Node<KeyType, ValueType>*> currentLevel(leaves.begin(), leaves.end());
+        root = buildInternalLevels(
+            std::vector<Node<KeyType, ValueType>*>(leaves.begin(), leaves.end()));
+        resetLeafEnds();
 
-        // Helper lambda to get the leftmost key in a subtree (used for separator keys)
-        auto getLeftmostKey = [](Node<KeyType, ValueType>* node) -> KeyType {
-            while (node->isInternal()) {
-                InternalNode<KeyType, ValueType>* internal =
-                    static_cast<InternalNode<KeyType, ValueType>*>(node);
-                node = internal->children[0];
-            }
-            return node->keys[0];
-        };
+    } catch (...) {
+        // Clean up all allocated nodes on exception
+        for (auto* leaf : leaves) {
+            deallocateLeafNode(leaf);
+        }
+        root = nullptr;
+        resetLeafEnds();
+        throw;
+    }
+}
 
-        while (currentLevel.size() > 1) {
-            std::vector<Node<KeyType, ValueType>*> nextLevel;
+/**
+ * @brief Builds the internal node levels above an ordered sequence of nodes
+ *
+ * Groups each level into internal nodes with evenly distributed children
+ * (between minKeys + 1 and maxKeys + 1 each) until a single root remains.
+ * Shared by bulkLoad() and mergeFrom(), which both produce packed leaves first.
+ *
+ * @param currentLevel The nodes of the lowest level, in key order (must be non-empty)
+ * @return The root of the constructed tree
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+Node<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::buildInternalLevels(
+    std::vector<Node<KeyType, ValueType>*> currentLevel) {
+    // Helper lambda to get the leftmost key in a subtree (used for separator keys)
+    auto getLeftmostKey = [](Node<KeyType, ValueType>* node) -> KeyType {
+        while (node->isInternal()) {
+            InternalNode<KeyType, ValueType>* internal =
+                static_cast<InternalNode<KeyType, ValueType>*>(node);
+            node = internal->children[0];
+        }
+        return node->keys[0];
+    };
+
+    while (currentLevel.size() > 1) {
+        std::vector<Node<KeyType, ValueType>*> nextLevel;
+
+        // Calculate how many children can fit in each internal node
+        // Each internal node can have at most (maxKeys + 1) children
+        size_t maxChildren = maxKeys + 1;
+        size_t minChildren = minKeys + 1;  // Minimum children for non-root internal nodes
+
+        // Calculate the number of internal nodes needed
+        size_t numChildren = currentLevel.size();
+        size_t numInternalNodes = (numChildren + maxChildren - 1) / maxChildren;
+
+        // Ensure each internal node gets at least minChildren
+        // With k nodes and n children, the minimum any node gets is floor(n/k)
+        // We need floor(n/k) >= minChildren, so k <= floor(n/minChildren)
+        size_t maxPossibleNodes = numChildren / minChildren;
+        if (maxPossibleNodes == 0) {
+            maxPossibleNodes = 1;  // At least 1 node (will be root)
+        }
+        if (numInternalNodes > maxPossibleNodes) {
+            numInternalNodes = maxPossibleNodes;
+        }
 
-            // Calculate how many children can fit in each internal node
-            // Each internal node can have at most (maxKeys + 1) children
-            size_t maxChildren = maxKeys + 1;
-            size_t minChildren = minKeys + 1;  // Minimum children for non-root internal nodes
+        // Build internal nodes with distributed children
+        size_t childIndex = 0;
+        for (size_t nodeIdx = 0; nodeIdx < numInternalNodes; ++nodeIdx) {
+            InternalNode<KeyType, ValueType>* newInternal = allocateInternalNode();
+            nextLevel.push_back(newInternal);
 
-            // Calculate the number of internal nodes needed
-            size_t numChildren = currentLevel.size();
-            size_t numInternalNodes = (numChildren + maxChildren - 1) / maxChildren;
+            // Calculate how many children this node should get
+            size_t remainingNodes = numInternalNodes - nodeIdx;
+            size_t remainingChildren = numChildren - childIndex;
+            size_t childrenForThis = (remainingChildren + remainingNodes - 1) / remainingNodes;
 
-            // Ensure each internal node gets at least minChildren
-            // With k nodes and n children, the minimum any node gets is floor(n/k)
-            // We need floor(n/k) >= minChildren, so k <= floor(n/minChildren)
-            size_t maxPossibleNodes = numChildren / minChildren;
-            if (maxPossibleNodes == 0) {
-                maxPossibleNodes = 1;  // At least 1 node (will be root)
+            // Don't exceed maxChildren
+            if (childrenForThis > maxChildren) {
+                childrenForThis = maxChildren;
             }
-            if (numInternalNodes > maxPossibleNodes) {
-                numInternalNodes = maxPossibleNodes;
-            }
-
-            // Build internal nodes with distributed children
-            size_t childIndex = 0;
-            for (size_t nodeIdx = 0; nodeIdx < numInternalNodes; ++nodeIdx) {
-                InternalNode<KeyType, ValueType>* newInternal = allocateInternalNode();
-                nextLevel.push_back(newInternal);
 
-                // Calculate how many children this node should get
-                size_t remainingNodes = numInternalNodes - nodeIdx;
-                size_t remainingChildren = numChildren - childIndex;
-                size_t childrenForThis = (remainingChildren + remainingNodes - 1) / remainingNodes;
-
-                // Don't exceed maxChildren
-                if (childrenForThis > maxChildren) {
-                    childrenForThis = maxChildren;
-                }
-
-                // Assign children to this internal node
-                for (size_t c = 0; c < childrenForThis && childIndex < numChildren; ++c) {
-                    if (c == 0) {
-                        // First child - no separator key needed
-                        newInternal->children[0] = currentLevel[childIndex];
-                        currentLevel[childIndex]->parent = newInternal;
-                    } else {
-                        // Add separator key and child
-                        KeyType separatorKey = getLeftmostKey(currentLevel[childIndex]);
-                        newInternal->keys[newInternal->numKeys] = separatorKey;
-                        newInternal->numKeys++;
-                        newInternal->children[newInternal->numKeys] = currentLevel[childIndex];
-                        currentLevel[childIndex]->parent = newInternal;
-                    }
-                    childIndex++;
+            // Assign children to this internal node
+            for (size_t c = 0; c < childrenForThis && childIndex < numChildren; ++c) {
+                if (c == 0) {
+                    // First child - no separator key needed
+                    newInternal->children[0] = currentLevel[childIndex];
+                    currentLevel[childIndex]->parent = newInternal;
+                } else {
+                    // Add separator key and child
+                    KeyType separatorKey = getLeftmostKey(currentLevel[childIndex]);
+                    newInternal->keys[newInternal->numKeys] = separatorKey;
+                    newInternal->numKeys++;
+                    newInternal->children[newInternal->numKeys] = currentLevel[childIndex];
+                    currentLevel[childIndex]->parent = newInternal;
                 }
+                childIndex++;
             }
-
-            currentLevel = std::move(nextLevel);
         }
 
-        // The last remaining node is the root
-        root = currentLevel[0];
-
-    } catch (...) {
-        // Clean up all allocated nodes on exception
-        for (auto* leaf : leaves) {
-            deallocateLeafNode(leaf);
-        }
-        root = nullptr;
-        throw;
+        currentLevel = std::move(nextLevel);
     }
+
+    return currentLevel[0];
+}
+
+/**
+ * @brief Links freshly packed leaves and builds the tree above them
+ *
+ * @param leaves Non-empty leaves in key order, each holding at least minKeys
+ *               entries (except when there is only one leaf)
+ * @return The root of the constructed tree
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+Node<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::buildFromLeaves(
+    std::vector<LeafNode<KeyType, ValueType>*>& leaves) {
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        leaves[i]->parent = nullptr;
+        leaves[i]->prev = i > 0 ? leaves[i - 1] : nullptr;
+        leaves[i]->next = i + 1 < leaves.size() ? leaves[i + 1] : nullptr;
+    }
+
+    if (leaves.size() == 1) {
+        return leaves[0];
+    }
+    return buildInternalLevels(
+        std::vector<Node<KeyType, ValueType>*>(leaves.begin(), leaves.end()));
+}
+
+/**
+ * @brief Fixes leaves left below minKeys by greedy packing
+ *
+ * Packing a stream into full leaves can leave a short leaf at the end of each
+ * packed run. Each short leaf is merged into a neighbour when the pair fits in
+ * one leaf, and otherwise the pair's entries are split evenly (both halves then
+ * hold at least floor((maxKeys + 1) / 2) >= minKeys entries).
+ *
+ * @param leaves Leaves in key order; merged-away leaves are released and erased
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::repairUnderfullLeaves(
+    std::vector<LeafNode<KeyType, ValueType>*>& leaves) {
+    size_t i = 0;
+    while (i < leaves.size()) {
+        if (leaves.size() == 1 || leaves[i]->numKeys >= minKeys) {
+            i++;
+            continue;
+        }
+
+        // Pair the short leaf with its right neighbour, or its left one at the end
+        size_t leftIdx = i + 1 < leaves.size() ? i : i - 1;
+        LeafNode<KeyType, ValueType>* left = leaves[leftIdx];
+        LeafNode<KeyType, ValueType>* right = leaves[leftIdx + 1];
+        size_t total = left->numKeys + right->numKeys;
+
+        if (total <= maxKeys) {
+            // Both fit in one leaf: append right to left and drop right
+            for (size_t j = 0; j < right->numKeys; ++j) {
+                left->keys[left->numKeys] = std::move(right->keys[j]);
+                left->values[left->numKeys] = std::move(right->values[j]);
+                left->numKeys++;
+            }
+            left->rebuildZone();
+            deallocateLeafNode(right);
+            leaves.erase(leaves.begin() + static_cast<std::ptrdiff_t>(leftIdx) + 1);
+            i = leftIdx;  // The merged leaf may still be short
+            continue;
+        }
+
+        size_t leftCount = total / 2;
+        if (left->numKeys > leftCount) {
+            // Shift right's entries up and move left's tail in front of them
+            size_t shift = left->numKeys - leftCount;
+            for (size_t j = right->numKeys; j > 0; --j) {
+                right->keys[j - 1 + shift] = std::move(right->keys[j - 1]);
+                right->values[j - 1 + shift] = std::move(right->values[j - 1]);
+            }
+            for (size_t j = 0; j < shift; ++j) {
+                right->keys[j] = std::move(left->keys[leftCount + j]);
+                right->values[j] = std::move(left->values[leftCount + j]);
+            }
+            right->numKeys += shift;
+            left->numKeys = leftCount;
+        } else {
+            // Append right's head to left and shift right's remaining entries down
+            size_t shift = leftCount - left->numKeys;
+            for (size_t j = 0; j < shift; ++j) {
+                left->keys[left->numKeys + j] = std::move(right->keys[j]);
+                left->values[left->numKeys + j] = std::move(right->values[j]);
+            }
+            for (size_t j = shift; j < right->numKeys; ++j) {
+                right->keys[j - shift] = std::move(right->keys[j]);
+                right->values[j - shift] = std::move(right->values[j]);
+            }
+            left->numKeys = leftCount;
+            right->numKeys -= shift;
+        }
+        left->rebuildZone();
+        right->rebuildZone();
+        i = leftIdx + 1;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+std::vector<LeafNode<KeyType, ValueType>*> BPlusTree<KeyType, ValueType, Allocator>::collectLeaves() {
+    std::vector<LeafNode<KeyType, ValueType>*> leaves;
+    for (LeafNode<KeyType, ValueType>* leaf = getFirstLeaf(); leaf; leaf = leaf->next) {
+        leaves.push_back(leaf);
+    }
+    return leaves;
+}
+
+// ==================== Merge Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::mergeFrom(BPlusTree&& other, ConflictPolicy policy,
+                                                          size_t numThreads) {
+    if (this == &other || !other.root) return;
+
+    refreshSnapshotState();
+    other.refreshSnapshotState();
+
+    // A position in a leaf chain: (leaf index, entry index within the leaf)
+    using Cursor = std::pair<size_t, size_t>;
+    using LeafChain = std::vector<LeafNode<KeyType, ValueType>*>;
+
+    LeafChain ourLeaves = collectLeaves();
+    LeafChain theirLeaves = other.collectLeaves();
+
+    // Step 1: Choose partition boundaries from the first keys of evenly spaced
+    // leaves of the larger chain. Partition p covers [splitters[p-1], splitters[p]).
+    const LeafChain& larger = ourLeaves.size() >= theirLeaves.size() ? ourLeaves : theirLeaves;
+    size_t numPartitions = std::max<size_t>(1, std::min(numThreads, larger.size()));
+    std::vector<KeyType> splitters;
+    for (size_t p = 1; p < numPartitions; ++p) {
+        splitters.push_back(larger[p * larger.size() / numPartitions]->keys[0]);
+    }
+
+    // Step 2: Locate every partition boundary in both chains up front, so worker
+    // threads never read entries that a neighbouring partition is moving out
+    auto seek = [](const LeafChain& chain, const KeyType& bound) -> Cursor {
+        auto it = std::lower_bound(chain.begin(), chain.end(), bound,
+            [](const LeafNode<KeyType, ValueType>* leaf, const KeyType& key) {
+                return leaf->keys[leaf->numKeys - 1] < key;
+            });
+        size_t leafIdx = static_cast<size_t>(it - chain.begin());
+        if (leafIdx == chain.size()) return Cursor(leafIdx, 0);
+        return Cursor(leafIdx, (*it)->findKeyPosition(bound));
+    };
+
+    std::vector<Cursor> ourBounds(1, Cursor(0, 0));
+    std::vector<Cursor> theirBounds(1, Cursor(0, 0));
+    for (const KeyType& splitter : splitters) {
+        ourBounds.push_back(seek(ourLeaves, splitter));
+        theirBounds.push_back(seek(theirLeaves, splitter));
+    }
+    ourBounds.emplace_back(ourLeaves.size(), 0);
+    theirBounds.emplace_back(theirLeaves.size(), 0);
+
+    // Step 3: Merge each partition into its own run of packed leaves
+    std::vector<LeafChain> partitionLeaves(numPartitions);
+    std::vector<std::exception_ptr> errors(numPartitions);
+    std::mutex allocMutex;
+
+    auto mergePartition = [&](size_t p) {
+        try {
+            Cursor a = ourBounds[p];
+            Cursor b = theirBounds[p];
+            LeafChain& out = partitionLeaves[p];
+
+            auto advance = [](const LeafChain& chain, Cursor& c) {
+                if (++c.second == chain[c.first]->numKeys) {
+                    c.first++;
+                    c.second = 0;
+                }
+            };
+
+            // Entries of leaves still shared with a snapshot are copied, not moved
+            auto takeKey = [](const BPlusTree& owner, LeafNode<KeyType, ValueType>* leaf,
+                              size_t pos) -> KeyType {
+                if (owner.isShared(leaf)) return leaf->keys[pos];
+                return std::move(leaf->keys[pos]);
+            };
+            auto takeValue = [](const BPlusTree& owner, LeafNode<KeyType, ValueType>* leaf,
+                                size_t pos) -> ValueType {
+                if (owner.isShared(leaf)) return leaf->values[pos];
+                return std::move(leaf->values[pos]);
+            };
+
+            auto emit = [&](KeyType&& key, ValueType&& value) {
+                if (out.empty() || out.back()->numKeys == maxKeys) {
+                    std::lock_guard<std::mutex> lock(allocMutex);
+                    // Reserve the slot first so a failing push_back cannot leak a node
+                    out.push_back(nullptr);
+                    out.back() = allocateLeafNode();
+                }
+                LeafNode<KeyType, ValueType>* leaf = out.back();
+                leaf->keys[leaf->numKeys] = std::move(key);
+                leaf->values[leaf->numKeys] = std::move(value);
+                leaf->numKeys++;
+            };
+
+            while (a != ourBounds[p + 1] || b != theirBounds[p + 1]) {
+                bool hasOurs = a != ourBounds[p + 1];
+                bool hasTheirs = b != theirBounds[p + 1];
+                LeafNode<KeyType, ValueType>* ourLeaf = hasOurs ? ourLeaves[a.first] : nullptr;
+                LeafNode<KeyType, ValueType>* theirLeaf = hasTheirs ? theirLeaves[b.first] : nullptr;
+
+                if (!hasTheirs || (hasOurs && ourLeaf->keys[a.second] < theirLeaf->keys[b.second])) {
+                    emit(takeKey(*this, ourLeaf, a.second), takeValue(*this, ourLeaf, a.second));
+                    advance(ourLeaves, a);
+                } else if (!hasOurs || theirLeaf->keys[b.second] < ourLeaf->keys[a.second]) {
+                    emit(takeKey(other, theirLeaf, b.second), takeValue(other, theirLeaf, b.second));
+                    advance(theirLeaves, b);
+                } else {
+                    // Key present in both trees: the policy picks the surviving value
+                    if (policy == ConflictPolicy::OVERWRITE) {
+                        emit(takeKey(*this, ourLeaf, a.second), takeValue(other, theirLeaf, b.second));
+                    } else {
+                        emit(takeKey(*this, ourLeaf, a.second), takeValue(*this, ourLeaf, a.second));
+                    }
+                    advance(ourLeaves, a);
+                    advance(theirLeaves, b);
+                }
+            }
+            for (LeafNode<KeyType, ValueType>* leaf : out) {
+                leaf->rebuildZone();
+            }
+        } catch (...) {
+            errors[p] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < numPartitions; ++p) {
+        workers.emplace_back(mergePartition, p);
+    }
+    mergePartition(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    LeafChain leaves;
+    for (LeafChain& part : partitionLeaves) {
+        leaves.insert(leaves.end(), part.begin(), part.end());
+    }
+
+    try {
+        for (const std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+
+        // Step 4: Fix short leaves at partition ends and build the levels above
+        repairUnderfullLeaves(leaves);
+        Node<KeyType, ValueType>* newRoot = buildFromLeaves(leaves);
+
+        // Step 5: Release the consumed nodes of both source trees
+        destroyTree(root);
+        root = newRoot;
+        resetLeafEnds();
+        other.destroyTree(other.root);
+        other.root = nullptr;
+        other.resetLeafEnds();
+    } catch (...) {
+        for (LeafNode<KeyType, ValueType>* leaf : leaves) {
+            deallocateLeafNode(leaf);
+        }
+        throw;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename InputIterator>
+BPlusTree<KeyType, ValueType, Allocator>
+BPlusTree<KeyType, ValueType, Allocator>::mergedWith(InputIterator first, InputIterator last) const {
+    BPlusTree result(order, get_allocator());
+    std::vector<LeafNode<KeyType, ValueType>*> leaves;
+
+    auto emit = [&](const KeyType& key, const ValueType& value) {
+        if (leaves.empty() || leaves.back()->numKeys == maxKeys) {
+            // Reserve the slot first so a failing push_back cannot leak a node
+            leaves.push_back(nullptr);
+            leaves.back() = result.allocateLeafNode();
+        }
+        LeafNode<KeyType, ValueType>* leaf = leaves.back();
+        leaf->keys[leaf->numKeys] = key;
+        leaf->values[leaf->numKeys] = value;
+        leaf->numKeys++;
+    };
+
+    try {
+        const LeafNode<KeyType, ValueType>* leaf = root ? getFirstLeaf() : nullptr;
+        size_t pos = 0;
+        while (leaf || first != last) {
+            if (first == last || (leaf && leaf->keys[pos] < first->first)) {
+                emit(leaf->keys[pos], leaf->values[pos]);
+            } else {
+                // The change wins over an existing entry for the same key
+                if (leaf && leaf->keys[pos] == first->first) {
+                    if (++pos == leaf->numKeys) {
+                        leaf = leaf->next;
+                        pos = 0;
+                    }
+                }
+                if (first->second) emit(first->first, *first->second);
+                ++first;
+                continue;
+            }
+            if (++pos == leaf->numKeys) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+
+        for (LeafNode<KeyType, ValueType>* packed : leaves) {
+            packed->rebuildZone();
+        }
+        if (!leaves.empty()) {
+            result.repairUnderfullLeaves(leaves);
+            result.root = result.buildFromLeaves(leaves);
+            result.resetLeafEnds();
+        }
+    } catch (...) {
+        if (!result.root) {
+            for (LeafNode<KeyType, ValueType>* packed : leaves) {
+                result.deallocateLeafNode(packed);
+            }
+        }
+        throw;
+    }
+    return result;
+}
+
+/**
+ * @brief Releases the internal nodes of a subtree, keeping its leaves
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::destroyInternalNodes(Node<KeyType, ValueType>* node) {
+    if (!node || node->isLeaf()) return;
+
+    InternalNode<KeyType, ValueType>* internal = static_cast<InternalNode<KeyType, ValueType>*>(node);
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        destroyInternalNodes(internal->children[i]);
+    }
+    deallocateInternalNode(internal);
+}
+
+/**
+ * @brief Returns a leaf whose entries may be changed, copying it if a snapshot shares it
+ *
+ * Unlike makeWritable() this does not touch the tree above the leaf; callers
+ * rebuild the index afterwards.
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::privateLeaf(
+    LeafNode<KeyType, ValueType>* leaf) {
+    if (!isShared(leaf)) return leaf;
+
+    stats.cowCopyCount++;
+    LeafNode<KeyType, ValueType>* copy = cloneLeafNode(leaf);
+    deallocateLeafNode(leaf);
+    return copy;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+BPlusTree<KeyType, ValueType, Allocator> BPlusTree<KeyType, ValueType, Allocator>::splitAt(
+    const KeyType& key) {
+    refreshSnapshotState();
+    BPlusTree result(order, get_allocator());
+    if (!root) return result;
+
+    std::vector<LeafNode<KeyType, ValueType>*> leaves = collectLeaves();
+
+    // The first leaf holding a key >= key is the one to divide
+    size_t first = static_cast<size_t>(std::partition_point(leaves.begin(), leaves.end(),
+        [&key](const LeafNode<KeyType, ValueType>* leaf) {
+            return leaf->keys[leaf->numKeys - 1] < key;
+        }) - leaves.begin());
+    if (first == leaves.size()) return result;  // Every key is smaller
+
+    std::vector<LeafNode<KeyType, ValueType>*> lower(leaves.begin(),
+                                                     leaves.begin() + static_cast<std::ptrdiff_t>(first));
+    std::vector<LeafNode<KeyType, ValueType>*> upper;
+    upper.reserve(leaves.size() - first + 1);
+
+    size_t pos = leaves[first]->findKeyPosition(key);
+    size_t moved = first;
+    if (pos > 0) {
+        // Keep the head of the boundary leaf and move its tail to a new leaf
+        LeafNode<KeyType, ValueType>* head = privateLeaf(leaves[first]);
+        LeafNode<KeyType, ValueType>* tail = result.allocateLeafNode();
+        for (size_t i = pos; i < head->numKeys; ++i) {
+            tail->keys[tail->numKeys] = std::move(head->keys[i]);
+            tail->values[tail->numKeys] = std::move(head->values[i]);
+            tail->numKeys++;
+        }
+        head->numKeys = pos;
+        head->rebuildZone();
+        tail->rebuildZone();
+        lower.push_back(head);
+        upper.push_back(tail);
+        moved++;
+    }
+
+    // Hand the remaining leaves to the result; leaves a snapshot still sees are copied
+    for (size_t i = moved; i < leaves.size(); ++i) {
+        LeafNode<KeyType, ValueType>* leaf = leaves[i];
+        if (isShared(leaf)) {
+            stats.cowCopyCount++;
+            LeafNode<KeyType, ValueType>* copy = result.cloneLeafNode(leaf);
+            deallocateLeafNode(leaf);
+            upper.push_back(copy);
+        } else {
+            stats.leafNodeCount--;
+            result.stats.leafNodeCount++;
+            leaf->version = result.writeVersion;  // Versions are per tree
+            upper.push_back(leaf);
+        }
+    }
+
+    // Only the leaves next to the cut can be short; make them private before repair
+    destroyInternalNodes(root);
+    root = nullptr;
+    for (size_t i = lower.size() >= 2 ? lower.size() - 2 : 0; i < lower.size(); ++i) {
+        lower[i] = privateLeaf(lower[i]);
+    }
+    repairUnderfullLeaves(lower);
+    result.repairUnderfullLeaves(upper);
+
+    root = lower.empty() ? nullptr : buildFromLeaves(lower);
+    result.root = upper.empty() ? nullptr : result.buildFromLeaves(upper);
+    resetLeafEnds();
+    result.resetLeafEnds();
+    return result;
+}
+
+// ==================== Set Operations Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::seekForward(
+    const LeafNode<KeyType, ValueType>*& leaf, size_t& pos, const KeyType& key) const {
+    // Target inside the current leaf: binary search the remaining entries
+    if (!(leaf->keys[leaf->numKeys - 1] < key)) {
+        pos = static_cast<size_t>(std::lower_bound(leaf->keys.begin() + static_cast<std::ptrdiff_t>(pos),
+                                                   leaf->keys.begin() + static_cast<std::ptrdiff_t>(leaf->numKeys),
+                                                   key) - leaf->keys.begin());
+        return;
+    }
+
+    // Target inside the next leaf: avoid a root descent for short hops
+    const LeafNode<KeyType, ValueType>* next = leaf->next;
+    if (next && !(next->keys[next->numKeys - 1] < key)) {
+        leaf = next;
+        pos = leaf->findKeyPosition(key);
+        return;
+    }
+
+    // Far away: skip every leaf in between with a fresh descent
+    leaf = findLeaf(key);
+    pos = leaf->findKeyPosition(key);
+    if (pos == leaf->numKeys) {
+        leaf = leaf->next;
+        pos = 0;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Callback>
+void BPlusTree<KeyType, ValueType, Allocator>::intersect(const BPlusTree& other,
+                                                         Callback callback) const {
+    if (!root || !other.root) return;
+
+    const LeafNode<KeyType, ValueType>* a = getFirstLeaf();
+    const LeafNode<KeyType, ValueType>* b = other.getFirstLeaf();
+    size_t i = 0;
+    size_t j = 0;
+
+    while (a && b) {
+        const KeyType& ka = a->keys[i];
+        const KeyType& kb = b->keys[j];
+        if (ka < kb) {
+            seekForward(a, i, kb);
+        } else if (kb < ka) {
+            other.seekForward(b, j, ka);
+        } else {
+            callback(ka, a->values[i], b->values[j]);
+            if (++i == a->numKeys) {
+                a = a->next;
+                i = 0;
+            }
+            if (++j == b->numKeys) {
+                b = b->next;
+                j = 0;
+            }
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+BPlusTree<KeyType, ValueType, Allocator>
+BPlusTree<KeyType, ValueType, Allocator>::intersect(const BPlusTree& other) const {
+    std::vector<std::pair<KeyType, ValueType>> data;
+    intersect(other, [&data](const KeyType& key, const ValueType& value, const ValueType&) {
+        data.emplace_back(key, value);
+    });
+
+    BPlusTree result(order, get_allocator());
+    result.bulkLoad(std::move(data));
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Callback>
+void BPlusTree<KeyType, ValueType, Allocator>::difference(const BPlusTree& other,
+                                                          Callback callback) const {
+    const LeafNode<KeyType, ValueType>* b = other.root ? other.getFirstLeaf() : nullptr;
+    size_t j = 0;
+
+    for (const LeafNode<KeyType, ValueType>* a = getFirstLeaf(); a; a = a->next) {
+        if (b) {
+            other.seekForward(b, j, a->keys[0]);
+        }
+
+        // No key of other falls within [min, max] of this leaf: emit it whole
+        if (!b || a->keys[a->numKeys - 1] < b->keys[j]) {
+            for (size_t i = 0; i < a->numKeys; ++i) {
+                callback(a->keys[i], a->values[i]);
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < a->numKeys; ++i) {
+            if (b) {
+                other.seekForward(b, j, a->keys[i]);
+            }
+            if (!b || a->keys[i] < b->keys[j]) {
+                callback(a->keys[i], a->values[i]);
+            }
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+BPlusTree<KeyType, ValueType, Allocator>
+BPlusTree<KeyType, ValueType, Allocator>::difference(const BPlusTree& other) const {
+    std::vector<std::pair<KeyType, ValueType>> data;
+    difference(other, [&data](const KeyType& key, const ValueType& value) {
+        data.emplace_back(key, value);
+    });
+
+    BPlusTree result(order, get_allocator());
+    result.bulkLoad(std::move(data));
+    return result;
+}
+
+// ==================== Filtered Scan Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Sink>
+size_t BPlusTree<KeyType, ValueType, Allocator>::scanWhere(const KeyType& low, const KeyType& high,
+                                                           const ScanPredicate<KeyType>& keyPredicate,
+                                                           const ScanPredicate<ValueType>& valuePredicate,
+                                                           Sink sink) const {
+    if (!root || high < low) return 0;
+
+    bool filterKeys = keyPredicate.op != CompareOp::ANY;
+    bool filterValues = valuePredicate.op != CompareOp::ANY;
+    if (filterValues && !detail::IsLessComparable<ValueType>::value) {
+        throw std::invalid_argument("scanWhere() value predicates need operator< on ValueType");
+    }
+    std::vector<unsigned char> mask(maxKeys + 1);
+    size_t matches = 0;
+
+    const LeafNode<KeyType, ValueType>* leaf = findLeaf(low);
+    size_t begin = leaf->findKeyPosition(low);
+    for (; leaf; leaf = leaf->next, begin = 0) {
+        size_t count = leaf->numKeys;
+        if (begin >= count) continue;
+
+        // Trim the last leaf of the range to keys <= high
+        bool lastLeaf = high < leaf->keys[count - 1];
+        size_t end = count;
+        if (lastLeaf) {
+            end = leaf->findKeyPosition(high);
+            if (end < count && leaf->keys[end] == high) end++;
+        }
+
+        if (begin < end) {
+            // Keys are sorted, so [first, last] is their zone
+            bool skip = filterKeys && !keyPredicate.mayMatchRange(leaf->keys[begin], leaf->keys[end - 1]);
+            if constexpr (LeafNode<KeyType, ValueType>::HAS_ZONE_MAP) {
+                skip = skip || (filterValues && leaf->zoneValid &&
+                                !valuePredicate.mayMatchRange(leaf->zoneMin, leaf->zoneMax));
+            }
+
+            if (skip) {
+                stats.zoneMapSkipCount++;
+            } else {
+                std::fill(mask.begin() + static_cast<std::ptrdiff_t>(begin),
+                          mask.begin() + static_cast<std::ptrdiff_t>(end), static_cast<unsigned char>(1));
+                if (filterKeys) keyPredicate.evaluate(&leaf->keys[begin], end - begin, &mask[begin]);
+                if constexpr (detail::IsLessComparable<ValueType>::value) {
+                    if (filterValues) valuePredicate.evaluate(&leaf->values[begin], end - begin, &mask[begin]);
+                }
+                for (size_t i = begin; i < end; ++i) {
+                    if (mask[i]) {
+                        sink(leaf->keys[i], leaf->values[i]);
+                        matches++;
+                    }
+                }
+            }
+        }
+        if (lastLeaf) break;
+    }
+    return matches;
+}
+
+// ==================== Parallel Scan Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+std::vector<typename BPlusTree<KeyType, ValueType, Allocator>::ScanTask>
+BPlusTree<KeyType, ValueType, Allocator>::collectScanTasks(const KeyType* low, const KeyType* high,
+                                                           size_t target) const {
+    std::vector<ScanTask> tasks;
+    if (!root) return tasks;
+    tasks.push_back(ScanTask{root, low != nullptr, high != nullptr});
+
+    // Replace the frontier by the overlapping children, one level at a time,
+    // until there are enough subtrees; child i holds keys in [keys[i-1], keys[i])
+    while (tasks.size() < target && tasks.front().subtree->isInternal()) {
+        std::vector<ScanTask> next;
+        for (const ScanTask& task : tasks) {
+            auto* node = static_cast<const InternalNode<KeyType, ValueType>*>(task.subtree);
+            for (size_t i = 0; i <= node->numKeys; ++i) {
+                bool lastChild = i == node->numKeys;
+                if (task.checkLow && !lastChild && !(*low < node->keys[i])) continue;
+                if (task.checkHigh && i > 0 && *high < node->keys[i - 1]) continue;
+                next.push_back(ScanTask{node->children[i],
+                                        task.checkLow && (i == 0 || node->keys[i - 1] < *low),
+                                        task.checkHigh && (lastChild || *high < node->keys[i])});
+            }
+        }
+        if (next.empty()) break;
+        tasks.swap(next);
+    }
+    return tasks;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Visit>
+void BPlusTree<KeyType, ValueType, Allocator>::scanSubtree(const ScanTask& task, const KeyType* low,
+                                                           const KeyType* high, Visit& visit) const {
+    // The subtree's leaves are a contiguous stretch of the leaf chain
+    const Node<KeyType, ValueType>* first = task.subtree;
+    const Node<KeyType, ValueType>* last = task.subtree;
+    while (first->isInternal()) {
+        auto* node = static_cast<const InternalNode<KeyType, ValueType>*>(first);
+        first = node->children[task.checkLow ? node->findChildIndex(*low) : 0];
+    }
+    while (last->isInternal()) {
+        auto* node = static_cast<const InternalNode<KeyType, ValueType>*>(last);
+        last = node->children[task.checkHigh ? node->findChildIndex(*high) : node->numKeys];
+    }
+
+    auto* leaf = static_cast<const LeafNode<KeyType, ValueType>*>(first);
+    size_t pos = task.checkLow ? leaf->findKeyPosition(*low) : 0;
+    for (;;) {
+        for (; pos < leaf->numKeys; ++pos) {
+            if (task.checkHigh && *high < leaf->keys[pos]) return;
+            visit(leaf->keys[pos], leaf->values[pos]);
+        }
+        if (leaf == last || !leaf->next) return;
+        leaf = leaf->next;
+        pos = 0;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename RunTask>
+void BPlusTree<KeyType, ValueType, Allocator>::runWorkStealing(size_t taskCount, size_t threads,
+                                                               RunTask& runTask) {
+    threads = std::min(threads, taskCount);
+    if (threads <= 1) {
+        for (size_t i = 0; i < taskCount; ++i) runTask(i);
+        return;
+    }
+
+    // Each thread owns a packed [begin, end) range of task indices: it pops
+    // from the front, and idle threads split off the back half
+    auto pack = [](uint64_t begin, uint64_t end) { return (begin << 32) | end; };
+    std::vector<std::atomic<uint64_t>> ranges(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        ranges[t].store(pack(taskCount * t / threads, taskCount * (t + 1) / threads));
+    }
+    std::atomic<bool> failed{false};
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto work = [&](size_t self) {
+        try {
+            while (!failed.load(std::memory_order_relaxed)) {
+                uint64_t mine = ranges[self].load();
+                uint64_t begin = mine >> 32, end = mine & 0xffffffffu;
+                if (begin < end) {
+                    if (ranges[self].compare_exchange_weak(mine, pack(begin + 1, end))) {
+                        runTask(static_cast<size_t>(begin));
+                    }
+                    continue;
+                }
+
+                size_t victim = self;
+                uint64_t most = 0;
+                for (size_t t = 0; t < threads; ++t) {
+                    uint64_t range = ranges[t].load();
+                    uint64_t remaining = (range & 0xffffffffu) - std::min(range >> 32, range & 0xffffffffu);
+                    if (t != self && remaining > most) {
+                        most = remaining;
+                        victim = t;
+                    }
+                }
+                if (most == 0) return;
+
+                uint64_t theirs = ranges[victim].load();
+                uint64_t theirBegin = theirs >> 32, theirEnd = theirs & 0xffffffffu;
+                if (theirBegin >= theirEnd) continue;
+                uint64_t take = (theirEnd - theirBegin + 1) / 2;
+                if (ranges[victim].compare_exchange_strong(theirs, pack(theirBegin, theirEnd - take))) {
+                    ranges[self].store(pack(theirEnd - take, theirEnd));
+                }
+            }
+        } catch (...) {
+            errors[self] = std::current_exception();
+            failed.store(true);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try {
+        for (size_t t = 1; t < threads; ++t) {
+            workers.emplace_back(work, t);
+        }
+    } catch (...) {
+        failed.store(true);
+        for (std::thread& worker : workers) worker.join();
+        throw;
+    }
+    work(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename Function>
+void BPlusTree<KeyType, ValueType, Allocator>::parallelScan(const KeyType* low, const KeyType* high,
+                                                            Function& fn, size_t threads) const {
+    const size_t TASKS_PER_THREAD = 8;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<ScanTask> tasks = collectScanTasks(low, high, threads * TASKS_PER_THREAD);
+    auto runTask = [&](size_t i) { scanSubtree(tasks[i], low, high, fn); };
+    runWorkStealing(tasks.size(), threads, runTask);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+template<typename T, typename Accumulate, typename Combine>
+T BPlusTree<KeyType, ValueType, Allocator>::parallelFold(const KeyType* low, const KeyType* high, T identity,
+                                                         Accumulate& accumulate, Combine& combine,
+                                                         size_t threads) const {
+    const size_t TASKS_PER_THREAD = 8;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<ScanTask> tasks = collectScanTasks(low, high, threads * TASKS_PER_THREAD);
+    std::vector<std::optional<T>> partials(tasks.size());
+    auto runTask = [&](size_t i) {
+        T acc = identity;
+        auto visit = [&acc, &accumulate](const KeyType& key, const ValueType& value) {
+            acc = accumulate(std::move(acc), key, value);
+        };
+        scanSubtree(tasks[i], low, high, visit);
+        partials[i] = std::move(acc);
+    };
+    runWorkStealing(tasks.size(), threads, runTask);
+
+    // Subtrees are in key order, so this also works for non-commutative combines
+    T result = std::move(identity);
+    for (std::optional<T>& partial : partials) {
+        result = combine(std::move(result), std::move(*partial));
+    }
+    return result;
+}
+
+// ==================== Snapshot Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+typename BPlusTree<KeyType, ValueType, Allocator>::snapshot_type
+BPlusTree<KeyType, ValueType, Allocator>::snapshot() {
+    if (!snapshots) {
+        snapshots = std::make_shared<detail::SnapshotRegistry>();
+    }
+
+    size_t version = writeVersion;
+    snapshots->acquire(version);
+
+    // Every node reachable now carries a version <= this one and becomes shared;
+    // nodes created from here on belong to the next version and stay writable
+    writeVersion++;
+    hasSharedNodes = true;
+    sharedVersion = version;
+
+    return snapshot_type(root, snapshots, version);
+}
+
+/**
+ * @brief Re-reads the live snapshot versions and frees unreachable retired nodes
+ *
+ * Called at the start of every write. Without any snapshot ever taken this is
+ * a single null check; with snapshots it takes the registry lock briefly.
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::refreshSnapshotState() {
+    if (!snapshots) return;
+
+    bool active = false;
+    size_t oldest = 0;
+    if (snapshots->activeCount.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(snapshots->mutex);
+        if (!snapshots->versions.empty()) {
+            active = true;
+            oldest = *snapshots->versions.begin();
+            sharedVersion = *snapshots->versions.rbegin();
+        }
+    }
+    hasSharedNodes = active;
+
+    if (!retiredNodes.empty()) {
+        freeRetiredNodes(!active, oldest);
+    }
+}
+
+/**
+ * @brief Frees retired nodes that no live snapshot can reach
+ *
+ * A node retired at version w is reachable only by snapshots with a version
+ * below w, so it can be freed once the oldest live snapshot is at least w.
+ *
+ * @param all Free every retired node (no snapshot is live)
+ * @param oldestVersion Version of the oldest live snapshot (ignored if all)
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::freeRetiredNodes(bool all, size_t oldestVersion) {
+    size_t kept = 0;
+    for (size_t i = 0; i < retiredNodes.size(); ++i) {
+        Node<KeyType, ValueType>* node = retiredNodes[i].first;
+        if (all || oldestVersion >= retiredNodes[i].second) {
+            if (node->isLeaf()) {
+                freeLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
+            } else {
+                freeInternalNode(static_cast<InternalNode<KeyType, ValueType>*>(node));
+            }
+        } else {
+            retiredNodes[kept++] = retiredNodes[i];
+        }
+    }
+    retiredNodes.resize(kept);
+}
+
+/**
+ * @brief Returns a node that may be modified in place, copying it if a snapshot shares it
+ *
+ * The copy takes the original's place in the live tree: its parent's child slot
+ * (or the root), the parent links of its children, and the leaf chain. The
+ * original is retired for the snapshots that still use it. Callers make nodes
+ * writable top-down, so the parent is always writable already.
+ *
+ * @param node A node of the live tree
+ * @return The node itself, or its writable copy
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+Node<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::makeWritable(
+    Node<KeyType, ValueType>* node) {
+    if (!isShared(node)) return node;
+
+    stats.cowCopyCount++;
+    Node<KeyType, ValueType>* copy = nullptr;
+
+    if (node->isLeaf()) {
+        LeafNode<KeyType, ValueType>* leafCopy =
+            cloneLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
+        // Splice the copy into the live leaf chain; snapshots never follow these links
+        if (leafCopy->prev) leafCopy->prev->next = leafCopy;
+        if (leafCopy->next) leafCopy->next->prev = leafCopy;
+        if (node == headLeaf) headLeaf = leafCopy;
+        if (node == tailLeaf) tailLeaf = leafCopy;
+        copy = leafCopy;
+    } else {
+        InternalNode<KeyType, ValueType>* internalCopy =
+            cloneInternalNode(static_cast<InternalNode<KeyType, ValueType>*>(node));
+        for (size_t i = 0; i <= internalCopy->numKeys; ++i) {
+            internalCopy->children[i]->parent = internalCopy;
+        }
+        copy = internalCopy;
+    }
+
+    if (node == root) {
+        root = copy;
+    } else {
+        assert(!isShared(node->parent) && "Parent must be made writable first");
+        InternalNode<KeyType, ValueType>* parent =
+            static_cast<InternalNode<KeyType, ValueType>*>(node->parent);
+        parent->children[static_cast<size_t>(getNodeIndex(node))] = copy;
+    }
+
+    if (node->isLeaf()) {
+        deallocateLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
+    } else {
+        deallocateInternalNode(static_cast<InternalNode<KeyType, ValueType>*>(node));
+    }
+    return copy;
+}
+
+/**
+ * @brief Finds the leaf for a key, making every node on the path writable
+ *
+ * Without live snapshots this is exactly findLeaf().
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::findLeafForWrite(
+    const KeyType& key) {
+    if (!hasSharedNodes) return findLeaf(key);
+
+    Node<KeyType, ValueType>* current = makeWritable(root);
+    while (current->isInternal()) {
+        InternalNode<KeyType, ValueType>* internal =
+            static_cast<InternalNode<KeyType, ValueType>*>(current);
+        current = makeWritable(internal->children[internal->findChildIndex(key)]);
+    }
+    return static_cast<LeafNode<KeyType, ValueType>*>(current);
+}
+
+/**
+ * @brief Like findLeafForWrite(key), also returning the separators around the leaf
+ *
+ * The leaf holds exactly the keys k with *lower <= k < *upper; a null bound is
+ * open. The bounds point into the path's nodes and stay valid until a node is
+ * split or merged.
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+LeafNode<KeyType, ValueType>* BPlusTree<KeyType, ValueType, Allocator>::findLeafForWrite(
+    const KeyType& key, const KeyType*& lower, const KeyType*& upper) {
+    lower = upper = nullptr;
+    Node<KeyType, ValueType>* current = makeWritable(root);
+    while (current->isInternal()) {
+        InternalNode<KeyType, ValueType>* internal =
+            static_cast<InternalNode<KeyType, ValueType>*>(current);
+        size_t index = internal->findChildIndex(key);
+        if (index > 0) lower = &internal->keys[index - 1];
+        if (index < internal->numKeys) upper = &internal->keys[index];
+        current = makeWritable(internal->children[index]);
+    }
+    return static_cast<LeafNode<KeyType, ValueType>*>(current);
 }
 
 // ==================== Persistence Implementation ====================
@@ -2379,6 +5087,7 @@ BPlusTree<KeyType, ValueType, Allocator>::allocateLeafNode() {
     LeafNode<KeyType, ValueType>* node = LeafNodeAllocTraits::allocate(leaf_allocator, 1);
     try {
         LeafNodeAllocTraits::construct(leaf_allocator, node, maxKeys);
+        node->version = writeVersion;
         stats.leafNodeCount++;
     } catch (...) {
         LeafNodeAllocTraits::deallocate(leaf_allocator, node, 1);
@@ -2390,9 +5099,18 @@ BPlusTree<KeyType, ValueType, Allocator>::allocateLeafNode() {
 template<typename KeyType, typename ValueType, typename Allocator>
 void BPlusTree<KeyType, ValueType, Allocator>::deallocateLeafNode(LeafNode<KeyType, ValueType>* node) {
     if (node) {
-        LeafNodeAllocTraits::destroy(leaf_allocator, node);
-        LeafNodeAllocTraits::deallocate(leaf_allocator, node, 1);
         stats.leafNodeCount--;
+        if (isShared(node)) {
+            // A snapshot can still reach this node: free it once that snapshot is released
+            retiredNodes.emplace_back(node, writeVersion);
+            return;
+        }
+        if (epochParticipant) {
+            // Latch-free readers may still hold it: free after their grace period
+            epochs->retire(*epochParticipant, node, &BPlusTree::reclaimLeafNode, this);
+            return;
+        }
+        freeLeafNode(node);
     }
 }
 
@@ -2402,6 +5120,7 @@ BPlusTree<KeyType, ValueType, Allocator>::allocateInternalNode() {
     InternalNode<KeyType, ValueType>* node = InternalNodeAllocTraits::allocate(internal_allocator, 1);
     try {
         InternalNodeAllocTraits::construct(internal_allocator, node, maxKeys);
+        node->version = writeVersion;
         stats.internalNodeCount++;
     } catch (...) {
         InternalNodeAllocTraits::deallocate(internal_allocator, node, 1);
@@ -2413,12 +5132,218 @@ BPlusTree<KeyType, ValueType, Allocator>::allocateInternalNode() {
 template<typename KeyType, typename ValueType, typename Allocator>
 void BPlusTree<KeyType, ValueType, Allocator>::deallocateInternalNode(InternalNode<KeyType, ValueType>* node) {
     if (node) {
-        InternalNodeAllocTraits::destroy(internal_allocator, node);
-        InternalNodeAllocTraits::deallocate(internal_allocator, node, 1);
         stats.internalNodeCount--;
+        if (isShared(node)) {
+            retiredNodes.emplace_back(node, writeVersion);
+            return;
+        }
+        if (epochParticipant) {
+            epochs->retire(*epochParticipant, node, &BPlusTree::reclaimInternalNode, this);
+            return;
+        }
+        freeInternalNode(node);
     }
 }
 
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::freeLeafNode(LeafNode<KeyType, ValueType>* node) {
+    LeafNodeAllocTraits::destroy(leaf_allocator, node);
+    LeafNodeAllocTraits::deallocate(leaf_allocator, node, 1);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::freeInternalNode(InternalNode<KeyType, ValueType>* node) {
+    InternalNodeAllocTraits::destroy(internal_allocator, node);
+    InternalNodeAllocTraits::deallocate(internal_allocator, node, 1);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::reclaimLeafNode(void* node, void* tree) {
+    static_cast<BPlusTree*>(tree)->freeLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::reclaimInternalNode(void* node, void* tree) {
+    static_cast<BPlusTree*>(tree)->freeInternalNode(static_cast<InternalNode<KeyType, ValueType>*>(node));
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void BPlusTree<KeyType, ValueType, Allocator>::setEpochManager(EpochManager* manager) {
+    if (manager == epochs) return;
+
+    if (epochs) {
+        // Retired nodes call back into this tree, so they must be gone before detaching
+        epochs->synchronize(*epochParticipant);
+        epochs->unregisterThread(epochParticipant);
+        epochParticipant = nullptr;
+    }
+
+    epochs = manager;
+    if (epochs) {
+        epochParticipant = epochs->registerThread();
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+LeafNode<KeyType, ValueType>*
+BPlusTree<KeyType, ValueType, Allocator>::cloneLeafNode(const LeafNode<KeyType, ValueType>* source) {
+    LeafNode<KeyType, ValueType>* node = LeafNodeAllocTraits::allocate(leaf_allocator, 1);
+    try {
+        LeafNodeAllocTraits::construct(leaf_allocator, node, *source);
+        node->version = writeVersion;
+        stats.leafNodeCount++;
+    } catch (...) {
+        LeafNodeAllocTraits::deallocate(leaf_allocator, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+BPlusTree<KeyType, ValueType, Allocator> BPlusTree<KeyType, ValueType, Allocator>::clone(size_t numThreads) const {
+    BPlusTree result(order, std::allocator_traits<Allocator>::select_on_container_copy_construction(get_allocator()));
+    result.prefetchDistance = prefetchDistance;
+    if (!root) return result;
+
+    // Every node, level by level in key order, with the position of its parent
+    // in the level above and its slot in that parent's child array
+    struct Slot {
+        const Node<KeyType, ValueType>* source;
+        size_t parent;
+        size_t childIndex;
+    };
+    std::vector<std::vector<Slot>> levels(1, std::vector<Slot>(1, Slot{root, 0, 0}));
+    while (levels.back().front().source->isInternal()) {
+        std::vector<Slot> below;
+        const std::vector<Slot>& above = levels.back();
+        for (size_t p = 0; p < above.size(); ++p) {
+            const auto* internal = static_cast<const InternalNode<KeyType, ValueType>*>(above[p].source);
+            for (size_t i = 0; i <= internal->numKeys; ++i) {
+                below.push_back(Slot{internal->children[i], p, i});
+            }
+        }
+        levels.push_back(std::move(below));
+    }
+
+    std::vector<std::vector<Node<KeyType, ValueType>*>> copies(levels.size());
+    std::mutex allocMutex;
+    const bool parallel = numThreads > 1;
+
+    // Allocation goes through the allocator one node at a time; the copy itself does not
+    auto copyNode = [&](const Node<KeyType, ValueType>* source) -> Node<KeyType, ValueType>* {
+        std::unique_lock<std::mutex> lock(allocMutex, std::defer_lock);
+        if (source->isLeaf()) {
+            const auto* leaf = static_cast<const LeafNode<KeyType, ValueType>*>(source);
+            if (parallel) lock.lock();
+            LeafNode<KeyType, ValueType>* node = LeafNodeAllocTraits::allocate(result.leaf_allocator, 1);
+            if (parallel) lock.unlock();
+            try {
+                LeafNodeAllocTraits::construct(result.leaf_allocator, node, *leaf);
+            } catch (...) {
+                if (parallel) lock.lock();
+                LeafNodeAllocTraits::deallocate(result.leaf_allocator, node, 1);
+                throw;
+            }
+            node->version = result.writeVersion;
+            return node;
+        }
+        const auto* internal = static_cast<const InternalNode<KeyType, ValueType>*>(source);
+        if (parallel) lock.lock();
+        InternalNode<KeyType, ValueType>* node = InternalNodeAllocTraits::allocate(result.internal_allocator, 1);
+        if (parallel) lock.unlock();
+        try {
+            InternalNodeAllocTraits::construct(result.internal_allocator, node, *internal);
+        } catch (...) {
+            if (parallel) lock.lock();
+            InternalNodeAllocTraits::deallocate(result.internal_allocator, node, 1);
+            throw;
+        }
+        node->version = result.writeVersion;
+        return node;
+    };
+
+    const size_t NODES_PER_TASK = 256;
+    try {
+        for (size_t level = 0; level < levels.size(); ++level) {
+            const std::vector<Slot>& slots = levels[level];
+            std::vector<Node<KeyType, ValueType>*>& out = copies[level];
+            out.assign(slots.size(), nullptr);
+            bool leafLevel = level + 1 == levels.size();
+
+            // Each copy is linked while it is hot: to its parent, which the level
+            // above already holds, and to the leaf before it within the same task
+            auto runTask = [&](size_t task) {
+                size_t begin = task * NODES_PER_TASK;
+                size_t end = std::min(begin + NODES_PER_TASK, slots.size());
+                for (size_t i = begin; i < end; ++i) {
+                    Node<KeyType, ValueType>* node = copyNode(slots[i].source);
+                    out[i] = node;
+                    if (level > 0) {
+                        auto* parent = static_cast<InternalNode<KeyType, ValueType>*>(
+                            copies[level - 1][slots[i].parent]);
+                        parent->children[slots[i].childIndex] = node;
+                        node->parent = parent;
+                    }
+                    if (leafLevel && i > begin) {
+                        auto* leaf = static_cast<LeafNode<KeyType, ValueType>*>(node);
+                        leaf->prev = static_cast<LeafNode<KeyType, ValueType>*>(out[i - 1]);
+                        leaf->prev->next = leaf;
+                    }
+                }
+            };
+            size_t tasks = (slots.size() + NODES_PER_TASK - 1) / NODES_PER_TASK;
+            runWorkStealing(tasks, parallel ? numThreads : 1, runTask);
+
+            if (leafLevel) {
+                // Stitch the leaf chain across task boundaries
+                for (size_t i = 0; i < out.size(); i += NODES_PER_TASK) {
+                    auto* leaf = static_cast<LeafNode<KeyType, ValueType>*>(out[i]);
+                    leaf->prev = i ? static_cast<LeafNode<KeyType, ValueType>*>(out[i - 1]) : nullptr;
+                    if (leaf->prev) leaf->prev->next = leaf;
+                }
+                static_cast<LeafNode<KeyType, ValueType>*>(out.back())->next = nullptr;
+            }
+        }
+    } catch (...) {
+        for (size_t level = 0; level < copies.size(); ++level) {
+            for (Node<KeyType, ValueType>* node : copies[level]) {
+                if (!node) continue;
+                if (node->isLeaf()) {
+                    result.freeLeafNode(static_cast<LeafNode<KeyType, ValueType>*>(node));
+                } else {
+                    result.freeInternalNode(static_cast<InternalNode<KeyType, ValueType>*>(node));
+                }
+            }
+        }
+        throw;
+    }
+
+    result.root = copies.front().front();
+    result.root->parent = nullptr;
+    result.headLeaf = static_cast<LeafNode<KeyType, ValueType>*>(copies.back().front());
+    result.tailLeaf = static_cast<LeafNode<KeyType, ValueType>*>(copies.back().back());
+    result.stats.leafNodeCount = copies.back().size();
+    for (size_t level = 0; level + 1 < copies.size(); ++level) {
+        result.stats.internalNodeCount += copies[level].size();
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+InternalNode<KeyType, ValueType>*
+BPlusTree<KeyType, ValueType, Allocator>::cloneInternalNode(const InternalNode<KeyType, ValueType>* source) {
+    InternalNode<KeyType, ValueType>* node = InternalNodeAllocTraits::allocate(internal_allocator, 1);
+    try {
+        InternalNodeAllocTraits::construct(internal_allocator, node, *source);
+        node->version = writeVersion;
+        stats.internalNodeCount++;
+    } catch (...) {
+        InternalNodeAllocTraits::deallocate(internal_allocator, node, 1);
+        throw;
+    }
+    return node;
+}
+
 } // namespace bptree
 
 #endif // BPLUSTREE_H
@@ -0,0 +1,1051 @@
+#ifndef BPLUSTREE_BUFFERED_H
+#define BPLUSTREE_BUFFERED_H
+
+#include "Node.h"
+#include "Config.h"
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief One pending update waiting in an internal node's buffer
+ *
+ * A buffer holds at most one message per key. A newer message for the same
+ * key is folded into the older one (see BufferedBPlusTree::combine()).
+ */
+template<typename KeyType, typename ValueType>
+struct BufferedMessage {
+    enum class Kind {
+        PUT,     ///< Set the key to value
+        ERASE,   ///< Remove the key
+        UPSERT   ///< Apply updates to the current value, or to ValueType() if absent
+    };
+
+    Kind kind;
+    ValueType value;                                        ///< Used by PUT
+    std::vector<std::function<void(ValueType&)>> updates;   ///< Used by UPSERT, oldest first
+};
+
+/**
+ * @brief Internal node carrying a buffer of messages for its subtree
+ *
+ * The buffer is sorted by key and every message in it is newer than any
+ * message or entry below this node with the same key.
+ */
+template<typename KeyType, typename ValueType>
+class BufferedInternalNode : public InternalNode<KeyType, ValueType> {
+public:
+    using Buffer = std::vector<std::pair<KeyType, BufferedMessage<KeyType, ValueType>>>;
+
+    Buffer buffer;  ///< Pending messages, sorted by key
+
+    explicit BufferedInternalNode(size_t maxKeys) : InternalNode<KeyType, ValueType>(maxKeys) {}
+
+    /**
+     * @brief Returns the index of the first message with a key not less than key
+     */
+    size_t lowerBound(const KeyType& key) const {
+        auto it = std::lower_bound(buffer.begin(), buffer.end(), key,
+                                   [](const typename Buffer::value_type& m, const KeyType& k) { return m.first < k; });
+        return it - buffer.begin();
+    }
+
+    /**
+     * @brief Returns the buffer range [first, last) routed to child index
+     */
+    std::pair<size_t, size_t> bufferSlice(size_t index) const {
+        size_t first = index > 0 ? lowerBound(this->keys[index - 1]) : 0;
+        size_t last = index < this->numKeys ? lowerBound(this->keys[index]) : buffer.size();
+        return {first, last};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Write-optimized B+ tree with Bε-tree style message buffers
+ *
+ * insert(), remove() and upsert() do not walk to a leaf. They append a message
+ * to a small staging area, which enters the root's buffer as one sorted batch
+ * every order messages. When a buffer grows past its capacity, the messages
+ * routed to the child with the most pending messages move down one level as
+ * a batch, and only that child is touched. A message therefore reaches its
+ * leaf together with many others, so the cost of loading a node and of any
+ * split it causes is shared by the whole batch.
+ *
+ * With the default capacity of order² messages per internal node this is a
+ * Bε-tree with ε = 1/2: an update costs O(log_B n / √B) amortized node
+ * visits instead of O(log_B n), while search() still visits one node per
+ * level and checks each buffer on the way down.
+ *
+ * Nodes use the regular Node.h layout and obey the same fill bounds as
+ * BPlusTree. rangeQuery() and forEach() overlay the buffered messages on the
+ * leaf entries, so they return exactly what an unbuffered tree would.
+ *
+ * upsert() functions are stored and run later, when their message meets an
+ * older message for the key or reaches a leaf. They must not throw and
+ * should capture by value.
+ *
+ * Usage example:
+ * @code
+ * BufferedBPlusTree<int, int> hits(16);
+ * for (int page : log) {
+ *     hits.upsert(page, [](int& n) { ++n; });
+ * }
+ * hits.search(42, count);  // sees the pending increments
+ * @endcode
+ *
+ * This class is not thread-safe.
+ *
+ * @tparam KeyType The type of keys (must be copyable, default constructible and support < and ==)
+ * @tparam ValueType The type of values (must be copyable and default constructible)
+ */
+template<typename KeyType, typename ValueType>
+class BufferedBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+
+private:
+    using BaseNode = Node<KeyType, ValueType>;
+    using Leaf = LeafNode<KeyType, ValueType>;
+    using Internal = detail::BufferedInternalNode<KeyType, ValueType>;
+    using Message = detail::BufferedMessage<KeyType, ValueType>;
+    using Batch = typename Internal::Buffer;
+    using Kind = typename Message::Kind;
+    using Entry = std::pair<KeyType, ValueType>;
+
+    BaseNode* root;          // Root node (nullptr if the tree holds no entries and no messages)
+    size_t order;            // Maximum number of children per node
+    size_t maxKeys;          // Maximum keys per node (order - 1)
+    size_t minKeys;          // Minimum keys per non-root node
+    size_t capacity;         // Maximum messages per buffer
+    size_t count;            // Entries stored in leaves
+    size_t pending;          // Messages waiting in staging and buffers
+    size_t flushes;          // Batches moved down one level
+    Batch staging;           // Newest messages in arrival order, not yet in the root's buffer
+
+    // Message plumbing
+    void send(const KeyType& key, Message message);
+    void drainStaging();
+    static size_t foldBatch(Batch& batch);
+    static void combine(Message& older, Message&& newer);
+    static void applyUpdates(ValueType& value, const Message& message);
+    void mergeIntoBuffer(Internal* node, Batch&& batch);
+    void moveBatch(Internal* node, size_t index);
+    void applyToLeaf(Leaf* leaf, Batch&& batch);
+
+    // Restructuring
+    void flushNode(Internal* node);
+    void fixChild(Internal* node, size_t index);
+    void fixRoot();
+    void splitChild(Internal* node, size_t index);
+    void mergeChild(Internal* node, size_t index);
+    void drain(Internal* node);
+    static void reserveSlots(Internal* node, size_t extraChildren);
+
+    // Read helpers
+    bool lookup(const BaseNode* node, const KeyType& key, ValueType& value) const;
+    bool resolve(const Message& message, const BaseNode* below, const KeyType& key, ValueType& value) const;
+    void collectAll(const KeyType* start, const KeyType* end, std::vector<Entry>& out) const;
+    void collect(const BaseNode* node, const KeyType* start, const KeyType* end, std::vector<Entry>& out) const;
+    static void overlay(const Batch& buffer, size_t first, size_t last, std::vector<Entry>& entries, size_t offset);
+    bool validateNode(const BaseNode* node, const KeyType* low, const KeyType* high, int level, int& leafLevel) const;
+    static void destroy(BaseNode* node);
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The maximum number of children per node. Values below
+     *            MIN_ORDER are raised to MIN_ORDER.
+     * @param bufferCapacity Maximum pending messages per internal node;
+     *            0 selects ord² (ε = 1/2)
+     */
+    explicit BufferedBPlusTree(size_t ord = DEFAULT_ORDER, size_t bufferCapacity = 0)
+        : root(nullptr), order(ord < MIN_ORDER ? MIN_ORDER : ord), maxKeys(order - 1),
+          minKeys((order + 1) / 2 - 1), capacity(bufferCapacity ? bufferCapacity : order * order),
+          count(0), pending(0), flushes(0) {}
+
+    ~BufferedBPlusTree() { destroy(root); }
+
+    BufferedBPlusTree(const BufferedBPlusTree&) = delete;
+    BufferedBPlusTree& operator=(const BufferedBPlusTree&) = delete;
+
+    /**
+     * @brief Sets the key to value, inserting it if absent
+     *
+     * Time complexity: O(log_B n / √B) amortized node visits
+     */
+    void insert(const KeyType& key, const ValueType& value) {
+        send(key, Message{Kind::PUT, value, {}});
+    }
+
+    /**
+     * @brief Removes the key if present
+     *
+     * Unlike BPlusTree::remove() this cannot report whether the key existed
+     * without a lookup; call contains() first if that is needed.
+     *
+     * Time complexity: O(log_B n / √B) amortized node visits
+     */
+    void remove(const KeyType& key) {
+        send(key, Message{Kind::ERASE, ValueType(), {}});
+    }
+
+    /**
+     * @brief Applies fn to the key's value, inserting ValueType() first if absent
+     *
+     * fn(ValueType&) runs when the message is folded or reaches a leaf, not
+     * necessarily before upsert() returns. It must not throw.
+     *
+     * Time complexity: O(log_B n / √B) amortized node visits
+     */
+    template<typename Function>
+    void upsert(const KeyType& key, Function fn) {
+        Message message{Kind::UPSERT, ValueType(), {}};
+        message.updates.emplace_back(std::move(fn));
+        send(key, std::move(message));
+    }
+
+    /**
+     * @brief Searches for a key, applying any buffered messages for it
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if found
+     * @return true if the key exists
+     *
+     * Time complexity: O(log n) (one node per level plus a buffer search)
+     */
+    bool search(const KeyType& key, ValueType& value) const;
+
+    /**
+     * @brief Checks if a key exists
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Buffered messages for keys in the range are applied to the result;
+     * the tree itself is not changed.
+     *
+     * Time complexity: O(log n + k + m) for k entries and m buffered messages in range
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        std::vector<Entry> result;
+        if (!(end < start)) collectAll(&start, &end, result);
+        return result;
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order
+     *
+     * Materializes the entries first, so fn may not modify the tree.
+     *
+     * Time complexity: O(n + m) for m buffered messages
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        std::vector<Entry> entries;
+        collectAll(nullptr, nullptr, entries);
+        for (const auto& entry : entries) {
+            fn(entry.first, entry.second);
+        }
+    }
+
+    /**
+     * @brief Pushes every buffered message down to the leaves
+     *
+     * Time complexity: O(m log n) for m buffered messages
+     */
+    void flush();
+
+    /**
+     * @brief Returns the exact number of entries
+     *
+     * Whether a buffered message adds or replaces an entry is only known at
+     * its leaf, so this flushes first when messages are pending.
+     */
+    size_t size() {
+        if (pending > 0) flush();
+        return count;
+    }
+
+    /**
+     * @brief Checks if the tree holds no entries (flushes like size())
+     */
+    bool isEmpty() { return size() == 0; }
+
+    /**
+     * @brief Removes all entries and pending messages
+     */
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        count = 0;
+        pending = 0;
+        staging.clear();
+    }
+
+    /**
+     * @brief Returns the number of messages not yet applied to a leaf
+     */
+    size_t pendingMessages() const noexcept { return pending; }
+
+    /**
+     * @brief Returns how many batches have been moved down one level
+     */
+    size_t flushCount() const noexcept { return flushes; }
+
+    /**
+     * @brief Returns the maximum number of messages per buffer
+     */
+    size_t bufferCapacity() const noexcept { return capacity; }
+
+    /**
+     * @brief Returns the order of the tree
+     */
+    size_t getOrder() const noexcept { return order; }
+
+    /**
+     * @brief Returns the height of the tree (0 if empty)
+     */
+    size_t height() const {
+        size_t h = 0;
+        for (const BaseNode* node = root; node;
+             node = node->isLeaf() ? nullptr : static_cast<const Internal*>(node)->children[0]) {
+            ++h;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Checks the tree and buffer invariants
+     *
+     * @return true if keys are sorted, nodes are within their fill bounds,
+     *         all leaves are at the same depth, every buffer is sorted, holds
+     *         one message per key within its node's key range and no more
+     *         than bufferCapacity() messages, and the entry and pending
+     *         counts match
+     */
+    bool validate() const;
+};
+
+// ==================== Message Plumbing ====================
+
+/**
+ * @brief Folds a newer message for the same key into an older one
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::combine(Message& older, Message&& newer) {
+    if (newer.kind != Kind::UPSERT) {
+        older.kind = newer.kind;
+        older.value = std::move(newer.value);
+        older.updates.clear();
+        return;
+    }
+    if (older.kind == Kind::UPSERT) {
+        for (auto& update : newer.updates) {
+            older.updates.push_back(std::move(update));
+        }
+        return;
+    }
+    // PUT or ERASE followed by UPSERT: the base value is known, so run the updates now
+    if (older.kind == Kind::ERASE) {
+        older.value = ValueType();
+    }
+    older.kind = Kind::PUT;
+    applyUpdates(older.value, newer);
+}
+
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::applyUpdates(ValueType& value, const Message& message) {
+    for (const auto& update : message.updates) {
+        update(value);
+    }
+}
+
+/**
+ * @brief Queues a message in the staging area
+ *
+ * Inserting single messages into the root's sorted buffer would shift up to
+ * capacity messages each time. Staging collects order messages and hands
+ * them to the root as one sorted batch instead.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::send(const KeyType& key, Message message) {
+    staging.emplace_back(key, std::move(message));
+    ++pending;
+    if (staging.size() >= order) {
+        drainStaging();
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::drainStaging() {
+    pending -= foldBatch(staging);
+    Batch batch = std::move(staging);
+    staging.clear();
+
+    if (!root) {
+        root = new Leaf(maxKeys);
+    }
+    if (root->isLeaf()) {
+        pending -= batch.size();
+        applyToLeaf(static_cast<Leaf*>(root), std::move(batch));
+    } else {
+        mergeIntoBuffer(static_cast<Internal*>(root), std::move(batch));
+    }
+    fixRoot();
+}
+
+/**
+ * @brief Sorts a batch in arrival order by key and folds messages for the same key
+ *
+ * @return The number of messages folded away
+ */
+template<typename KeyType, typename ValueType>
+size_t BufferedBPlusTree<KeyType, ValueType>::foldBatch(Batch& batch) {
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const typename Batch::value_type& a, const typename Batch::value_type& b) {
+                         return a.first < b.first;
+                     });
+    size_t kept = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (kept > 0 && batch[kept - 1].first == batch[i].first) {
+            combine(batch[kept - 1].second, std::move(batch[i].second));
+        } else if (kept != i) {
+            batch[kept++] = std::move(batch[i]);
+        } else {
+            ++kept;
+        }
+    }
+    size_t folded = batch.size() - kept;
+    batch.erase(batch.begin() + kept, batch.end());
+    return folded;
+}
+
+/**
+ * @brief Merges a sorted batch of newer messages into node's buffer
+ *
+ * Merges from the back into the grown buffer, so no second buffer is
+ * allocated; the gap left by folded messages is closed at the end.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::mergeIntoBuffer(Internal* node, Batch&& batch) {
+    Batch& buffer = node->buffer;
+    size_t i = buffer.size();
+    size_t j = batch.size();
+    size_t w = i + j;
+    buffer.resize(w);
+
+    while (j > 0) {
+        if (i > 0 && batch[j - 1].first < buffer[i - 1].first) {
+            buffer[--w] = std::move(buffer[--i]);
+        } else if (i > 0 && buffer[i - 1].first == batch[j - 1].first) {
+            --i;
+            combine(buffer[i].second, std::move(batch[--j].second));
+            buffer[--w] = std::move(buffer[i]);
+            --pending;
+        } else {
+            buffer[--w] = std::move(batch[--j]);
+        }
+    }
+    buffer.erase(buffer.begin() + i, buffer.begin() + w);
+}
+
+/**
+ * @brief Moves every message routed to children[index] out of node's buffer
+ *
+ * The messages join the child's buffer, or are applied if the child is a
+ * leaf. The child is not restructured; call fixChild() afterwards.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::moveBatch(Internal* node, size_t index) {
+    auto slice = node->bufferSlice(index);
+    if (slice.first == slice.second) return;
+    ++flushes;
+
+    auto first = node->buffer.begin() + slice.first;
+    auto last = node->buffer.begin() + slice.second;
+    Batch batch(std::make_move_iterator(first), std::make_move_iterator(last));
+    node->buffer.erase(first, last);
+
+    BaseNode* child = node->children[index];
+    if (child->isLeaf()) {
+        pending -= batch.size();
+        applyToLeaf(static_cast<Leaf*>(child), std::move(batch));
+    } else {
+        mergeIntoBuffer(static_cast<Internal*>(child), std::move(batch));
+    }
+}
+
+/**
+ * @brief Applies a sorted batch of messages to a leaf
+ *
+ * The leaf may end up holding any number of entries; fixChild() or
+ * fixRoot() splits or merges it afterwards.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::applyToLeaf(Leaf* leaf, Batch&& batch) {
+    std::vector<KeyType> keys;
+    std::vector<ValueType> values;
+    keys.reserve(leaf->numKeys + batch.size());
+    values.reserve(leaf->numKeys + batch.size());
+
+    size_t i = 0;
+    for (auto& item : batch) {
+        Message& message = item.second;
+        while (i < leaf->numKeys && leaf->keys[i] < item.first) {
+            keys.push_back(std::move(leaf->keys[i]));
+            values.push_back(std::move(leaf->values[i]));
+            ++i;
+        }
+        bool exists = i < leaf->numKeys && leaf->keys[i] == item.first;
+        ValueType value = exists ? std::move(leaf->values[i]) : ValueType();
+        if (exists) ++i;
+
+        if (message.kind == Kind::ERASE) {
+            if (exists) --count;
+            continue;
+        }
+        if (message.kind == Kind::PUT) {
+            value = std::move(message.value);
+        } else {
+            applyUpdates(value, message);
+        }
+        if (!exists) ++count;
+        keys.push_back(std::move(item.first));
+        values.push_back(std::move(value));
+    }
+    for (; i < leaf->numKeys; ++i) {
+        keys.push_back(std::move(leaf->keys[i]));
+        values.push_back(std::move(leaf->values[i]));
+    }
+
+    size_t n = keys.size();
+    keys.resize(std::max(n, maxKeys + 1));
+    values.resize(std::max(n, maxKeys + 1));
+    leaf->keys = std::move(keys);
+    leaf->values = std::move(values);
+    leaf->numKeys = n;
+    leaf->rebuildZone();
+}
+
+// ==================== Restructuring ====================
+
+/**
+ * @brief Moves batches down until node's buffer is within capacity
+ *
+ * Each round empties the slice of the child with the most pending messages,
+ * which is at least capacity / order messages.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::flushNode(Internal* node) {
+    while (node->buffer.size() > capacity) {
+        // One pass over the buffer counts the messages routed to each child
+        size_t heaviest = 0;
+        size_t most = 0;
+        size_t index = 0;
+        size_t run = 0;
+        for (const auto& item : node->buffer) {
+            while (index < node->numKeys && !(item.first < node->keys[index])) {
+                index++;
+                run = 0;
+            }
+            if (++run > most) {
+                most = run;
+                heaviest = index;
+            }
+        }
+        moveBatch(node, heaviest);
+        fixChild(node, heaviest);
+    }
+}
+
+/**
+ * @brief Restores the invariants of children[index] after it received a batch
+ *
+ * Flushes the child's buffer if it overflowed, then splits an overfull child
+ * or merges an underfull one with a sibling.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::fixChild(Internal* node, size_t index) {
+    BaseNode* child = node->children[index];
+    if (child->isInternal()) {
+        flushNode(static_cast<Internal*>(child));
+    }
+    if (child->numKeys > maxKeys) {
+        splitChild(node, index);
+    } else if (child->numKeys < minKeys && node->numKeys > 0) {
+        mergeChild(node, index);
+    }
+}
+
+/**
+ * @brief Restores the root's invariants, growing or shrinking the tree
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::fixRoot() {
+    while (root) {
+        if (root->numKeys > maxKeys) {
+            auto* top = new Internal(maxKeys);
+            top->children[0] = root;
+            root->parent = top;
+            root = top;
+            splitChild(top, 0);
+            continue;
+        }
+        if (root->isLeaf()) {
+            if (root->numKeys == 0) {
+                delete root;
+                root = nullptr;
+            }
+            return;
+        }
+
+        auto* node = static_cast<Internal*>(root);
+        if (node->numKeys == 0) {
+            // A single child: hand it the buffer and let it become the root
+            moveBatch(node, 0);
+            root = node->children[0];
+            root->parent = nullptr;
+            node->children[0] = nullptr;
+            delete node;
+            continue;
+        }
+        if (node->buffer.size() > capacity) {
+            flushNode(node);
+            continue;
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Makes room in node's arrays for extraChildren more children
+ *
+ * Buffered nodes can gain several children in one step, more than the
+ * single-split headroom InternalNode pre-allocates.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::reserveSlots(Internal* node, size_t extraChildren) {
+    size_t keysNeeded = node->numKeys + extraChildren + 1;
+    if (node->keys.size() < keysNeeded) node->keys.resize(keysNeeded);
+    if (node->children.size() < keysNeeded + 2) node->children.resize(keysNeeded + 2, nullptr);
+}
+
+/**
+ * @brief Splits an overfull children[index] into as many nodes as it needs
+ *
+ * Pieces get near-equal shares, which keeps each of them within
+ * [minKeys, maxKeys]. An internal child's buffer is partitioned by the new
+ * separators. node itself may become overfull.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::splitChild(Internal* node, size_t index) {
+    BaseNode* child = node->children[index];
+    std::vector<BaseNode*> pieces{child};
+    std::vector<KeyType> separators;
+
+    if (child->isLeaf()) {
+        auto* leaf = static_cast<Leaf*>(child);
+        size_t n = leaf->numKeys;
+        size_t parts = (n + maxKeys - 1) / maxKeys;
+        size_t begin = n / parts + (0 < n % parts ? 1 : 0);
+        for (size_t part = 1; part < parts; ++part) {
+            size_t size = n / parts + (part < n % parts ? 1 : 0);
+            auto* right = new Leaf(maxKeys);
+            for (size_t i = 0; i < size; ++i) {
+                right->keys[i] = std::move(leaf->keys[begin + i]);
+                right->values[i] = std::move(leaf->values[begin + i]);
+            }
+            right->numKeys = size;
+            right->rebuildZone();
+            separators.push_back(right->keys[0]);
+            pieces.push_back(right);
+            begin += size;
+        }
+        leaf->numKeys = n / parts + (0 < n % parts ? 1 : 0);
+        leaf->keys.resize(maxKeys + 1);
+        leaf->values.resize(maxKeys + 1);
+        leaf->rebuildZone();
+    } else {
+        auto* inner = static_cast<Internal*>(child);
+        size_t n = inner->numKeys + 1;  // children to share out
+        size_t parts = (n + order - 1) / order;
+        size_t begin = n / parts + (0 < n % parts ? 1 : 0);
+        for (size_t part = 1; part < parts; ++part) {
+            size_t size = n / parts + (part < n % parts ? 1 : 0);
+            auto* right = new Internal(maxKeys);
+            separators.push_back(std::move(inner->keys[begin - 1]));
+            for (size_t i = 0; i < size; ++i) {
+                if (i > 0) right->keys[i - 1] = std::move(inner->keys[begin + i - 1]);
+                right->children[i] = inner->children[begin + i];
+                right->children[i]->parent = right;
+                inner->children[begin + i] = nullptr;
+            }
+            right->numKeys = size - 1;
+            pieces.push_back(right);
+            begin += size;
+        }
+        inner->numKeys = n / parts + (0 < n % parts ? 1 : 0) - 1;
+
+        // Hand each piece the messages at or above its separator
+        for (size_t part = pieces.size() - 1; part > 0; --part) {
+            auto from = inner->buffer.begin() + inner->lowerBound(separators[part - 1]);
+            static_cast<Internal*>(pieces[part])->buffer.assign(std::make_move_iterator(from),
+                                                                 std::make_move_iterator(inner->buffer.end()));
+            inner->buffer.erase(from, inner->buffer.end());
+        }
+        inner->keys.resize(maxKeys + 1);
+        inner->children.resize(maxKeys + 3, nullptr);
+    }
+
+    reserveSlots(node, separators.size());
+    for (size_t i = 0; i < separators.size(); ++i) {
+        node->insertKeyAt(index + i, separators[i]);
+        node->insertChildAt(index + i + 1, pieces[i + 1]);
+    }
+}
+
+/**
+ * @brief Merges an underfull children[index] with a neighbour
+ *
+ * The left neighbour is preferred. If the merged node is overfull it is
+ * split again, which amounts to borrowing from the neighbour.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::mergeChild(Internal* node, size_t index) {
+    size_t leftIndex = index > 0 ? index - 1 : index;
+    BaseNode* left = node->children[leftIndex];
+    BaseNode* right = node->children[leftIndex + 1];
+
+    if (left->isLeaf()) {
+        auto* l = static_cast<Leaf*>(left);
+        auto* r = static_cast<Leaf*>(right);
+        size_t n = l->numKeys + r->numKeys;
+        l->keys.resize(std::max(n, maxKeys + 1));
+        l->values.resize(std::max(n, maxKeys + 1));
+        for (size_t i = 0; i < r->numKeys; ++i) {
+            l->keys[l->numKeys + i] = std::move(r->keys[i]);
+            l->values[l->numKeys + i] = std::move(r->values[i]);
+        }
+        l->numKeys = n;
+        l->rebuildZone();
+    } else {
+        auto* l = static_cast<Internal*>(left);
+        auto* r = static_cast<Internal*>(right);
+        reserveSlots(l, r->numKeys + 1);
+        l->keys[l->numKeys] = node->keys[leftIndex];
+        for (size_t i = 0; i < r->numKeys; ++i) {
+            l->keys[l->numKeys + 1 + i] = std::move(r->keys[i]);
+        }
+        for (size_t i = 0; i <= r->numKeys; ++i) {
+            l->children[l->numKeys + 1 + i] = r->children[i];
+            r->children[i]->parent = l;
+            r->children[i] = nullptr;
+        }
+        l->numKeys += r->numKeys + 1;
+        // Every key in r's buffer is above every key in l's buffer
+        for (auto& item : r->buffer) {
+            l->buffer.push_back(std::move(item));
+        }
+        r->buffer.clear();
+    }
+
+    node->removeChildAt(leftIndex + 1);
+    node->removeKeyAt(leftIndex);
+    delete right;
+
+    // A node left with one child after drain() may hold an underfull child
+    // that only now has a sibling to merge with
+    if (left->isInternal()) {
+        auto* merged = static_cast<Internal*>(left);
+        for (size_t i = merged->numKeys + 1; i-- > 0;) {
+            if (i <= merged->numKeys && merged->children[i]->numKeys < minKeys) {
+                fixChild(merged, i);
+            }
+        }
+    }
+
+    // The merged node may be overfull or hold more messages than a buffer may
+    fixChild(node, leftIndex);
+}
+
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::flush() {
+    if (!staging.empty()) {
+        drainStaging();
+    }
+    while (pending > 0 && root && root->isInternal()) {
+        drain(static_cast<Internal*>(root));
+        fixRoot();
+    }
+}
+
+/**
+ * @brief Empties node's buffer and those below it as far as structure allows
+ *
+ * Restructuring may shift children around mid-pass; flush() repeats passes
+ * until nothing is pending.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::drain(Internal* node) {
+    for (size_t index = 0; index <= node->numKeys; ++index) {
+        moveBatch(node, index);
+    }
+    for (size_t index = 0; index <= node->numKeys; ++index) {
+        BaseNode* child = node->children[index];
+        if (child->isInternal()) {
+            drain(static_cast<Internal*>(child));
+        }
+    }
+    // Children may now be over- or underfull; fix them right to left so indices stay valid
+    for (size_t index = node->numKeys + 1; index-- > 0;) {
+        if (index <= node->numKeys) fixChild(node, index);
+    }
+}
+
+// ==================== Read Implementation ====================
+
+template<typename KeyType, typename ValueType>
+bool BufferedBPlusTree<KeyType, ValueType>::search(const KeyType& key, ValueType& value) const {
+    // Fold the staged messages for the key, oldest first
+    Message staged{Kind::PUT, ValueType(), {}};
+    bool found = false;
+    for (const auto& item : staging) {
+        if (!(item.first == key)) continue;
+        if (found) {
+            combine(staged, Message(item.second));
+        } else {
+            staged = item.second;
+            found = true;
+        }
+    }
+    if (found) {
+        return resolve(staged, root, key, value);
+    }
+    return root && lookup(root, key, value);
+}
+
+template<typename KeyType, typename ValueType>
+bool BufferedBPlusTree<KeyType, ValueType>::lookup(const BaseNode* node, const KeyType& key,
+                                                   ValueType& value) const {
+    if (node->isLeaf()) {
+        return static_cast<const Leaf*>(node)->findValue(key, value);
+    }
+
+    const auto* internal = static_cast<const Internal*>(node);
+    const BaseNode* child = internal->children[internal->findChildIndex(key)];
+    size_t pos = internal->lowerBound(key);
+    if (pos == internal->buffer.size() || !(internal->buffer[pos].first == key)) {
+        return lookup(child, key, value);
+    }
+    return resolve(internal->buffer[pos].second, child, key, value);
+}
+
+/**
+ * @brief Applies a message to the key's value in the subtree below it
+ *
+ * Only an UPSERT needs the older value, so only then is the subtree searched.
+ */
+template<typename KeyType, typename ValueType>
+bool BufferedBPlusTree<KeyType, ValueType>::resolve(const Message& message, const BaseNode* below,
+                                                    const KeyType& key, ValueType& value) const {
+    switch (message.kind) {
+    case Kind::PUT:
+        value = message.value;
+        return true;
+    case Kind::ERASE:
+        return false;
+    case Kind::UPSERT:
+        if (!below || !lookup(below, key, value)) value = ValueType();
+        applyUpdates(value, message);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Appends the entries in [*start, *end] to out, including staged messages
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::collectAll(const KeyType* start, const KeyType* end,
+                                                       std::vector<Entry>& out) const {
+    if (root) collect(root, start, end, out);
+
+    Batch staged;
+    for (const auto& item : staging) {
+        if ((!start || !(item.first < *start)) && (!end || !(*end < item.first))) {
+            staged.push_back(item);
+        }
+    }
+    foldBatch(staged);
+    overlay(staged, 0, staged.size(), out, 0);
+}
+
+/**
+ * @brief Appends the entries of node's subtree in [*start, *end] to out
+ *
+ * Null bounds are open. The children's entries are appended first and the
+ * node's own messages, which are newer, are then overlaid on them.
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::collect(const BaseNode* node, const KeyType* start,
+                                                    const KeyType* end, std::vector<Entry>& out) const {
+    if (node->isLeaf()) {
+        const auto* leaf = static_cast<const Leaf*>(node);
+        size_t i = start ? leaf->findKeyPosition(*start) : 0;
+        for (; i < leaf->numKeys && !(end && *end < leaf->keys[i]); ++i) {
+            out.emplace_back(leaf->keys[i], leaf->values[i]);
+        }
+        return;
+    }
+
+    const auto* internal = static_cast<const Internal*>(node);
+    size_t first = start ? internal->findChildIndex(*start) : 0;
+    size_t last = end ? internal->findChildIndex(*end) : internal->numKeys;
+
+    size_t mark = out.size();
+    for (size_t index = first; index <= last; ++index) {
+        collect(internal->children[index], start, end, out);
+    }
+
+    const Batch& buffer = internal->buffer;
+    size_t from = start ? internal->lowerBound(*start) : 0;
+    size_t to = from;
+    while (to < buffer.size() && !(end && *end < buffer[to].first)) ++to;
+    overlay(buffer, from, to, out, mark);
+}
+
+/**
+ * @brief Applies buffer[first, last) to the sorted entries from offset on in one merge pass
+ */
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::overlay(const Batch& buffer, size_t first, size_t last,
+                                                    std::vector<Entry>& entries, size_t offset) {
+    if (first == last) return;
+
+    std::vector<Entry> result;
+    result.reserve(entries.size() - offset + (last - first));
+    size_t i = offset;
+    for (size_t m = first; m < last; ++m) {
+        const KeyType& key = buffer[m].first;
+        const Message& message = buffer[m].second;
+        while (i < entries.size() && entries[i].first < key) {
+            result.push_back(std::move(entries[i++]));
+        }
+        bool exists = i < entries.size() && entries[i].first == key;
+        ValueType value = exists ? std::move(entries[i].second) : ValueType();
+        if (exists) ++i;
+
+        if (message.kind == Kind::ERASE) continue;
+        if (message.kind == Kind::PUT) {
+            value = message.value;
+        } else {
+            applyUpdates(value, message);
+        }
+        result.emplace_back(key, std::move(value));
+    }
+    for (; i < entries.size(); ++i) {
+        result.push_back(std::move(entries[i]));
+    }
+    entries.resize(offset);
+    for (auto& entry : result) {
+        entries.push_back(std::move(entry));
+    }
+}
+
+template<typename KeyType, typename ValueType>
+bool BufferedBPlusTree<KeyType, ValueType>::validate() const {
+    if (!root) return count == 0 && pending == staging.size();
+
+    int leafLevel = -1;
+    if (!validateNode(root, nullptr, nullptr, 0, leafLevel)) return false;
+
+    // Recount entries and messages
+    size_t entries = 0;
+    size_t messages = 0;
+    std::vector<const BaseNode*> stack{root};
+    while (!stack.empty()) {
+        const BaseNode* node = stack.back();
+        stack.pop_back();
+        if (node->isLeaf()) {
+            entries += node->numKeys;
+            continue;
+        }
+        const auto* internal = static_cast<const Internal*>(node);
+        messages += internal->buffer.size();
+        for (size_t i = 0; i <= internal->numKeys; ++i) {
+            stack.push_back(internal->children[i]);
+        }
+    }
+    return entries == count && messages + staging.size() == pending;
+}
+
+template<typename KeyType, typename ValueType>
+bool BufferedBPlusTree<KeyType, ValueType>::validateNode(const BaseNode* node, const KeyType* low,
+                                                         const KeyType* high, int level, int& leafLevel) const {
+    if (node->numKeys > maxKeys) return false;
+    if (node != root && node->numKeys < minKeys) return false;
+    if (node->isInternal() && node->numKeys == 0) return false;
+
+    for (size_t i = 0; i < node->numKeys; ++i) {
+        if (i > 0 && !(node->keys[i - 1] < node->keys[i])) return false;
+        if (low && node->keys[i] < *low) return false;
+        if (high && !(node->keys[i] < *high)) return false;
+    }
+
+    if (node->isLeaf()) {
+        if (leafLevel == -1) leafLevel = level;
+        return leafLevel == level && (node != root || node->numKeys > 0);
+    }
+
+    const auto* internal = static_cast<const Internal*>(node);
+    const Batch& buffer = internal->buffer;
+    if (buffer.size() > capacity) return false;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        if (i > 0 && !(buffer[i - 1].first < buffer[i].first)) return false;
+        if (low && buffer[i].first < *low) return false;
+        if (high && !(buffer[i].first < *high)) return false;
+    }
+
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        const BaseNode* child = internal->children[i];
+        if (!child || child->parent != internal) return false;
+        const KeyType* childLow = i > 0 ? &internal->keys[i - 1] : low;
+        const KeyType* childHigh = i < internal->numKeys ? &internal->keys[i] : high;
+        if (!validateNode(child, childLow, childHigh, level + 1, leafLevel)) return false;
+    }
+    return true;
+}
+
+template<typename KeyType, typename ValueType>
+void BufferedBPlusTree<KeyType, ValueType>::destroy(BaseNode* node) {
+    if (!node) return;
+    if (node->isInternal()) {
+        auto* internal = static_cast<Internal*>(node);
+        for (size_t i = 0; i <= internal->numKeys; ++i) {
+            destroy(internal->children[i]);
+        }
+        delete internal;
+    } else {
+        delete static_cast<Leaf*>(node);
+    }
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_BUFFERED_H
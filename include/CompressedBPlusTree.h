@@ -0,0 +1,987 @@
+#ifndef BPLUSTREE_COMPRESSED_H
+#define BPLUSTREE_COMPRESSED_H
+
+#include "Node.h"
+#include "Config.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief Leaf that can trade its key and value arrays for a compressed blob
+ *
+ * While compressed, keys and values are released and numKeys still gives
+ * the entry count. accessed is the epoch bit: set on every point access and
+ * cleared by each CompressedBPlusTree::compressColdLeaves() pass.
+ */
+template<typename KeyType, typename ValueType>
+class CompressibleLeaf : public LeafNode<KeyType, ValueType> {
+public:
+    std::vector<unsigned char> packed;  ///< Encoded entries while compressed
+    bool compressed;                    ///< Whether keys and values live in packed
+    bool accessed;                      ///< Touched since the last compression pass
+
+    explicit CompressibleLeaf(size_t maxKeys)
+        : LeafNode<KeyType, ValueType>(maxKeys), compressed(false), accessed(true) {}
+};
+
+// Minimal LZ77 block format: each sequence is a token (literal count in the
+// high nibble, match length - LZ_MIN_MATCH in the low nibble, 15 meaning
+// that more length bytes follow), the literals, then a 2-byte match offset.
+// The last sequence has literals only.
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_HASH_BITS = 10;
+constexpr size_t LZ_MAX_OFFSET = 65535;
+
+inline void lzWriteLength(std::vector<unsigned char>& out, size_t length) {
+    for (; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<unsigned char>(length));
+}
+
+inline size_t lzReadLength(const unsigned char*& in) {
+    size_t length = 0;
+    unsigned char byte;
+    do {
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+inline void lzEmit(std::vector<unsigned char>& out, const unsigned char* literals, size_t literalCount,
+                   size_t offset, size_t matchLength) {
+    size_t extra = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+    out.push_back(static_cast<unsigned char>((std::min<size_t>(literalCount, 15) << 4) |
+                                             std::min<size_t>(extra, 15)));
+    if (literalCount >= 15) lzWriteLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) return;
+    out.push_back(static_cast<unsigned char>(offset & 0xff));
+    out.push_back(static_cast<unsigned char>(offset >> 8));
+    if (extra >= 15) lzWriteLength(out, extra - 15);
+}
+
+/**
+ * @brief Appends the LZ encoding of in[0, size) to out
+ */
+inline void lzCompress(const unsigned char* in, size_t size, std::vector<unsigned char>& out) {
+    constexpr uint32_t NONE = 0xffffffffu;
+    uint32_t table[size_t(1) << LZ_HASH_BITS];
+    std::fill(std::begin(table), std::end(table), NONE);
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + LZ_MIN_MATCH <= size) {
+        uint32_t sequence;
+        std::memcpy(&sequence, in + i, sizeof(sequence));
+        uint32_t& slot = table[(sequence * 2654435761u) >> (32 - LZ_HASH_BITS)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(i);
+        if (candidate == NONE || i - candidate > LZ_MAX_OFFSET ||
+            std::memcmp(in + candidate, in + i, LZ_MIN_MATCH) != 0) {
+            i++;
+            continue;
+        }
+        size_t length = LZ_MIN_MATCH;
+        while (i + length < size && in[candidate + length] == in[i + length]) length++;
+        lzEmit(out, in + anchor, i - anchor, i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+    lzEmit(out, in + anchor, size - anchor, 0, 0);
+}
+
+/**
+ * @brief Decodes an lzCompress() block into out, which has room for the original bytes
+ */
+inline void lzDecompress(const unsigned char* in, size_t size, unsigned char* out) {
+    const unsigned char* end = in + size;
+    while (in < end) {
+        unsigned token = *in++;
+        size_t literals = token >> 4;
+        if (literals == 15) literals += lzReadLength(in);
+        std::memcpy(out, in, literals);
+        in += literals;
+        out += literals;
+        if (in == end) break;
+
+        size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t length = (token & 15) + LZ_MIN_MATCH;
+        if ((token & 15) == 15) length += lzReadLength(in);
+        // Byte by byte, since a match may overlap the bytes it produces
+        const unsigned char* from = out - offset;
+        for (size_t k = 0; k < length; ++k) {
+            out[k] = from[k];
+        }
+        out += length;
+    }
+}
+
+/**
+ * @brief Codec for the entries of one leaf
+ *
+ * Integer keys are sorted, so they are stored as the first key and the
+ * bit-packed deltas to their successors, all with the width of the largest
+ * delta. Values (and keys of other types) are byte-shuffled, so that byte k
+ * of every value is stored together, and then LZ compressed. Shuffling turns
+ * the high bytes of small or slowly changing numbers into long runs.
+ */
+template<typename KeyType, typename ValueType>
+struct LeafCodec {
+    static constexpr bool DELTA_KEYS = std::is_integral<KeyType>::value &&
+                                       !std::is_same<KeyType, bool>::value && sizeof(KeyType) <= 8;
+
+    static void encode(const KeyType* keys, const ValueType* values, size_t n, std::vector<unsigned char>& out) {
+        std::vector<unsigned char> bytes(shuffledSize(n));
+        shuffle(values, n, bytes.data());
+        if constexpr (DELTA_KEYS) {
+            encodeKeys(keys, n, out);
+        } else {
+            shuffle(keys, n, bytes.data() + n * sizeof(ValueType));
+        }
+        lzCompress(bytes.data(), bytes.size(), out);
+    }
+
+    static void decode(const std::vector<unsigned char>& in, size_t n, KeyType* keys, ValueType* values) {
+        const unsigned char* data = in.data();
+        if constexpr (DELTA_KEYS) {
+            data = decodeKeys(data, n, keys);
+        }
+        std::vector<unsigned char> bytes(shuffledSize(n));
+        lzDecompress(data, static_cast<size_t>(in.data() + in.size() - data), bytes.data());
+        unshuffle(bytes.data(), n, values);
+        if constexpr (!DELTA_KEYS) {
+            unshuffle(bytes.data() + n * sizeof(ValueType), n, keys);
+        }
+    }
+
+private:
+    using UnsignedKey = typename std::make_unsigned<
+        typename std::conditional<DELTA_KEYS, KeyType, int>::type>::type;
+
+    static size_t shuffledSize(size_t n) {
+        return n * (sizeof(ValueType) + (DELTA_KEYS ? 0 : sizeof(KeyType)));
+    }
+
+    template<typename T>
+    static void shuffle(const T* items, size_t n, unsigned char* out) {
+        const unsigned char* raw = reinterpret_cast<const unsigned char*>(items);
+        for (size_t b = 0; b < sizeof(T); ++b) {
+            for (size_t i = 0; i < n; ++i) {
+                out[b * n + i] = raw[i * sizeof(T) + b];
+            }
+        }
+    }
+
+    template<typename T>
+    static void unshuffle(const unsigned char* in, size_t n, T* items) {
+        unsigned char* raw = reinterpret_cast<unsigned char*>(items);
+        for (size_t b = 0; b < sizeof(T); ++b) {
+            for (size_t i = 0; i < n; ++i) {
+                raw[i * sizeof(T) + b] = in[b * n + i];
+            }
+        }
+    }
+
+    static uint64_t delta(const KeyType& from, const KeyType& to) {
+        return static_cast<UnsignedKey>(static_cast<UnsignedKey>(to) - static_cast<UnsignedKey>(from));
+    }
+
+    static void encodeKeys(const KeyType* keys, size_t n, std::vector<unsigned char>& out) {
+        uint64_t first = static_cast<UnsignedKey>(keys[0]);
+        for (size_t b = 0; b < sizeof(KeyType); ++b) {
+            out.push_back(static_cast<unsigned char>(first >> (8 * b)));
+        }
+        uint64_t largest = 0;
+        for (size_t i = 1; i < n; ++i) {
+            largest = std::max(largest, delta(keys[i - 1], keys[i]));
+        }
+        unsigned width = 0;
+        while (width < 64 && (largest >> width) != 0) width++;
+        out.push_back(static_cast<unsigned char>(width));
+
+        // Little-endian bit stream, filled one byte at a time
+        unsigned used = 8;
+        for (size_t i = 1; i < n; ++i) {
+            uint64_t bits = delta(keys[i - 1], keys[i]);
+            for (unsigned left = width; left > 0;) {
+                if (used == 8) {
+                    out.push_back(0);
+                    used = 0;
+                }
+                unsigned take = std::min(left, 8 - used);
+                out.back() |= static_cast<unsigned char>((bits & ((1u << take) - 1)) << used);
+                bits >>= take;
+                used += take;
+                left -= take;
+            }
+        }
+    }
+
+    static const unsigned char* decodeKeys(const unsigned char* in, size_t n, KeyType* keys) {
+        uint64_t first = 0;
+        for (size_t b = 0; b < sizeof(KeyType); ++b) {
+            first |= static_cast<uint64_t>(*in++) << (8 * b);
+        }
+        keys[0] = static_cast<KeyType>(static_cast<UnsignedKey>(first));
+        unsigned width = *in++;
+
+        unsigned used = 8;
+        for (size_t i = 1; i < n; ++i) {
+            uint64_t bits = 0;
+            for (unsigned got = 0; got < width;) {
+                if (used == 8) {
+                    in++;
+                    used = 0;
+                }
+                unsigned take = std::min(width - got, 8 - used);
+                bits |= static_cast<uint64_t>((in[-1] >> used) & ((1u << take) - 1)) << got;
+                used += take;
+                got += take;
+            }
+            keys[i] = static_cast<KeyType>(static_cast<UnsignedKey>(static_cast<UnsignedKey>(keys[i - 1]) + bits));
+        }
+        return in;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief B+ tree that keeps rarely used leaves compressed in memory
+ *
+ * Every point access (search(), insert(), remove(), ...) sets the leaf's
+ * access bit. compressColdLeaves() is the explicit compaction pass: it
+ * compresses each leaf whose bit is still clear since the previous pass and
+ * then clears all bits, so a leaf is compressed once it has gone a whole
+ * pass interval without a point access. Call it periodically, e.g. from a
+ * maintenance timer. A compressed leaf is decompressed on its next point
+ * access and stays uncompressed until it goes cold again.
+ *
+ * Scans (rangeQuery(), forEach()) decode compressed leaves into a scratch
+ * buffer instead, so reading through cold data does not inflate it. They
+ * count as decompressions but do not set access bits.
+ *
+ * The codec (detail::LeafCodec) delta-codes and bit-packs integer keys and
+ * LZ compresses byte-shuffled values. A leaf is left uncompressed if the
+ * encoding would not be smaller.
+ *
+ * Usage example:
+ * @code
+ * CompressedBPlusTree<uint64_t, uint32_t> index(64);
+ * // ... load data ...
+ * index.compressColdLeaves();  // every minute, say
+ * std::cout << index.compressionRatio() << "x on "
+ *           << index.compressedLeafCount() << " leaves\n";
+ * @endcode
+ *
+ * This class is not thread-safe; run compressColdLeaves() under the same
+ * lock as writes.
+ *
+ * @tparam KeyType The type of keys (trivially copyable, supports < and ==)
+ * @tparam ValueType The type of values (trivially copyable)
+ */
+template<typename KeyType, typename ValueType>
+class CompressedBPlusTree {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "CompressedBPlusTree compresses raw bytes: KeyType must be trivially copyable");
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "CompressedBPlusTree compresses raw bytes: ValueType must be trivially copyable");
+
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+
+private:
+    using BaseNode = Node<KeyType, ValueType>;
+    using Internal = InternalNode<KeyType, ValueType>;
+    using Leaf = detail::CompressibleLeaf<KeyType, ValueType>;
+    using Codec = detail::LeafCodec<KeyType, ValueType>;
+    using Entry = std::pair<KeyType, ValueType>;
+
+    BaseNode* root;          // Root node (nullptr if empty)
+    size_t order;            // Maximum number of children per node
+    size_t maxKeys;          // Maximum keys per node (order - 1)
+    size_t minKeys;          // Minimum keys per non-root node
+    size_t count;            // Number of entries
+    size_t leaves;           // Number of leaves
+    size_t packedLeaves;     // Leaves currently compressed
+    size_t packedBytes;      // Bytes of compressed blobs
+    size_t rawBytes;         // Bytes the compressed leaves' entries take uncompressed
+    size_t compressions;     // Leaves compressed since construction
+    mutable size_t decompressions;  // Compressed leaves decoded since construction
+
+    // Structure
+    Leaf* findLeaf(const KeyType& key);
+    const Leaf* findLeafForScan(const KeyType& key) const;
+    const Leaf* firstLeaf() const;
+    void splitLeaf(Leaf* leaf);
+    void splitInternal(Internal* node);
+    void insertIntoParent(BaseNode* left, const KeyType& key, BaseNode* right);
+    void rebalance(BaseNode* node);
+    static size_t childIndex(const Internal* parent, const BaseNode* child);
+    void destroy(BaseNode* node);
+
+    // Compression
+    bool compress(Leaf* leaf);
+    void inflate(Leaf* leaf);
+    template<typename Visit>
+    bool visitLeaf(const Leaf* leaf, std::vector<KeyType>& keys, std::vector<ValueType>& values,
+                   Visit& visit) const;
+    bool validateNode(const BaseNode* node, const KeyType* low, const KeyType* high, int level,
+                      int& leafLevel) const;
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The maximum number of children per node. Values below
+     *            MIN_ORDER are raised to MIN_ORDER. Larger leaves compress better.
+     */
+    explicit CompressedBPlusTree(size_t ord = DEFAULT_ORDER)
+        : root(nullptr), order(ord < MIN_ORDER ? MIN_ORDER : ord), maxKeys(order - 1),
+          minKeys((order + 1) / 2 - 1), count(0), leaves(0), packedLeaves(0), packedBytes(0),
+          rawBytes(0), compressions(0), decompressions(0) {}
+
+    ~CompressedBPlusTree() { destroy(root); }
+
+    CompressedBPlusTree(const CompressedBPlusTree&) = delete;
+    CompressedBPlusTree& operator=(const CompressedBPlusTree&) = delete;
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: O(log n), plus one leaf decompression if the leaf is cold
+     */
+    void insert(const KeyType& key, const ValueType& value);
+
+    /**
+     * @brief Removes a key
+     *
+     * May decompress a cold sibling it borrows from or merges with.
+     *
+     * @return true if the key was found and removed
+     */
+    bool remove(const KeyType& key);
+
+    /**
+     * @brief Searches for a key, decompressing its leaf if it is cold
+     */
+    bool search(const KeyType& key, ValueType& value) {
+        if (!root) return false;
+        Leaf* leaf = findLeaf(key);
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos == leaf->numKeys || !(leaf->keys[pos] == key)) return false;
+        value = leaf->values[pos];
+        return true;
+    }
+
+    bool contains(const KeyType& key) {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Cold leaves are decoded into a scratch buffer and stay compressed.
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const;
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order
+     *
+     * Cold leaves are decoded into a scratch buffer and stay compressed.
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        auto visit = [&](const KeyType& key, const ValueType& value) {
+            fn(key, value);
+            return true;
+        };
+        for (const Leaf* leaf = firstLeaf(); leaf; leaf = static_cast<const Leaf*>(leaf->next)) {
+            visitLeaf(leaf, keys, values, visit);
+        }
+    }
+
+    /**
+     * @brief Compresses every leaf not accessed since the previous pass
+     *
+     * Clears all access bits afterwards, starting the next epoch.
+     *
+     * @return The number of leaves compressed by this pass
+     *
+     * Time complexity: O(number of leaves) plus the encoding work
+     */
+    size_t compressColdLeaves();
+
+    /**
+     * @brief Decompresses every compressed leaf
+     */
+    void decompressAll();
+
+    size_t size() const noexcept { return count; }
+    bool isEmpty() const noexcept { return count == 0; }
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        count = 0;
+        leaves = 0;
+        packedLeaves = 0;
+        packedBytes = 0;
+        rawBytes = 0;
+    }
+
+    /**
+     * @brief Returns the order of the tree
+     */
+    size_t getOrder() const noexcept { return order; }
+
+    /**
+     * @brief Returns the height of the tree (0 if empty)
+     */
+    size_t height() const {
+        size_t h = 0;
+        for (const BaseNode* node = root; node;
+             node = node->isLeaf() ? nullptr : static_cast<const Internal*>(node)->children[0]) {
+            ++h;
+        }
+        return h;
+    }
+
+    size_t leafCount() const noexcept { return leaves; }
+    size_t compressedLeafCount() const noexcept { return packedLeaves; }
+
+    /**
+     * @brief Returns uncompressed / compressed size of the entries in compressed leaves
+     *
+     * 1.0 while no leaf is compressed. Counts only the entries; the memory
+     * saved is larger, since an uncompressed leaf also holds its free slots.
+     */
+    double compressionRatio() const noexcept {
+        return packedBytes ? static_cast<double>(rawBytes) / static_cast<double>(packedBytes) : 1.0;
+    }
+
+    /**
+     * @brief Returns the bytes held by compressed leaf blobs
+     */
+    size_t compressedBytes() const noexcept { return packedBytes; }
+
+    /**
+     * @brief Returns the bytes of the key and value arrays or blobs of all leaves
+     *
+     * Time complexity: O(number of leaves)
+     */
+    size_t leafMemoryUsage() const;
+
+    /**
+     * @brief Returns how many times a leaf has been compressed
+     */
+    size_t compressionCount() const noexcept { return compressions; }
+
+    /**
+     * @brief Returns how many times a compressed leaf has been decoded
+     *
+     * Includes point accesses, which decompress the leaf, and scans, which
+     * decode it into a scratch buffer.
+     */
+    size_t decompressionCount() const noexcept { return decompressions; }
+
+    /**
+     * @brief Validates the tree structure, the leaf chain and the compression counters
+     */
+    bool validate() const;
+};
+
+// ==================== Compression ====================
+
+/**
+ * @brief Encodes a leaf's entries and releases its arrays
+ * @return false (leaving the leaf alone) if the encoding is not smaller
+ */
+template<typename KeyType, typename ValueType>
+bool CompressedBPlusTree<KeyType, ValueType>::compress(Leaf* leaf) {
+    size_t n = leaf->numKeys;
+    size_t raw = n * (sizeof(KeyType) + sizeof(ValueType));
+    std::vector<unsigned char> blob;
+    blob.reserve(raw);
+    Codec::encode(leaf->keys.data(), leaf->values.data(), n, blob);
+    if (blob.size() >= raw) return false;
+
+    blob.shrink_to_fit();
+    leaf->packed = std::move(blob);
+    std::vector<KeyType>().swap(leaf->keys);
+    std::vector<ValueType>().swap(leaf->values);
+    leaf->compressed = true;
+    packedLeaves++;
+    packedBytes += leaf->packed.size();
+    rawBytes += raw;
+    compressions++;
+    return true;
+}
+
+/**
+ * @brief Restores a compressed leaf's arrays
+ */
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::inflate(Leaf* leaf) {
+    if (!leaf->compressed) return;
+    size_t n = leaf->numKeys;
+    leaf->keys.resize(maxKeys + 1);
+    leaf->values.resize(maxKeys + 1);
+    Codec::decode(leaf->packed, n, leaf->keys.data(), leaf->values.data());
+    packedLeaves--;
+    packedBytes -= leaf->packed.size();
+    rawBytes -= n * (sizeof(KeyType) + sizeof(ValueType));
+    std::vector<unsigned char>().swap(leaf->packed);
+    leaf->compressed = false;
+    decompressions++;
+}
+
+/**
+ * @brief Calls visit(key, value) for the leaf's entries until it returns false
+ *
+ * A compressed leaf is decoded into keys and values (scratch buffers).
+ *
+ * @return false if visit asked to stop
+ */
+template<typename KeyType, typename ValueType>
+template<typename Visit>
+bool CompressedBPlusTree<KeyType, ValueType>::visitLeaf(const Leaf* leaf, std::vector<KeyType>& keys,
+                                                        std::vector<ValueType>& values, Visit& visit) const {
+    const KeyType* k = leaf->keys.data();
+    const ValueType* v = leaf->values.data();
+    if (leaf->compressed) {
+        keys.resize(leaf->numKeys);
+        values.resize(leaf->numKeys);
+        Codec::decode(leaf->packed, leaf->numKeys, keys.data(), values.data());
+        decompressions++;
+        k = keys.data();
+        v = values.data();
+    }
+    for (size_t i = 0; i < leaf->numKeys; ++i) {
+        if (!visit(k[i], v[i])) return false;
+    }
+    return true;
+}
+
+template<typename KeyType, typename ValueType>
+size_t CompressedBPlusTree<KeyType, ValueType>::compressColdLeaves() {
+    size_t packed = 0;
+    for (Leaf* leaf = const_cast<Leaf*>(firstLeaf()); leaf; leaf = static_cast<Leaf*>(leaf->next)) {
+        if (!leaf->accessed && !leaf->compressed && compress(leaf)) packed++;
+        leaf->accessed = false;
+    }
+    return packed;
+}
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::decompressAll() {
+    for (Leaf* leaf = const_cast<Leaf*>(firstLeaf()); leaf; leaf = static_cast<Leaf*>(leaf->next)) {
+        inflate(leaf);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+size_t CompressedBPlusTree<KeyType, ValueType>::leafMemoryUsage() const {
+    size_t bytes = 0;
+    for (const Leaf* leaf = firstLeaf(); leaf; leaf = static_cast<const Leaf*>(leaf->next)) {
+        bytes += leaf->packed.capacity() + leaf->keys.capacity() * sizeof(KeyType) +
+                 leaf->values.capacity() * sizeof(ValueType);
+    }
+    return bytes;
+}
+
+// ==================== Lookup ====================
+
+/**
+ * @brief Descends to the leaf for key, decompresses it and marks it accessed
+ */
+template<typename KeyType, typename ValueType>
+typename CompressedBPlusTree<KeyType, ValueType>::Leaf*
+CompressedBPlusTree<KeyType, ValueType>::findLeaf(const KeyType& key) {
+    BaseNode* node = root;
+    while (node->isInternal()) {
+        auto* internal = static_cast<Internal*>(node);
+        node = internal->children[internal->findChildIndex(key)];
+    }
+    auto* leaf = static_cast<Leaf*>(node);
+    inflate(leaf);
+    leaf->accessed = true;
+    return leaf;
+}
+
+/**
+ * @brief Descends to the leaf for key without touching its state
+ */
+template<typename KeyType, typename ValueType>
+const typename CompressedBPlusTree<KeyType, ValueType>::Leaf*
+CompressedBPlusTree<KeyType, ValueType>::findLeafForScan(const KeyType& key) const {
+    const BaseNode* node = root;
+    while (node && node->isInternal()) {
+        const auto* internal = static_cast<const Internal*>(node);
+        node = internal->children[internal->findChildIndex(key)];
+    }
+    return static_cast<const Leaf*>(node);
+}
+
+template<typename KeyType, typename ValueType>
+const typename CompressedBPlusTree<KeyType, ValueType>::Leaf*
+CompressedBPlusTree<KeyType, ValueType>::firstLeaf() const {
+    const BaseNode* node = root;
+    while (node && node->isInternal()) {
+        node = static_cast<const Internal*>(node)->children[0];
+    }
+    return static_cast<const Leaf*>(node);
+}
+
+template<typename KeyType, typename ValueType>
+std::vector<std::pair<KeyType, ValueType>>
+CompressedBPlusTree<KeyType, ValueType>::rangeQuery(const KeyType& start, const KeyType& end) const {
+    std::vector<Entry> result;
+    if (end < start) return result;
+
+    std::vector<KeyType> keys;
+    std::vector<ValueType> values;
+    auto visit = [&](const KeyType& key, const ValueType& value) {
+        if (end < key) return false;
+        if (!(key < start)) result.emplace_back(key, value);
+        return true;
+    };
+    for (const Leaf* leaf = findLeafForScan(start); leaf; leaf = static_cast<const Leaf*>(leaf->next)) {
+        if (!visitLeaf(leaf, keys, values, visit)) break;
+    }
+    return result;
+}
+
+// ==================== Updates ====================
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value) {
+    if (!root) {
+        auto* leaf = new Leaf(maxKeys);
+        leaf->insertAt(0, key, value);
+        root = leaf;
+        leaves = 1;
+        count = 1;
+        return;
+    }
+
+    Leaf* leaf = findLeaf(key);
+    size_t pos = leaf->findKeyPosition(key);
+    if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+        leaf->values[pos] = value;
+        leaf->widenZone(value);
+        return;
+    }
+    leaf->insertAt(pos, key, value);
+    count++;
+    if (leaf->isFull()) splitLeaf(leaf);
+}
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::splitLeaf(Leaf* leaf) {
+    auto* right = new Leaf(maxKeys);
+    leaves++;
+    size_t keep = leaf->numKeys / 2;
+    size_t moved = leaf->numKeys - keep;
+    for (size_t i = 0; i < moved; ++i) {
+        right->keys[i] = std::move(leaf->keys[keep + i]);
+        right->values[i] = std::move(leaf->values[keep + i]);
+    }
+    right->numKeys = moved;
+    leaf->numKeys = keep;
+    leaf->rebuildZone();
+    right->rebuildZone();
+
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next) leaf->next->prev = right;
+    leaf->next = right;
+
+    insertIntoParent(leaf, right->keys[0], right);
+}
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::splitInternal(Internal* node) {
+    auto* right = new Internal(maxKeys);
+    size_t mid = node->numKeys / 2;
+    KeyType separator = node->keys[mid];
+    for (size_t i = mid + 1; i < node->numKeys; ++i) {
+        right->keys[i - mid - 1] = std::move(node->keys[i]);
+    }
+    for (size_t i = mid + 1; i <= node->numKeys; ++i) {
+        right->children[i - mid - 1] = node->children[i];
+        right->children[i - mid - 1]->parent = right;
+        node->children[i] = nullptr;
+    }
+    right->numKeys = node->numKeys - mid - 1;
+    node->numKeys = mid;
+
+    insertIntoParent(node, separator, right);
+}
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::insertIntoParent(BaseNode* left, const KeyType& key,
+                                                               BaseNode* right) {
+    if (!left->parent) {
+        auto* top = new Internal(maxKeys);
+        top->keys[0] = key;
+        top->children[0] = left;
+        top->children[1] = right;
+        top->numKeys = 1;
+        left->parent = top;
+        right->parent = top;
+        root = top;
+        return;
+    }
+
+    auto* parent = static_cast<Internal*>(left->parent);
+    size_t index = childIndex(parent, left);
+    parent->insertKeyAt(index, key);
+    parent->insertChildAt(index + 1, right);
+    if (parent->isFull()) splitInternal(parent);
+}
+
+template<typename KeyType, typename ValueType>
+size_t CompressedBPlusTree<KeyType, ValueType>::childIndex(const Internal* parent, const BaseNode* child) {
+    size_t index = 0;
+    while (parent->children[index] != child) index++;
+    return index;
+}
+
+template<typename KeyType, typename ValueType>
+bool CompressedBPlusTree<KeyType, ValueType>::remove(const KeyType& key) {
+    if (!root) return false;
+    Leaf* leaf = findLeaf(key);
+    size_t pos = leaf->findKeyPosition(key);
+    if (pos == leaf->numKeys || !(leaf->keys[pos] == key)) return false;
+    leaf->removeAt(pos);
+    count--;
+    rebalance(leaf);
+    return true;
+}
+
+/**
+ * @brief Restores the fill bounds after node lost an entry or a child
+ *
+ * Borrows one entry from a sibling that can spare it, otherwise merges the
+ * node into its left neighbour (or its right neighbour into it) and repairs
+ * the parent in turn.
+ */
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::rebalance(BaseNode* node) {
+    if (node == root) {
+        if (node->isLeaf() && node->numKeys == 0) {
+            delete static_cast<Leaf*>(node);
+            root = nullptr;
+            leaves = 0;
+        } else if (node->isInternal() && node->numKeys == 0) {
+            auto* internal = static_cast<Internal*>(node);
+            root = internal->children[0];
+            root->parent = nullptr;
+            internal->children[0] = nullptr;
+            delete internal;
+        }
+        return;
+    }
+    if (node->numKeys >= minKeys) return;
+
+    auto* parent = static_cast<Internal*>(node->parent);
+    size_t index = childIndex(parent, node);
+    size_t leftIndex = index > 0 ? index - 1 : index;
+    BaseNode* left = parent->children[leftIndex];
+    BaseNode* right = parent->children[leftIndex + 1];
+    BaseNode* sibling = left == node ? right : left;
+
+    if (node->isLeaf()) {
+        auto* l = static_cast<Leaf*>(left);
+        auto* r = static_cast<Leaf*>(right);
+        inflate(static_cast<Leaf*>(sibling));
+
+        if (sibling->numKeys > minKeys) {
+            if (sibling == l) {
+                r->insertAt(0, l->keys[l->numKeys - 1], l->values[l->numKeys - 1]);
+                l->removeAt(l->numKeys - 1);
+            } else {
+                l->insertAt(l->numKeys, r->keys[0], r->values[0]);
+                r->removeAt(0);
+            }
+            parent->keys[leftIndex] = r->keys[0];
+            return;
+        }
+
+        for (size_t i = 0; i < r->numKeys; ++i) {
+            l->keys[l->numKeys + i] = std::move(r->keys[i]);
+            l->values[l->numKeys + i] = std::move(r->values[i]);
+        }
+        l->numKeys += r->numKeys;
+        l->rebuildZone();
+        l->accessed = true;
+        l->next = r->next;
+        if (r->next) r->next->prev = l;
+        delete r;
+        leaves--;
+    } else {
+        auto* l = static_cast<Internal*>(left);
+        auto* r = static_cast<Internal*>(right);
+
+        if (sibling->numKeys > minKeys) {
+            if (sibling == l) {
+                r->insertKeyAt(0, parent->keys[leftIndex]);
+                r->insertChildAt(0, l->children[l->numKeys]);
+                l->children[l->numKeys] = nullptr;
+                parent->keys[leftIndex] = l->keys[l->numKeys - 1];
+                l->numKeys--;
+            } else {
+                l->keys[l->numKeys] = parent->keys[leftIndex];
+                l->children[l->numKeys + 1] = r->children[0];
+                r->children[0]->parent = l;
+                l->numKeys++;
+                parent->keys[leftIndex] = r->keys[0];
+                r->removeChildAt(0);
+                r->removeKeyAt(0);
+            }
+            return;
+        }
+
+        l->keys[l->numKeys] = parent->keys[leftIndex];
+        for (size_t i = 0; i < r->numKeys; ++i) {
+            l->keys[l->numKeys + 1 + i] = std::move(r->keys[i]);
+        }
+        for (size_t i = 0; i <= r->numKeys; ++i) {
+            l->children[l->numKeys + 1 + i] = r->children[i];
+            r->children[i]->parent = l;
+            r->children[i] = nullptr;
+        }
+        l->numKeys += r->numKeys + 1;
+        delete r;
+    }
+
+    parent->removeChildAt(leftIndex + 1);
+    parent->removeKeyAt(leftIndex);
+    rebalance(parent);
+}
+
+template<typename KeyType, typename ValueType>
+void CompressedBPlusTree<KeyType, ValueType>::destroy(BaseNode* node) {
+    if (!node) return;
+    if (node->isInternal()) {
+        auto* internal = static_cast<Internal*>(node);
+        for (size_t i = 0; i <= internal->numKeys; ++i) {
+            destroy(internal->children[i]);
+        }
+        delete internal;
+    } else {
+        delete static_cast<Leaf*>(node);
+    }
+}
+
+// ==================== Validation ====================
+
+template<typename KeyType, typename ValueType>
+bool CompressedBPlusTree<KeyType, ValueType>::validate() const {
+    if (!root) return count == 0 && leaves == 0 && packedLeaves == 0 && packedBytes == 0;
+
+    // Decoding leaves here is not an access
+    size_t decoded = decompressions;
+    struct Restore {
+        size_t& counter;
+        size_t value;
+        ~Restore() { counter = value; }
+    } restore{decompressions, decoded};
+
+    int leafLevel = -1;
+    if (!validateNode(root, nullptr, nullptr, 0, leafLevel)) return false;
+
+    // The leaf chain holds every entry in order and matches the counters
+    size_t entries = 0;
+    size_t chained = 0;
+    size_t packed = 0;
+    size_t bytes = 0;
+    bool ordered = true;
+    bool first = true;
+    KeyType previous{};
+    std::vector<KeyType> keys;
+    std::vector<ValueType> values;
+    auto visit = [&](const KeyType& key, const ValueType&) {
+        if (!first && !(previous < key)) ordered = false;
+        previous = key;
+        first = false;
+        entries++;
+        return true;
+    };
+    const Leaf* prev = nullptr;
+    for (const Leaf* leaf = firstLeaf(); leaf; leaf = static_cast<const Leaf*>(leaf->next)) {
+        if (leaf->prev != prev) return false;
+        if (leaf->compressed) {
+            if (!leaf->keys.empty() || !leaf->values.empty() || leaf->packed.empty()) return false;
+            packed++;
+            bytes += leaf->packed.size();
+        } else if (!leaf->packed.empty()) {
+            return false;
+        }
+        visitLeaf(leaf, keys, values, visit);
+        chained++;
+        prev = leaf;
+    }
+    return ordered && entries == count && chained == leaves && packed == packedLeaves &&
+           bytes == packedBytes;
+}
+
+template<typename KeyType, typename ValueType>
+bool CompressedBPlusTree<KeyType, ValueType>::validateNode(const BaseNode* node, const KeyType* low,
+                                                           const KeyType* high, int level,
+                                                           int& leafLevel) const {
+    if (node->numKeys > maxKeys) return false;
+    if (node != root && node->numKeys < minKeys) return false;
+
+    if (node->isLeaf()) {
+        if (leafLevel == -1) leafLevel = level;
+        if (leafLevel != level || node->numKeys == 0) return false;
+        const auto* leaf = static_cast<const Leaf*>(node);
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        bool inRange = true;
+        auto visit = [&](const KeyType& key, const ValueType&) {
+            if ((low && key < *low) || (high && !(key < *high))) inRange = false;
+            return inRange;
+        };
+        visitLeaf(leaf, keys, values, visit);
+        return inRange;
+    }
+
+    if (node->numKeys == 0) return false;
+    for (size_t i = 0; i < node->numKeys; ++i) {
+        if (i > 0 && !(node->keys[i - 1] < node->keys[i])) return false;
+        if (low && node->keys[i] < *low) return false;
+        if (high && !(node->keys[i] < *high)) return false;
+    }
+    const auto* internal = static_cast<const Internal*>(node);
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        const BaseNode* child = internal->children[i];
+        if (!child || child->parent != internal) return false;
+        const KeyType* childLow = i > 0 ? &internal->keys[i - 1] : low;
+        const KeyType* childHigh = i < internal->numKeys ? &internal->keys[i] : high;
+        if (!validateNode(child, childLow, childHigh, level + 1, leafLevel)) return false;
+    }
+    return true;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_COMPRESSED_H
@@ -33,6 +33,32 @@ constexpr size_t DEFAULT_ORDER = 4;
  */
 constexpr size_t MIN_ORDER = 3;
 
+/**
+ * @brief Default page size in bytes for DiskBPlusTree
+ *
+ * Matches the page size of common file systems and SSDs, so that every page
+ * read or write is a single aligned device I/O. The fanout of a disk-resident
+ * node follows from the page size and the key and value sizes.
+ */
+constexpr size_t DEFAULT_PAGE_SIZE = 4096;
+
+/**
+ * @brief Default number of leaves that scans prefetch ahead of the current one
+ *
+ * Entering a leaf requests the node `distance` leaves ahead and the key and
+ * value arrays of the leaf before that, so the dependent miss on each next
+ * pointer overlaps with work on earlier leaves. 0 disables prefetching.
+ */
+constexpr size_t DEFAULT_PREFETCH_DISTANCE = 2;
+
+/**
+ * @brief Default number of entries a SmallBPlusTree keeps inline
+ *
+ * Up to this many entries live inside the tree object itself; one more
+ * promotes them to a heap-allocated BPlusTree.
+ */
+constexpr size_t DEFAULT_INLINE_CAPACITY = 8;
+
 } // namespace bptree
 
 #endif // BPLUSTREE_CONFIG_H
@@ -0,0 +1,609 @@
+#ifndef BPLUSTREE_DELEGATED_H
+#define BPLUSTREE_DELEGATED_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <variant>
+#include <stdexcept>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief Bounded lock-free multi-producer single-consumer ring buffer
+ *
+ * Each slot carries a sequence number telling producers and the consumer
+ * whose turn it is (Vyukov's bounded queue). Producers claim a slot with one
+ * CAS on the tail; the single consumer needs no atomic read-modify-write.
+ * The capacity is rounded up to a power of two.
+ *
+ * T must be default constructible, and its move assignment should not throw.
+ */
+template<typename T>
+class MpscRing {
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0};   // Next position to claim (producers)
+    alignas(64) size_t head = 0;               // Next position to read (consumer only)
+
+public:
+    explicit MpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Appends a value; returns false if the ring is full
+     *
+     * Thread safety: Any number of producers
+     */
+    bool tryPush(T&& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest value; returns false if none is ready
+     *
+     * Thread safety: Single consumer only
+     */
+    bool tryPop(T& out) {
+        Slot& slot = slots[head & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != head + 1) return false;
+        out = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    /**
+     * @brief Checks if the next value is not ready yet (consumer only)
+     */
+    bool empty() const {
+        return slots[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    /**
+     * @brief Returns the number of slots
+     */
+    size_t capacity() const noexcept { return mask + 1; }
+};
+
+} // namespace detail
+
+/**
+ * @brief Trees owned by worker threads that serve requests through queues
+ *
+ * Instead of sharing nodes between cores, each range partition of the key
+ * space lives in a BPlusTree that only its owner thread ever touches. Other
+ * threads submit search/insert/remove requests into the owner's lock-free
+ * MPSC ring and get a future, or a callback invoked on the owner thread.
+ *
+ * The owner drains its ring in batches of up to maxBatch requests, stably
+ * sorts each batch by key and serves consecutive lookups with
+ * BPlusTree::searchBatch() and consecutive inserts and removes with
+ * BPlusTree::applyBatch(), so a batch walks the leaves in key order rather
+ * than descending from the root for every request. Requests for the same key
+ * still take effect in submission order. execute() runs an arbitrary task on
+ * the owner, ordered with respect to the requests around it.
+ *
+ * All public methods are thread-safe. Callbacks and tasks run on an owner
+ * thread; they must not throw and must not wait on requests to the same tree.
+ * If the tree operation itself throws, a future receives the exception and a
+ * callback is not called.
+ *
+ * Usage example:
+ * @code
+ * DelegatedBPlusTree<int, std::string> tree({1000}, 64);  // two owner threads
+ * auto done = tree.insert(42, "x");
+ * auto found = tree.search(42);      // served after the insert
+ * done.wait();
+ * std::optional<std::string> value = found.get();
+ * tree.remove(42, [](bool removed) { ... });   // runs on the owner thread
+ * @endcode
+ *
+ * @tparam KeyType The type of keys
+ * @tparam ValueType The type of values
+ * @tparam Allocator The allocator each partition's tree uses
+ */
+template<typename KeyType, typename ValueType,
+         typename Allocator = std::allocator<std::pair<const KeyType, ValueType>>>
+class DelegatedBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using tree_type = BPlusTree<KeyType, ValueType, Allocator>;
+
+    /**
+     * @brief Default number of requests each ring can hold
+     */
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024;
+
+    /**
+     * @brief Default maximum number of requests an owner serves per batch
+     */
+    static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+
+private:
+    enum class Operation { SEARCH, INSERT, REMOVE, EXECUTE };
+
+    using Completion = std::variant<std::monostate,
+                                    std::promise<std::optional<ValueType>>,   // search future
+                                    std::promise<void>,                      // insert future
+                                    std::promise<bool>,                      // remove future
+                                    std::function<void(const ValueType*)>,   // search callback
+                                    std::function<void()>,                   // insert callback
+                                    std::function<void(bool)>,               // remove callback
+                                    std::function<void(tree_type&)>>;        // execute task
+
+    struct Request {
+        Operation op = Operation::SEARCH;
+        KeyType key{};
+        ValueType value{};
+        Completion completion;
+    };
+
+    // Adapts a range of Request pointers to the key range searchBatch() reads
+    struct KeyIterator {
+        Request* const* position;
+
+        const KeyType& operator*() const { return (*position)->key; }
+        KeyIterator& operator++() {
+            ++position;
+            return *this;
+        }
+        bool operator!=(const KeyIterator& other) const { return position != other.position; }
+    };
+
+    // Adapts a range of insert and remove Request pointers to the changes applyBatch() reads
+    struct ChangeIterator {
+        Request* const* position;
+
+        std::pair<const KeyType&, const ValueType*> operator*() const {
+            const Request& request = **position;
+            return {request.key, request.op == Operation::INSERT ? &request.value : nullptr};
+        }
+        ChangeIterator& operator++() {
+            ++position;
+            return *this;
+        }
+        bool operator!=(const ChangeIterator& other) const { return position != other.position; }
+    };
+
+    struct Worker {
+        tree_type tree;
+        detail::MpscRing<Request> ring;
+        std::thread thread;
+
+        std::mutex sleepMutex;                 // Guards sleeping waits on wakeup
+        std::condition_variable wakeup;
+        std::atomic<bool> sleeping{false};
+
+        std::atomic<size_t> batches{0};
+        std::atomic<size_t> requests{0};
+
+        Worker(size_t order, size_t capacity, const Allocator& alloc) : tree(order, alloc), ring(capacity) {}
+    };
+
+    std::vector<KeyType> partitionKeys;        // partitionKeys[i] is the smallest key of worker i + 1
+    std::vector<std::unique_ptr<Worker>> workers;
+    size_t maxBatch;
+    std::atomic<bool> stopping{false};
+
+    size_t partitionFor(const KeyType& key) const {
+        return static_cast<size_t>(std::upper_bound(partitionKeys.begin(), partitionKeys.end(), key) -
+                                   partitionKeys.begin());
+    }
+
+    Worker& workerFor(const KeyType& key) const { return *workers[partitionFor(key)]; }
+
+    void submit(Worker& worker, Request&& request);
+    void run(Worker& worker);
+    void serveBatch(Worker& worker, std::vector<Request>& batch, std::vector<Request*>& order);
+    void serveKeyed(Worker& worker, Request** first, Request** last);
+    void stop() noexcept;
+
+public:
+    /**
+     * @brief Starts one owner thread per partition
+     *
+     * @param keys Partition keys; n keys give n + 1 owner threads. They are
+     *             sorted and de-duplicated.
+     * @param ord The order of every partition's tree
+     * @param queueCapacity Requests each ring holds before submitters wait
+     * @param batchSize Maximum requests an owner drains per batch (at least 1)
+     * @param alloc The allocator every partition's tree uses
+     */
+    explicit DelegatedBPlusTree(std::vector<KeyType> keys = {}, size_t ord = DEFAULT_ORDER,
+                                size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+                                size_t batchSize = DEFAULT_BATCH_SIZE, const Allocator& alloc = Allocator());
+
+    /**
+     * @brief Serves every request already queued, then stops the owner threads
+     */
+    ~DelegatedBPlusTree() { stop(); }
+
+    DelegatedBPlusTree(const DelegatedBPlusTree&) = delete;
+    DelegatedBPlusTree& operator=(const DelegatedBPlusTree&) = delete;
+
+    // ==================== Requests ====================
+
+    /**
+     * @brief Looks up a key
+     *
+     * @return Future holding the value, or std::nullopt if the key is absent
+     */
+    std::future<std::optional<ValueType>> search(const KeyType& key) {
+        std::promise<std::optional<ValueType>> promise;
+        auto future = promise.get_future();
+        submit(workerFor(key), Request{Operation::SEARCH, key, ValueType(), Completion(std::move(promise))});
+        return future;
+    }
+
+    /**
+     * @brief Looks up a key; callback(value) gets nullptr if the key is absent
+     */
+    void search(const KeyType& key, std::function<void(const ValueType*)> callback) {
+        submit(workerFor(key), Request{Operation::SEARCH, key, ValueType(), Completion(std::move(callback))});
+    }
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * @return Future that becomes ready once the insert is applied
+     */
+    std::future<void> insert(const KeyType& key, const ValueType& value) {
+        std::promise<void> promise;
+        auto future = promise.get_future();
+        submit(workerFor(key), Request{Operation::INSERT, key, value, Completion(std::move(promise))});
+        return future;
+    }
+
+    /**
+     * @brief Inserts a key-value pair; callback() runs once it is applied
+     */
+    void insert(const KeyType& key, const ValueType& value, std::function<void()> callback) {
+        submit(workerFor(key), Request{Operation::INSERT, key, value, Completion(std::move(callback))});
+    }
+
+    /**
+     * @brief Removes a key
+     *
+     * @return Future holding true if the key was found and removed
+     */
+    std::future<bool> remove(const KeyType& key) {
+        std::promise<bool> promise;
+        auto future = promise.get_future();
+        submit(workerFor(key), Request{Operation::REMOVE, key, ValueType(), Completion(std::move(promise))});
+        return future;
+    }
+
+    /**
+     * @brief Removes a key; callback(removed) runs once it is applied
+     */
+    void remove(const KeyType& key, std::function<void(bool)> callback) {
+        submit(workerFor(key), Request{Operation::REMOVE, key, ValueType(), Completion(std::move(callback))});
+    }
+
+    /**
+     * @brief Runs task(tree) on the owner of one partition
+     *
+     * The task sees every request submitted to that partition before it, and
+     * none submitted after it returns.
+     *
+     * @param partition The partition index
+     * @param task Callable taking tree_type&
+     * @return Future holding the task's result or exception
+     * @throws std::out_of_range if partition is not a partition index
+     */
+    template<typename Task>
+    auto execute(size_t partition, Task task) -> std::future<decltype(task(std::declval<tree_type&>()))> {
+        using Result = decltype(task(std::declval<tree_type&>()));
+        if (partition >= workers.size()) {
+            throw std::out_of_range("Partition index out of range");
+        }
+        auto packaged = std::make_shared<std::packaged_task<Result(tree_type&)>>(std::move(task));
+        auto future = packaged->get_future();
+        std::function<void(tree_type&)> run = [packaged](tree_type& tree) { (*packaged)(tree); };
+        submit(*workers[partition], Request{Operation::EXECUTE, KeyType(), ValueType(), Completion(std::move(run))});
+        return future;
+    }
+
+    // ==================== Whole-Tree Operations ====================
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Each overlapping partition is queried on its owner, in parallel; the
+     * partitions are not read at one common instant.
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        if (end < start) return result;
+
+        std::vector<std::future<std::vector<std::pair<KeyType, ValueType>>>> parts;
+        for (size_t i = partitionFor(start); i <= partitionFor(end); ++i) {
+            parts.push_back(execute(i, [start, end](tree_type& tree) { return tree.rangeQuery(start, end); }));
+        }
+        for (auto& part : parts) {
+            auto rows = part.get();
+            std::move(rows.begin(), rows.end(), std::back_inserter(result));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the total number of entries
+     *
+     * Waits for every request submitted before the call.
+     */
+    size_t size() {
+        std::vector<std::future<size_t>> counts;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            counts.push_back(execute(i, [](tree_type& tree) { return tree.size(); }));
+        }
+        size_t total = 0;
+        for (auto& count : counts) total += count.get();
+        return total;
+    }
+
+    /**
+     * @brief Waits until every request submitted before the call is applied
+     */
+    void flush() { size(); }
+
+    // ==================== Introspection ====================
+
+    /**
+     * @brief Returns the number of partitions (and owner threads)
+     */
+    size_t partitionCount() const noexcept { return workers.size(); }
+
+    /**
+     * @brief Returns the number of batches the owners have served
+     */
+    size_t batchCount() const noexcept {
+        size_t total = 0;
+        for (const auto& worker : workers) total += worker->batches.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * @brief Returns the number of requests the owners have served
+     */
+    size_t requestCount() const noexcept {
+        size_t total = 0;
+        for (const auto& worker : workers) total += worker->requests.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+// ==================== Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+DelegatedBPlusTree<KeyType, ValueType, Allocator>::DelegatedBPlusTree(std::vector<KeyType> keys, size_t ord,
+                                                                      size_t queueCapacity, size_t batchSize,
+                                                                      const Allocator& alloc)
+    : partitionKeys(std::move(keys)), maxBatch(std::max<size_t>(batchSize, 1)) {
+    std::sort(partitionKeys.begin(), partitionKeys.end());
+    partitionKeys.erase(std::unique(partitionKeys.begin(), partitionKeys.end()), partitionKeys.end());
+    try {
+        for (size_t i = 0; i <= partitionKeys.size(); ++i) {
+            workers.push_back(std::unique_ptr<Worker>(new Worker(ord, queueCapacity, alloc)));
+            Worker& worker = *workers.back();
+            worker.thread = std::thread([this, &worker]() { run(worker); });
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void DelegatedBPlusTree<KeyType, ValueType, Allocator>::stop() noexcept {
+    stopping.store(true, std::memory_order_seq_cst);
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->sleepMutex);
+            worker->wakeup.notify_one();
+        }
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void DelegatedBPlusTree<KeyType, ValueType, Allocator>::submit(Worker& worker, Request&& request) {
+    // Back-pressure: wait for the owner to make room
+    while (!worker.ring.tryPush(std::move(request))) {
+        std::this_thread::yield();
+    }
+
+    // Pairs with the fence in run(): either the owner sees the request or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (worker.sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(worker.sleepMutex);
+        worker.wakeup.notify_one();
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void DelegatedBPlusTree<KeyType, ValueType, Allocator>::run(Worker& worker) {
+    const size_t SPINS_BEFORE_SLEEP = 64;
+    std::vector<Request> batch;
+    std::vector<Request*> order;
+    batch.reserve(maxBatch);
+    order.reserve(maxBatch);
+
+    size_t idle = 0;
+    for (;;) {
+        batch.clear();
+        Request request;
+        while (batch.size() < maxBatch && worker.ring.tryPop(request)) {
+            batch.push_back(std::move(request));
+        }
+
+        if (!batch.empty()) {
+            idle = 0;
+            serveBatch(worker, batch, order);
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire) && worker.ring.empty()) {
+            return;
+        }
+        if (++idle < SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(worker.sleepMutex);
+        worker.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        worker.wakeup.wait(lock, [this, &worker]() {
+            return !worker.ring.empty() || stopping.load(std::memory_order_acquire);
+        });
+        worker.sleeping.store(false, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void DelegatedBPlusTree<KeyType, ValueType, Allocator>::serveBatch(Worker& worker, std::vector<Request>& batch,
+                                                                   std::vector<Request*>& order) {
+    // Keyed requests between two tasks are sorted and served together; tasks
+    // act as barriers so they observe exactly the requests submitted before them
+    order.clear();
+    for (Request& request : batch) {
+        if (request.op != Operation::EXECUTE) {
+            order.push_back(&request);
+            continue;
+        }
+        serveKeyed(worker, order.data(), order.data() + order.size());
+        order.clear();
+        std::get<std::function<void(tree_type&)>>(request.completion)(worker.tree);
+    }
+    serveKeyed(worker, order.data(), order.data() + order.size());
+
+    worker.batches.fetch_add(1, std::memory_order_relaxed);
+    worker.requests.fetch_add(batch.size(), std::memory_order_relaxed);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void DelegatedBPlusTree<KeyType, ValueType, Allocator>::serveKeyed(Worker& worker, Request** first, Request** last) {
+    // Stable, so requests for one key keep their submission order
+    std::stable_sort(first, last, [](const Request* a, const Request* b) { return a->key < b->key; });
+
+    // A request that failed gets the exception if it has a future; callbacks are not called
+    auto fail = [](Request& request) {
+        std::exception_ptr error = std::current_exception();
+        if (auto* search = std::get_if<std::promise<std::optional<ValueType>>>(&request.completion)) {
+            search->set_exception(error);
+        } else if (auto* insert = std::get_if<std::promise<void>>(&request.completion)) {
+            insert->set_exception(error);
+        } else if (auto* remove = std::get_if<std::promise<bool>>(&request.completion)) {
+            remove->set_exception(error);
+        }
+    };
+
+    while (first != last) {
+        bool searching = (*first)->op == Operation::SEARCH;
+        Request** runEnd = first;
+        while (runEnd != last && ((*runEnd)->op == Operation::SEARCH) == searching) ++runEnd;
+
+        // Serve the run in one ascending pass over the leaves: lookups with
+        // searchBatch(), inserts and removes with applyBatch(). A request that
+        // throws fails alone and the pass resumes after it; next is the first
+        // request of the run not completed yet.
+        Request** next = first;
+        while (searching && next != runEnd) {
+            try {
+                worker.tree.searchBatch(KeyIterator{next}, KeyIterator{runEnd},
+                                        [&next](const KeyType&, const ValueType* value) {
+                    Completion& completion = (*next)->completion;
+                    if (auto* promise = std::get_if<std::promise<std::optional<ValueType>>>(&completion)) {
+                        promise->set_value(value ? std::optional<ValueType>(*value) : std::nullopt);
+                    } else {
+                        std::get<std::function<void(const ValueType*)>>(completion)(value);
+                    }
+                    ++next;
+                });
+            } catch (...) {
+                fail(**next);
+                ++next;
+            }
+        }
+        while (!searching && next != runEnd) {
+            try {
+                worker.tree.applyBatch(ChangeIterator{next}, ChangeIterator{runEnd}, [&next](bool existed) {
+                    Request& request = **next;
+                    if (request.op == Operation::INSERT) {
+                        if (auto* promise = std::get_if<std::promise<void>>(&request.completion)) {
+                            promise->set_value();
+                        } else {
+                            std::get<std::function<void()>>(request.completion)();
+                        }
+                    } else if (auto* promise = std::get_if<std::promise<bool>>(&request.completion)) {
+                        promise->set_value(existed);
+                    } else {
+                        std::get<std::function<void(bool)>>(request.completion)(existed);
+                    }
+                    ++next;
+                });
+            } catch (...) {
+                fail(**next);
+                ++next;
+            }
+        }
+        first = runEnd;
+    }
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_DELEGATED_H
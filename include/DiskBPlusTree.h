@@ -0,0 +1,1400 @@
+#ifndef BPLUSTREE_DISK_H
+#define BPLUSTREE_DISK_H
+
+#include "BPlusTree.h"
+#include "Config.h"
+#include "PageIO.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bptree {
+
+namespace detail {
+
+/// Index of a fixed-size page in a DiskBPlusTree file
+using PageId = std::uint32_t;
+
+/// Page 0 holds the file header, so no node ever lives there
+constexpr PageId INVALID_PAGE = 0;
+
+constexpr uint32_t DISK_MAGIC = 0x4b445042;  // "BPDK" in little-endian
+constexpr uint32_t DISK_VERSION = 1;
+
+/**
+ * @brief Fixed set of page frames caching a file, with CLOCK eviction
+ *
+ * pin() returns the frame holding a page, reading it on a miss, and keeps it
+ * resident until the matching unpin(). When no frame is free, the clock hand
+ * sweeps the frames, clearing reference bits, and takes the first unpinned
+ * frame whose bit is already clear; a dirty victim is written back with
+ * pwrite first. prefetch() loads several pages with one batch from the
+ * PageReader, so their reads overlap. Hits, misses, evictions, write-backs
+ * and prefetches are counted in the Statistics passed to the constructor.
+ */
+class BufferPool {
+public:
+    BufferPool(int fd, size_t pageSize, size_t frameCount, Statistics& stats,
+               std::unique_ptr<PageReader> pageReader)
+        : fd(fd), pageSize(pageSize), memory(pageSize * frameCount), frames(frameCount),
+          hand(0), stats(stats), reader(std::move(pageReader)) {
+        table.reserve(frameCount * 2);
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Pins a page and returns its frame
+     *
+     * @param id The page to pin
+     * @param fresh The page was just allocated; zero it instead of reading it
+     * @throws std::runtime_error If every frame is pinned or the read fails
+     */
+    char* pin(PageId id, bool fresh) {
+        auto it = table.find(id);
+        if (it != table.end()) {
+            Frame& frame = frames[it->second];
+            frame.pins++;
+            frame.referenced = true;
+            stats.pageHitCount++;
+            return frameData(it->second);
+        }
+
+        size_t index = victim();
+        char* data = frameData(index);
+        if (fresh) {
+            std::memset(data, 0, pageSize);
+        } else {
+            readPage(fd, data, pageSize, offsetOf(id));
+            stats.pageMissCount++;
+        }
+        Frame& frame = frames[index];
+        frame.page = id;
+        frame.pins = 1;
+        frame.dirty = fresh;
+        frame.referenced = true;
+        table.emplace(id, index);
+        return data;
+    }
+
+    /**
+     * @brief Releases a pin taken by pin(), recording whether the page changed
+     */
+    void unpin(PageId id, bool dirty) noexcept {
+        auto it = table.find(id);
+        if (it == table.end()) return;
+        Frame& frame = frames[it->second];
+        if (frame.pins > 0) frame.pins--;
+        frame.dirty = frame.dirty || dirty;
+    }
+
+    /**
+     * @brief Loads the pages that are not resident with one batched read
+     *
+     * Uses at most half the frames, so a prefetch never evicts everything the
+     * caller is working with. Prefetched pages are left unpinned but marked
+     * referenced, so CLOCK keeps them for at least one sweep.
+     *
+     * @return The number of pages read
+     */
+    size_t prefetch(const std::vector<PageId>& ids) {
+        std::vector<size_t> claimed;
+        std::vector<ReadRequest> requests;
+        try {
+            for (PageId id : ids) {
+                if (claimed.size() >= frames.size() / 2) break;
+                if (table.count(id)) continue;
+                size_t index = victim();
+                Frame& frame = frames[index];
+                frame.page = id;
+                frame.pins = 1;
+                frame.referenced = true;
+                table.emplace(id, index);
+                claimed.push_back(index);
+                requests.push_back(ReadRequest{fd, frameData(index), pageSize, offsetOf(id)});
+            }
+            reader->readBatch(requests);
+        } catch (...) {
+            for (size_t index : claimed) {
+                table.erase(frames[index].page);
+                frames[index] = Frame();
+            }
+            throw;
+        }
+
+        for (size_t index : claimed) {
+            frames[index].pins = 0;
+        }
+        stats.pagePrefetchCount += claimed.size();
+        return claimed.size();
+    }
+
+    /**
+     * @brief Returns the backend used for batched reads
+     */
+    IOBackend backend() const noexcept { return reader->backend(); }
+
+    /**
+     * @brief Writes every dirty page back to the file
+     */
+    void flushAll() {
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (frames[i].page != INVALID_PAGE && frames[i].dirty) {
+                writeBack(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Forgets every cached page without writing it
+     */
+    void discardAll() noexcept {
+        for (Frame& frame : frames) frame = Frame();
+        table.clear();
+        hand = 0;
+    }
+
+    size_t frameCount() const noexcept { return frames.size(); }
+
+    /**
+     * @brief Returns the number of frames currently holding a page
+     */
+    size_t residentCount() const noexcept { return table.size(); }
+
+private:
+    struct Frame {
+        PageId page = INVALID_PAGE;
+        uint32_t pins = 0;
+        bool dirty = false;
+        bool referenced = false;
+    };
+
+    int fd;
+    size_t pageSize;
+    std::vector<char> memory;                     // frameCount pages, never reallocated
+    std::vector<Frame> frames;
+    std::unordered_map<PageId, size_t> table;     // Resident page -> frame
+    size_t hand;                                  // CLOCK hand
+    Statistics& stats;
+    std::unique_ptr<PageReader> reader;           // Issues prefetch batches
+
+    char* frameData(size_t index) noexcept { return memory.data() + index * pageSize; }
+    off_t offsetOf(PageId id) const noexcept {
+        return static_cast<off_t>(id) * static_cast<off_t>(pageSize);
+    }
+
+    void writeBack(size_t index) {
+        writePage(fd, frameData(index), pageSize, offsetOf(frames[index].page));
+        frames[index].dirty = false;
+        stats.pageWriteCount++;
+    }
+
+    size_t victim() {
+        // Two sweeps clear every reference bit, so a third finds a victim if any is unpinned
+        for (size_t step = 0; step < 3 * frames.size(); ++step) {
+            size_t index = hand;
+            hand = (hand + 1) % frames.size();
+            Frame& frame = frames[index];
+            if (frame.page == INVALID_PAGE) return index;
+            if (frame.pins > 0) continue;
+            if (frame.referenced) {
+                frame.referenced = false;
+                continue;
+            }
+            if (frame.dirty) writeBack(index);
+            table.erase(frame.page);
+            frame = Frame();
+            stats.pageEvictionCount++;
+            return index;
+        }
+        throw std::runtime_error("Buffer pool exhausted: every frame is pinned");
+    }
+};
+
+/**
+ * @brief Pin on a buffer pool page, released when the guard is destroyed
+ */
+class PageGuard {
+public:
+    PageGuard(BufferPool* pool, PageId id, char* data) noexcept
+        : pool(pool), pageId(id), bytes(data), dirty(false) {}
+
+    PageGuard(PageGuard&& other) noexcept
+        : pool(other.pool), pageId(other.pageId), bytes(other.bytes), dirty(other.dirty) {
+        other.pool = nullptr;
+    }
+
+    PageGuard(const PageGuard&) = delete;
+    PageGuard& operator=(const PageGuard&) = delete;
+    PageGuard& operator=(PageGuard&&) = delete;
+
+    ~PageGuard() {
+        if (pool) pool->unpin(pageId, dirty);
+    }
+
+    PageId id() const noexcept { return pageId; }
+    char* data() const noexcept { return bytes; }
+    void markDirty() noexcept { dirty = true; }
+
+private:
+    BufferPool* pool;
+    PageId pageId;
+    char* bytes;
+    bool dirty;
+};
+
+} // namespace detail
+
+/**
+ * @brief Disk-resident B+ tree backed by a page file and a buffer pool
+ *
+ * Nodes are fixed-size pages in a single file and refer to each other by page
+ * ID, so the tree can be many times larger than memory. Pages are cached in a
+ * BufferPool sized by a memory budget and evicted with CLOCK; dirty pages are
+ * written back with pwrite when evicted and on flush(). The fanout follows
+ * from the page size: a page holds as many keys and values (or keys and child
+ * IDs) as fit after a 16-byte header.
+ *
+ * Page layout:
+ * - Header: isLeaf (u32), numKeys (u32), next (u32), prev (u32)
+ * - Leaf: keys[], then values[]
+ * - Internal: keys[], then children[]
+ *
+ * Page 0 holds the file header (root, free list, counts). Freed pages are
+ * chained through their next field and reused before the file grows.
+ *
+ * Changes are durable once flush() returns; the destructor flushes too. There
+ * is no write-ahead log, so a crash between flushes can leave the file
+ * inconsistent. Like BPlusTree, the tree is not thread-safe, and iterators
+ * are invalidated by insert() and remove().
+ *
+ * Usage example:
+ * @code
+ * DiskBPlusTree<uint64_t, uint64_t> index("index.db", 64 << 20);  // 64 MiB of frames
+ * index.insert(42, 7);
+ * uint64_t value;
+ * if (index.search(42, value)) { ... }
+ * std::cout << index.statistics().pageHitRate() << std::endl;
+ * @endcode
+ *
+ * @tparam KeyType The type of keys (must be trivially copyable)
+ * @tparam ValueType The type of values (must be trivially copyable)
+ */
+template<typename KeyType, typename ValueType>
+class DiskBPlusTree {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "KeyType must be trivially copyable to be stored in pages");
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "ValueType must be trivially copyable to be stored in pages");
+
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using value_type = std::pair<KeyType, ValueType>;
+    using size_type = std::size_t;
+
+    /// Frames the buffer pool keeps regardless of the memory budget
+    static constexpr size_t MIN_POOL_FRAMES = 16;
+
+    /// Leaves a scan requests ahead of the one it is reading
+    static constexpr size_t DEFAULT_READ_AHEAD = 16;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+private:
+    using PageId = detail::PageId;
+    using PageGuard = detail::PageGuard;
+
+    static constexpr size_t HEADER_SIZE = 16;
+
+    // File header stored at the start of page 0
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t pageSize;
+        uint32_t keySize;
+        uint32_t valueSize;
+        PageId root;
+        PageId freeHead;
+        PageId pageCount;
+        uint64_t count;
+        uint64_t height;
+        uint64_t leafPages;
+        uint64_t internalPages;
+    };
+
+    std::string path;
+    int fd;
+    size_t pageSize;
+    size_t leafMaxKeys;
+    size_t leafMinKeys;
+    size_t internalMaxKeys;
+    size_t internalMinKeys;
+    size_t valuesOffset;    // Leaf values start here
+    size_t childrenOffset;  // Internal children start here
+
+    PageId root;
+    PageId freeHead;        // First free page (INVALID_PAGE if none)
+    PageId pageCount;       // Pages in the file, including the header page
+    size_t count;
+    size_t treeHeight;
+    size_t readAheadLeaves;
+
+    mutable Statistics stats;
+    mutable std::unique_ptr<detail::BufferPool> pool;
+
+    // Page field access; memcpy keeps unaligned fields well-defined
+    static uint32_t loadU32(const char* page, size_t offset) noexcept {
+        uint32_t v;
+        std::memcpy(&v, page + offset, sizeof(v));
+        return v;
+    }
+    static void storeU32(char* page, size_t offset, uint32_t v) noexcept {
+        std::memcpy(page + offset, &v, sizeof(v));
+    }
+
+    static bool isLeaf(const char* page) noexcept { return loadU32(page, 0) != 0; }
+    static size_t numKeys(const char* page) noexcept { return loadU32(page, 4); }
+    static void setNumKeys(char* page, size_t n) noexcept { storeU32(page, 4, static_cast<uint32_t>(n)); }
+    static PageId nextOf(const char* page) noexcept { return loadU32(page, 8); }
+    static void setNext(char* page, PageId id) noexcept { storeU32(page, 8, id); }
+    static PageId prevOf(const char* page) noexcept { return loadU32(page, 12); }
+    static void setPrev(char* page, PageId id) noexcept { storeU32(page, 12, id); }
+
+    static char* keySlot(char* page, size_t i) noexcept { return page + HEADER_SIZE + i * sizeof(KeyType); }
+    char* valueSlot(char* page, size_t i) const noexcept { return page + valuesOffset + i * sizeof(ValueType); }
+    char* childSlot(char* page, size_t i) const noexcept { return page + childrenOffset + i * sizeof(PageId); }
+
+    static KeyType keyAt(const char* page, size_t i) noexcept {
+        KeyType key;
+        std::memcpy(&key, page + HEADER_SIZE + i * sizeof(KeyType), sizeof(KeyType));
+        return key;
+    }
+    static void setKey(char* page, size_t i, const KeyType& key) noexcept {
+        std::memcpy(keySlot(page, i), &key, sizeof(KeyType));
+    }
+    ValueType valueAt(const char* page, size_t i) const noexcept {
+        ValueType value;
+        std::memcpy(&value, page + valuesOffset + i * sizeof(ValueType), sizeof(ValueType));
+        return value;
+    }
+    void setValue(char* page, size_t i, const ValueType& value) const noexcept {
+        std::memcpy(valueSlot(page, i), &value, sizeof(ValueType));
+    }
+    PageId childAt(const char* page, size_t i) const noexcept {
+        return loadU32(page, childrenOffset + i * sizeof(PageId));
+    }
+    void setChild(char* page, size_t i, PageId id) const noexcept {
+        storeU32(page, childrenOffset + i * sizeof(PageId), id);
+    }
+
+    // First slot whose key is >= key
+    static size_t lowerBoundIn(const char* page, const KeyType& key) noexcept;
+    // Child covering key: the first slot whose key is > key
+    static size_t childIndex(const char* page, const KeyType& key) noexcept;
+
+    PageGuard fetch(PageId id) const {
+        return PageGuard(pool.get(), id, pool->pin(id, false));
+    }
+    PageGuard allocatePage(bool leaf);
+    void freePage(PageGuard& page);
+
+    std::optional<std::pair<KeyType, PageId>> insertInto(PageId id, const KeyType& key,
+                                                         const ValueType& value);
+    std::pair<KeyType, PageId> splitLeaf(PageGuard& left);
+    std::pair<KeyType, PageId> splitInternal(PageGuard& left);
+
+    bool removeFrom(PageId id, const KeyType& key, bool& underfull);
+    void fixChild(PageGuard& parent, size_t index);
+    void removeSeparator(char* parent, size_t index) const;
+
+    PageId findLeaf(const KeyType& key) const;
+    PageId edgeLeaf(bool last) const;
+    size_t readAheadAfter(const KeyType& key, const KeyType* limit) const;
+
+    void openFile(size_t requestedPageSize);
+    void configureLayout();
+    void writeHeader();
+
+    bool validateNode(PageId id, size_t depth, size_t& leafDepth, const KeyType* low,
+                      const KeyType* high, PageId& expectedLeaf, size_t& entries) const;
+
+public:
+    /**
+     * @brief Opens or creates a disk-resident tree
+     *
+     * An existing file keeps the page size it was created with.
+     *
+     * @param filename Path of the page file
+     * @param memoryBudget Bytes of page frames in the buffer pool (at least MIN_POOL_FRAMES pages)
+     * @param requestedPageSize Page size for a new file
+     * @param ioBackend How scans read ahead; AUTO uses io_uring when the kernel has it
+     * @throws std::runtime_error If the file cannot be opened or is not a compatible tree file,
+     *         or if IO_URING is requested but unavailable
+     * @throws std::logic_error If the file stores keys or values of a different size
+     * @throws std::invalid_argument If a page cannot hold at least two entries
+     */
+    explicit DiskBPlusTree(const std::string& filename, size_t memoryBudget = 16 << 20,
+                           size_t requestedPageSize = DEFAULT_PAGE_SIZE,
+                           IOBackend ioBackend = IOBackend::AUTO);
+
+    /**
+     * @brief Flushes dirty pages and closes the file
+     */
+    ~DiskBPlusTree();
+
+    DiskBPlusTree(const DiskBPlusTree&) = delete;
+    DiskBPlusTree& operator=(const DiskBPlusTree&) = delete;
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: O(log n) page accesses
+     */
+    void insert(const KeyType& key, const ValueType& value);
+
+    /**
+     * @brief Removes a key
+     * @return true if the key was found and removed
+     *
+     * Time complexity: O(log n) page accesses
+     */
+    bool remove(const KeyType& key);
+
+    /**
+     * @brief Searches for a key
+     * @return true if the key was found, with its value stored in value
+     *
+     * Time complexity: O(log n) page accesses
+     */
+    bool search(const KeyType& key, ValueType& value) const;
+
+    /**
+     * @brief Checks if a key exists
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Leaves after the first are read ahead in batches of readAhead(), using
+     * the page IDs in their parents, and the batch stops at the first leaf
+     * past end.
+     *
+     * Time complexity: O(log n + k / B) page accesses for k results and B entries per leaf
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const;
+
+    /**
+     * @brief Writes every dirty page and the file header, then syncs the file
+     * @throws std::runtime_error If a write or sync fails
+     */
+    void flush();
+
+    /**
+     * @brief Removes all entries and truncates the file
+     */
+    void clear();
+
+    size_t size() const noexcept { return count; }
+    bool isEmpty() const noexcept { return root == detail::INVALID_PAGE; }
+    size_t height() const noexcept { return treeHeight; }
+    size_t getPageSize() const noexcept { return pageSize; }
+    size_t pageCapacity() const noexcept { return pool->frameCount(); }
+
+    /**
+     * @brief Sets how many leaves forward scans read ahead in one batch (0 disables)
+     */
+    void setReadAhead(size_t leaves) noexcept { readAheadLeaves = leaves; }
+    size_t readAhead() const noexcept { return readAheadLeaves; }
+
+    /**
+     * @brief Returns the backend that issues read-ahead batches
+     */
+    IOBackend ioBackend() const noexcept { return pool->backend(); }
+
+    /**
+     * @brief Returns the most entries a leaf page holds
+     */
+    size_t leafCapacity() const noexcept { return leafMaxKeys; }
+
+    /**
+     * @brief Returns the most keys an internal page holds
+     */
+    size_t internalCapacity() const noexcept { return internalMaxKeys; }
+
+    /**
+     * @brief Returns a copy of current statistics, including buffer pool hits and misses
+     */
+    Statistics getStatistics() const noexcept { return stats; }
+
+    /**
+     * @brief Returns a reference to current statistics
+     */
+    const Statistics& statistics() const noexcept { return stats; }
+
+    /**
+     * @brief Resets operation and buffer pool counters, preserving node counts
+     */
+    void resetStatistics() noexcept {
+        size_t leafCount = stats.leafNodeCount;
+        size_t internalCount = stats.internalNodeCount;
+        stats.reset();
+        stats.leafNodeCount = leafCount;
+        stats.internalNodeCount = internalCount;
+    }
+
+    /**
+     * @brief Validates the structure: key order, fill, uniform leaf depth and leaf links
+     */
+    bool validate() const;
+
+    const_iterator begin() const {
+        PageId first = edgeLeaf(false);
+        return first == detail::INVALID_PAGE ? end() : const_iterator(this, first, 0);
+    }
+    const_iterator end() const { return const_iterator(this, detail::INVALID_PAGE, 0); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /**
+     * @brief Returns an iterator to the first entry with key >= key
+     */
+    const_iterator lower_bound(const KeyType& key) const;
+
+    /**
+     * @brief Returns an iterator to the first entry with key > key
+     */
+    const_iterator upper_bound(const KeyType& key) const {
+        const_iterator it = lower_bound(key);
+        if (it != end() && it->first == key) ++it;
+        return it;
+    }
+
+    /**
+     * @brief Bidirectional iterator over a DiskBPlusTree in key order
+     *
+     * Holds a page ID and slot rather than a pin, so any number of iterators
+     * can be live without tying up frames. Each step pins the page briefly
+     * and copies the entry out. Moving forward onto a new leaf reads the next
+     * readAhead() leaves in one batch once the previous batch is used up.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<KeyType, ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() : tree(nullptr), page(detail::INVALID_PAGE), index(0), runway(0), cached() {}
+
+        reference operator*() const { return cached; }
+        pointer operator->() const { return &cached; }
+
+        const_iterator& operator++() {
+            if (page == detail::INVALID_PAGE) return *this;
+            PageGuard guard = tree->fetch(page);
+            if (index + 1 < numKeys(guard.data())) {
+                index++;
+                load(guard.data());
+                return *this;
+            }
+            page = nextOf(guard.data());
+            if (page != detail::INVALID_PAGE) {
+                if (runway == 0) runway = tree->readAheadAfter(keyAt(guard.data(), index), nullptr);
+                if (runway > 0) runway--;
+            }
+            index = 0;
+            if (page != detail::INVALID_PAGE) {
+                PageGuard next = tree->fetch(page);
+                load(next.data());
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        const_iterator& operator--() {
+            PageId target = page;
+            if (page == detail::INVALID_PAGE) {
+                target = tree->edgeLeaf(true);
+            } else if (index > 0) {
+                index--;
+                PageGuard guard = tree->fetch(page);
+                load(guard.data());
+                return *this;
+            } else {
+                PageGuard guard = tree->fetch(page);
+                target = prevOf(guard.data());
+            }
+            if (target == detail::INVALID_PAGE) return *this;
+            PageGuard guard = tree->fetch(target);
+            page = target;
+            index = numKeys(guard.data()) - 1;
+            load(guard.data());
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return page == other.page && index == other.index;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class DiskBPlusTree;
+
+        const DiskBPlusTree* tree;
+        PageId page;
+        size_t index;
+        size_t runway;      // Leaves ahead of this one already read ahead
+        value_type cached;
+
+        const_iterator(const DiskBPlusTree* owner, PageId id, size_t slot)
+            : tree(owner), page(id), index(slot), runway(0), cached() {
+            if (page != detail::INVALID_PAGE) {
+                PageGuard guard = tree->fetch(page);
+                load(guard.data());
+            }
+        }
+
+        void load(const char* data) {
+            cached.first = keyAt(data, index);
+            cached.second = tree->valueAt(data, index);
+        }
+    };
+};
+
+// ==================== Construction ====================
+
+template<typename KeyType, typename ValueType>
+DiskBPlusTree<KeyType, ValueType>::DiskBPlusTree(const std::string& filename, size_t memoryBudget,
+                                                 size_t requestedPageSize, IOBackend ioBackend)
+    : path(filename), fd(-1), pageSize(0), leafMaxKeys(0), leafMinKeys(0), internalMaxKeys(0),
+      internalMinKeys(0), valuesOffset(0), childrenOffset(0), root(detail::INVALID_PAGE),
+      freeHead(detail::INVALID_PAGE), pageCount(1), count(0), treeHeight(0),
+      readAheadLeaves(DEFAULT_READ_AHEAD) {
+    openFile(requestedPageSize);
+    try {
+        size_t frames = std::max(MIN_POOL_FRAMES, memoryBudget / pageSize);
+        pool.reset(new detail::BufferPool(fd, pageSize, frames, stats,
+                                          detail::makePageReader(ioBackend, DEFAULT_READ_AHEAD)));
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+template<typename KeyType, typename ValueType>
+DiskBPlusTree<KeyType, ValueType>::~DiskBPlusTree() {
+    try {
+        flush();
+    } catch (...) {
+        // Destructors must not throw; call flush() first to observe write errors
+    }
+    ::close(fd);
+}
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::configureLayout() {
+    if (pageSize <= HEADER_SIZE + sizeof(PageId)) {
+        throw std::invalid_argument("Page size " + std::to_string(pageSize) + " is too small");
+    }
+    // One spare slot lets a node overflow by one entry before it is split
+    size_t leafSlots = (pageSize - HEADER_SIZE) / (sizeof(KeyType) + sizeof(ValueType));
+    size_t internalSlots = (pageSize - HEADER_SIZE - sizeof(PageId)) / (sizeof(KeyType) + sizeof(PageId));
+    if (leafSlots < MIN_ORDER || internalSlots < MIN_ORDER) {
+        throw std::invalid_argument("Page size " + std::to_string(pageSize) +
+                                    " cannot hold two entries per node");
+    }
+    leafMaxKeys = leafSlots - 1;
+    internalMaxKeys = internalSlots - 1;
+    leafMinKeys = leafMaxKeys / 2;
+    internalMinKeys = internalMaxKeys / 2;
+    valuesOffset = HEADER_SIZE + leafSlots * sizeof(KeyType);
+    childrenOffset = HEADER_SIZE + internalSlots * sizeof(KeyType);
+}
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::openFile(size_t requestedPageSize) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    try {
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            throw std::runtime_error("Failed to stat file: " + path);
+        }
+
+        if (info.st_size == 0) {
+            pageSize = requestedPageSize;
+            configureLayout();
+            writeHeader();
+            return;
+        }
+
+        FileHeader header;
+        detail::readPage(fd, reinterpret_cast<char*>(&header), sizeof(header), 0);
+        if (header.magic != detail::DISK_MAGIC) {
+            throw std::runtime_error("Invalid file format: not a disk B+ tree file");
+        }
+        if (header.version != detail::DISK_VERSION) {
+            throw std::runtime_error("Incompatible file version: expected " +
+                                     std::to_string(detail::DISK_VERSION) +
+                                     ", got " + std::to_string(header.version));
+        }
+        if (header.keySize != sizeof(KeyType) || header.valueSize != sizeof(ValueType)) {
+            throw std::logic_error("Key or value size mismatch: file stores " +
+                                   std::to_string(header.keySize) + "-byte keys and " +
+                                   std::to_string(header.valueSize) + "-byte values");
+        }
+
+        pageSize = header.pageSize;
+        configureLayout();
+        root = header.root;
+        freeHead = header.freeHead;
+        pageCount = header.pageCount;
+        count = static_cast<size_t>(header.count);
+        treeHeight = static_cast<size_t>(header.height);
+        stats.leafNodeCount = static_cast<size_t>(header.leafPages);
+        stats.internalNodeCount = static_cast<size_t>(header.internalPages);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::writeHeader() {
+    std::vector<char> page(pageSize, 0);
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = detail::DISK_MAGIC;
+    header.version = detail::DISK_VERSION;
+    header.pageSize = static_cast<uint32_t>(pageSize);
+    header.keySize = static_cast<uint32_t>(sizeof(KeyType));
+    header.valueSize = static_cast<uint32_t>(sizeof(ValueType));
+    header.root = root;
+    header.freeHead = freeHead;
+    header.pageCount = pageCount;
+    header.count = count;
+    header.height = treeHeight;
+    header.leafPages = stats.leafNodeCount;
+    header.internalPages = stats.internalNodeCount;
+    std::memcpy(page.data(), &header, sizeof(header));
+    detail::writePage(fd, page.data(), pageSize, 0);
+}
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::flush() {
+    pool->flushAll();
+    writeHeader();
+    if (::fsync(fd) != 0) {
+        throw std::runtime_error("Failed to sync file: " + path);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::clear() {
+    pool->discardAll();
+    if (::ftruncate(fd, static_cast<off_t>(pageSize)) != 0) {
+        throw std::runtime_error("Failed to truncate file: " + path);
+    }
+    root = detail::INVALID_PAGE;
+    freeHead = detail::INVALID_PAGE;
+    pageCount = 1;
+    count = 0;
+    treeHeight = 0;
+    stats.leafNodeCount = 0;
+    stats.internalNodeCount = 0;
+    writeHeader();
+}
+
+// ==================== Page Management ====================
+
+/**
+ * @brief Takes a page from the free list, or appends one to the file
+ */
+template<typename KeyType, typename ValueType>
+detail::PageGuard DiskBPlusTree<KeyType, ValueType>::allocatePage(bool leaf) {
+    PageId id;
+    char* data;
+    if (freeHead != detail::INVALID_PAGE) {
+        id = freeHead;
+        data = pool->pin(id, false);
+        freeHead = nextOf(data);
+        std::memset(data, 0, pageSize);
+    } else {
+        if (pageCount == UINT32_MAX) {
+            throw std::length_error("Disk B+ tree file is out of page IDs");
+        }
+        id = pageCount;
+        data = pool->pin(id, true);
+        pageCount++;
+    }
+
+    PageGuard page(pool.get(), id, data);
+    storeU32(data, 0, leaf ? 1 : 0);
+    page.markDirty();
+    if (leaf) {
+        stats.leafNodeCount++;
+    } else {
+        stats.internalNodeCount++;
+    }
+    return page;
+}
+
+/**
+ * @brief Pushes a page onto the free list
+ */
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::freePage(PageGuard& page) {
+    if (isLeaf(page.data())) {
+        stats.leafNodeCount--;
+    } else {
+        stats.internalNodeCount--;
+    }
+    std::memset(page.data(), 0, pageSize);
+    setNext(page.data(), freeHead);
+    freeHead = page.id();
+    page.markDirty();
+}
+
+// ==================== Search ====================
+
+template<typename KeyType, typename ValueType>
+size_t DiskBPlusTree<KeyType, ValueType>::lowerBoundIn(const char* page, const KeyType& key) noexcept {
+    size_t lo = 0;
+    size_t hi = numKeys(page);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (keyAt(page, mid) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template<typename KeyType, typename ValueType>
+size_t DiskBPlusTree<KeyType, ValueType>::childIndex(const char* page, const KeyType& key) noexcept {
+    size_t lo = 0;
+    size_t hi = numKeys(page);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (key < keyAt(page, mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+template<typename KeyType, typename ValueType>
+detail::PageId DiskBPlusTree<KeyType, ValueType>::findLeaf(const KeyType& key) const {
+    PageId id = root;
+    while (id != detail::INVALID_PAGE) {
+        PageGuard page = fetch(id);
+        if (isLeaf(page.data())) break;
+        id = childAt(page.data(), childIndex(page.data(), key));
+    }
+    return id;
+}
+
+template<typename KeyType, typename ValueType>
+detail::PageId DiskBPlusTree<KeyType, ValueType>::edgeLeaf(bool last) const {
+    PageId id = root;
+    while (id != detail::INVALID_PAGE) {
+        PageGuard page = fetch(id);
+        if (isLeaf(page.data())) break;
+        id = childAt(page.data(), last ? numKeys(page.data()) : 0);
+    }
+    return id;
+}
+
+/**
+ * @brief Reads ahead the leaves that follow the one holding key, in key order
+ *
+ * The leaf chain only links a leaf to its immediate neighbour, so the IDs
+ * come from the parents instead: the path to key's leaf is stepped forward
+ * one child at a time, moving up and back down when a parent runs out of
+ * children. Stops after readAhead() leaves, or at the first leaf whose
+ * smallest possible key is past limit.
+ *
+ * @return The number of leaves requested (some may already have been resident)
+ */
+template<typename KeyType, typename ValueType>
+size_t DiskBPlusTree<KeyType, ValueType>::readAheadAfter(const KeyType& key, const KeyType* limit) const {
+    if (readAheadLeaves == 0 || treeHeight < 2) return 0;
+
+    // The internal nodes from the root down to the leaf's parent, with the child taken in each
+    std::vector<std::pair<PageId, size_t>> path;
+    PageId id = root;
+    for (size_t level = 1; level < treeHeight; ++level) {
+        PageGuard page = fetch(id);
+        size_t index = childIndex(page.data(), key);
+        path.emplace_back(id, index);
+        id = childAt(page.data(), index);
+    }
+
+    std::vector<PageId> leaves;
+    while (leaves.size() < readAheadLeaves) {
+        // Find the lowest ancestor with a child to the right of the path
+        size_t level = path.size();
+        for (; level > 0; --level) {
+            PageGuard page = fetch(path[level - 1].first);
+            if (path[level - 1].second < numKeys(page.data())) break;
+        }
+        if (level == 0) break;
+
+        PageGuard page = fetch(path[level - 1].first);
+        size_t index = ++path[level - 1].second;
+        if (limit && *limit < keyAt(page.data(), index - 1)) break;
+
+        // Descend along leftmost children to the next leaf
+        PageId child = childAt(page.data(), index);
+        for (size_t lower = level; lower < path.size(); ++lower) {
+            path[lower] = {child, 0};
+            PageGuard node = fetch(child);
+            child = childAt(node.data(), 0);
+        }
+        leaves.push_back(child);
+    }
+
+    pool->prefetch(leaves);
+    return leaves.size();
+}
+
+template<typename KeyType, typename ValueType>
+bool DiskBPlusTree<KeyType, ValueType>::search(const KeyType& key, ValueType& value) const {
+    stats.searchCount++;
+    PageId id = findLeaf(key);
+    if (id == detail::INVALID_PAGE) return false;
+
+    PageGuard leaf = fetch(id);
+    size_t pos = lowerBoundIn(leaf.data(), key);
+    if (pos < numKeys(leaf.data()) && keyAt(leaf.data(), pos) == key) {
+        value = valueAt(leaf.data(), pos);
+        stats.searchHitCount++;
+        return true;
+    }
+    return false;
+}
+
+template<typename KeyType, typename ValueType>
+std::vector<std::pair<KeyType, ValueType>>
+DiskBPlusTree<KeyType, ValueType>::rangeQuery(const KeyType& start, const KeyType& end) const {
+    std::vector<std::pair<KeyType, ValueType>> result;
+    if (end < start) return result;
+
+    PageId id = findLeaf(start);
+    bool first = true;
+    size_t runway = 0;  // Leaves ahead of this one already read ahead
+    while (id != detail::INVALID_PAGE) {
+        PageGuard leaf = fetch(id);
+        const char* data = leaf.data();
+        size_t n = numKeys(data);
+        size_t pos = first ? lowerBoundIn(data, start) : 0;
+        first = false;
+        for (; pos < n; ++pos) {
+            KeyType key = keyAt(data, pos);
+            if (end < key) return result;
+            result.emplace_back(key, valueAt(data, pos));
+        }
+        id = nextOf(data);
+        if (id != detail::INVALID_PAGE) {
+            if (runway == 0) runway = readAheadAfter(keyAt(data, n - 1), &end);
+            if (runway > 0) runway--;
+        }
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType>
+typename DiskBPlusTree<KeyType, ValueType>::const_iterator
+DiskBPlusTree<KeyType, ValueType>::lower_bound(const KeyType& key) const {
+    PageId id = findLeaf(key);
+    if (id == detail::INVALID_PAGE) return end();
+
+    PageGuard leaf = fetch(id);
+    size_t pos = lowerBoundIn(leaf.data(), key);
+    if (pos < numKeys(leaf.data())) return const_iterator(this, id, pos);
+    PageId next = nextOf(leaf.data());
+    return next == detail::INVALID_PAGE ? end() : const_iterator(this, next, 0);
+}
+
+// ==================== Insertion ====================
+
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value) {
+    stats.insertCount++;
+    if (root == detail::INVALID_PAGE) {
+        PageGuard leaf = allocatePage(true);
+        setKey(leaf.data(), 0, key);
+        setValue(leaf.data(), 0, value);
+        setNumKeys(leaf.data(), 1);
+        root = leaf.id();
+        treeHeight = 1;
+        count = 1;
+        return;
+    }
+
+    auto split = insertInto(root, key, value);
+    if (split) {
+        PageGuard node = allocatePage(false);
+        setKey(node.data(), 0, split->first);
+        setChild(node.data(), 0, root);
+        setChild(node.data(), 1, split->second);
+        setNumKeys(node.data(), 1);
+        root = node.id();
+        treeHeight++;
+    }
+}
+
+/**
+ * @brief Inserts below a page, returning the separator and new page if it split
+ *
+ * Pins the path from the root while descending, so a split can update each
+ * parent without fetching it again.
+ */
+template<typename KeyType, typename ValueType>
+std::optional<std::pair<KeyType, detail::PageId>>
+DiskBPlusTree<KeyType, ValueType>::insertInto(PageId id, const KeyType& key, const ValueType& value) {
+    PageGuard page = fetch(id);
+    char* data = page.data();
+    size_t n = numKeys(data);
+
+    if (isLeaf(data)) {
+        size_t pos = lowerBoundIn(data, key);
+        page.markDirty();
+        if (pos < n && keyAt(data, pos) == key) {
+            setValue(data, pos, value);
+            return std::nullopt;
+        }
+        std::memmove(keySlot(data, pos + 1), keySlot(data, pos), (n - pos) * sizeof(KeyType));
+        std::memmove(valueSlot(data, pos + 1), valueSlot(data, pos), (n - pos) * sizeof(ValueType));
+        setKey(data, pos, key);
+        setValue(data, pos, value);
+        setNumKeys(data, n + 1);
+        count++;
+        if (n + 1 <= leafMaxKeys) return std::nullopt;
+        return splitLeaf(page);
+    }
+
+    size_t index = childIndex(data, key);
+    auto split = insertInto(childAt(data, index), key, value);
+    if (!split) return std::nullopt;
+
+    page.markDirty();
+    std::memmove(keySlot(data, index + 1), keySlot(data, index), (n - index) * sizeof(KeyType));
+    std::memmove(childSlot(data, index + 2), childSlot(data, index + 1), (n - index) * sizeof(PageId));
+    setKey(data, index, split->first);
+    setChild(data, index + 1, split->second);
+    setNumKeys(data, n + 1);
+    if (n + 1 <= internalMaxKeys) return std::nullopt;
+    return splitInternal(page);
+}
+
+template<typename KeyType, typename ValueType>
+std::pair<KeyType, detail::PageId> DiskBPlusTree<KeyType, ValueType>::splitLeaf(PageGuard& left) {
+    char* l = left.data();
+    size_t n = numKeys(l);
+    size_t keep = n / 2;
+    size_t move = n - keep;
+
+    PageGuard right = allocatePage(true);
+    char* r = right.data();
+    std::memcpy(keySlot(r, 0), keySlot(l, keep), move * sizeof(KeyType));
+    std::memcpy(valueSlot(r, 0), valueSlot(l, keep), move * sizeof(ValueType));
+    setNumKeys(r, move);
+    setNumKeys(l, keep);
+
+    PageId after = nextOf(l);
+    setNext(r, after);
+    setPrev(r, left.id());
+    setNext(l, right.id());
+    if (after != detail::INVALID_PAGE) {
+        PageGuard next = fetch(after);
+        setPrev(next.data(), right.id());
+        next.markDirty();
+    }
+    stats.leafSplitCount++;
+    return {keyAt(r, 0), right.id()};
+}
+
+template<typename KeyType, typename ValueType>
+std::pair<KeyType, detail::PageId> DiskBPlusTree<KeyType, ValueType>::splitInternal(PageGuard& left) {
+    char* l = left.data();
+    size_t n = numKeys(l);
+    size_t mid = n / 2;
+    KeyType separator = keyAt(l, mid);
+
+    PageGuard right = allocatePage(false);
+    char* r = right.data();
+    size_t moved = n - mid - 1;
+    std::memcpy(keySlot(r, 0), keySlot(l, mid + 1), moved * sizeof(KeyType));
+    std::memcpy(childSlot(r, 0), childSlot(l, mid + 1), (moved + 1) * sizeof(PageId));
+    setNumKeys(r, moved);
+    setNumKeys(l, mid);
+    stats.internalSplitCount++;
+    return {separator, right.id()};
+}
+
+// ==================== Deletion ====================
+
+template<typename KeyType, typename ValueType>
+bool DiskBPlusTree<KeyType, ValueType>::remove(const KeyType& key) {
+    if (root == detail::INVALID_PAGE) return false;
+
+    bool underfull = false;
+    if (!removeFrom(root, key, underfull)) return false;
+    stats.removeCount++;
+    count--;
+
+    // Collapse an empty root
+    PageGuard page = fetch(root);
+    if (numKeys(page.data()) == 0) {
+        root = isLeaf(page.data()) ? detail::INVALID_PAGE : childAt(page.data(), 0);
+        treeHeight--;
+        freePage(page);
+    }
+    return true;
+}
+
+/**
+ * @brief Removes key below a page, reporting whether the page fell below its minimum
+ */
+template<typename KeyType, typename ValueType>
+bool DiskBPlusTree<KeyType, ValueType>::removeFrom(PageId id, const KeyType& key, bool& underfull) {
+    PageGuard page = fetch(id);
+    char* data = page.data();
+    size_t n = numKeys(data);
+
+    if (isLeaf(data)) {
+        size_t pos = lowerBoundIn(data, key);
+        if (pos == n || !(keyAt(data, pos) == key)) return false;
+        std::memmove(keySlot(data, pos), keySlot(data, pos + 1), (n - pos - 1) * sizeof(KeyType));
+        std::memmove(valueSlot(data, pos), valueSlot(data, pos + 1), (n - pos - 1) * sizeof(ValueType));
+        setNumKeys(data, n - 1);
+        page.markDirty();
+        underfull = n - 1 < leafMinKeys;
+        return true;
+    }
+
+    size_t index = childIndex(data, key);
+    bool childUnderfull = false;
+    if (!removeFrom(childAt(data, index), key, childUnderfull)) return false;
+    if (childUnderfull) {
+        fixChild(page, index);
+    }
+    underfull = numKeys(data) < internalMinKeys;
+    return true;
+}
+
+/**
+ * @brief Removes key index and child index + 1 from an internal page
+ */
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::removeSeparator(char* parent, size_t index) const {
+    size_t n = numKeys(parent);
+    std::memmove(keySlot(parent, index), keySlot(parent, index + 1), (n - index - 1) * sizeof(KeyType));
+    std::memmove(childSlot(parent, index + 1), childSlot(parent, index + 2), (n - index - 1) * sizeof(PageId));
+    setNumKeys(parent, n - 1);
+}
+
+/**
+ * @brief Restores the minimum fill of a child by borrowing from or merging with a sibling
+ */
+template<typename KeyType, typename ValueType>
+void DiskBPlusTree<KeyType, ValueType>::fixChild(PageGuard& parent, size_t index) {
+    char* p = parent.data();
+    size_t li = index > 0 ? index - 1 : index;
+    PageGuard left = fetch(childAt(p, li));
+    PageGuard right = fetch(childAt(p, li + 1));
+    char* l = left.data();
+    char* r = right.data();
+    size_t ln = numKeys(l);
+    size_t rn = numKeys(r);
+    parent.markDirty();
+    left.markDirty();
+    right.markDirty();
+
+    if (isLeaf(l)) {
+        if (ln + rn <= leafMaxKeys) {
+            std::memcpy(keySlot(l, ln), keySlot(r, 0), rn * sizeof(KeyType));
+            std::memcpy(valueSlot(l, ln), valueSlot(r, 0), rn * sizeof(ValueType));
+            setNumKeys(l, ln + rn);
+            PageId after = nextOf(r);
+            setNext(l, after);
+            if (after != detail::INVALID_PAGE) {
+                PageGuard next = fetch(after);
+                setPrev(next.data(), left.id());
+                next.markDirty();
+            }
+            removeSeparator(p, li);
+            freePage(right);
+            stats.leafMergeCount++;
+        } else if (ln < rn) {
+            // Move the first entry of the right leaf to the end of the left one
+            setKey(l, ln, keyAt(r, 0));
+            setValue(l, ln, valueAt(r, 0));
+            setNumKeys(l, ln + 1);
+            std::memmove(keySlot(r, 0), keySlot(r, 1), (rn - 1) * sizeof(KeyType));
+            std::memmove(valueSlot(r, 0), valueSlot(r, 1), (rn - 1) * sizeof(ValueType));
+            setNumKeys(r, rn - 1);
+            setKey(p, li, keyAt(r, 0));
+            stats.redistributeCount++;
+        } else {
+            // Move the last entry of the left leaf to the front of the right one
+            std::memmove(keySlot(r, 1), keySlot(r, 0), rn * sizeof(KeyType));
+            std::memmove(valueSlot(r, 1), valueSlot(r, 0), rn * sizeof(ValueType));
+            setKey(r, 0, keyAt(l, ln - 1));
+            setValue(r, 0, valueAt(l, ln - 1));
+            setNumKeys(r, rn + 1);
+            setNumKeys(l, ln - 1);
+            setKey(p, li, keyAt(r, 0));
+            stats.redistributeCount++;
+        }
+        return;
+    }
+
+    KeyType separator = keyAt(p, li);
+    if (ln + rn + 1 <= internalMaxKeys) {
+        setKey(l, ln, separator);
+        std::memcpy(keySlot(l, ln + 1), keySlot(r, 0), rn * sizeof(KeyType));
+        std::memcpy(childSlot(l, ln + 1), childSlot(r, 0), (rn + 1) * sizeof(PageId));
+        setNumKeys(l, ln + rn + 1);
+        removeSeparator(p, li);
+        freePage(right);
+        stats.internalMergeCount++;
+    } else if (ln < rn) {
+        // Rotate left through the parent
+        setKey(l, ln, separator);
+        setChild(l, ln + 1, childAt(r, 0));
+        setNumKeys(l, ln + 1);
+        setKey(p, li, keyAt(r, 0));
+        std::memmove(keySlot(r, 0), keySlot(r, 1), (rn - 1) * sizeof(KeyType));
+        std::memmove(childSlot(r, 0), childSlot(r, 1), rn * sizeof(PageId));
+        setNumKeys(r, rn - 1);
+        stats.redistributeCount++;
+    } else {
+        // Rotate right through the parent
+        std::memmove(keySlot(r, 1), keySlot(r, 0), rn * sizeof(KeyType));
+        std::memmove(childSlot(r, 1), childSlot(r, 0), (rn + 1) * sizeof(PageId));
+        setKey(r, 0, separator);
+        setChild(r, 0, childAt(l, ln));
+        setNumKeys(r, rn + 1);
+        setKey(p, li, keyAt(l, ln - 1));
+        setNumKeys(l, ln - 1);
+        stats.redistributeCount++;
+    }
+}
+
+// ==================== Validation ====================
+
+template<typename KeyType, typename ValueType>
+bool DiskBPlusTree<KeyType, ValueType>::validate() const {
+    if (root == detail::INVALID_PAGE) {
+        return count == 0 && treeHeight == 0;
+    }
+
+    size_t leafDepth = 0;
+    PageId expectedLeaf = edgeLeaf(false);
+    size_t entries = 0;
+    if (!validateNode(root, 1, leafDepth, nullptr, nullptr, expectedLeaf, entries)) {
+        return false;
+    }
+    return expectedLeaf == detail::INVALID_PAGE && entries == count && leafDepth == treeHeight;
+}
+
+/**
+ * @brief Checks a subtree; expectedLeaf follows the leaf chain in key order
+ */
+template<typename KeyType, typename ValueType>
+bool DiskBPlusTree<KeyType, ValueType>::validateNode(PageId id, size_t depth, size_t& leafDepth,
+                                                     const KeyType* low, const KeyType* high,
+                                                     PageId& expectedLeaf, size_t& entries) const {
+    if (id == detail::INVALID_PAGE || id >= pageCount) return false;
+
+    PageGuard page = fetch(id);
+    const char* data = page.data();
+    size_t n = numKeys(data);
+    bool isRoot = id == root;
+
+    for (size_t i = 0; i < n; ++i) {
+        KeyType key = keyAt(data, i);
+        if (i > 0 && !(keyAt(data, i - 1) < key)) return false;
+        if (low && key < *low) return false;
+        if (high && !(key < *high)) return false;
+    }
+
+    if (isLeaf(data)) {
+        if (n > leafMaxKeys || n == 0 || (!isRoot && n < leafMinKeys)) return false;
+        if (leafDepth == 0) leafDepth = depth;
+        if (depth != leafDepth || id != expectedLeaf) return false;
+        PageId next = nextOf(data);
+        if (next != detail::INVALID_PAGE) {
+            PageGuard after = fetch(next);
+            if (prevOf(after.data()) != id) return false;
+        }
+        expectedLeaf = next;
+        entries += n;
+        return true;
+    }
+
+    if (n > internalMaxKeys || n == 0 || (!isRoot && n < internalMinKeys)) return false;
+    for (size_t i = 0; i <= n; ++i) {
+        KeyType lo;
+        KeyType hi;
+        const KeyType* childLow = low;
+        const KeyType* childHigh = high;
+        if (i > 0) {
+            lo = keyAt(data, i - 1);
+            childLow = &lo;
+        }
+        if (i < n) {
+            hi = keyAt(data, i);
+            childHigh = &hi;
+        }
+        if (!validateNode(childAt(data, i), depth + 1, leafDepth, childLow, childHigh,
+                          expectedLeaf, entries)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_DISK_H
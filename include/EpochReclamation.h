@@ -0,0 +1,331 @@
+#ifndef BPLUSTREE_EPOCH_RECLAMATION_H
+#define BPLUSTREE_EPOCH_RECLAMATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+namespace bptree {
+
+/**
+ * @brief Epoch-based reclamation (EBR) of memory shared with latch-free readers
+ *
+ * Threads that read shared nodes without latches register once and pin the
+ * current epoch around each operation. Memory unlinked by a writer is not freed
+ * immediately but retired into the writer's limbo list, tagged with the global
+ * epoch. The global epoch only advances once every pinned thread has observed
+ * it, so an object retired in epoch e can no longer be reached by anyone once
+ * the global epoch reaches e + 2, and is then reclaimed.
+ *
+ * Reclamation is batched: a participant tries to advance the epoch and frees
+ * its reclaimable objects once every batchSize retirements, so retire() is
+ * usually just a vector append.
+ *
+ * Usage example:
+ * @code
+ * EpochManager epochs;
+ * EpochManager::Participant* self = epochs.registerThread();
+ * {
+ *     EpochManager::Guard guard(epochs, *self);   // readers may follow pointers now
+ *     ...
+ * }
+ * epochs.retire(*self, node, [](void* object, void*) { delete static_cast<Node*>(object); });
+ * epochs.unregisterThread(self);
+ * @endcode
+ */
+class EpochManager {
+public:
+    /**
+     * @brief Function that frees a retired object; context is passed through from retire()
+     */
+    using ReclaimFunction = void (*)(void* object, void* context);
+
+    /**
+     * @brief Default number of retirements between reclamation attempts
+     */
+    static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+
+private:
+    static constexpr uint64_t INACTIVE = std::numeric_limits<uint64_t>::max();
+
+    // An object waiting for the grace period of its retire epoch to pass
+    struct RetiredObject {
+        void* object;
+        ReclaimFunction reclaim;
+        void* context;
+        uint64_t epoch;
+    };
+
+public:
+    /**
+     * @brief Per-thread reclamation state
+     *
+     * Created by registerThread() and used only by the registering thread,
+     * except for its epoch, which other threads read when advancing.
+     */
+    class Participant {
+    private:
+        friend class EpochManager;
+
+        std::atomic<uint64_t> localEpoch{INACTIVE};  // Pinned epoch, or INACTIVE
+        size_t pinDepth = 0;                         // Nesting level of Guards
+        std::vector<RetiredObject> limbo;            // Retired objects in epoch order
+        size_t retiredSinceCollect = 0;              // Retirements since last collect()
+    };
+
+    /**
+     * @brief RAII pin of the current epoch
+     *
+     * While a Guard exists, no object retired after it was created will be
+     * reclaimed. Guards may nest.
+     */
+    class Guard {
+    private:
+        EpochManager* manager;
+        Participant* participant;
+
+    public:
+        Guard(EpochManager& m, Participant& p) : manager(&m), participant(&p) {
+            manager->enter(*participant);
+        }
+
+        ~Guard() {
+            if (participant) manager->exit(*participant);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        Guard(Guard&& other) noexcept : manager(other.manager), participant(other.participant) {
+            other.participant = nullptr;
+        }
+        Guard& operator=(Guard&&) = delete;
+    };
+
+private:
+    std::atomic<uint64_t> globalEpoch{0};
+    size_t batchSize;
+
+    mutable std::mutex registryMutex;                       // Guards participants and orphans
+    std::vector<std::unique_ptr<Participant>> participants;
+    std::vector<RetiredObject> orphans;                     // Limbo left by unregistered threads
+
+    std::atomic<size_t> pending{0};                         // Objects retired but not reclaimed
+    std::atomic<size_t> reclaimed{0};                       // Objects reclaimed so far
+
+    void enter(Participant& p) {
+        if (p.pinDepth++ == 0) {
+            // The store must be visible before the thread reads shared pointers
+            p.localEpoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+    }
+
+    void exit(Participant& p) {
+        assert(p.pinDepth > 0 && "Unbalanced epoch exit");
+        if (--p.pinDepth == 0) {
+            p.localEpoch.store(INACTIVE, std::memory_order_release);
+        }
+    }
+
+    // Advances the global epoch if every pinned thread has observed it
+    bool tryAdvance() {
+        uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const auto& p : participants) {
+                uint64_t local = p->localEpoch.load(std::memory_order_seq_cst);
+                if (local != INACTIVE && local != epoch) return false;
+            }
+        }
+        return globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    // Reclaims the safe prefix of an epoch-ordered list; returns the count freed
+    size_t reclaimSafe(std::vector<RetiredObject>& list, uint64_t epoch) {
+        size_t freed = 0;
+        while (freed < list.size() && list[freed].epoch + 2 <= epoch) {
+            list[freed].reclaim(list[freed].object, list[freed].context);
+            freed++;
+        }
+        list.erase(list.begin(), list.begin() + static_cast<std::ptrdiff_t>(freed));
+        pending.fetch_sub(freed, std::memory_order_relaxed);
+        reclaimed.fetch_add(freed, std::memory_order_relaxed);
+        return freed;
+    }
+
+public:
+    /**
+     * @brief Constructs an epoch manager
+     *
+     * @param batch Retirements per participant between reclamation attempts
+     *              (values below 1 are raised to 1)
+     */
+    explicit EpochManager(size_t batch = DEFAULT_BATCH_SIZE) : batchSize(std::max<size_t>(batch, 1)) {}
+
+    /**
+     * @brief Reclaims every remaining object
+     *
+     * No thread may be pinned, and every registered thread must be done with
+     * the manager.
+     */
+    ~EpochManager() {
+        for (auto& p : participants) {
+            assert(p->pinDepth == 0 && "Thread still pinned at EpochManager destruction");
+            reclaimSafe(p->limbo, INACTIVE);
+        }
+        reclaimSafe(orphans, INACTIVE);
+    }
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /**
+     * @brief Registers the calling thread
+     *
+     * @return The thread's participant, valid until unregisterThread()
+     *
+     * Thread safety: May be called concurrently
+     */
+    Participant* registerThread() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        participants.push_back(std::unique_ptr<Participant>(new Participant()));
+        return participants.back().get();
+    }
+
+    /**
+     * @brief Unregisters a thread; its unreclaimed objects are handed to the manager
+     *
+     * @param p A participant returned by registerThread() that is not pinned
+     *
+     * Thread safety: May be called concurrently
+     */
+    void unregisterThread(Participant* p) {
+        if (!p) return;
+        assert(p->pinDepth == 0 && "Unregistering a pinned thread");
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        orphans.insert(orphans.end(), p->limbo.begin(), p->limbo.end());
+        std::stable_sort(orphans.begin(), orphans.end(),
+                         [](const RetiredObject& a, const RetiredObject& b) { return a.epoch < b.epoch; });
+        participants.erase(std::remove_if(participants.begin(), participants.end(),
+                                          [p](const std::unique_ptr<Participant>& q) { return q.get() == p; }),
+                           participants.end());
+    }
+
+    /**
+     * @brief Pins the current epoch for the calling thread
+     */
+    Guard pin(Participant& p) { return Guard(*this, p); }
+
+    /**
+     * @brief Defers freeing an object until no pinned thread can reach it
+     *
+     * The object must already be unreachable for threads that pin from now on.
+     * Every batch-size retirements the participant attempts a collect().
+     *
+     * @param p The calling thread's participant
+     * @param object The object to free
+     * @param reclaim Function that frees the object
+     * @param context Passed unchanged to reclaim (e.g. the owning allocator)
+     *
+     * Time complexity: amortized O(1) plus O(threads) per batch
+     */
+    void retire(Participant& p, void* object, ReclaimFunction reclaim, void* context = nullptr) {
+        p.limbo.push_back(RetiredObject{object, reclaim, context, globalEpoch.load(std::memory_order_seq_cst)});
+        pending.fetch_add(1, std::memory_order_relaxed);
+        if (++p.retiredSinceCollect >= batchSize) {
+            collect(p);
+        }
+    }
+
+    /**
+     * @brief Re-points a participant's retired objects from one context to another
+     *
+     * For owners that move: objects retired with context oldContext are passed
+     * newContext when reclaimed. Must be called by the participant's thread.
+     *
+     * @param p The calling thread's participant
+     * @param oldContext Context the objects were retired with
+     * @param newContext Context to reclaim them with instead
+     *
+     * Time complexity: O(objects the participant has not reclaimed yet)
+     */
+    void rebindContext(Participant& p, void* oldContext, void* newContext) noexcept {
+        for (RetiredObject& retired : p.limbo) {
+            if (retired.context == oldContext) retired.context = newContext;
+        }
+    }
+
+    /**
+     * @brief Tries to advance the epoch and reclaims what has become safe
+     *
+     * @param p The calling thread's participant
+     * @return Number of objects reclaimed
+     */
+    size_t collect(Participant& p) {
+        p.retiredSinceCollect = 0;
+        tryAdvance();
+        uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+
+        size_t freed = reclaimSafe(p.limbo, epoch);
+        std::unique_lock<std::mutex> lock(registryMutex, std::try_to_lock);
+        if (lock.owns_lock() && !orphans.empty()) {
+            freed += reclaimSafe(orphans, epoch);
+        }
+        return freed;
+    }
+
+    /**
+     * @brief Waits until every object retired by the participant is reclaimed
+     *
+     * Blocks while other threads stay pinned in old epochs. The calling thread
+     * must not be pinned itself.
+     *
+     * @param p The calling thread's participant
+     */
+    void synchronize(Participant& p) {
+        if (p.pinDepth != 0) {
+            throw std::logic_error("EpochManager::synchronize() called from a pinned thread");
+        }
+        while (!p.limbo.empty()) {
+            if (collect(p) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the current global epoch
+     */
+    uint64_t currentEpoch() const noexcept { return globalEpoch.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Returns the number of retired objects not yet reclaimed
+     */
+    size_t pendingCount() const noexcept { return pending.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of registered threads
+     */
+    size_t participantCount() const {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        return participants.size();
+    }
+
+    /**
+     * @brief Returns the total number of objects reclaimed
+     */
+    size_t reclaimedCount() const noexcept { return reclaimed.load(std::memory_order_relaxed); }
+};
+
+} // namespace bptree
+
+#endif // BPLUSTREE_EPOCH_RECLAMATION_H
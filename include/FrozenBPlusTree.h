@@ -0,0 +1,532 @@
+#ifndef BPLUSTREE_FROZEN_H
+#define BPLUSTREE_FROZEN_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace bptree {
+
+namespace detail {
+
+constexpr uint32_t FROZEN_MAGIC = 0x5a465042;  // "BPFZ" in little-endian
+constexpr uint32_t FROZEN_VERSION = 1;
+
+/// Index levels a frozen tree can have; enough for 2^64 entries at the minimum node size
+constexpr size_t FROZEN_MAX_LEVELS = 32;
+
+/**
+ * @brief Header at the start of a FrozenBPlusTree blob
+ *
+ * Offsets are in bytes from the start of the blob. Index level l (0 is the
+ * level just above the entries) starts levelOffset[l] keys into the index
+ * area and holds levelSize[l] keys.
+ */
+struct FrozenHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint64_t count;
+    uint64_t nodeKeys;
+    uint64_t levels;
+    uint64_t keysOffset;
+    uint64_t valuesOffset;
+    uint64_t indexOffset;
+    uint64_t blobSize;
+    uint64_t levelOffset[FROZEN_MAX_LEVELS];
+    uint64_t levelSize[FROZEN_MAX_LEVELS];
+};
+
+} // namespace detail
+
+/**
+ * @brief Immutable, pointer-free B+ tree for read-only data sets
+ *
+ * A frozen tree lives in one contiguous blob: a header, all keys in order,
+ * all values in the same order, and the index levels. Leaves are implicit and
+ * completely full: leaf i is entries [i * nodeKeys, (i + 1) * nodeKeys).
+ * Each index level holds the first key of every node of the level below,
+ * again in nodes of nodeKeys keys, up to a single root node. The child of
+ * the j-th key of a level is node j of the level below, so no pointers,
+ * parent links, vtables or free slots are stored.
+ *
+ * Memory is therefore the raw key and value bytes plus about
+ * sizeof(KeyType) / (nodeKeys - 1) per entry for the index. save() writes
+ * the blob as is, and loadFromFile()/fromBlob() copy it back and check the
+ * header.
+ *
+ * Usage example:
+ * @code
+ * BPlusTree<uint64_t, uint32_t> staging(64);
+ * // ... load reference data ...
+ * auto frozen = FrozenBPlusTree<uint64_t, uint32_t>::build(staging);
+ * frozen.save("reference.frz");
+ * auto again = FrozenBPlusTree<uint64_t, uint32_t>::loadFromFile("reference.frz");
+ * @endcode
+ *
+ * All operations are const and safe to call from any number of threads.
+ *
+ * @tparam KeyType The type of keys (trivially copyable, supports < and ==)
+ * @tparam ValueType The type of values (trivially copyable)
+ */
+template<typename KeyType, typename ValueType>
+class FrozenBPlusTree {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "FrozenBPlusTree stores raw bytes: KeyType must be trivially copyable");
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "FrozenBPlusTree stores raw bytes: ValueType must be trivially copyable");
+    static_assert(alignof(KeyType) <= alignof(std::max_align_t) &&
+                  alignof(ValueType) <= alignof(std::max_align_t),
+                  "FrozenBPlusTree does not support over-aligned keys or values");
+
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+
+    /// Keys per node (leaf or index) unless build() says otherwise
+    static constexpr size_t DEFAULT_NODE_KEYS = 64;
+    /// Smallest node size build() accepts
+    static constexpr size_t MIN_NODE_KEYS = 4;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+private:
+    using Header = detail::FrozenHeader;
+
+    std::vector<unsigned char> blob;  // Header, keys, values and index levels
+
+    const Header& header() const noexcept { return *reinterpret_cast<const Header*>(blob.data()); }
+    const KeyType* keys() const noexcept {
+        return reinterpret_cast<const KeyType*>(blob.data() + header().keysOffset);
+    }
+    const ValueType* values() const noexcept {
+        return reinterpret_cast<const ValueType*>(blob.data() + header().valuesOffset);
+    }
+    const KeyType* level(size_t l) const noexcept {
+        return reinterpret_cast<const KeyType*>(blob.data() + header().indexOffset) + header().levelOffset[l];
+    }
+
+    static size_t alignUp(size_t offset) noexcept {
+        constexpr size_t ALIGN = alignof(std::max_align_t);
+        return (offset + ALIGN - 1) / ALIGN * ALIGN;
+    }
+
+    static Header layout(size_t count, size_t nodeKeys);
+    template<typename Fill>
+    static FrozenBPlusTree assemble(size_t count, size_t nodeKeys, Fill fill);
+    void checkHeader(size_t size) const;
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     */
+    FrozenBPlusTree() {
+        Header h = layout(0, DEFAULT_NODE_KEYS);
+        blob.resize(h.blobSize);
+        std::memcpy(blob.data(), &h, sizeof(h));
+    }
+
+    /**
+     * @brief Freezes the contents of a BPlusTree
+     *
+     * @param tree The tree to copy; it is not modified
+     * @param nodeKeys Keys per leaf and per index node (raised to MIN_NODE_KEYS)
+     *
+     * Time complexity: O(n)
+     */
+    template<typename Allocator>
+    static FrozenBPlusTree build(const BPlusTree<KeyType, ValueType, Allocator>& tree,
+                                 size_t nodeKeys = DEFAULT_NODE_KEYS) {
+        return assemble(tree.size(), nodeKeys, [&](KeyType* k, ValueType* v) {
+            size_t i = 0;
+            for (auto it = tree.begin(); it != tree.end(); ++it, ++i) {
+                k[i] = it->first;
+                v[i] = it->second;
+            }
+        });
+    }
+
+    /**
+     * @brief Freezes a vector of entries sorted by strictly increasing key
+     *
+     * @throws std::invalid_argument If the keys are not strictly increasing
+     *
+     * Time complexity: O(n)
+     */
+    static FrozenBPlusTree build(const std::vector<std::pair<KeyType, ValueType>>& sorted,
+                                 size_t nodeKeys = DEFAULT_NODE_KEYS) {
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            if (!(sorted[i - 1].first < sorted[i].first)) {
+                throw std::invalid_argument("FrozenBPlusTree::build: keys must be strictly increasing");
+            }
+        }
+        return assemble(sorted.size(), nodeKeys, [&](KeyType* k, ValueType* v) {
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                k[i] = sorted[i].first;
+                v[i] = sorted[i].second;
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the index of the first entry with a key not less than key
+     *
+     * Time complexity: O(log n), one binary search per level
+     */
+    size_t lowerBoundIndex(const KeyType& key) const;
+
+    const_iterator lower_bound(const KeyType& key) const { return const_iterator(this, lowerBoundIndex(key)); }
+
+    const_iterator upper_bound(const KeyType& key) const {
+        size_t i = lowerBoundIndex(key);
+        if (i < size() && keys()[i] == key) ++i;
+        return const_iterator(this, i);
+    }
+
+    const_iterator find(const KeyType& key) const {
+        size_t i = lowerBoundIndex(key);
+        return i < size() && keys()[i] == key ? const_iterator(this, i) : end();
+    }
+
+    /**
+     * @brief Searches for a key
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if found
+     * @return true if the key exists
+     */
+    bool search(const KeyType& key, ValueType& value) const {
+        size_t i = lowerBoundIndex(key);
+        if (i == size() || !(keys()[i] == key)) return false;
+        value = values()[i];
+        return true;
+    }
+
+    bool contains(const KeyType& key) const {
+        size_t i = lowerBoundIndex(key);
+        return i < size() && keys()[i] == key;
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        if (end < start) return result;
+        for (size_t i = lowerBoundIndex(start); i < size() && !(end < keys()[i]); ++i) {
+            result.emplace_back(keys()[i], values()[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        for (size_t i = 0; i < size(); ++i) {
+            fn(keys()[i], values()[i]);
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_t size() const noexcept { return static_cast<size_t>(header().count); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Returns the keys per leaf and per index node
+     */
+    size_t nodeKeys() const noexcept { return static_cast<size_t>(header().nodeKeys); }
+
+    /**
+     * @brief Returns the number of levels, counting the leaves (0 if empty)
+     */
+    size_t height() const noexcept {
+        return isEmpty() ? 0 : static_cast<size_t>(header().levels) + 1;
+    }
+
+    /**
+     * @brief Returns the size of the blob, which is all the tree allocates
+     */
+    size_t memoryUsage() const noexcept { return blob.size(); }
+
+    /**
+     * @brief Returns the blob; copying these bytes and passing them to fromBlob() recreates the tree
+     */
+    const unsigned char* data() const noexcept { return blob.data(); }
+
+    /**
+     * @brief Recreates a tree from the bytes returned by data()
+     *
+     * @throws std::runtime_error If the bytes are not a valid blob
+     * @throws std::logic_error If the blob was built for other key or value sizes
+     */
+    static FrozenBPlusTree fromBlob(const void* bytes, size_t size) {
+        FrozenBPlusTree tree;
+        const auto* begin = static_cast<const unsigned char*>(bytes);
+        tree.blob.assign(begin, begin + size);
+        tree.checkHeader(size);
+        return tree;
+    }
+
+    /**
+     * @brief Checks that keys increase and that every index level matches the level below
+     */
+    bool validate() const;
+
+    /**
+     * @brief Writes the blob to a file
+     *
+     * @throws std::runtime_error If the file cannot be opened or written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Reads a tree written by save()
+     *
+     * @throws std::runtime_error If the file cannot be read or is corrupted
+     * @throws std::logic_error If the file was built for other key or value sizes
+     */
+    static FrozenBPlusTree loadFromFile(const std::string& filename);
+
+    /**
+     * @brief Random-access iterator over the entries
+     *
+     * Dereferencing yields a pair of references into the blob.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<KeyType, ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const KeyType&, const ValueType&>;
+
+        /// Result of operator->(), which holds the reference pair
+        struct pointer {
+            reference entry;
+            const reference* operator->() const { return &entry; }
+        };
+
+        const_iterator() : tree(nullptr), index(0) {}
+
+        reference operator*() const { return reference(tree->keys()[index], tree->values()[index]); }
+        pointer operator->() const { return pointer{**this}; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator copy = *this; ++index; return copy; }
+        const_iterator& operator--() { --index; return *this; }
+        const_iterator operator--(int) { const_iterator copy = *this; --index; return copy; }
+        const_iterator& operator+=(difference_type n) { index += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(tree, index + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(tree, index - n); }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index && tree == other.tree; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+        bool operator<(const const_iterator& other) const { return index < other.index; }
+        bool operator>(const const_iterator& other) const { return other < *this; }
+        bool operator<=(const const_iterator& other) const { return !(other < *this); }
+        bool operator>=(const const_iterator& other) const { return !(*this < other); }
+
+    private:
+        friend class FrozenBPlusTree;
+        const FrozenBPlusTree* tree;
+        size_t index;
+
+        const_iterator(const FrozenBPlusTree* t, size_t i) : tree(t), index(i) {}
+    };
+};
+
+// ==================== Building ====================
+
+/**
+ * @brief Computes the header (level sizes and offsets) for count entries
+ */
+template<typename KeyType, typename ValueType>
+detail::FrozenHeader FrozenBPlusTree<KeyType, ValueType>::layout(size_t count, size_t nodeKeys) {
+    Header h{};
+    h.magic = detail::FROZEN_MAGIC;
+    h.version = detail::FROZEN_VERSION;
+    h.keySize = sizeof(KeyType);
+    h.valueSize = sizeof(ValueType);
+    h.count = count;
+    h.nodeKeys = nodeKeys;
+
+    // Each level holds one key per node of the level below, up to a single node
+    size_t below = count;
+    size_t indexKeys = 0;
+    while (below > nodeKeys) {
+        size_t nodes = (below + nodeKeys - 1) / nodeKeys;
+        h.levelOffset[h.levels] = indexKeys;
+        h.levelSize[h.levels] = nodes;
+        h.levels++;
+        indexKeys += nodes;
+        below = nodes;
+    }
+
+    h.keysOffset = alignUp(sizeof(Header));
+    h.valuesOffset = alignUp(h.keysOffset + count * sizeof(KeyType));
+    h.indexOffset = alignUp(h.valuesOffset + count * sizeof(ValueType));
+    h.blobSize = h.indexOffset + indexKeys * sizeof(KeyType);
+    return h;
+}
+
+/**
+ * @brief Allocates the blob, lets fill(keys, values) write the entries and builds the index
+ */
+template<typename KeyType, typename ValueType>
+template<typename Fill>
+FrozenBPlusTree<KeyType, ValueType>
+FrozenBPlusTree<KeyType, ValueType>::assemble(size_t count, size_t nodeKeys, Fill fill) {
+    Header h = layout(count, std::max(nodeKeys, MIN_NODE_KEYS));
+    FrozenBPlusTree tree;
+    tree.blob.resize(h.blobSize);
+    unsigned char* base = tree.blob.data();
+    std::memcpy(base, &h, sizeof(h));
+
+    auto* k = reinterpret_cast<KeyType*>(base + h.keysOffset);
+    fill(k, reinterpret_cast<ValueType*>(base + h.valuesOffset));
+
+    auto* index = reinterpret_cast<KeyType*>(base + h.indexOffset);
+    const KeyType* below = k;
+    for (size_t l = 0; l < h.levels; ++l) {
+        KeyType* keysHere = index + h.levelOffset[l];
+        for (size_t j = 0; j < h.levelSize[l]; ++j) {
+            keysHere[j] = below[j * h.nodeKeys];
+        }
+        below = keysHere;
+    }
+    return tree;
+}
+
+// ==================== Lookup ====================
+
+template<typename KeyType, typename ValueType>
+size_t FrozenBPlusTree<KeyType, ValueType>::lowerBoundIndex(const KeyType& key) const {
+    size_t n = size();
+    if (n == 0) return 0;
+    const Header& h = header();
+    size_t width = static_cast<size_t>(h.nodeKeys);
+
+    // In each index node follow the last key <= key; below the first key, the first child
+    size_t node = 0;
+    for (size_t l = static_cast<size_t>(h.levels); l-- > 0;) {
+        const KeyType* keysHere = level(l);
+        size_t first = node * width;
+        size_t last = std::min(first + width, static_cast<size_t>(h.levelSize[l]));
+        size_t i = static_cast<size_t>(std::upper_bound(keysHere + first, keysHere + last, key) - keysHere);
+        node = i > first ? i - 1 : first;
+    }
+
+    const KeyType* k = keys();
+    size_t first = node * width;
+    size_t last = std::min(first + width, n);
+    return static_cast<size_t>(std::lower_bound(k + first, k + last, key) - k);
+}
+
+// ==================== Validation and Persistence ====================
+
+template<typename KeyType, typename ValueType>
+bool FrozenBPlusTree<KeyType, ValueType>::validate() const {
+    const Header& h = header();
+    const KeyType* k = keys();
+    for (size_t i = 1; i < size(); ++i) {
+        if (!(k[i - 1] < k[i])) return false;
+    }
+    const KeyType* below = k;
+    for (size_t l = 0; l < h.levels; ++l) {
+        const KeyType* keysHere = level(l);
+        for (size_t j = 0; j < h.levelSize[l]; ++j) {
+            if (!(keysHere[j] == below[j * h.nodeKeys])) return false;
+        }
+        below = keysHere;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that the blob holds a consistent header for this tree type
+ */
+template<typename KeyType, typename ValueType>
+void FrozenBPlusTree<KeyType, ValueType>::checkHeader(size_t size) const {
+    if (size < sizeof(Header)) {
+        throw std::runtime_error("Invalid frozen tree: blob too small");
+    }
+    const Header& h = header();
+    if (h.magic != detail::FROZEN_MAGIC) {
+        throw std::runtime_error("Invalid file format: not a frozen B+ tree");
+    }
+    if (h.version != detail::FROZEN_VERSION) {
+        throw std::runtime_error("Incompatible file version: expected " +
+                                 std::to_string(detail::FROZEN_VERSION) +
+                                 ", got " + std::to_string(h.version));
+    }
+    if (h.keySize != sizeof(KeyType) || h.valueSize != sizeof(ValueType)) {
+        throw std::logic_error("Frozen tree was built for " + std::to_string(h.keySize) + "-byte keys and " +
+                               std::to_string(h.valueSize) + "-byte values");
+    }
+    if (h.nodeKeys < MIN_NODE_KEYS || h.count > size) {
+        throw std::runtime_error("Invalid frozen tree: corrupted header");
+    }
+
+    // The layout follows from count and nodeKeys; anything else is corruption
+    Header expected = layout(static_cast<size_t>(h.count), static_cast<size_t>(h.nodeKeys));
+    if (std::memcmp(&expected, &h, sizeof(Header)) != 0 || h.blobSize != size) {
+        throw std::runtime_error("Invalid frozen tree: corrupted header");
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void FrozenBPlusTree<KeyType, ValueType>::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write to file: " + filename);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+FrozenBPlusTree<KeyType, ValueType> FrozenBPlusTree<KeyType, ValueType>::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for reading: " + filename);
+    }
+    std::streamoff size = file.tellg();
+    file.seekg(0);
+
+    FrozenBPlusTree tree;
+    tree.blob.resize(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(tree.blob.data()), size);
+    if (!file) {
+        throw std::runtime_error("Failed to read file: " + filename);
+    }
+    tree.checkHeader(tree.blob.size());
+    return tree;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_FROZEN_H
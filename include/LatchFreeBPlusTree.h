@@ -0,0 +1,754 @@
+#ifndef BPLUSTREE_LATCH_FREE_H
+#define BPLUSTREE_LATCH_FREE_H
+
+#include "Node.h"
+#include "Config.h"
+#include "EpochReclamation.h"
+#include "PersistentBPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <cassert>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief One record of a page's delta chain
+ *
+ * A page is a chain of records ending in a BASE record that owns a regular,
+ * immutable LeafNode. Records are immutable once published.
+ */
+template<typename KeyType, typename ValueType>
+struct DeltaRecord {
+    enum class Kind {
+        INSERT,   ///< key now maps to value
+        DELETE,   ///< key is no longer present
+        SPLIT,    ///< keys >= key moved to page rightPage
+        BASE      ///< consolidated page contents
+    };
+
+    Kind kind;
+    KeyType key{};                              ///< INSERT/DELETE key, SPLIT separator, BASE high key
+    ValueType value{};                          ///< INSERT value
+    DeltaRecord* next = nullptr;                ///< Older record (nullptr for BASE)
+    size_t chainLength = 0;                     ///< Deltas above the base, including this one
+    LeafNode<KeyType, ValueType>* base = nullptr;  ///< BASE contents
+    bool bounded = false;                       ///< BASE: whether key is a high key
+    size_t rightPage = 0;                       ///< SPLIT/bounded BASE: page holding greater keys
+
+    explicit DeltaRecord(Kind k) : kind(k) {}
+
+    ~DeltaRecord() { delete base; }
+};
+
+/**
+ * @brief The epoch participants a thread holds in the trees it has used
+ *
+ * Entries refer to their manager weakly: those of destroyed trees are dropped
+ * on the next lookup, and the rest are unregistered when the thread exits, so
+ * neither this list nor a manager's participant list grows with dead entries.
+ */
+class ThreadRegistrations {
+private:
+    struct Entry {
+        std::weak_ptr<EpochManager> owner;
+        const EpochManager* manager;  // Compared only while owner is alive
+        EpochManager::Participant* participant;
+    };
+
+    std::vector<Entry> entries;
+
+public:
+    ThreadRegistrations() = default;
+    ThreadRegistrations(const ThreadRegistrations&) = delete;
+    ThreadRegistrations& operator=(const ThreadRegistrations&) = delete;
+
+    ~ThreadRegistrations() {
+        for (const Entry& entry : entries) {
+            if (std::shared_ptr<EpochManager> epochs = entry.owner.lock()) {
+                epochs->unregisterThread(entry.participant);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the calling thread's participant in epochs, registering on first use
+     */
+    EpochManager::Participant& participant(const std::shared_ptr<EpochManager>& epochs) {
+        EpochManager::Participant* found = nullptr;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&](const Entry& entry) {
+                                         if (entry.owner.expired()) return true;
+                                         if (entry.manager == epochs.get()) found = entry.participant;
+                                         return false;
+                                     }),
+                      entries.end());
+        if (!found) {
+            found = epochs->registerThread();
+            entries.push_back(Entry{epochs, epochs.get(), found});
+        }
+        return *found;
+    }
+
+    /**
+     * @brief Returns the number of trees the calling thread is registered with
+     */
+    size_t size() const noexcept { return entries.size(); }
+};
+
+/**
+ * @brief Returns the calling thread's registrations
+ */
+inline ThreadRegistrations& threadRegistrations() {
+    thread_local ThreadRegistrations registrations;
+    return registrations;
+}
+
+} // namespace detail
+
+/**
+ * @brief Experimental latch-free B+ tree with Bw-tree-style delta updates
+ *
+ * Leaves are logical pages addressed through a mapping table of atomic
+ * pointers. insert() and remove() never latch a leaf: they prepend an immutable
+ * delta record to the page's chain with a single compare-and-swap, retrying if
+ * another thread got there first. Once a chain grows past the consolidation
+ * threshold, the thread that extended it folds the deltas into a fresh
+ * LeafNode and swaps that in; replaced chains are freed through an
+ * EpochManager once no reader can still be walking them.
+ *
+ * Structure modifications are rare and kept simple: an overfull page is split
+ * under a mutex by publishing the upper half as a new page and installing a
+ * SPLIT delta on the old one, after which the key-to-page routing (a
+ * PersistentBPlusTree version published through an atomic pointer) is updated.
+ * Threads that routed with the old version follow the SPLIT delta. Pages are
+ * never merged; removed entries shrink pages but empty pages stay in place.
+ *
+ * search(), insert(), remove() and rangeQuery() may be called from any number
+ * of threads concurrently. Each thread registers with the tree's epoch manager
+ * on first use and unregisters when it exits.
+ *
+ * @tparam KeyType The type of keys (must be copyable, default constructible and support < and ==)
+ * @tparam ValueType The type of values (must be copyable and default constructible)
+ */
+template<typename KeyType, typename ValueType>
+class LatchFreeBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Default number of deltas a chain may hold before it is consolidated
+     */
+    static constexpr size_t DEFAULT_CONSOLIDATE_THRESHOLD = 8;
+
+private:
+    using Delta = detail::DeltaRecord<KeyType, ValueType>;
+    using Kind = typename Delta::Kind;
+    using Routing = PersistentBPlusTree<KeyType, size_t>;
+    using Entries = std::vector<std::pair<KeyType, ValueType>>;
+
+    // The mapping table grows in chunks so that slots never move
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNKS = 4096;
+
+    // Consolidated view of one page
+    struct PageView {
+        Entries entries;        // Sorted entries below the high key
+        bool bounded = false;   // Whether highKey limits the page
+        KeyType highKey{};
+        size_t rightPage = 0;
+    };
+
+    // Outcome of looking a key up in one page
+    enum class Lookup { FOUND, ABSENT, MOVED };
+
+    size_t maxKeys;               // Entries per page before it splits
+    size_t consolidateThreshold;  // Deltas per chain before consolidation
+
+    std::unique_ptr<std::atomic<std::atomic<Delta*>*>[]> chunks;  // Mapping table
+    size_t pageCount;             // Pages allocated (guarded by smoMutex)
+    std::atomic<const Routing*> routing;  // Separator key -> page id
+    std::mutex smoMutex;          // Serializes splits
+
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> consolidations{0};
+    std::atomic<size_t> splits{0};
+    std::atomic<size_t> casRetries{0};
+
+    // Shared with the thread-local registrations, which only hold it weakly
+    std::shared_ptr<EpochManager> epochs;
+
+    std::atomic<Delta*>& slot(size_t page) const {
+        return chunks[page / CHUNK_SIZE].load(std::memory_order_acquire)[page % CHUNK_SIZE];
+    }
+
+    size_t allocatePage(Delta* contents);
+    EpochManager::Participant& participant();
+    size_t route(const KeyType& key) const;
+    Lookup lookup(const Delta* head, const KeyType& key, ValueType* value, size_t& redirect) const;
+    Delta* findPage(size_t& page, const KeyType& key, ValueType* value, bool& found) const;
+    PageView materialize(const Delta* head) const;
+    Delta* makeBase(const PageView& view) const;
+    void consolidate(EpochManager::Participant& self, size_t page);
+    void split(EpochManager::Participant& self, size_t page);
+    static void freeChain(Delta* head);
+    static void reclaimChain(void* head, void*);
+    static void reclaimRouting(void* version, void*);
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord Maximum entries per page plus one (as for BPlusTree; values
+     *            below MIN_ORDER are raised to MIN_ORDER)
+     * @param threshold Deltas per chain before consolidation (at least 1)
+     */
+    explicit LatchFreeBPlusTree(size_t ord = DEFAULT_ORDER,
+                                size_t threshold = DEFAULT_CONSOLIDATE_THRESHOLD);
+
+    /**
+     * @brief Destroys the tree; no other thread may still be using it
+     */
+    ~LatchFreeBPlusTree();
+
+    LatchFreeBPlusTree(const LatchFreeBPlusTree&) = delete;
+    LatchFreeBPlusTree& operator=(const LatchFreeBPlusTree&) = delete;
+
+    /**
+     * @brief Inserts a key-value pair, replacing the value if the key exists
+     *
+     * @return true if the key was new
+     *
+     * Time complexity: O(log p + c + B) for p pages, chain length c and B keys per page
+     * Thread safety: Lock-free except for the occasional page split
+     */
+    bool insert(const KeyType& key, const ValueType& value);
+
+    /**
+     * @brief Removes a key
+     *
+     * @return true if the key was present
+     *
+     * Thread safety: Lock-free
+     */
+    bool remove(const KeyType& key);
+
+    /**
+     * @brief Searches for a key
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if found
+     * @return true if the key exists
+     *
+     * Thread safety: Wait-free apart from following concurrent splits
+     */
+    bool search(const KeyType& key, ValueType& value);
+
+    /**
+     * @brief Checks if a key exists
+     */
+    bool contains(const KeyType& key) {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Each page is read atomically; pages are not read at a single instant.
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end);
+
+    /**
+     * @brief Returns the number of entries
+     */
+    size_t size() const noexcept { return count.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Checks if the tree is empty
+     */
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Returns the number of chain consolidations performed
+     */
+    size_t consolidationCount() const noexcept { return consolidations.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of page splits performed
+     */
+    size_t splitCount() const noexcept { return splits.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns how often a compare-and-swap lost against another thread
+     */
+    size_t casRetryCount() const noexcept { return casRetries.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of live threads that have used the tree
+     *
+     * Threads register on first use and unregister when they exit.
+     */
+    size_t registeredThreadCount() const { return epochs->participantCount(); }
+
+    /**
+     * @brief Checks page ordering, bounds and the entry count
+     *
+     * Must only be called while no other thread modifies the tree.
+     */
+    bool validate();
+};
+
+// ==================== Page Management Implementation ====================
+
+template<typename KeyType, typename ValueType>
+LatchFreeBPlusTree<KeyType, ValueType>::LatchFreeBPlusTree(size_t ord, size_t threshold)
+    : maxKeys((ord < MIN_ORDER ? MIN_ORDER : ord) - 1),
+      consolidateThreshold(threshold < 1 ? 1 : threshold),
+      chunks(new std::atomic<std::atomic<Delta*>*>[MAX_CHUNKS]),
+      pageCount(0),
+      routing(new Routing()),
+      epochs(new EpochManager()) {
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Page 0 is the leftmost page; splits only ever create pages to its right
+    PageView empty;
+    allocatePage(makeBase(empty));
+}
+
+template<typename KeyType, typename ValueType>
+LatchFreeBPlusTree<KeyType, ValueType>::~LatchFreeBPlusTree() {
+    for (size_t page = 0; page < pageCount; ++page) {
+        freeChain(slot(page).load(std::memory_order_relaxed));
+    }
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+    delete routing.load(std::memory_order_relaxed);
+    // epochs then reclaims whatever is still retired once the last thread
+    // holding it, possibly one that is exiting concurrently, lets go
+}
+
+template<typename KeyType, typename ValueType>
+size_t LatchFreeBPlusTree<KeyType, ValueType>::allocatePage(Delta* contents) {
+    size_t page = pageCount;
+    size_t chunk = page / CHUNK_SIZE;
+    if (chunk >= MAX_CHUNKS) {
+        throw std::length_error("LatchFreeBPlusTree mapping table is full");
+    }
+    if (!chunks[chunk].load(std::memory_order_relaxed)) {
+        std::atomic<Delta*>* slots = new std::atomic<Delta*>[CHUNK_SIZE];
+        for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        chunks[chunk].store(slots, std::memory_order_release);
+    }
+    slot(page).store(contents, std::memory_order_release);
+    pageCount++;
+    return page;
+}
+
+template<typename KeyType, typename ValueType>
+EpochManager::Participant& LatchFreeBPlusTree<KeyType, ValueType>::participant() {
+    return detail::threadRegistrations().participant(epochs);
+}
+
+template<typename KeyType, typename ValueType>
+size_t LatchFreeBPlusTree<KeyType, ValueType>::route(const KeyType& key) const {
+    KeyType separator;
+    size_t page = 0;
+    if (!routing.load(std::memory_order_acquire)->floor(key, separator, page)) {
+        return 0;
+    }
+    return page;
+}
+
+/**
+ * @brief Looks a key up in one page's chain
+ *
+ * The newest record about the key wins. MOVED means the key belongs to the
+ * page stored in redirect.
+ */
+template<typename KeyType, typename ValueType>
+typename LatchFreeBPlusTree<KeyType, ValueType>::Lookup
+LatchFreeBPlusTree<KeyType, ValueType>::lookup(const Delta* head, const KeyType& key,
+                                               ValueType* value, size_t& redirect) const {
+    for (const Delta* d = head; d; d = d->next) {
+        switch (d->kind) {
+            case Kind::INSERT:
+                if (d->key == key) {
+                    if (value) *value = d->value;
+                    return Lookup::FOUND;
+                }
+                break;
+            case Kind::DELETE:
+                if (d->key == key) return Lookup::ABSENT;
+                break;
+            case Kind::SPLIT:
+                if (!(key < d->key)) {
+                    redirect = d->rightPage;
+                    return Lookup::MOVED;
+                }
+                break;
+            case Kind::BASE: {
+                if (d->bounded && !(key < d->key)) {
+                    redirect = d->rightPage;
+                    return Lookup::MOVED;
+                }
+                const LeafNode<KeyType, ValueType>* leaf = d->base;
+                size_t pos = leaf->findKeyPosition(key);
+                if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+                    if (value) *value = leaf->values[pos];
+                    return Lookup::FOUND;
+                }
+                return Lookup::ABSENT;
+            }
+        }
+    }
+    return Lookup::ABSENT;
+}
+
+/**
+ * @brief Finds the page responsible for a key and returns its current chain head
+ *
+ * @param page In: page to start from; out: the responsible page
+ * @param found Set to whether the key is present in the returned chain
+ */
+template<typename KeyType, typename ValueType>
+typename LatchFreeBPlusTree<KeyType, ValueType>::Delta*
+LatchFreeBPlusTree<KeyType, ValueType>::findPage(size_t& page, const KeyType& key,
+                                                 ValueType* value, bool& found) const {
+    for (;;) {
+        Delta* head = slot(page).load(std::memory_order_acquire);
+        size_t redirect = 0;
+        Lookup result = lookup(head, key, value, redirect);
+        if (result != Lookup::MOVED) {
+            found = (result == Lookup::FOUND);
+            return head;
+        }
+        page = redirect;
+    }
+}
+
+/**
+ * @brief Folds a chain into sorted entries plus the page's bounds
+ */
+template<typename KeyType, typename ValueType>
+typename LatchFreeBPlusTree<KeyType, ValueType>::PageView
+LatchFreeBPlusTree<KeyType, ValueType>::materialize(const Delta* head) const {
+    std::vector<const Delta*> deltas;
+    const Delta* base = head;
+    while (base->kind != Kind::BASE) {
+        deltas.push_back(base);
+        base = base->next;
+    }
+
+    PageView view;
+    view.bounded = base->bounded;
+    view.highKey = base->key;
+    view.rightPage = base->rightPage;
+    const LeafNode<KeyType, ValueType>* leaf = base->base;
+    view.entries.reserve(leaf->numKeys + deltas.size());
+    for (size_t i = 0; i < leaf->numKeys; ++i) {
+        view.entries.emplace_back(leaf->keys[i], leaf->values[i]);
+    }
+
+    auto byKey = [](const std::pair<KeyType, ValueType>& entry, const KeyType& key) {
+        return entry.first < key;
+    };
+
+    // Replay the deltas from oldest to newest
+    for (size_t i = deltas.size(); i-- > 0;) {
+        const Delta* d = deltas[i];
+        auto it = std::lower_bound(view.entries.begin(), view.entries.end(), d->key, byKey);
+        bool present = it != view.entries.end() && it->first == d->key;
+        switch (d->kind) {
+            case Kind::INSERT:
+                if (present) {
+                    it->second = d->value;
+                } else {
+                    view.entries.insert(it, std::make_pair(d->key, d->value));
+                }
+                break;
+            case Kind::DELETE:
+                if (present) view.entries.erase(it);
+                break;
+            case Kind::SPLIT:
+                view.entries.erase(it, view.entries.end());
+                view.bounded = true;
+                view.highKey = d->key;
+                view.rightPage = d->rightPage;
+                break;
+            case Kind::BASE:
+                break;
+        }
+    }
+    return view;
+}
+
+template<typename KeyType, typename ValueType>
+typename LatchFreeBPlusTree<KeyType, ValueType>::Delta*
+LatchFreeBPlusTree<KeyType, ValueType>::makeBase(const PageView& view) const {
+    // Pages may exceed maxKeys until they are split, so size the leaf to fit
+    std::unique_ptr<LeafNode<KeyType, ValueType>> leaf(
+        new LeafNode<KeyType, ValueType>(std::max(maxKeys, view.entries.size())));
+    for (const auto& entry : view.entries) {
+        leaf->keys[leaf->numKeys] = entry.first;
+        leaf->values[leaf->numKeys] = entry.second;
+        leaf->numKeys++;
+    }
+
+    Delta* base = new Delta(Kind::BASE);
+    base->base = leaf.release();
+    base->bounded = view.bounded;
+    base->key = view.highKey;
+    base->rightPage = view.rightPage;
+    return base;
+}
+
+/**
+ * @brief Replaces a page's chain with a single consolidated BASE record
+ *
+ * Gives up silently if another thread changes the page meanwhile; the next
+ * update of the page tries again.
+ */
+template<typename KeyType, typename ValueType>
+void LatchFreeBPlusTree<KeyType, ValueType>::consolidate(EpochManager::Participant& self, size_t page) {
+    Delta* head = slot(page).load(std::memory_order_acquire);
+    if (head->kind == Kind::BASE) return;
+
+    PageView view = materialize(head);
+    bool overfull = view.entries.size() > maxKeys;
+    Delta* base = makeBase(view);
+
+    if (!slot(page).compare_exchange_strong(head, base, std::memory_order_acq_rel)) {
+        delete base;
+        return;
+    }
+    consolidations.fetch_add(1, std::memory_order_relaxed);
+    epochs->retire(self, head, &LatchFreeBPlusTree::reclaimChain);
+
+    if (overfull) {
+        split(self, page);
+    }
+}
+
+/**
+ * @brief Moves the upper half of an overfull page to a new page
+ */
+template<typename KeyType, typename ValueType>
+void LatchFreeBPlusTree<KeyType, ValueType>::split(EpochManager::Participant& self, size_t page) {
+    std::lock_guard<std::mutex> lock(smoMutex);
+
+    for (;;) {
+        Delta* head = slot(page).load(std::memory_order_acquire);
+        PageView view = materialize(head);
+        if (view.entries.size() <= maxKeys) return;  // Someone else split it
+
+        size_t splitPoint = view.entries.size() / 2;
+        PageView upper;
+        upper.entries.assign(view.entries.begin() + static_cast<std::ptrdiff_t>(splitPoint),
+                             view.entries.end());
+        upper.bounded = view.bounded;
+        upper.highKey = view.highKey;
+        upper.rightPage = view.rightPage;
+        KeyType separator = upper.entries.front().first;
+
+        // The new page is unreachable until the SPLIT delta is installed
+        size_t rightPage = allocatePage(makeBase(upper));
+
+        Delta* splitDelta = new Delta(Kind::SPLIT);
+        splitDelta->key = separator;
+        splitDelta->rightPage = rightPage;
+        splitDelta->next = head;
+        splitDelta->chainLength = head->chainLength + 1;
+
+        if (!slot(page).compare_exchange_strong(head, splitDelta, std::memory_order_acq_rel)) {
+            // An update slipped in: drop the unpublished page and retry
+            splitDelta->next = nullptr;
+            delete splitDelta;
+            freeChain(slot(rightPage).exchange(nullptr, std::memory_order_relaxed));
+            pageCount--;
+            casRetries.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        splits.fetch_add(1, std::memory_order_relaxed);
+
+        // Publish the new route; readers with the old one follow the SPLIT delta
+        const Routing* oldRouting = routing.load(std::memory_order_acquire);
+        routing.store(new Routing(oldRouting->insert(separator, rightPage)), std::memory_order_release);
+        epochs->retire(self, const_cast<Routing*>(oldRouting), &LatchFreeBPlusTree::reclaimRouting);
+
+        // Fold the SPLIT delta in so the old page drops its upper half
+        head = slot(page).load(std::memory_order_acquire);
+        Delta* base = makeBase(materialize(head));
+        if (slot(page).compare_exchange_strong(head, base, std::memory_order_acq_rel)) {
+            consolidations.fetch_add(1, std::memory_order_relaxed);
+            epochs->retire(self, head, &LatchFreeBPlusTree::reclaimChain);
+        } else {
+            delete base;
+        }
+        return;
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void LatchFreeBPlusTree<KeyType, ValueType>::freeChain(Delta* head) {
+    while (head) {
+        Delta* next = head->next;
+        delete head;
+        head = next;
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void LatchFreeBPlusTree<KeyType, ValueType>::reclaimChain(void* head, void*) {
+    freeChain(static_cast<Delta*>(head));
+}
+
+template<typename KeyType, typename ValueType>
+void LatchFreeBPlusTree<KeyType, ValueType>::reclaimRouting(void* version, void*) {
+    delete static_cast<Routing*>(version);
+}
+
+// ==================== Operation Implementation ====================
+
+template<typename KeyType, typename ValueType>
+bool LatchFreeBPlusTree<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value) {
+    EpochManager::Participant& self = participant();
+    EpochManager::Guard guard(*epochs, self);
+
+    std::unique_ptr<Delta> delta(new Delta(Kind::INSERT));
+    delta->key = key;
+    delta->value = value;
+
+    size_t page = route(key);
+    for (;;) {
+        bool found = false;
+        Delta* head = findPage(page, key, nullptr, found);
+        delta->next = head;
+        delta->chainLength = head->chainLength + 1;
+
+        if (slot(page).compare_exchange_weak(head, delta.get(), std::memory_order_acq_rel)) {
+            size_t length = delta.release()->chainLength;
+            if (!found) count.fetch_add(1, std::memory_order_relaxed);
+            if (length >= consolidateThreshold) {
+                consolidate(self, page);
+            }
+            return !found;
+        }
+        casRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+bool LatchFreeBPlusTree<KeyType, ValueType>::remove(const KeyType& key) {
+    EpochManager::Participant& self = participant();
+    EpochManager::Guard guard(*epochs, self);
+
+    std::unique_ptr<Delta> delta(new Delta(Kind::DELETE));
+    delta->key = key;
+
+    size_t page = route(key);
+    for (;;) {
+        bool found = false;
+        Delta* head = findPage(page, key, nullptr, found);
+        if (!found) return false;
+        delta->next = head;
+        delta->chainLength = head->chainLength + 1;
+
+        if (slot(page).compare_exchange_weak(head, delta.get(), std::memory_order_acq_rel)) {
+            size_t length = delta.release()->chainLength;
+            count.fetch_sub(1, std::memory_order_relaxed);
+            if (length >= consolidateThreshold) {
+                consolidate(self, page);
+            }
+            return true;
+        }
+        casRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+bool LatchFreeBPlusTree<KeyType, ValueType>::search(const KeyType& key, ValueType& value) {
+    EpochManager::Guard guard(*epochs, participant());
+    size_t page = route(key);
+    bool found = false;
+    findPage(page, key, &value, found);
+    return found;
+}
+
+template<typename KeyType, typename ValueType>
+std::vector<std::pair<KeyType, ValueType>>
+LatchFreeBPlusTree<KeyType, ValueType>::rangeQuery(const KeyType& start, const KeyType& end) {
+    std::vector<std::pair<KeyType, ValueType>> result;
+    if (end < start) return result;
+
+    EpochManager::Guard guard(*epochs, participant());
+    size_t page = route(start);
+    bool found = false;
+    findPage(page, start, nullptr, found);
+
+    // Walk pages left to right through their high keys
+    for (;;) {
+        PageView view = materialize(slot(page).load(std::memory_order_acquire));
+        for (const auto& entry : view.entries) {
+            if (entry.first < start) continue;
+            if (end < entry.first) return result;
+            result.push_back(entry);
+        }
+        if (!view.bounded || end < view.highKey) return result;
+        page = view.rightPage;
+    }
+}
+
+template<typename KeyType, typename ValueType>
+bool LatchFreeBPlusTree<KeyType, ValueType>::validate() {
+    EpochManager::Guard guard(*epochs, participant());
+
+    size_t entries = 0;
+    bool first = true;
+    KeyType previous{};
+    size_t page = 0;
+    for (;;) {
+        PageView view = materialize(slot(page).load(std::memory_order_acquire));
+        for (const auto& entry : view.entries) {
+            if (!first && !(previous < entry.first)) {
+                std::cerr << "Keys not sorted across pages at page " << page << std::endl;
+                return false;
+            }
+            if (view.bounded && !(entry.first < view.highKey)) {
+                std::cerr << "Key beyond high key at page " << page << std::endl;
+                return false;
+            }
+            previous = entry.first;
+            first = false;
+            entries++;
+        }
+        if (!view.bounded) break;
+        page = view.rightPage;
+    }
+
+    if (entries != size()) {
+        std::cerr << "Entry count mismatch: " << entries << " vs " << size() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_LATCH_FREE_H
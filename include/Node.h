@@ -1,8 +1,28 @@
 #ifndef BPLUSTREE_NODE_H
 #define BPLUSTREE_NODE_H
 
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Hints the CPU to load the cache line holding address for reading
+ *
+ * A prefetch is only a hint, so the compiler may drop the loads that compute
+ * its address (and the prefetch with them); the empty asm keeps them.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define BPLUSTREE_PREFETCH(address)                                \
+    do {                                                           \
+        const void* bplustreePrefetched = (address);               \
+        __asm__ __volatile__("" : : "r"(bplustreePrefetched));     \
+        __builtin_prefetch(bplustreePrefetched, 0, 3);             \
+    } while (0)
+#else
+#define BPLUSTREE_PREFETCH(address) ((void)(address))
+#endif
 
 namespace bptree {
 
@@ -14,6 +34,48 @@ enum class NodeType {
     LEAF       ///< Leaf node that contains key-value pairs and is linked to adjacent leaves
 };
 
+namespace detail {
+
+/**
+ * @brief Whether values of T can be ordered with operator<
+ */
+template<typename T, typename = void>
+struct IsLessComparable : std::false_type {};
+
+template<typename T>
+struct IsLessComparable<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>>
+    : std::true_type {};
+
+/**
+ * @brief Prefetches every cache line of [data, data + bytes)
+ */
+inline void prefetchBytes(const void* data, std::size_t bytes) {
+    constexpr std::size_t CACHE_LINE = 64;
+    const char* first = static_cast<const char*>(data);
+    for (std::size_t offset = 0; offset < bytes; offset += CACHE_LINE) {
+        BPLUSTREE_PREFETCH(first + offset);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Whether leaves keep a min/max zone map of values of type ValueType
+ *
+ * A zone map lets BPlusTree::scanWhere() skip leaves whose values cannot
+ * match, but it costs two value copies per leaf and a little work on every
+ * write. It is kept by default for arithmetic values only; specialize this
+ * template in namespace bptree to opt another type with operator< in, or to
+ * opt a type out:
+ * @code
+ * namespace bptree {
+ * template<> struct ZoneMapTraits<std::string> : std::true_type {};
+ * }
+ * @endcode
+ */
+template<typename ValueType>
+struct ZoneMapTraits : std::is_arithmetic<ValueType> {};
+
 // Forward declarations
 template<typename KeyType, typename ValueType>
 class InternalNode;
@@ -38,6 +100,7 @@ public:
     std::vector<KeyType> keys;  ///< Array of keys (sorted)
     Node* parent;            ///< Pointer to parent node (nullptr for root)
     size_t maxKeys;          ///< Maximum number of keys this node can hold
+    size_t version;          ///< Tree write version that created this node (copy-on-write)
 
     /**
      * @brief Constructs a node with the specified type and maximum capacity
@@ -46,7 +109,7 @@ public:
      * @param maxK Maximum number of keys (order - 1)
      */
     Node(NodeType t, size_t maxK)
-        : type(t), numKeys(0), parent(nullptr), maxKeys(maxK) {
+        : type(t), numKeys(0), parent(nullptr), maxKeys(maxK), version(0) {
         // Pre-allocate to maxKeys + 1 to handle overflow during splits
         keys.resize(maxK + 1);
     }
@@ -295,9 +358,22 @@ public:
 template<typename KeyType, typename ValueType>
 class LeafNode : public Node<KeyType, ValueType> {
 public:
+    /**
+     * @brief Whether leaves keep a min/max zone map of their values
+     *
+     * Only values ordered by operator< and enabled by ZoneMapTraits have one;
+     * otherwise the zone map is never valid and takes a single byte per bound.
+     */
+    static constexpr bool HAS_ZONE_MAP =
+        ZoneMapTraits<ValueType>::value && detail::IsLessComparable<ValueType>::value;
+    using ZoneValue = typename std::conditional<HAS_ZONE_MAP, ValueType, char>::type;
+
     std::vector<ValueType> values;  ///< Array of values corresponding to keys
     LeafNode* next;                 ///< Pointer to next leaf in linked list (for range queries)
     LeafNode* prev;                 ///< Pointer to previous leaf in linked list (for reverse traversal)
+    bool zoneValid;                 ///< Whether zoneMin/zoneMax bound every value in the leaf
+    ZoneValue zoneMin;              ///< No value is below this while zoneValid (may be loose)
+    ZoneValue zoneMax;              ///< No value is above this while zoneValid (may be loose)
 
     /**
      * @brief Constructs a leaf node
@@ -308,7 +384,7 @@ public:
      */
     LeafNode(size_t maxKeys)
         : Node<KeyType, ValueType>(NodeType::LEAF, maxKeys),
-          next(nullptr), prev(nullptr) {
+          next(nullptr), prev(nullptr), zoneValid(false), zoneMin(), zoneMax() {
         // Pre-allocate to maxKeys + 1 to handle overflow during splits
         values.resize(maxKeys + 1);
     }
@@ -318,6 +394,50 @@ public:
      */
     ~LeafNode() override = default;
 
+    /**
+     * @brief Prefetches the leaves a forward scan reaches next
+     *
+     * Requests the node `distance` leaves ahead and the key and value arrays
+     * of the leaf before it (of the next leaf when distance is 1). Leaves
+     * under the same parent are found through its child array, so the
+     * requests do not wait on one another the way chasing next pointers
+     * would; only past the parent's last child are next pointers followed,
+     * through nodes that earlier calls already requested.
+     *
+     * @param distance How many leaves ahead to prefetch (0 does nothing)
+     */
+    void prefetchAhead(std::size_t distance) const {
+        if (distance == 0) return;
+
+        // This leaf's slot in its parent, if the parent is known
+        const auto* siblings = static_cast<const InternalNode<KeyType, ValueType>*>(this->parent);
+        std::size_t index = 0;
+        std::size_t last = 0;
+        if (siblings) {
+            last = siblings->numKeys;
+            while (index <= last && siblings->children[index] != this) ++index;
+            if (index > last) siblings = nullptr;
+        }
+        auto ahead = [&](std::size_t steps) -> const LeafNode* {
+            const LeafNode* leaf = this;
+            if (siblings) {
+                std::size_t jump = steps < last - index ? steps : last - index;
+                leaf = static_cast<const LeafNode*>(siblings->children[index + jump]);
+                steps -= jump;
+            }
+            for (; steps > 0 && leaf; --steps) leaf = leaf->next;
+            return leaf;
+        };
+
+        if (const LeafNode* target = ahead(distance)) {
+            detail::prefetchBytes(target, sizeof(LeafNode));
+        }
+        if (const LeafNode* before = ahead(distance > 1 ? distance - 1 : 1)) {
+            detail::prefetchBytes(before->keys.data(), before->numKeys * sizeof(KeyType));
+            detail::prefetchBytes(before->values.data(), before->numKeys * sizeof(ValueType));
+        }
+    }
+
     /**
      * @brief Inserts a key-value pair at the specified position (copy version)
      *
@@ -343,6 +463,7 @@ public:
         values[pos] = value;
 
         this->numKeys++;
+        noteInsertedValue(pos);
     }
 
     /**
@@ -371,6 +492,7 @@ public:
         values[pos] = std::move(value);
 
         this->numKeys++;
+        noteInsertedValue(pos);
     }
 
     /**
@@ -383,6 +505,12 @@ public:
      * Time complexity: O(numKeys)
      */
     void removeAt(size_t pos) {
+        // Only removing a bound of the zone map can tighten it
+        bool boundary = false;
+        if constexpr (HAS_ZONE_MAP) {
+            boundary = zoneValid && (!(zoneMin < values[pos]) || !(values[pos] < zoneMax));
+        }
+
         // Shift keys (using parent class method)
         this->removeKeyAt(pos);
 
@@ -390,6 +518,61 @@ public:
         for (size_t i = pos; i < this->numKeys; ++i) {
             values[i] = std::move(values[i + 1]);
         }
+
+        if (boundary || this->numKeys == 0) {
+            rebuildZone();
+        }
+    }
+
+    /**
+     * @brief Widens the zone map to cover a value stored in the leaf
+     *
+     * Call after overwriting a value in place. The zone map stays valid but
+     * may become loose; removeAt() and rebuildZone() tighten it again.
+     *
+     * Time complexity: O(1)
+     */
+    void widenZone(const ValueType& value) {
+        if constexpr (HAS_ZONE_MAP) {
+            if (!zoneValid) return;
+            if (value < zoneMin) zoneMin = value;
+            if (zoneMax < value) zoneMax = value;
+        }
+    }
+
+    /**
+     * @brief widenZone() for cleanup paths that must not throw
+     *
+     * If widening throws, the zone map is dropped instead (zoneValid = false),
+     * which stops scans from skipping the leaf until rebuildZone().
+     */
+    void widenZoneNoThrow(const ValueType& value) noexcept {
+        try {
+            widenZone(value);
+        } catch (...) {
+            zoneValid = false;
+        }
+    }
+
+    /**
+     * @brief Recomputes the zone map from the values
+     *
+     * Call after writing values[] directly (splits, merges, bulk building).
+     * An empty leaf has no valid zone map.
+     *
+     * Time complexity: O(numKeys)
+     */
+    void rebuildZone() {
+        if constexpr (HAS_ZONE_MAP) {
+            zoneValid = this->numKeys > 0;
+            if (!zoneValid) return;
+            zoneMin = values[0];
+            zoneMax = values[0];
+            for (size_t i = 1; i < this->numKeys; ++i) {
+                if (values[i] < zoneMin) zoneMin = values[i];
+                if (zoneMax < values[i]) zoneMax = values[i];
+            }
+        }
     }
 
     /**
@@ -413,6 +596,16 @@ public:
         }
         return false;
     }
+
+private:
+    // Keeps the zone map covering a value just placed at pos by insertAt()
+    void noteInsertedValue(size_t pos) {
+        if (this->numKeys == 1) {
+            rebuildZone();
+        } else {
+            widenZone(values[pos]);
+        }
+    }
 };
 
 } // namespace bptree
@@ -0,0 +1,460 @@
+#ifndef BPLUSTREE_PAGE_IO_H
+#define BPLUSTREE_PAGE_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define BPLUSTREE_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+/**
+ * @file PageIO.h
+ * @brief Page read backends for DiskBPlusTree
+ */
+
+namespace bptree {
+
+/**
+ * @brief How DiskBPlusTree issues batched page reads
+ */
+enum class IOBackend {
+    AUTO,         ///< io_uring if the kernel supports it, otherwise THREAD_POOL
+    IO_URING,     ///< One io_uring submission per batch (Linux 5.6+)
+    THREAD_POOL,  ///< Worker threads issuing pread in parallel
+    SYNC          ///< pread one page at a time on the calling thread
+};
+
+namespace detail {
+
+/**
+ * @brief Reads exactly count bytes at offset, zero-filling past the end of the file
+ */
+inline void readPage(int fd, char* buffer, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t n = ::pread(fd, buffer + done, count - done, offset + static_cast<off_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to read page: " + std::string(std::strerror(errno)));
+        }
+        if (n == 0) {
+            std::memset(buffer + done, 0, count - done);
+            return;
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+/**
+ * @brief Writes exactly count bytes at offset
+ */
+inline void writePage(int fd, const char* buffer, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t n = ::pwrite(fd, buffer + done, count - done, offset + static_cast<off_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write page: " + std::string(std::strerror(errno)));
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+/**
+ * @brief One page read in a batch
+ */
+struct ReadRequest {
+    int fd;
+    char* buffer;
+    size_t length;
+    off_t offset;
+};
+
+/**
+ * @brief Issues a batch of page reads and waits for all of them
+ */
+class PageReader {
+public:
+    virtual ~PageReader() = default;
+
+    /**
+     * @brief Reads every request; reads past the end of the file are zero-filled
+     * @throws std::runtime_error If any read fails
+     */
+    virtual void readBatch(const std::vector<ReadRequest>& requests) = 0;
+
+    /**
+     * @brief Returns the backend actually in use
+     */
+    virtual IOBackend backend() const noexcept = 0;
+};
+
+/**
+ * @brief Reads pages one after another with pread
+ */
+class SyncPageReader : public PageReader {
+public:
+    void readBatch(const std::vector<ReadRequest>& requests) override {
+        for (const ReadRequest& request : requests) {
+            readPage(request.fd, request.buffer, request.length, request.offset);
+        }
+    }
+
+    IOBackend backend() const noexcept override { return IOBackend::SYNC; }
+};
+
+/**
+ * @brief Reads pages with pread on a fixed set of worker threads
+ *
+ * Keeps up to one read per worker in flight, so a batch of N pages costs
+ * about N / workers device round trips instead of N.
+ */
+class ThreadPoolPageReader : public PageReader {
+public:
+    explicit ThreadPoolPageReader(size_t workerCount) : remaining(0), stopping(false) {
+        size_t count = std::max<size_t>(1, workerCount);
+        workers.reserve(count);
+        try {
+            for (size_t i = 0; i < count; ++i) {
+                workers.emplace_back([this] { run(); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~ThreadPoolPageReader() override { stop(); }
+
+    ThreadPoolPageReader(const ThreadPoolPageReader&) = delete;
+    ThreadPoolPageReader& operator=(const ThreadPoolPageReader&) = delete;
+
+    void readBatch(const std::vector<ReadRequest>& requests) override {
+        if (requests.empty()) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (const ReadRequest& request : requests) {
+            queue.push_back(request);
+        }
+        remaining = requests.size();
+        error = nullptr;
+        wakeup.notify_all();
+        finished.wait(lock, [this] { return remaining == 0; });
+        if (error) std::rethrow_exception(error);
+    }
+
+    IOBackend backend() const noexcept override { return IOBackend::THREAD_POOL; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;                  // Guards the fields below
+    std::condition_variable wakeup;
+    std::condition_variable finished;
+    std::deque<ReadRequest> queue;
+    size_t remaining;                  // Reads of the current batch not yet done
+    std::exception_ptr error;          // First failure in the current batch
+    bool stopping;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wakeup.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            ReadRequest request = queue.front();
+            queue.pop_front();
+
+            lock.unlock();
+            std::exception_ptr failure;
+            try {
+                readPage(request.fd, request.buffer, request.length, request.offset);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            lock.lock();
+
+            if (failure && !error) error = failure;
+            if (--remaining == 0) finished.notify_all();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+};
+
+#ifdef BPLUSTREE_HAS_IO_URING
+
+/**
+ * @brief Reads pages through an io_uring submission and completion queue
+ *
+ * Talks to the kernel with the raw io_uring_setup and io_uring_enter system
+ * calls, so it needs no liburing. A batch is placed in the submission queue
+ * and submitted with one io_uring_enter call. Completions are then reaped as
+ * they arrive. A read that fails or comes back short (for example on a
+ * kernel without IORING_OP_READ) is redone with pread. If io_uring_enter
+ * itself fails, every read already handed to the kernel is waited out before
+ * the error is thrown, so no read lands in a buffer the caller has reused.
+ */
+class IoUringPageReader : public PageReader {
+public:
+    /**
+     * @brief Sets up a ring with the given queue depth
+     * @return nullptr if the kernel refuses io_uring
+     */
+    static std::unique_ptr<IoUringPageReader> create(unsigned depth) {
+        std::unique_ptr<IoUringPageReader> reader(new IoUringPageReader());
+        if (!reader->setup(depth)) return nullptr;
+        return reader;
+    }
+
+    ~IoUringPageReader() override { closeRing(); }
+
+    IoUringPageReader(const IoUringPageReader&) = delete;
+    IoUringPageReader& operator=(const IoUringPageReader&) = delete;
+
+    void readBatch(const std::vector<ReadRequest>& requests) override {
+        if (ringFd < 0) {
+            // The ring was closed after a failure it could not recover from
+            for (const ReadRequest& request : requests) {
+                readPage(request.fd, request.buffer, request.length, request.offset);
+            }
+            return;
+        }
+
+        size_t submitted = 0;
+        size_t completed = 0;
+        std::vector<size_t> retry;
+
+        while (completed < requests.size()) {
+            // Queue as many reads as the ring and the completion queue allow
+            unsigned tail = *sqTail;
+            unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            while (submitted < requests.size() && tail - head < sqEntries &&
+                   submitted - completed < sqEntries) {
+                const ReadRequest& request = requests[submitted];
+                unsigned slot = tail & *sqMask;
+                io_uring_sqe* sqe = &sqes[slot];
+                std::memset(sqe, 0, sizeof(*sqe));
+                sqe->opcode = IORING_OP_READ;
+                sqe->fd = request.fd;
+                sqe->addr = reinterpret_cast<uint64_t>(request.buffer);
+                sqe->len = static_cast<uint32_t>(request.length);
+                sqe->off = static_cast<uint64_t>(request.offset);
+                sqe->user_data = submitted;
+                sqArray[slot] = slot;
+                tail++;
+                submitted++;
+            }
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+            unsigned pending = tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            if (enter(pending) < 0) {
+                if (errno == EAGAIN || errno == EBUSY) {
+                    // Out of kernel resources or completion space: reap below, then submit again
+                    std::this_thread::yield();
+                } else if (errno != EINTR) {
+                    int error = errno;
+                    abandon(submitted - completed);
+                    throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(error)));
+                }
+            }
+
+            completed += reap([&requests, &retry](size_t index, int res) {
+                if (res < 0 || static_cast<size_t>(res) < requests[index].length) {
+                    retry.push_back(index);
+                }
+            });
+        }
+
+        for (size_t index : retry) {
+            const ReadRequest& request = requests[index];
+            readPage(request.fd, request.buffer, request.length, request.offset);
+        }
+    }
+
+    IOBackend backend() const noexcept override { return IOBackend::IO_URING; }
+
+private:
+    int ringFd = -1;
+    unsigned sqEntries = 0;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    IoUringPageReader() = default;
+
+    long enter(unsigned toSubmit) noexcept {
+        return ::syscall(__NR_io_uring_enter, ringFd, toSubmit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+
+    // Pops every completion in the queue, passing fn each one's request index and result
+    template<typename Function>
+    size_t reap(Function fn) {
+        unsigned cqh = *cqHead;
+        unsigned cqt = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        size_t count = 0;
+        for (; cqh != cqt; ++cqh, ++count) {
+            const io_uring_cqe& cqe = cqes[cqh & *cqMask];
+            fn(static_cast<size_t>(cqe.user_data), cqe.res);
+        }
+        __atomic_store_n(cqHead, cqh, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /**
+     * @brief Settles the outstanding reads of a batch that failed to submit
+     *
+     * Reads the kernel has not consumed yet are withdrawn from the submission
+     * queue; the rest are waited for and their completions dropped, so none
+     * is left for the next batch. If even waiting fails, the ring is closed
+     * and later batches use pread.
+     */
+    void abandon(size_t outstanding) noexcept {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        outstanding -= *sqTail - head;
+        __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+
+        for (;;) {
+            outstanding -= reap([](size_t, int) {});
+            if (outstanding == 0) return;
+            if (enter(0) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                closeRing();
+                return;
+            }
+        }
+    }
+
+    void closeRing() noexcept {
+        if (sqes) ::munmap(sqes, sqesSize);
+        if (cqRing && cqRing != sqRing) ::munmap(cqRing, cqRingSize);
+        if (sqRing) ::munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) ::close(ringFd);
+        sqes = nullptr;
+        cqRing = sqRing = nullptr;
+        ringFd = -1;
+    }
+
+    bool setup(unsigned depth) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        long fd = ::syscall(__NR_io_uring_setup, std::max(depth, 1u), &params);
+        if (fd < 0) return false;
+        ringFd = static_cast<int>(fd);
+        sqEntries = params.sq_entries;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+        void* sq = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ringFd, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED) return false;
+        sqRing = sq;
+
+        if (single) {
+            cqRing = sqRing;
+        } else {
+            void* cq = ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              ringFd, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED) return false;
+            cqRing = cq;
+        }
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* entries = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               ringFd, IORING_OFF_SQES);
+        if (entries == MAP_FAILED) return false;
+        sqes = static_cast<io_uring_sqe*>(entries);
+
+        char* sqBase = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sqBase + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sqBase + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sqBase + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sqBase + params.sq_off.array);
+
+        char* cqBase = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cqBase + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cqBase + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cqBase + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+        return true;
+    }
+};
+
+#endif // BPLUSTREE_HAS_IO_URING
+
+/**
+ * @brief Creates a page reader for a backend
+ *
+ * @param backend The requested backend; AUTO picks io_uring when available
+ * @param depth Reads the backend should keep in flight
+ * @throws std::runtime_error If IO_URING is requested but unavailable
+ */
+inline std::unique_ptr<PageReader> makePageReader(IOBackend backend, size_t depth) {
+    unsigned queueDepth = static_cast<unsigned>(std::min<size_t>(std::max<size_t>(depth, 1), 4096));
+    switch (backend) {
+    case IOBackend::SYNC:
+        return std::unique_ptr<PageReader>(new SyncPageReader());
+    case IOBackend::THREAD_POOL:
+        return std::unique_ptr<PageReader>(new ThreadPoolPageReader(std::min<size_t>(queueDepth, 16)));
+    case IOBackend::IO_URING:
+    case IOBackend::AUTO:
+#ifdef BPLUSTREE_HAS_IO_URING
+        if (auto ring = IoUringPageReader::create(queueDepth)) {
+            return std::unique_ptr<PageReader>(ring.release());
+        }
+#endif
+        if (backend == IOBackend::IO_URING) {
+            throw std::runtime_error("io_uring is not available on this system");
+        }
+        return std::unique_ptr<PageReader>(new ThreadPoolPageReader(std::min<size_t>(queueDepth, 16)));
+    }
+    return std::unique_ptr<PageReader>(new SyncPageReader());
+}
+
+} // namespace detail
+
+} // namespace bptree
+
+#endif // BPLUSTREE_PAGE_IO_H
@@ -0,0 +1,770 @@
+#ifndef BPLUSTREE_PERSISTENT_H
+#define BPLUSTREE_PERSISTENT_H
+
+#include "Node.h"
+#include "Config.h"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <unordered_set>
+#include <cassert>
+
+namespace bptree {
+
+namespace detail {
+
+/**
+ * @brief Leaf node owned by one or more persistent tree versions
+ *
+ * Persistent nodes are never linked to their neighbours or parents, because
+ * a shared node has a different neighbour and parent in every version.
+ */
+template<typename KeyType, typename ValueType>
+class PersistentLeafNode : public LeafNode<KeyType, ValueType> {
+public:
+    explicit PersistentLeafNode(size_t maxKeys) : LeafNode<KeyType, ValueType>(maxKeys) {}
+
+    PersistentLeafNode(const PersistentLeafNode& other) : LeafNode<KeyType, ValueType>(other) {
+        this->next = nullptr;
+        this->prev = nullptr;
+        this->parent = nullptr;
+    }
+};
+
+/**
+ * @brief Internal node owned by one or more persistent tree versions
+ *
+ * Keeps the regular raw child pointers for navigation and holds the owning
+ * references in the parallel owned array. Slots past the last child are null
+ * in both arrays.
+ */
+template<typename KeyType, typename ValueType>
+class PersistentInternalNode : public InternalNode<KeyType, ValueType> {
+public:
+    std::vector<std::shared_ptr<const Node<KeyType, ValueType>>> owned;  ///< Owning references, parallel to children
+
+    explicit PersistentInternalNode(size_t maxKeys)
+        : InternalNode<KeyType, ValueType>(maxKeys), owned(maxKeys + 3) {}
+
+    PersistentInternalNode(const PersistentInternalNode& other) = default;
+
+    /**
+     * @brief Replaces the child at the given position
+     */
+    void setChild(size_t pos, std::shared_ptr<const Node<KeyType, ValueType>> child) {
+        this->children[pos] = const_cast<Node<KeyType, ValueType>*>(child.get());
+        owned[pos] = std::move(child);
+    }
+
+    /**
+     * @brief Inserts a child after insertKeyAt() has added its separator
+     *
+     * Unlike InternalNode::insertChildAt() this never writes the child's
+     * parent pointer, since the child may be shared with other versions.
+     */
+    void insertSharedChildAt(size_t pos, std::shared_ptr<const Node<KeyType, ValueType>> child) {
+        for (size_t i = this->numKeys; i > pos; --i) {
+            this->children[i] = this->children[i - 1];
+            owned[i] = std::move(owned[i - 1]);
+        }
+        setChild(pos, std::move(child));
+    }
+
+    /**
+     * @brief Removes a child before removeKeyAt() drops its separator
+     */
+    void removeSharedChildAt(size_t pos) {
+        size_t numChildren = this->numKeys + 1;
+        for (size_t i = pos; i < numChildren - 1; ++i) {
+            this->children[i] = this->children[i + 1];
+            owned[i] = std::move(owned[i + 1]);
+        }
+        this->children[numChildren - 1] = nullptr;
+        owned[numChildren - 1].reset();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Immutable B+ tree whose updates return new versions
+ *
+ * insert() and remove() leave the tree they are called on untouched and return
+ * a new version. The new version copies only the nodes on the root-to-leaf path
+ * of the change (plus a sibling when rebalancing), and shares every other node
+ * with the old version, so a version costs O(log n) nodes. Nodes are reference
+ * counted and freed when the last version that reaches them is destroyed.
+ *
+ * Nodes use the regular Node.h layout and follow the same split point, borrow
+ * and merge rules as BPlusTree. Since versions are immutable, any number of
+ * threads may read and derive versions from the same tree concurrently.
+ *
+ * Usage example:
+ * @code
+ * PersistentBPlusTree<std::string, int> v1;
+ * auto v2 = v1.insert("timeout", 30);
+ * auto v3 = v2.insert("retries", 5);   // v2 still holds only "timeout"
+ * auto undo = v2;                      // O(1) fork
+ * @endcode
+ *
+ * @tparam KeyType The type of keys (must be copyable and support < and ==)
+ * @tparam ValueType The type of values (must be copyable)
+ */
+template<typename KeyType, typename ValueType>
+class PersistentBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+
+private:
+    using BaseNode = Node<KeyType, ValueType>;
+    using Leaf = detail::PersistentLeafNode<KeyType, ValueType>;
+    using Internal = detail::PersistentInternalNode<KeyType, ValueType>;
+    using NodePtr = std::shared_ptr<const BaseNode>;
+    using MutableNodePtr = std::shared_ptr<BaseNode>;
+
+    NodePtr root;        // Root of this version (nullptr if empty)
+    size_t order;        // Maximum number of children per node
+    size_t maxKeys;      // Maximum keys per node (order - 1)
+    size_t minKeys;      // Minimum keys per non-root node
+    size_t count;        // Number of entries in this version
+
+    // Result of inserting into a subtree that had to split
+    struct SplitResult {
+        NodePtr right;
+        KeyType separator{};
+        bool split = false;
+    };
+
+    PersistentBPlusTree(NodePtr r, size_t ord, size_t cnt)
+        : root(std::move(r)), order(ord), maxKeys(ord - 1), minKeys((ord + 1) / 2 - 1), count(cnt) {}
+
+    // Path copying
+    MutableNodePtr copyNode(const BaseNode* node) const;
+    MutableNodePtr insertInto(const BaseNode* node, const KeyType& key, const ValueType& value,
+                              SplitResult& split, bool& replaced) const;
+    MutableNodePtr removeFrom(const BaseNode* node, const KeyType& key) const;
+
+    // Structural changes on freshly copied nodes
+    void splitLeaf(Leaf& leaf, SplitResult& split) const;
+    void splitInternal(Internal& node, SplitResult& split) const;
+    void rebalanceChild(Internal& parent, size_t index, const MutableNodePtr& child) const;
+    void borrowFromLeft(BaseNode& node, BaseNode& left, Internal& parent, size_t separatorIndex) const;
+    void borrowFromRight(BaseNode& node, BaseNode& right, Internal& parent, size_t separatorIndex) const;
+    void mergeNodes(BaseNode& left, const BaseNode& right, Internal& parent, size_t separatorIndex) const;
+
+    // Read helpers
+    void collectRange(const BaseNode* node, const KeyType& start, const KeyType& end,
+                      std::vector<std::pair<KeyType, ValueType>>& result) const;
+    template<typename Function>
+    static void visit(const BaseNode* node, Function& fn);
+    static void collectNodes(const BaseNode* node, std::unordered_set<const BaseNode*>& nodes);
+    static bool floorIn(const BaseNode* node, const KeyType& key, KeyType& foundKey, ValueType& value);
+    bool validateNode(const BaseNode* node, int level, int& leafLevel) const;
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The maximum number of children per node. Values below
+     *            MIN_ORDER are raised to MIN_ORDER.
+     */
+    explicit PersistentBPlusTree(size_t ord = DEFAULT_ORDER)
+        : PersistentBPlusTree(nullptr, ord < MIN_ORDER ? MIN_ORDER : ord, 0) {}
+
+    /**
+     * @brief Copies a version in O(1); both copies share all nodes
+     */
+    PersistentBPlusTree(const PersistentBPlusTree&) = default;
+    PersistentBPlusTree& operator=(const PersistentBPlusTree&) = default;
+    PersistentBPlusTree(PersistentBPlusTree&&) noexcept = default;
+    PersistentBPlusTree& operator=(PersistentBPlusTree&&) noexcept = default;
+
+    /**
+     * @brief Returns a new version with the key inserted or its value replaced
+     *
+     * @param key The key to insert
+     * @param value The value to associate with the key
+     * @return The new version; this version is unchanged
+     *
+     * Time complexity: O(B log n) for B keys per node (copies one node per level)
+     * Exception safety: Strong guarantee
+     */
+    PersistentBPlusTree insert(const KeyType& key, const ValueType& value) const;
+
+    /**
+     * @brief Returns a new version without the key
+     *
+     * @param key The key to remove
+     * @return The new version, or a copy of this version if the key is absent
+     *
+     * Time complexity: O(B log n)
+     * Exception safety: Strong guarantee
+     */
+    PersistentBPlusTree remove(const KeyType& key) const;
+
+    /**
+     * @brief Searches for a key
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if found
+     * @return true if the key exists in this version
+     *
+     * Time complexity: O(log n)
+     */
+    bool search(const KeyType& key, ValueType& value) const;
+
+    /**
+     * @brief Finds the entry with the greatest key not greater than key
+     *
+     * @param key The key to search for
+     * @param foundKey Output parameter set to the entry's key if found
+     * @param value Output parameter set to the entry's value if found
+     * @return false if every key in this version is greater than key
+     *
+     * Time complexity: O(log n)
+     */
+    bool floor(const KeyType& key, KeyType& foundKey, ValueType& value) const {
+        return root && floorIn(root.get(), key, foundKey, value);
+    }
+
+    /**
+     * @brief Checks if a key exists in this version
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Time complexity: O(log n + k) where k is the result size
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const;
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order
+     *
+     * Time complexity: O(n)
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        if (root) visit(root.get(), fn);
+    }
+
+    /**
+     * @brief Returns the number of entries in this version
+     */
+    size_t size() const noexcept { return count; }
+
+    /**
+     * @brief Checks if this version is empty
+     */
+    bool isEmpty() const noexcept { return root == nullptr; }
+
+    /**
+     * @brief Returns the order of the tree
+     */
+    size_t getOrder() const noexcept { return order; }
+
+    /**
+     * @brief Returns the height of the tree (0 if empty)
+     */
+    size_t height() const;
+
+    /**
+     * @brief Returns the number of nodes reachable from this version
+     *
+     * Time complexity: O(n/B)
+     */
+    size_t nodeCount() const;
+
+    /**
+     * @brief Returns how many of this version's nodes are also used by another version
+     *
+     * Useful to check the memory a fork or an update history really costs.
+     *
+     * Time complexity: O(n/B)
+     */
+    size_t sharedNodeCount(const PersistentBPlusTree& other) const;
+
+    /**
+     * @brief Checks the B+ tree invariants of this version
+     *
+     * @return true if keys are sorted, nodes are within their fill bounds and
+     *         all leaves are at the same depth
+     */
+    bool validate() const;
+};
+
+// ==================== Path Copying Implementation ====================
+
+template<typename KeyType, typename ValueType>
+typename PersistentBPlusTree<KeyType, ValueType>::MutableNodePtr
+PersistentBPlusTree<KeyType, ValueType>::copyNode(const BaseNode* node) const {
+    if (node->isLeaf()) {
+        return std::make_shared<Leaf>(*static_cast<const Leaf*>(node));
+    }
+    return std::make_shared<Internal>(*static_cast<const Internal*>(node));
+}
+
+template<typename KeyType, typename ValueType>
+PersistentBPlusTree<KeyType, ValueType>
+PersistentBPlusTree<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value) const {
+    if (!root) {
+        auto leaf = std::make_shared<Leaf>(maxKeys);
+        leaf->insertAt(0, key, value);
+        return PersistentBPlusTree(std::move(leaf), order, 1);
+    }
+
+    SplitResult split;
+    bool replaced = false;
+    NodePtr newRoot = insertInto(root.get(), key, value, split, replaced);
+
+    // Root split: the tree grows by one level
+    if (split.split) {
+        auto internal = std::make_shared<Internal>(maxKeys);
+        internal->keys[0] = split.separator;
+        internal->numKeys = 1;
+        internal->setChild(0, std::move(newRoot));
+        internal->setChild(1, std::move(split.right));
+        newRoot = std::move(internal);
+    }
+
+    return PersistentBPlusTree(std::move(newRoot), order, replaced ? count : count + 1);
+}
+
+/**
+ * @brief Copies the path to the key's leaf and inserts into the copy
+ *
+ * Splits follow BPlusTree::splitLeaf()/splitInternal(); the new right node and
+ * its separator are reported to the caller instead of through parent pointers.
+ */
+template<typename KeyType, typename ValueType>
+typename PersistentBPlusTree<KeyType, ValueType>::MutableNodePtr
+PersistentBPlusTree<KeyType, ValueType>::insertInto(const BaseNode* node, const KeyType& key,
+                                                    const ValueType& value, SplitResult& split,
+                                                    bool& replaced) const {
+    if (node->isLeaf()) {
+        auto leaf = std::make_shared<Leaf>(*static_cast<const Leaf*>(node));
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+            leaf->values[pos] = value;
+            replaced = true;
+            return leaf;
+        }
+        leaf->insertAt(pos, key, value);
+        if (leaf->isFull()) {
+            splitLeaf(*leaf, split);
+        }
+        return leaf;
+    }
+
+    auto internal = std::make_shared<Internal>(*static_cast<const Internal*>(node));
+    size_t index = internal->findChildIndex(key);
+
+    SplitResult childSplit;
+    internal->setChild(index, insertInto(internal->children[index], key, value, childSplit, replaced));
+
+    if (childSplit.split) {
+        internal->insertKeyAt(index, childSplit.separator);
+        internal->insertSharedChildAt(index + 1, std::move(childSplit.right));
+        if (internal->isFull()) {
+            splitInternal(*internal, split);
+        }
+    }
+    return internal;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::splitLeaf(Leaf& leaf, SplitResult& split) const {
+    auto right = std::make_shared<Leaf>(maxKeys);
+    size_t splitPoint = (maxKeys + 1) / 2;
+
+    size_t rightIndex = 0;
+    for (size_t i = splitPoint; i < leaf.numKeys; i++) {
+        right->keys[rightIndex] = std::move(leaf.keys[i]);
+        right->values[rightIndex] = std::move(leaf.values[i]);
+        rightIndex++;
+    }
+    right->numKeys = rightIndex;
+    leaf.numKeys = splitPoint;
+
+    split.separator = right->keys[0];
+    split.right = std::move(right);
+    split.split = true;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::splitInternal(Internal& node, SplitResult& split) const {
+    auto right = std::make_shared<Internal>(maxKeys);
+    size_t splitPoint = (maxKeys + 1) / 2;
+    size_t numChildren = node.numKeys + 1;
+
+    split.separator = node.keys[splitPoint];
+
+    size_t rightKeyIndex = 0;
+    for (size_t i = splitPoint + 1; i < node.numKeys; i++) {
+        right->keys[rightKeyIndex++] = std::move(node.keys[i]);
+    }
+    right->numKeys = rightKeyIndex;
+
+    size_t rightChildIndex = 0;
+    for (size_t i = splitPoint + 1; i < numChildren; i++) {
+        right->setChild(rightChildIndex++, std::move(node.owned[i]));
+        node.children[i] = nullptr;
+    }
+    node.numKeys = splitPoint;
+
+    split.right = std::move(right);
+    split.split = true;
+}
+
+template<typename KeyType, typename ValueType>
+PersistentBPlusTree<KeyType, ValueType>
+PersistentBPlusTree<KeyType, ValueType>::remove(const KeyType& key) const {
+    if (!root) return *this;
+
+    MutableNodePtr newRoot = removeFrom(root.get(), key);
+    if (!newRoot) return *this;  // Key not found: share everything
+
+    // Collapse an empty root, shrinking the tree by one level
+    if (newRoot->numKeys == 0) {
+        if (newRoot->isLeaf()) {
+            return PersistentBPlusTree(nullptr, order, 0);
+        }
+        NodePtr child = static_cast<Internal*>(newRoot.get())->owned[0];
+        return PersistentBPlusTree(std::move(child), order, count - 1);
+    }
+
+    return PersistentBPlusTree(std::move(newRoot), order, count - 1);
+}
+
+/**
+ * @brief Copies the path to the key's leaf and removes from the copy
+ *
+ * Returns nullptr without copying anything if the key is absent. An underfull
+ * child is fixed by its (already copied) parent using the same borrow-then-merge
+ * order as BPlusTree::deleteEntry().
+ */
+template<typename KeyType, typename ValueType>
+typename PersistentBPlusTree<KeyType, ValueType>::MutableNodePtr
+PersistentBPlusTree<KeyType, ValueType>::removeFrom(const BaseNode* node, const KeyType& key) const {
+    if (node->isLeaf()) {
+        size_t pos = node->findKeyPosition(key);
+        if (pos >= node->numKeys || !(node->keys[pos] == key)) return nullptr;
+
+        auto leaf = std::make_shared<Leaf>(*static_cast<const Leaf*>(node));
+        leaf->removeAt(pos);
+        return leaf;
+    }
+
+    const Internal* source = static_cast<const Internal*>(node);
+    size_t index = source->findChildIndex(key);
+    MutableNodePtr child = removeFrom(source->children[index], key);
+    if (!child) return nullptr;
+
+    auto internal = std::make_shared<Internal>(*source);
+    internal->setChild(index, child);
+    if (child->isUnderflow(minKeys)) {
+        rebalanceChild(*internal, index, child);
+    }
+    return internal;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::rebalanceChild(Internal& parent, size_t index,
+                                                             const MutableNodePtr& child) const {
+    // Try to borrow from a sibling (the sibling is copied before it changes)
+    if (index > 0 && parent.children[index - 1]->numKeys > minKeys) {
+        MutableNodePtr left = copyNode(parent.children[index - 1]);
+        borrowFromLeft(*child, *left, parent, index - 1);
+        parent.setChild(index - 1, std::move(left));
+        return;
+    }
+    if (index < parent.numKeys && parent.children[index + 1]->numKeys > minKeys) {
+        MutableNodePtr right = copyNode(parent.children[index + 1]);
+        borrowFromRight(*child, *right, parent, index);
+        parent.setChild(index + 1, std::move(right));
+        return;
+    }
+
+    // Merge with a sibling
+    if (index > 0) {
+        MutableNodePtr left = copyNode(parent.children[index - 1]);
+        mergeNodes(*left, *child, parent, index - 1);
+        parent.setChild(index - 1, std::move(left));
+        parent.removeSharedChildAt(index);
+        parent.removeKeyAt(index - 1);
+    } else {
+        // The right sibling is only read, so it needs no copy
+        mergeNodes(*child, *parent.children[index + 1], parent, index);
+        parent.removeSharedChildAt(index + 1);
+        parent.removeKeyAt(index);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::borrowFromLeft(BaseNode& node, BaseNode& left,
+                                                             Internal& parent, size_t separatorIndex) const {
+    if (node.isLeaf()) {
+        Leaf& leaf = static_cast<Leaf&>(node);
+        Leaf& leftLeaf = static_cast<Leaf&>(left);
+        size_t last = leftLeaf.numKeys - 1;
+        leaf.insertAt(0, std::move(leftLeaf.keys[last]), std::move(leftLeaf.values[last]));
+        leftLeaf.numKeys--;
+        parent.keys[separatorIndex] = leaf.keys[0];
+        return;
+    }
+
+    // Rotate through the parent: separator moves down, left's last key moves up
+    Internal& internal = static_cast<Internal&>(node);
+    Internal& leftInternal = static_cast<Internal&>(left);
+    size_t lastChild = leftInternal.numKeys;
+    internal.insertKeyAt(0, parent.keys[separatorIndex]);
+    internal.insertSharedChildAt(0, std::move(leftInternal.owned[lastChild]));
+    leftInternal.children[lastChild] = nullptr;
+    parent.keys[separatorIndex] = std::move(leftInternal.keys[leftInternal.numKeys - 1]);
+    leftInternal.numKeys--;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::borrowFromRight(BaseNode& node, BaseNode& right,
+                                                              Internal& parent, size_t separatorIndex) const {
+    if (node.isLeaf()) {
+        Leaf& leaf = static_cast<Leaf&>(node);
+        Leaf& rightLeaf = static_cast<Leaf&>(right);
+        leaf.insertAt(leaf.numKeys, std::move(rightLeaf.keys[0]), std::move(rightLeaf.values[0]));
+        rightLeaf.removeAt(0);
+        parent.keys[separatorIndex] = rightLeaf.keys[0];
+        return;
+    }
+
+    Internal& internal = static_cast<Internal&>(node);
+    Internal& rightInternal = static_cast<Internal&>(right);
+    internal.keys[internal.numKeys] = parent.keys[separatorIndex];
+    internal.numKeys++;
+    internal.setChild(internal.numKeys, std::move(rightInternal.owned[0]));
+    parent.keys[separatorIndex] = rightInternal.keys[0];
+    rightInternal.removeSharedChildAt(0);
+    rightInternal.removeKeyAt(0);
+}
+
+/**
+ * @brief Appends right's entries (and, for internal nodes, the separator) to left
+ *
+ * The caller removes the separator and the right child from the parent.
+ */
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::mergeNodes(BaseNode& left, const BaseNode& right,
+                                                         Internal& parent, size_t separatorIndex) const {
+    if (left.isLeaf()) {
+        Leaf& leftLeaf = static_cast<Leaf&>(left);
+        const Leaf& rightLeaf = static_cast<const Leaf&>(right);
+        for (size_t i = 0; i < rightLeaf.numKeys; i++) {
+            leftLeaf.keys[leftLeaf.numKeys] = rightLeaf.keys[i];
+            leftLeaf.values[leftLeaf.numKeys] = rightLeaf.values[i];
+            leftLeaf.numKeys++;
+        }
+        return;
+    }
+
+    Internal& leftInternal = static_cast<Internal&>(left);
+    const Internal& rightInternal = static_cast<const Internal&>(right);
+    size_t childIndex = leftInternal.numKeys + 1;
+
+    leftInternal.keys[leftInternal.numKeys++] = parent.keys[separatorIndex];
+    for (size_t i = 0; i < rightInternal.numKeys; i++) {
+        leftInternal.keys[leftInternal.numKeys++] = rightInternal.keys[i];
+    }
+    for (size_t i = 0; i <= rightInternal.numKeys; i++) {
+        leftInternal.setChild(childIndex++, rightInternal.owned[i]);
+    }
+}
+
+// ==================== Query Implementation ====================
+
+template<typename KeyType, typename ValueType>
+bool PersistentBPlusTree<KeyType, ValueType>::search(const KeyType& key, ValueType& value) const {
+    const BaseNode* current = root.get();
+    if (!current) return false;
+    while (current->isInternal()) {
+        const Internal* internal = static_cast<const Internal*>(current);
+        current = internal->children[internal->findChildIndex(key)];
+    }
+    return static_cast<const Leaf*>(current)->findValue(key, value);
+}
+
+template<typename KeyType, typename ValueType>
+bool PersistentBPlusTree<KeyType, ValueType>::floorIn(const BaseNode* node, const KeyType& key,
+                                                      KeyType& foundKey, ValueType& value) {
+    if (node->isLeaf()) {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        size_t pos = leaf->findKeyPosition(key);
+        if (pos < leaf->numKeys && leaf->keys[pos] == key) {
+            pos++;
+        }
+        if (pos == 0) return false;
+        foundKey = leaf->keys[pos - 1];
+        value = leaf->values[pos - 1];
+        return true;
+    }
+
+    // Separators may be stale after removals, so the child left of the key's
+    // child supplies the answer when the key's child holds only greater keys
+    const Internal* internal = static_cast<const Internal*>(node);
+    for (size_t i = internal->findChildIndex(key) + 1; i-- > 0;) {
+        if (floorIn(internal->children[i], key, foundKey, value)) return true;
+    }
+    return false;
+}
+
+template<typename KeyType, typename ValueType>
+std::vector<std::pair<KeyType, ValueType>>
+PersistentBPlusTree<KeyType, ValueType>::rangeQuery(const KeyType& start, const KeyType& end) const {
+    std::vector<std::pair<KeyType, ValueType>> result;
+    if (root && !(end < start)) {
+        collectRange(root.get(), start, end, result);
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::collectRange(
+    const BaseNode* node, const KeyType& start, const KeyType& end,
+    std::vector<std::pair<KeyType, ValueType>>& result) const {
+    if (node->isLeaf()) {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        for (size_t i = leaf->findKeyPosition(start); i < leaf->numKeys && !(end < leaf->keys[i]); ++i) {
+            result.emplace_back(leaf->keys[i], leaf->values[i]);
+        }
+        return;
+    }
+
+    const Internal* internal = static_cast<const Internal*>(node);
+    size_t last = internal->findChildIndex(end);
+    for (size_t i = internal->findChildIndex(start); i <= last; ++i) {
+        collectRange(internal->children[i], start, end, result);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+template<typename Function>
+void PersistentBPlusTree<KeyType, ValueType>::visit(const BaseNode* node, Function& fn) {
+    if (node->isLeaf()) {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        for (size_t i = 0; i < leaf->numKeys; ++i) {
+            fn(leaf->keys[i], leaf->values[i]);
+        }
+        return;
+    }
+
+    const Internal* internal = static_cast<const Internal*>(node);
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        visit(internal->children[i], fn);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+size_t PersistentBPlusTree<KeyType, ValueType>::height() const {
+    size_t h = 0;
+    for (const BaseNode* current = root.get(); current; ++h) {
+        current = current->isLeaf() ? nullptr : static_cast<const Internal*>(current)->children[0];
+    }
+    return h;
+}
+
+template<typename KeyType, typename ValueType>
+void PersistentBPlusTree<KeyType, ValueType>::collectNodes(const BaseNode* node,
+                                                           std::unordered_set<const BaseNode*>& nodes) {
+    nodes.insert(node);
+    if (node->isInternal()) {
+        const Internal* internal = static_cast<const Internal*>(node);
+        for (size_t i = 0; i <= internal->numKeys; ++i) {
+            collectNodes(internal->children[i], nodes);
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType>
+size_t PersistentBPlusTree<KeyType, ValueType>::nodeCount() const {
+    std::unordered_set<const BaseNode*> nodes;
+    if (root) collectNodes(root.get(), nodes);
+    return nodes.size();
+}
+
+template<typename KeyType, typename ValueType>
+size_t PersistentBPlusTree<KeyType, ValueType>::sharedNodeCount(const PersistentBPlusTree& other) const {
+    std::unordered_set<const BaseNode*> ours;
+    std::unordered_set<const BaseNode*> theirs;
+    if (root) collectNodes(root.get(), ours);
+    if (other.root) collectNodes(other.root.get(), theirs);
+
+    size_t shared = 0;
+    for (const BaseNode* node : ours) {
+        shared += theirs.count(node);
+    }
+    return shared;
+}
+
+template<typename KeyType, typename ValueType>
+bool PersistentBPlusTree<KeyType, ValueType>::validate() const {
+    if (!root) return count == 0;
+
+    size_t entries = 0;
+    bool sorted = true;
+    bool first = true;
+    KeyType previous{};
+    forEach([&](const KeyType& key, const ValueType&) {
+        if (!first && !(previous < key)) sorted = false;
+        previous = key;
+        first = false;
+        entries++;
+    });
+    if (!sorted || entries != count) {
+        std::cerr << "Entries out of order or count mismatch" << std::endl;
+        return false;
+    }
+
+    int leafLevel = -1;
+    return validateNode(root.get(), 0, leafLevel);
+}
+
+template<typename KeyType, typename ValueType>
+bool PersistentBPlusTree<KeyType, ValueType>::validateNode(const BaseNode* node, int level,
+                                                           int& leafLevel) const {
+    if (node != root.get() && (node->numKeys < minKeys || node->numKeys > maxKeys)) {
+        std::cerr << "Invalid key count at level " << level << std::endl;
+        return false;
+    }
+
+    if (node->isLeaf()) {
+        if (leafLevel == -1) {
+            leafLevel = level;
+        } else if (leafLevel != level) {
+            std::cerr << "Leaves at different levels" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    const Internal* internal = static_cast<const Internal*>(node);
+    for (size_t i = 0; i <= internal->numKeys; ++i) {
+        if (!internal->children[i] || internal->children[i] != internal->owned[i].get()) {
+            std::cerr << "Child ownership mismatch at level " << level << std::endl;
+            return false;
+        }
+        if (!validateNode(internal->children[i], level + 1, leafLevel)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_PERSISTENT_H
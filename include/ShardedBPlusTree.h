@@ -0,0 +1,423 @@
+#ifndef BPLUSTREE_SHARDED_H
+#define BPLUSTREE_SHARDED_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+
+namespace bptree {
+
+/**
+ * @brief Range-partitioned tree of independent BPlusTree shards
+ *
+ * The key space is cut at partition keys into consecutive ranges; each range
+ * is held by its own BPlusTree guarded by its own mutex. Point operations
+ * look the shard up in the partition table and lock only that shard, so
+ * writers working on disjoint ranges never contend with each other.
+ * rangeQuery() and forEachInRange() stitch the shards together in key order,
+ * holding one shard lock at a time.
+ *
+ * Partitions can be changed online: splitShard() and joinShards() cut and
+ * glue shards with BPlusTree::splitAt() and BPlusTree::mergeFrom(), and
+ * rebalance() uses both to even out skewed shards. These take the partition
+ * table exclusively, briefly pausing the point operations. Each shard keeps
+ * its entry count, so size() and rebalance() never walk the leaves to count.
+ *
+ * All public methods are thread-safe.
+ *
+ * Usage example:
+ * @code
+ * ShardedBPlusTree<int, std::string> tree({1000, 2000, 3000}, 64);  // 4 shards
+ * // Threads writing keys in [0, 1000) and [1000, 2000) run in parallel
+ * tree.insert(42, "x");
+ * auto rows = tree.rangeQuery(900, 1100);   // spans two shards
+ * @endcode
+ *
+ * @tparam KeyType The type of keys
+ * @tparam ValueType The type of values
+ * @tparam Allocator The allocator each shard uses
+ */
+template<typename KeyType, typename ValueType,
+         typename Allocator = std::allocator<std::pair<const KeyType, ValueType>>>
+class ShardedBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using tree_type = BPlusTree<KeyType, ValueType, Allocator>;
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        tree_type tree;
+        std::atomic<size_t> count;   // Entries in tree; written under mutex, read without it
+
+        Shard(size_t order, const Allocator& alloc) : tree(order, alloc), count(0) {}
+        explicit Shard(tree_type&& t) : tree(std::move(t)), count(tree.size()) {}
+    };
+
+    mutable std::shared_mutex tableMutex;      // Guards the partition table
+    std::vector<KeyType> partitionKeys;        // partitionKeys[i] is the smallest key of shard i + 1
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t layoutVersion = 0;                  // Bumped by every split and join
+    size_t order;
+    Allocator allocator;
+
+    // Index of the shard owning key (table lock held)
+    size_t shardFor(const KeyType& key) const {
+        return static_cast<size_t>(std::upper_bound(partitionKeys.begin(), partitionKeys.end(), key) -
+                                   partitionKeys.begin());
+    }
+
+    void splitShardLocked(size_t index, const KeyType& key);
+    void joinShardsLocked(size_t index);
+    bool medianKey(size_t index, KeyType& key) const;
+    bool planRound(size_t& largest, size_t& join, KeyType& median) const;
+
+public:
+    /**
+     * @brief Constructs a tree with the given partition keys
+     *
+     * @param keys Partition keys; n keys give n + 1 shards. They are sorted
+     *             and de-duplicated.
+     * @param ord The order of every shard
+     * @param alloc The allocator every shard uses
+     */
+    explicit ShardedBPlusTree(std::vector<KeyType> keys = {}, size_t ord = DEFAULT_ORDER,
+                              const Allocator& alloc = Allocator())
+        : partitionKeys(std::move(keys)), order(ord), allocator(alloc) {
+        std::sort(partitionKeys.begin(), partitionKeys.end());
+        partitionKeys.erase(std::unique(partitionKeys.begin(), partitionKeys.end()), partitionKeys.end());
+        for (size_t i = 0; i <= partitionKeys.size(); ++i) {
+            shards.push_back(std::unique_ptr<Shard>(new Shard(order, allocator)));
+        }
+    }
+
+    ShardedBPlusTree(const ShardedBPlusTree&) = delete;
+    ShardedBPlusTree& operator=(const ShardedBPlusTree&) = delete;
+
+    // ==================== Point Operations ====================
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: O(log s + log n) for s shards
+     */
+    void insert(const KeyType& key, const ValueType& value) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        Shard& shard = *shards[shardFor(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.tree.insert_or_assign(key, value).second) {
+            shard.count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Removes a key
+     *
+     * @return true if the key was found and removed
+     */
+    bool remove(const KeyType& key) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        Shard& shard = *shards[shardFor(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.tree.remove(key)) return false;
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Searches for a key
+     *
+     * @param key The key to search for
+     * @param value Output parameter set to the value if found
+     * @return true if the key was found
+     */
+    bool search(const KeyType& key, ValueType& value) const {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        const Shard& shard = *shards[shardFor(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.tree.search(key, value);
+    }
+
+    /**
+     * @brief Checks if a key exists
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return search(key, value);
+    }
+
+    // ==================== Range Operations ====================
+
+    /**
+     * @brief Calls fn(key, value) for every entry with key in [start, end], in key order
+     *
+     * Shards are visited one after another, each under its own lock, so each
+     * shard's part is consistent but the whole range is not read atomically.
+     * fn must not call back into this tree.
+     *
+     * Time complexity: O(s log n + k) for s shards spanned and k results
+     */
+    template<typename Function>
+    void forEachInRange(const KeyType& start, const KeyType& end, Function fn) const {
+        if (end < start) return;
+
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        size_t last = shardFor(end);
+        for (size_t i = shardFor(start); i <= last; ++i) {
+            const Shard& shard = *shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.tree.lower_bound(start); it != shard.tree.end() && !(end < it->first); ++it) {
+                fn(it->first, it->second);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * @see forEachInRange() for the consistency guarantees
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        forEachInRange(start, end, [&result](const KeyType& key, const ValueType& value) {
+            result.emplace_back(key, value);
+        });
+        return result;
+    }
+
+    /**
+     * @brief Returns the total number of entries
+     *
+     * Sums the per-shard entry counts without taking the shard locks; with
+     * writers running, the result reflects each shard at a slightly different time.
+     *
+     * Time complexity: O(s)
+     */
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard->count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Checks if no shard holds any entry
+     */
+    bool isEmpty() const { return size() == 0; }
+
+    // ==================== Partition Management ====================
+
+    /**
+     * @brief Returns the number of shards
+     */
+    size_t shardCount() const {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        return shards.size();
+    }
+
+    /**
+     * @brief Returns the number of entries in one shard
+     *
+     * @throws std::out_of_range if index is not a shard index
+     *
+     * Time complexity: O(1)
+     */
+    size_t shardSize(size_t index) const {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        if (index >= shards.size()) {
+            throw std::out_of_range("Shard index out of range");
+        }
+        return shards[index]->count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the current partition keys
+     */
+    std::vector<KeyType> partitions() const {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        return partitionKeys;
+    }
+
+    /**
+     * @brief Splits a shard in two at a key
+     *
+     * Entries >= key move to a new shard inserted right after index.
+     *
+     * @param index The shard to split
+     * @param key The new partition key; must lie strictly inside the shard's range
+     * @throws std::out_of_range if index is not a shard index
+     * @throws std::invalid_argument if key does not fall strictly inside the shard
+     *
+     * Time complexity: O(n/B) for the shard's n entries and B keys per leaf
+     */
+    void splitShard(size_t index, const KeyType& key) {
+        std::unique_lock<std::shared_mutex> table(tableMutex);
+        if (index >= shards.size()) {
+            throw std::out_of_range("Shard index out of range");
+        }
+        bool aboveLow = index == 0 || partitionKeys[index - 1] < key;
+        bool belowHigh = index == partitionKeys.size() || key < partitionKeys[index];
+        if (!aboveLow || !belowHigh) {
+            throw std::invalid_argument("Split key must lie strictly inside the shard's key range");
+        }
+        splitShardLocked(index, key);
+    }
+
+    /**
+     * @brief Joins a shard with the shard after it
+     *
+     * @param index The left shard of the pair
+     * @throws std::out_of_range if index + 1 is not a shard index
+     *
+     * Time complexity: O(n + m) for the two shards' sizes
+     */
+    void joinShards(size_t index) {
+        std::unique_lock<std::shared_mutex> table(tableMutex);
+        if (index + 1 >= shards.size()) {
+            throw std::out_of_range("Shard index out of range");
+        }
+        joinShardsLocked(index);
+    }
+
+    /**
+     * @brief Evens out shard sizes while keeping the number of shards
+     *
+     * Repeatedly splits the largest shard at its median key and joins the
+     * adjacent pair with the fewest entries, while the largest shard holds
+     * more than twice its fair share and more than that pair together.
+     *
+     * Each round is planned under the shared table lock from the per-shard
+     * entry counts, locking only the largest shard while walking its leaves to
+     * the median, so point operations keep running. The table is taken
+     * exclusively just for the split and join; if another thread changed the
+     * partitions in between, the round is planned again.
+     *
+     * @return The number of split/join rounds performed
+     *
+     * Time complexity: O(s + n/B) per round for the n entries of the shards
+     * split and joined and B keys per leaf
+     */
+    size_t rebalance();
+};
+
+// ==================== Partition Management Implementation ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void ShardedBPlusTree<KeyType, ValueType, Allocator>::splitShardLocked(size_t index, const KeyType& key) {
+    Shard& lower = *shards[index];
+    std::unique_ptr<Shard> upper(new Shard(lower.tree.splitAt(key)));
+    size_t moved = upper->count.load(std::memory_order_relaxed);
+    try {
+        partitionKeys.insert(partitionKeys.begin() + static_cast<std::ptrdiff_t>(index), key);
+        shards.insert(shards.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+    } catch (...) {
+        // Keep the table consistent: put the entries back
+        if (partitionKeys.size() == shards.size()) {
+            partitionKeys.erase(partitionKeys.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+        if (upper) lower.tree.mergeFrom(std::move(upper->tree));
+        throw;
+    }
+    lower.count.fetch_sub(moved, std::memory_order_relaxed);
+    layoutVersion++;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void ShardedBPlusTree<KeyType, ValueType, Allocator>::joinShardsLocked(size_t index) {
+    Shard& lower = *shards[index];
+    lower.tree.mergeFrom(std::move(shards[index + 1]->tree));
+    lower.count.fetch_add(shards[index + 1]->count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    shards.erase(shards.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+    partitionKeys.erase(partitionKeys.begin() + static_cast<std::ptrdiff_t>(index));
+    layoutVersion++;
+}
+
+// Finds the key at position count / 2 by skipping whole leaves (table lock and shard mutex held)
+template<typename KeyType, typename ValueType, typename Allocator>
+bool ShardedBPlusTree<KeyType, ValueType, Allocator>::medianKey(size_t index, KeyType& key) const {
+    const Shard& shard = *shards[index];
+    size_t half = shard.count.load(std::memory_order_relaxed) / 2;
+    if (half == 0) return false;
+    for (const LeafNode<KeyType, ValueType>* leaf = shard.tree.getFirstLeaf(); leaf; leaf = leaf->next) {
+        if (half < leaf->numKeys) {
+            key = leaf->keys[half];
+            return true;
+        }
+        half -= leaf->numKeys;
+    }
+    return false;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+size_t ShardedBPlusTree<KeyType, ValueType, Allocator>::rebalance() {
+    size_t rounds = 0;
+    for (size_t attempt = 0;; ++attempt) {
+        size_t largest = 0;
+        size_t join = 0;
+        size_t version = 0;
+        KeyType median;
+        {
+            std::shared_lock<std::shared_mutex> table(tableMutex);
+            if (shards.size() < 2 || attempt >= shards.size()) break;
+            if (!planRound(largest, join, median)) break;
+            version = layoutVersion;
+        }
+
+        // Another thread may have split or joined shards in between; plan again if so
+        std::unique_lock<std::shared_mutex> table(tableMutex);
+        if (layoutVersion != version) continue;
+        // Split first so the indexes computed above stay valid for the join
+        splitShardLocked(largest, median);
+        joinShardsLocked(join);
+        rounds++;
+    }
+    return rounds;
+}
+
+// Picks the shard to split at its median and the pair to join (table lock held)
+template<typename KeyType, typename ValueType, typename Allocator>
+bool ShardedBPlusTree<KeyType, ValueType, Allocator>::planRound(size_t& largest, size_t& join,
+                                                                 KeyType& median) const {
+    std::vector<size_t> sizes;
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        sizes.push_back(shard->count.load(std::memory_order_relaxed));
+        total += sizes.back();
+    }
+
+    largest = static_cast<size_t>(std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+    size_t smallestPair = shards.size();
+    for (size_t i = 0; i + 1 < sizes.size(); ++i) {
+        if (i == largest || i + 1 == largest) continue;
+        if (smallestPair == shards.size() ||
+            sizes[i] + sizes[i + 1] < sizes[smallestPair] + sizes[smallestPair + 1]) {
+            smallestPair = i;
+        }
+    }
+
+    size_t fairShare = total / shards.size();
+    if (smallestPair == shards.size() || sizes[largest] <= 2 * fairShare ||
+        sizes[largest] <= sizes[smallestPair] + sizes[smallestPair + 1]) {
+        return false;
+    }
+
+    // The pair's index once the split has inserted a shard before it
+    join = smallestPair < largest ? smallestPair : smallestPair + 1;
+    std::lock_guard<std::mutex> lock(shards[largest]->mutex);
+    return medianKey(largest, median);
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_SHARDED_H
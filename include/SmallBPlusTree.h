@@ -0,0 +1,287 @@
+#ifndef BPLUSTREE_SMALL_H
+#define BPLUSTREE_SMALL_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <algorithm>
+
+namespace bptree {
+
+/**
+ * @brief B+ tree that keeps its first few entries inside the object
+ *
+ * Up to InlineCapacity entries are held in sorted arrays within the tree
+ * object, with no heap allocation at all. Inserting one more promotes the
+ * entries to a heap-allocated BPlusTree of the configured order; removing
+ * entries until at most half of InlineCapacity remain moves them back
+ * inline. The gap between the two thresholds keeps a tree that hovers
+ * around the capacity from converting back and forth.
+ *
+ * Meant for large numbers of tiny maps: an empty BPlusTree object alone is
+ * a few hundred bytes, and its first entry allocates a leaf with maxKeys + 1
+ * key and value slots in two further allocations.
+ *
+ * Usage example:
+ * @code
+ * std::vector<SmallBPlusTree<uint32_t, uint64_t>> sessions(1000000);
+ * sessions[id].insert(field, value);  // no allocation until the 9th field
+ * @endcode
+ *
+ * @tparam KeyType The type of keys (default constructible)
+ * @tparam ValueType The type of values (default constructible)
+ * @tparam InlineCapacity The number of entries kept inline
+ * @tparam Allocator Allocator for the nodes of the promoted tree
+ */
+template<typename KeyType, typename ValueType, size_t InlineCapacity = DEFAULT_INLINE_CAPACITY,
+         typename Allocator = std::allocator<std::pair<const KeyType, ValueType>>>
+class SmallBPlusTree {
+    static_assert(InlineCapacity >= 1, "SmallBPlusTree needs room for at least one inline entry");
+
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using tree_type = BPlusTree<KeyType, ValueType, Allocator>;
+
+    static constexpr size_t INLINE_CAPACITY = InlineCapacity;
+
+private:
+    std::unique_ptr<tree_type> tree;   // The promoted tree, or nullptr while entries are inline
+    size_t count;                      // Entries, inline or in the tree
+    std::uint32_t order;               // Order of the tree built on promotion
+    Allocator allocator;
+    std::array<KeyType, InlineCapacity> keys;      // Sorted; the first count are live while inline
+    std::array<ValueType, InlineCapacity> values;
+
+    size_t inlinePosition(const KeyType& key) const {
+        return static_cast<size_t>(std::lower_bound(keys.begin(), keys.begin() + count, key) - keys.begin());
+    }
+    void promote(const KeyType& key, const ValueType& value, size_t pos);
+    void demote();
+    void resetInline(size_t from);
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The order of the tree built once the inline entries overflow
+     * @param alloc Allocator for the nodes of that tree
+     */
+    explicit SmallBPlusTree(size_t ord = DEFAULT_ORDER, const Allocator& alloc = Allocator())
+        : tree(), count(0), order(static_cast<std::uint32_t>(ord)), allocator(alloc), keys(), values() {}
+
+    SmallBPlusTree(SmallBPlusTree&& other) noexcept
+        : tree(std::move(other.tree)), count(other.count), order(other.order), allocator(other.allocator),
+          keys(std::move(other.keys)), values(std::move(other.values)) {
+        other.count = 0;
+    }
+
+    SmallBPlusTree& operator=(SmallBPlusTree&& other) noexcept {
+        if (this != &other) {
+            tree = std::move(other.tree);
+            count = other.count;
+            order = other.order;
+            allocator = other.allocator;
+            keys = std::move(other.keys);
+            values = std::move(other.values);
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: O(InlineCapacity) inline, O(log n) once promoted
+     * Exception safety: Strong guarantee while inline and on promotion;
+     *                   that of BPlusTree::insert() once promoted
+     */
+    void insert(const KeyType& key, const ValueType& value);
+
+    /**
+     * @brief Removes a key
+     * @return true if the key was found and removed
+     */
+    bool remove(const KeyType& key);
+
+    bool search(const KeyType& key, ValueType& value) const {
+        const ValueType* found = find(key);
+        if (!found) return false;
+        value = *found;
+        return true;
+    }
+
+    /**
+     * @brief Returns a pointer to the key's value, or nullptr
+     *
+     * The pointer is invalidated by the next insert() or remove().
+     */
+    const ValueType* find(const KeyType& key) const {
+        if (tree) return tree->findValueSlot(key);
+        size_t pos = inlinePosition(key);
+        return pos < count && keys[pos] == key ? &values[pos] : nullptr;
+    }
+
+    bool contains(const KeyType& key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        if (tree) return tree->rangeQuery(start, end);
+        std::vector<std::pair<KeyType, ValueType>> result;
+        for (size_t i = inlinePosition(start); i < count && !(end < keys[i]); ++i) {
+            result.emplace_back(keys[i], values[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        if (tree) {
+            for (auto it = tree->begin(); it != tree->end(); ++it) {
+                fn(it->first, it->second);
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            fn(keys[i], values[i]);
+        }
+    }
+
+    void clear() {
+        tree.reset();
+        resetInline(0);
+        count = 0;
+    }
+
+    size_t size() const noexcept { return count; }
+    bool isEmpty() const noexcept { return count == 0; }
+
+    /**
+     * @brief Whether the entries are held inline rather than in a promoted tree
+     */
+    bool isInline() const noexcept { return !tree; }
+
+    /**
+     * @brief Returns the promoted tree, or nullptr while the entries are inline
+     */
+    const tree_type* promotedTree() const noexcept { return tree.get(); }
+
+    /**
+     * @brief Checks the inline entries are sorted, or validates the promoted tree
+     */
+    bool validate() const;
+};
+
+// ==================== Updates ====================
+
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+void SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::insert(const KeyType& key,
+                                                                            const ValueType& value) {
+    if (tree) {
+        if (tree->insert_or_assign(key, value).second) count++;
+        return;
+    }
+    size_t pos = inlinePosition(key);
+    if (pos < count && keys[pos] == key) {
+        values[pos] = value;
+        return;
+    }
+    if (count == InlineCapacity) {
+        promote(key, value, pos);
+        return;
+    }
+
+    // Build the shifted entry before moving anything, so a throwing copy leaves the tree as it was
+    KeyType newKey(key);
+    ValueType newValue(value);
+    std::move_backward(keys.begin() + pos, keys.begin() + count, keys.begin() + count + 1);
+    std::move_backward(values.begin() + pos, values.begin() + count, values.begin() + count + 1);
+    keys[pos] = std::move(newKey);
+    values[pos] = std::move(newValue);
+    count++;
+}
+
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+bool SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::remove(const KeyType& key) {
+    if (tree) {
+        if (!tree->remove(key)) return false;
+        count--;
+        if (count <= InlineCapacity / 2) demote();
+        return true;
+    }
+    size_t pos = inlinePosition(key);
+    if (pos == count || !(keys[pos] == key)) return false;
+    std::move(keys.begin() + pos + 1, keys.begin() + count, keys.begin() + pos);
+    std::move(values.begin() + pos + 1, values.begin() + count, values.begin() + pos);
+    count--;
+    resetInline(count);
+    return true;
+}
+
+// Moves the inline entries and one new entry at pos into a fresh tree
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+void SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::promote(const KeyType& key,
+                                                                             const ValueType& value, size_t pos) {
+    auto promoted = std::unique_ptr<tree_type>(new tree_type(order, allocator));
+    for (size_t i = 0; i < count; ++i) {
+        if (i == pos) promoted->insert(key, value);
+        promoted->insert(keys[i], values[i]);
+    }
+    if (pos == count) promoted->insert(key, value);
+
+    tree = std::move(promoted);
+    resetInline(0);
+    count++;
+}
+
+// Moves the entries of a tree that has shrunk back inline
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+void SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::demote() {
+    try {
+        size_t i = 0;
+        for (auto it = tree->begin(); it != tree->end(); ++it, ++i) {
+            keys[i] = it->first;
+            values[i] = it->second;
+        }
+    } catch (...) {
+        // The tree still holds every entry; stay promoted rather than fail a remove that succeeded
+        resetInline(0);
+        return;
+    }
+    tree.reset();
+}
+
+// Releases whatever the inline slots from `from` on still hold
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+void SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::resetInline(size_t from) {
+    for (size_t i = from; i < InlineCapacity; ++i) {
+        keys[i] = KeyType();
+        values[i] = ValueType();
+    }
+}
+
+template<typename KeyType, typename ValueType, size_t InlineCapacity, typename Allocator>
+bool SmallBPlusTree<KeyType, ValueType, InlineCapacity, Allocator>::validate() const {
+    if (tree) {
+        return tree->validate() && tree->size() == count && count > InlineCapacity / 2;
+    }
+    if (count > InlineCapacity) return false;
+    for (size_t i = 1; i < count; ++i) {
+        if (!(keys[i - 1] < keys[i])) return false;
+    }
+    return true;
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_SMALL_H
@@ -0,0 +1,570 @@
+#ifndef BPLUSTREE_VALUE_LOG_H
+#define BPLUSTREE_VALUE_LOG_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace bptree {
+
+namespace detail {
+
+constexpr uint32_t VLOG_MAGIC = 0x4c565042;  // "BPVL" in little-endian
+constexpr uint32_t VLOG_VERSION = 1;
+
+/**
+ * @brief Append-only log of (key, value) records addressed by 8-byte handles
+ *
+ * Records live in fixed-size segments; a handle is the segment number in the
+ * high 32 bits and the slot in the low 32 bits. release() only marks a record
+ * dead. Segments are never written again once full, so a segment whose
+ * records are all dead is freed, and compaction moves the live records out
+ * of mostly-dead segments. Each record keeps its key so that compaction can
+ * find the index entry that points to it.
+ */
+template<typename KeyType, typename ValueType>
+class ValueLog {
+public:
+    using Handle = std::uint64_t;
+
+    explicit ValueLog(size_t recordsPerSegment)
+        : segmentCapacity(recordsPerSegment ? recordsPerSegment : 1), firstSegment(0),
+          allocatedSegments(0), liveRecords(0), deadRecords(0) {}
+
+    /**
+     * @brief Appends a record at the head of the log
+     */
+    Handle append(const KeyType& key, const ValueType& value) {
+        if (segments.empty() || segments.back().keys.size() == segmentCapacity) {
+            segments.emplace_back();
+            segments.back().keys.reserve(segmentCapacity);
+            segments.back().values.reserve(segmentCapacity);
+            segments.back().live.reserve(segmentCapacity);
+            allocatedSegments++;
+        }
+        Segment& head = segments.back();
+        head.values.push_back(value);
+        try {
+            head.keys.push_back(key);
+        } catch (...) {
+            head.values.pop_back();
+            throw;
+        }
+        head.live.push_back(true);  // Reserved, so this cannot throw
+        head.liveCount++;
+        liveRecords++;
+        size_t number = firstSegment + segments.size() - 1;
+        return (static_cast<Handle>(number) << 32) | (head.keys.size() - 1);
+    }
+
+    const ValueType& value(Handle handle) const {
+        return segments[segmentIndex(handle)].values[slot(handle)];
+    }
+
+    /**
+     * @brief Replaces the key stored with a record
+     */
+    void setKey(Handle handle, const KeyType& key) {
+        segments[segmentIndex(handle)].keys[slot(handle)] = key;
+    }
+
+    /**
+     * @brief Marks a record dead, freeing its segment once nothing in it is live
+     */
+    void release(Handle handle) noexcept {
+        size_t index = segmentIndex(handle);
+        Segment& segment = segments[index];
+        size_t position = slot(handle);
+        if (!segment.live[position]) return;
+        segment.live[position] = false;
+        segment.liveCount--;
+        liveRecords--;
+        deadRecords++;
+        if (segment.liveCount == 0 && index + 1 < segments.size()) {
+            freeSegment(index);
+        }
+    }
+
+    /**
+     * @brief Moves the live records of mostly-dead full segments to the head
+     *
+     * @param minDeadRatio Segments with at least this fraction of dead records are compacted
+     * @param relocate Called as relocate(key, oldHandle, newHandle) for each moved record
+     * @return The number of records moved
+     */
+    template<typename Relocate>
+    size_t compact(double minDeadRatio, Relocate relocate) {
+        size_t moved = 0;
+        // Only full segments; the head segment is still being filled
+        size_t end = firstSegment + (segments.empty() ? 0 : segments.size() - 1);
+        for (size_t number = firstSegment; number < end; ++number) {
+            if (number < firstSegment) continue;  // Freed while compacting an earlier one
+            const Segment& segment = segments[number - firstSegment];
+            size_t dead = segment.keys.size() - segment.liveCount;
+            if (segment.keys.empty() ||
+                static_cast<double>(dead) < minDeadRatio * static_cast<double>(segment.keys.size())) {
+                continue;
+            }
+
+            // It died while it was still the head segment
+            if (segment.liveCount == 0) {
+                freeSegment(number - firstSegment);
+                continue;
+            }
+
+            // Sealed segments never grow and deque references survive push_back,
+            // so the segment stays put until its last live record is released
+            size_t remaining = segment.liveCount;
+            for (size_t i = 0; remaining > 0; ++i) {
+                if (!segment.live[i]) continue;
+                Handle from = (static_cast<Handle>(number) << 32) | i;
+                Handle to = append(segment.keys[i], segment.values[i]);
+                relocate(segment.keys[i], from, to);
+                remaining--;
+                release(from);
+                moved++;
+            }
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Calls fn(handle, key, value) for each live record in log order
+     */
+    template<typename Function>
+    void forEachLive(Function fn) const {
+        for (size_t index = 0; index < segments.size(); ++index) {
+            const Segment& segment = segments[index];
+            for (size_t i = 0; i < segment.keys.size(); ++i) {
+                if (!segment.live[i]) continue;
+                Handle handle = (static_cast<Handle>(firstSegment + index) << 32) | i;
+                fn(handle, segment.keys[i], segment.values[i]);
+            }
+        }
+    }
+
+    void clear() noexcept {
+        segments.clear();
+        firstSegment = 0;
+        allocatedSegments = 0;
+        liveRecords = 0;
+        deadRecords = 0;
+    }
+
+    size_t liveCount() const noexcept { return liveRecords; }
+    size_t deadCount() const noexcept { return deadRecords; }
+    size_t segmentCount() const noexcept { return allocatedSegments; }
+    size_t recordsPerSegment() const noexcept { return segmentCapacity; }
+
+private:
+    struct Segment {
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        std::vector<bool> live;
+        size_t liveCount = 0;
+    };
+
+    size_t segmentCapacity;
+    std::deque<Segment> segments;   // segments[i] is segment number firstSegment + i
+    size_t firstSegment;
+    size_t allocatedSegments;       // Segments not yet freed
+    size_t liveRecords;
+    size_t deadRecords;             // Dead records still occupying memory
+
+    size_t segmentIndex(Handle handle) const noexcept {
+        return static_cast<size_t>(handle >> 32) - firstSegment;
+    }
+    static size_t slot(Handle handle) noexcept {
+        return static_cast<size_t>(handle & 0xffffffffu);
+    }
+
+    void freeSegment(size_t index) noexcept {
+        Segment& segment = segments[index];
+        deadRecords -= segment.keys.size();
+        allocatedSegments--;
+        // Swap with empty vectors so the memory is returned
+        std::vector<KeyType>().swap(segment.keys);
+        std::vector<ValueType>().swap(segment.values);
+        std::vector<bool>().swap(segment.live);
+        while (!segments.empty() && segments.size() > 1 && segments.front().keys.empty()) {
+            segments.pop_front();
+            firstSegment++;
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief B+ tree that keeps values out of line in an append-only value log
+ *
+ * Leaves hold only keys and 8-byte handles into a detail::ValueLog, as in
+ * WiscKey. Splits, merges and in-leaf shifts therefore move handles rather
+ * than large values, and key searches keep leaves small and cache-friendly.
+ * A value is copied once, when it is appended to the log; overwrites and
+ * removals mark the old record dead.
+ *
+ * Dead records are reclaimed in two ways. A segment is freed as soon as
+ * every record in it is dead. Once dead records make up more than
+ * gcThreshold of the log, full segments that are at least that fraction
+ * dead have their live records re-appended at the head, and the index is
+ * repointed at the copies. compact() does the same for every segment with
+ * dead records.
+ *
+ * Usage example:
+ * @code
+ * ValueLogBPlusTree<uint64_t, std::array<char, 4096>> blobs(64);
+ * blobs.insert(id, page);
+ * blobs.save("blobs.dat");  // values are written in log order
+ * @endcode
+ *
+ * @tparam KeyType The type of keys
+ * @tparam ValueType The type of values (typically large)
+ */
+template<typename KeyType, typename ValueType>
+class ValueLogBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using handle_type = std::uint64_t;
+    using index_type = BPlusTree<KeyType, handle_type>;
+
+    /// Records per log segment unless the constructor says otherwise
+    static constexpr size_t DEFAULT_SEGMENT_RECORDS = 1024;
+
+private:
+    size_t order;
+    index_type index;
+    detail::ValueLog<KeyType, ValueType> log;
+    double gcThreshold;
+    size_t gcTrigger;      // Dead records needed before the next automatic compaction
+    size_t relocations;
+
+    void collectIfNeeded();
+    void relocate(double minDeadRatio);
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The order of the key index
+     * @param segmentRecords Records per value log segment
+     * @param garbageThreshold Fraction of dead records that triggers compaction (0 < t <= 1)
+     * @throws std::invalid_argument If garbageThreshold is outside (0, 1]
+     */
+    explicit ValueLogBPlusTree(size_t ord = DEFAULT_ORDER,
+                               size_t segmentRecords = DEFAULT_SEGMENT_RECORDS,
+                               double garbageThreshold = 0.5)
+        : order(ord), index(ord), log(segmentRecords), gcThreshold(garbageThreshold),
+          gcTrigger(log.recordsPerSegment()), relocations(0) {
+        if (!(garbageThreshold > 0.0 && garbageThreshold <= 1.0)) {
+            throw std::invalid_argument("garbageThreshold must be in (0, 1]");
+        }
+    }
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: O(log n) handle moves plus one value copy
+     */
+    void insert(const KeyType& key, const ValueType& value);
+
+    /**
+     * @brief Removes a key
+     * @return true if the key was found and removed
+     */
+    bool remove(const KeyType& key);
+
+    /**
+     * @brief Searches for a key, copying its value out of the log
+     */
+    bool search(const KeyType& key, ValueType& value) const {
+        handle_type handle;
+        if (!index.search(key, handle)) return false;
+        value = log.value(handle);
+        return true;
+    }
+
+    /**
+     * @brief Returns a pointer to the key's value in the log, or nullptr
+     *
+     * The pointer is invalidated by the next insert(), remove() or compact().
+     */
+    const ValueType* find(const KeyType& key) const {
+        handle_type handle;
+        return index.search(key, handle) ? &log.value(handle) : nullptr;
+    }
+
+    bool contains(const KeyType& key) const {
+        handle_type handle;
+        return index.search(key, handle);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const {
+        std::vector<std::pair<KeyType, ValueType>> result;
+        for (const auto& entry : index.rangeQuery(start, end)) {
+            result.emplace_back(entry.first, log.value(entry.second));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every entry in key order without copying values
+     */
+    template<typename Function>
+    void forEach(Function fn) const {
+        for (auto it = index.begin(); it != index.end(); ++it) {
+            fn(it->first, log.value(it->second));
+        }
+    }
+
+    /**
+     * @brief Moves every live record out of segments that hold dead ones
+     * @return The number of records moved
+     */
+    size_t compact();
+
+    void clear() {
+        index = index_type(order);
+        log.clear();
+        gcTrigger = log.recordsPerSegment();
+    }
+
+    size_t size() const noexcept { return log.liveCount(); }
+    bool isEmpty() const noexcept { return index.isEmpty(); }
+
+    /**
+     * @brief Returns the fraction of records in the log that are dead
+     */
+    double garbageRatio() const noexcept {
+        size_t total = log.liveCount() + log.deadCount();
+        return total ? static_cast<double>(log.deadCount()) / static_cast<double>(total) : 0.0;
+    }
+
+    /**
+     * @brief Returns how many records garbage collection has moved
+     */
+    size_t relocationCount() const noexcept { return relocations; }
+
+    size_t segmentCount() const noexcept { return log.segmentCount(); }
+
+    /**
+     * @brief Returns the key index, whose values are log handles
+     */
+    const index_type& keyIndex() const noexcept { return index; }
+
+    /**
+     * @brief Checks the index and that every handle points at a live record with its key
+     */
+    bool validate() const;
+
+    /**
+     * @brief Saves the tree to a binary file
+     *
+     * Writes the live values in log order as one sequential run, followed by
+     * the keys in key order with their positions in that run. load() appends
+     * the values to a fresh log and bulk loads the keys, so it never sorts.
+     *
+     * @throws std::runtime_error If the file cannot be opened or written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Replaces the contents with a file written by save()
+     *
+     * @throws std::runtime_error If the file cannot be opened or is corrupted
+     */
+    void load(const std::string& filename);
+};
+
+// ==================== Updates ====================
+
+template<typename KeyType, typename ValueType>
+void ValueLogBPlusTree<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value) {
+    handle_type fresh = log.append(key, value);
+    handle_type old = 0;
+    bool inserted;
+    try {
+        inserted = index.upsert(key, [&](handle_type& handle) {
+            old = handle;
+            handle = fresh;
+        });
+    } catch (...) {
+        log.release(fresh);
+        throw;
+    }
+    if (!inserted) log.release(old);
+    collectIfNeeded();
+}
+
+template<typename KeyType, typename ValueType>
+bool ValueLogBPlusTree<KeyType, ValueType>::remove(const KeyType& key) {
+    handle_type handle;
+    if (!index.search(key, handle)) return false;
+    index.remove(key);
+    log.release(handle);
+    collectIfNeeded();
+    return true;
+}
+
+template<typename KeyType, typename ValueType>
+void ValueLogBPlusTree<KeyType, ValueType>::collectIfNeeded() {
+    if (log.deadCount() < gcTrigger || garbageRatio() <= gcThreshold) return;
+    relocate(gcThreshold);
+    // Wait for another segment's worth of garbage, so a log that stays just
+    // above the threshold is not rescanned on every write
+    gcTrigger = log.deadCount() + log.recordsPerSegment();
+}
+
+template<typename KeyType, typename ValueType>
+void ValueLogBPlusTree<KeyType, ValueType>::relocate(double minDeadRatio) {
+    relocations += log.compact(minDeadRatio, [this](const KeyType& key, handle_type, handle_type to) {
+        index.update(key, [to](handle_type& handle) { handle = to; });
+    });
+}
+
+template<typename KeyType, typename ValueType>
+size_t ValueLogBPlusTree<KeyType, ValueType>::compact() {
+    size_t before = relocations;
+    relocate(1e-9);
+    return relocations - before;
+}
+
+template<typename KeyType, typename ValueType>
+bool ValueLogBPlusTree<KeyType, ValueType>::validate() const {
+    if (!index.validate()) return false;
+    size_t entries = 0;
+    bool ok = true;
+    std::unordered_map<handle_type, KeyType> live;
+    log.forEachLive([&](handle_type handle, const KeyType& key, const ValueType&) {
+        live.emplace(handle, key);
+    });
+    for (auto it = index.begin(); it != index.end(); ++it) {
+        auto found = live.find(it->second);
+        if (found == live.end() || !(found->second == it->first)) ok = false;
+        entries++;
+    }
+    return ok && entries == log.liveCount();
+}
+
+// ==================== Persistence ====================
+
+template<typename KeyType, typename ValueType>
+void ValueLogBPlusTree<KeyType, ValueType>::save(const std::string& filename) const {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "KeyType must be trivially copyable for binary serialization. "
+                  "For complex types like std::string, use custom serialization.");
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "ValueType must be trivially copyable for binary serialization. "
+                  "For complex types like std::string, use custom serialization.");
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    uint32_t magic = detail::VLOG_MAGIC;
+    uint32_t version = detail::VLOG_VERSION;
+    uint64_t count = log.liveCount();
+    file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    // Values in log order, remembering where each handle lands
+    std::unordered_map<handle_type, uint64_t> position;
+    position.reserve(count);
+    log.forEachLive([&](handle_type handle, const KeyType&, const ValueType& value) {
+        position.emplace(handle, position.size());
+        file.write(reinterpret_cast<const char*>(&value), sizeof(ValueType));
+    });
+
+    // Keys in key order with the position of their value
+    for (auto it = index.begin(); it != index.end(); ++it) {
+        uint64_t at = position.at(it->second);
+        file.write(reinterpret_cast<const char*>(&it->first), sizeof(KeyType));
+        file.write(reinterpret_cast<const char*>(&at), sizeof(at));
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to write to file: " + filename);
+    }
+}
+
+template<typename KeyType, typename ValueType>
+void ValueLogBPlusTree<KeyType, ValueType>::load(const std::string& filename) {
+    static_assert(std::is_trivially_copyable<KeyType>::value,
+                  "KeyType must be trivially copyable for binary serialization. "
+                  "For complex types like std::string, use custom serialization.");
+    static_assert(std::is_trivially_copyable<ValueType>::value,
+                  "ValueType must be trivially copyable for binary serialization. "
+                  "For complex types like std::string, use custom serialization.");
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for reading: " + filename);
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t count = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || magic != detail::VLOG_MAGIC) {
+        throw std::runtime_error("Invalid file format: not a value log B+ tree file");
+    }
+    if (version != detail::VLOG_VERSION) {
+        throw std::runtime_error("Incompatible file version: expected " +
+                                 std::to_string(detail::VLOG_VERSION) +
+                                 ", got " + std::to_string(version));
+    }
+
+    // Keys follow the values, so records are appended first and keyed afterwards
+    detail::ValueLog<KeyType, ValueType> loaded(log.recordsPerSegment());
+    std::vector<handle_type> handles;
+    handles.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        ValueType value;
+        file.read(reinterpret_cast<char*>(&value), sizeof(ValueType));
+        if (!file) {
+            throw std::runtime_error("Unexpected end of file or read error at value " + std::to_string(i));
+        }
+        handles.push_back(loaded.append(KeyType(), value));
+    }
+
+    std::vector<std::pair<KeyType, handle_type>> entries;
+    entries.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        KeyType key;
+        uint64_t at = 0;
+        file.read(reinterpret_cast<char*>(&key), sizeof(KeyType));
+        file.read(reinterpret_cast<char*>(&at), sizeof(at));
+        if (!file || at >= count) {
+            throw std::runtime_error("Unexpected end of file or read error at key " + std::to_string(i));
+        }
+        loaded.setKey(handles[at], key);
+        entries.emplace_back(key, handles[at]);
+    }
+
+    index_type fresh(order);
+    fresh.bulkLoad(std::move(entries));
+    index = std::move(fresh);
+    log = std::move(loaded);
+    gcTrigger = log.recordsPerSegment();
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_VALUE_LOG_H
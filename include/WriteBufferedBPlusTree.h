@@ -0,0 +1,507 @@
+#ifndef BPLUSTREE_WRITE_BUFFERED_H
+#define BPLUSTREE_WRITE_BUFFERED_H
+
+#include "BPlusTree.h"
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace bptree {
+
+/**
+ * @brief Where WriteBufferedBPlusTree merges a full write buffer into its tree
+ */
+enum class MergeMode {
+    FOREGROUND,  ///< The write that fills the buffer performs the merge
+    BACKGROUND   ///< A dedicated thread performs the merge while writes continue
+};
+
+/**
+ * @brief BPlusTree behind an LSM-style in-memory write buffer
+ *
+ * insert() and remove() only append to a short unsorted tail; a removal is
+ * recorded as a tombstone. A full tail is sorted and folded into a sorted run
+ * in place. When the run holds bufferCapacity() keys it is frozen, a fresh
+ * one takes new writes, and the frozen run is applied to the tree with
+ * BPlusTree::applyBatch(): one ascending pass that descends once per leaf the
+ * run lands on and rewrites only those leaves and the paths above them. A
+ * write therefore never descends the tree itself, and a merge of M keys
+ * landing on L leaves costs O(M + L (B + log n)) for B keys per leaf rather
+ * than a pass over all n entries; clustered keys share leaves, while keys
+ * spread over a large tree approach one leaf copy per write.
+ *
+ * Readers are not blocked by a merge: they read a snapshot of the tree
+ * published after the previous merge, while the merge copies each node it
+ * changes (see BPlusTree::snapshot()). search() and rangeQuery() consult the
+ * tail, the run, the frozen run and then that snapshot. Once the merge is
+ * done, a new snapshot is published in O(1) and the copied-over nodes are
+ * freed by the next merge. If the run fills while the frozen one is still
+ * being merged, writers wait for the merge to finish. A merge that throws
+ * leaves its run frozen and visible; the next writer that needs the buffer,
+ * or flush(), retries it on its own thread, so a lasting error reaches that
+ * caller instead of blocking it. Changes the failed merge already applied
+ * are simply applied again.
+ *
+ * Larger buffers merge less often and put more keys on each leaf a merge
+ * touches, but hold more unmerged writes that readers search through.
+ *
+ * All public methods are thread-safe.
+ *
+ * Usage example:
+ * @code
+ * WriteBufferedBPlusTree<int, int> tree(64, 1 << 15, MergeMode::BACKGROUND);
+ * for (auto& event : burst) tree.insert(event.id, event.value);
+ * tree.flush();   // wait until everything is in the tree
+ * @endcode
+ *
+ * @tparam KeyType The type of keys
+ * @tparam ValueType The type of values (must be copyable)
+ * @tparam Allocator The allocator the tree uses
+ */
+template<typename KeyType, typename ValueType,
+         typename Allocator = std::allocator<std::pair<const KeyType, ValueType>>>
+class WriteBufferedBPlusTree {
+public:
+    using key_type = KeyType;
+    using mapped_type = ValueType;
+    using size_type = std::size_t;
+    using tree_type = BPlusTree<KeyType, ValueType, Allocator>;
+    using snapshot_type = typename tree_type::snapshot_type;
+
+    /// Writes appended before the tail is folded into the sorted run
+    static constexpr size_t TAIL_CAPACITY = 256;
+
+private:
+    // nullopt marks a removed key
+    using Entry = std::pair<KeyType, std::optional<ValueType>>;
+    using Run = std::vector<Entry>;
+
+    mutable std::shared_mutex mutex;          // Guards the fields below
+    mutable std::condition_variable_any mergeDone;  // Signalled when a merge ends
+    std::condition_variable_any mergeNeeded;  // Wakes the merge thread
+    tree_type tree;                           // Written only by the thread that holds merging
+    snapshot_type view;                       // What readers see of tree; released before it
+    size_t entries;                           // Entries in tree as of view
+    Run tail;                                 // Newest writes, in arrival order
+    Run active;                               // Sorted, one entry per key
+    std::shared_ptr<const Run> frozen;        // Being merged into tree (nullptr if none)
+    size_t capacity;
+    size_t tailCapacity;
+    MergeMode mode;
+    size_t merges;
+    bool merging;                             // A thread is applying frozen to tree
+    bool mergeFailed;                         // The last merge of frozen threw; retry it
+    bool stopping;
+    std::thread merger;
+
+    // Caller holds mutex exclusively
+    void write(const KeyType& key, std::optional<ValueType> value);
+    void foldTail();
+    void freezeLocked(std::unique_lock<std::shared_mutex>& lock);
+    void awaitMerge(std::unique_lock<std::shared_mutex>& lock);
+    void mergeFrozen(std::unique_lock<std::shared_mutex>& lock);
+    void mergeLoop();
+
+    static void sortUnique(Run& run);
+    static typename Run::const_iterator find(const Run& run, const KeyType& key);
+
+    // Applies sorted entries in [start, end] to sorted rows
+    static void overlay(const Run& run, const KeyType& start, const KeyType& end,
+                        std::vector<std::pair<KeyType, ValueType>>& rows);
+
+public:
+    /**
+     * @brief Constructs an empty tree
+     *
+     * @param ord The order of the underlying tree
+     * @param bufferCapacity Keys the write buffer holds before it is merged (at least 1)
+     * @param mergeMode Whether merges run on the writing thread or a background thread
+     * @param alloc The allocator the tree uses
+     */
+    explicit WriteBufferedBPlusTree(size_t ord = DEFAULT_ORDER, size_t bufferCapacity = 1 << 15,
+                                    MergeMode mergeMode = MergeMode::BACKGROUND,
+                                    const Allocator& alloc = Allocator())
+        : tree(ord, alloc), view(tree.snapshot()), entries(0),
+          capacity(bufferCapacity ? bufferCapacity : 1),
+          tailCapacity(std::min(capacity, TAIL_CAPACITY)), mode(mergeMode),
+          merges(0), merging(false), mergeFailed(false), stopping(false) {
+        tail.reserve(tailCapacity);
+        if (mode == MergeMode::BACKGROUND) {
+            merger = std::thread(&WriteBufferedBPlusTree::mergeLoop, this);
+        }
+    }
+
+    /**
+     * @brief Stops the merge thread; buffered writes are discarded with the tree
+     */
+    ~WriteBufferedBPlusTree() {
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            stopping = true;
+        }
+        mergeNeeded.notify_all();
+        if (merger.joinable()) merger.join();
+    }
+
+    WriteBufferedBPlusTree(const WriteBufferedBPlusTree&) = delete;
+    WriteBufferedBPlusTree& operator=(const WriteBufferedBPlusTree&) = delete;
+
+    /**
+     * @brief Inserts a key-value pair, updating the value if the key exists
+     *
+     * Time complexity: amortized O(log T + M / T) for a tail of T and a buffer of M
+     * keys, plus a merge every M distinct keys
+     */
+    void insert(const KeyType& key, const ValueType& value) {
+        write(key, value);
+    }
+
+    /**
+     * @brief Removes a key if present
+     *
+     * Records a tombstone without looking the key up, so unlike
+     * BPlusTree::remove() it does not report whether the key existed.
+     *
+     * Time complexity: same as insert()
+     */
+    void remove(const KeyType& key) {
+        write(key, std::nullopt);
+    }
+
+    /**
+     * @brief Searches for a key in the buffers and the tree
+     *
+     * Time complexity: O(T + log M + log n)
+     */
+    bool search(const KeyType& key, ValueType& value) const;
+
+    /**
+     * @brief Checks if a key exists
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return search(key, value);
+    }
+
+    /**
+     * @brief Returns all entries with keys in [start, end], sorted by key
+     *
+     * Time complexity: O(log n + k + b + T log T) for k tree entries and b buffered keys in range
+     */
+    std::vector<std::pair<KeyType, ValueType>> rangeQuery(const KeyType& start, const KeyType& end) const;
+
+    /**
+     * @brief Merges all buffered writes into the tree and waits until they are in
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of entries, flushing first
+     *
+     * Whether a buffered write adds a key is only known once it is merged.
+     */
+    size_t size() {
+        flush();
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return entries;
+    }
+
+    /**
+     * @brief Returns the number of writes not yet merged into the tree
+     *
+     * Repeated writes to a key in the tail count separately until it is folded.
+     */
+    size_t bufferedCount() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return tail.size() + active.size() + (frozen ? frozen->size() : 0);
+    }
+
+    /**
+     * @brief Returns how many buffers have been merged into the tree
+     */
+    size_t mergeCount() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return merges;
+    }
+
+    /**
+     * @brief Returns the number of keys a buffer holds before it is merged
+     */
+    size_t bufferCapacity() const noexcept { return capacity; }
+
+    /**
+     * @brief Checks the invariants of the underlying tree
+     *
+     * Waits for a running merge to finish first.
+     */
+    bool validate() const {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        mergeDone.wait(lock, [this] { return !merging; });
+        return tree.validate();
+    }
+};
+
+// ==================== Write Path ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::write(const KeyType& key,
+                                                                  std::optional<ValueType> value) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    tail.emplace_back(key, std::move(value));
+    if (tail.size() < tailCapacity) return;
+
+    foldTail();
+    if (active.size() < capacity) return;
+
+    freezeLocked(lock);
+    if (mode == MergeMode::FOREGROUND) {
+        mergeFrozen(lock);
+    }
+}
+
+/**
+ * @brief Sorts a run by key, keeping only the newest entry of each key
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::sortUnique(Run& run) {
+    std::stable_sort(run.begin(), run.end(),
+                     [](const Entry& a, const Entry& b) { return a.first < b.first; });
+    size_t out = 0;
+    for (size_t i = 0; i < run.size(); ++i) {
+        if (i + 1 < run.size() && run[i + 1].first == run[i].first) continue;
+        if (out != i) run[out] = std::move(run[i]);
+        ++out;
+    }
+    run.resize(out);
+}
+
+/**
+ * @brief Folds the tail into the sorted run with a backward in-place merge
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::foldTail() {
+    if (tail.empty()) return;
+    sortUnique(tail);
+
+    size_t added = 0;
+    for (const Entry& entry : tail) {
+        if (find(active, entry.first) == active.end()) ++added;
+    }
+
+    // Merge from the back so neither run has to be copied first
+    size_t i = active.size();
+    size_t j = tail.size();
+    active.resize(active.size() + added);
+    size_t out = active.size();
+    while (j > 0) {
+        if (i > 0 && tail[j - 1].first < active[i - 1].first) {
+            active[--out] = std::move(active[--i]);
+        } else {
+            if (i > 0 && active[i - 1].first == tail[j - 1].first) --i;
+            active[--out] = std::move(tail[--j]);
+        }
+    }
+    tail.clear();
+}
+
+/**
+ * @brief Hands the sorted run to the merge, waiting for a previous merge first
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::freezeLocked(
+    std::unique_lock<std::shared_mutex>& lock) {
+    awaitMerge(lock);
+    if (active.empty()) return;
+
+    frozen = std::make_shared<const Run>(std::move(active));
+    active = Run();
+    if (mode == MergeMode::BACKGROUND) {
+        mergeNeeded.notify_one();
+    }
+}
+
+/**
+ * @brief Waits until no run is frozen, retrying a merge that failed
+ *
+ * Nothing else retries a failed merge, so the waiting thread does it; its
+ * exception then propagates to this caller.
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::awaitMerge(
+    std::unique_lock<std::shared_mutex>& lock) {
+    while (frozen) {
+        if (mergeFailed) {
+            mergeFrozen(lock);
+        } else {
+            mergeDone.wait(lock);
+        }
+    }
+}
+
+/**
+ * @brief Applies the frozen run to the tree and publishes a new snapshot
+ *
+ * The lock is released while the run is applied. Only one merge runs at a
+ * time, since a run is frozen only when frozen is empty and merging keeps the
+ * merge thread off a run being retried, so the merging thread is the tree's
+ * only writer and readers only see the previous snapshot until it is done.
+ */
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::mergeFrozen(
+    std::unique_lock<std::shared_mutex>& lock) {
+    std::shared_ptr<const Run> batch = frozen;
+    if (!batch) return;
+
+    merging = true;
+    mergeFailed = false;
+    lock.unlock();
+    size_t added = 0;
+    size_t removed = 0;
+    try {
+        auto entry = batch->begin();
+        tree.applyBatch(batch->begin(), batch->end(), [&](bool existed) {
+            if (entry->second && !existed) added++;
+            if (!entry->second && existed) removed++;
+            ++entry;
+        });
+    } catch (...) {
+        // Keep the run visible to readers; waiting writers retry it (see awaitMerge())
+        lock.lock();
+        entries += added - removed;
+        merging = false;
+        mergeFailed = true;
+        mergeDone.notify_all();
+        throw;
+    }
+    lock.lock();
+
+    // Nodes only the old snapshot still uses are freed by the next merge
+    view = tree.snapshot();
+    entries += added - removed;
+    frozen.reset();
+    merging = false;
+    merges++;
+    mergeDone.notify_all();
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::mergeLoop() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (;;) {
+        mergeNeeded.wait(lock, [this] { return stopping || (frozen && !merging && !mergeFailed); });
+        if (stopping) return;
+        try {
+            mergeFrozen(lock);
+        } catch (...) {
+            // The next writer or flush() retries it and sees the error
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::flush() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    foldTail();
+    freezeLocked(lock);
+    if (mode == MergeMode::FOREGROUND) {
+        mergeFrozen(lock);
+    } else {
+        mergeNeeded.notify_one();
+        awaitMerge(lock);
+    }
+}
+
+// ==================== Read Path ====================
+
+template<typename KeyType, typename ValueType, typename Allocator>
+typename WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::Run::const_iterator
+WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::find(const Run& run, const KeyType& key) {
+    auto it = std::lower_bound(run.begin(), run.end(), key,
+                               [](const Entry& entry, const KeyType& k) { return entry.first < k; });
+    return (it != run.end() && it->first == key) ? it : run.end();
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+bool WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::search(const KeyType& key,
+                                                                   ValueType& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    // The newest write to a key is the last one in the tail
+    for (auto it = tail.rbegin(); it != tail.rend(); ++it) {
+        if (it->first == key) {
+            if (!it->second) return false;
+            value = *it->second;
+            return true;
+        }
+    }
+    for (const Run* run : {&active, frozen.get()}) {
+        if (!run) continue;
+        auto it = find(*run, key);
+        if (it != run->end()) {
+            if (!it->second) return false;
+            value = *it->second;
+            return true;
+        }
+    }
+
+    // A merge may be writing the tree; the snapshot stays as published
+    return view.search(key, value);
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+std::vector<std::pair<KeyType, ValueType>>
+WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::rangeQuery(const KeyType& start,
+                                                                  const KeyType& end) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<std::pair<KeyType, ValueType>> rows = view.rangeQuery(start, end);
+    if (end < start) return rows;
+
+    // Oldest writes first, so the newest have the last word
+    if (frozen) overlay(*frozen, start, end, rows);
+    overlay(active, start, end, rows);
+
+    Run recent;
+    for (const Entry& entry : tail) {
+        if (!(entry.first < start) && !(end < entry.first)) recent.push_back(entry);
+    }
+    sortUnique(recent);
+    overlay(recent, start, end, rows);
+    return rows;
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void WriteBufferedBPlusTree<KeyType, ValueType, Allocator>::overlay(
+    const Run& run, const KeyType& start, const KeyType& end,
+    std::vector<std::pair<KeyType, ValueType>>& rows) {
+    auto byKey = [](const Entry& entry, const KeyType& k) { return entry.first < k; };
+    auto first = std::lower_bound(run.begin(), run.end(), start, byKey);
+    auto last = first;
+    while (last != run.end() && !(end < last->first)) ++last;
+    if (first == last) return;
+
+    std::vector<std::pair<KeyType, ValueType>> merged;
+    merged.reserve(rows.size() + static_cast<size_t>(last - first));
+    size_t i = 0;
+    for (auto it = first; it != last; ++it) {
+        while (i < rows.size() && rows[i].first < it->first) {
+            merged.push_back(std::move(rows[i++]));
+        }
+        if (i < rows.size() && rows[i].first == it->first) ++i;
+        if (it->second) merged.emplace_back(it->first, *it->second);
+    }
+    for (; i < rows.size(); ++i) {
+        merged.push_back(std::move(rows[i]));
+    }
+    rows = std::move(merged);
+}
+
+} // namespace bptree
+
+#endif // BPLUSTREE_WRITE_BUFFERED_H
@@ -0,0 +1,225 @@
+#include "../include/BufferedBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Checks that the tree holds exactly the entries of the reference map
+template<typename Tree, typename Map>
+void assertMatches(const Tree& tree, const Map& expected) {
+    assert(tree.validate());
+    auto it = expected.begin();
+    tree.forEach([&](const typename Map::key_type& key, const typename Map::mapped_type& value) {
+        assert(it != expected.end());
+        assert(key == it->first);
+        assert(value == it->second);
+        ++it;
+    });
+    assert(it == expected.end());
+}
+
+void testEmptyTree() {
+    BufferedBPlusTree<int, int> tree;
+    assert(tree.isEmpty());
+    assert(tree.height() == 0);
+    assert(tree.bufferCapacity() == DEFAULT_ORDER * DEFAULT_ORDER);
+    assert(tree.validate());
+
+    int value = 0;
+    assert(!tree.search(1, value));
+    assert(tree.rangeQuery(0, 100).empty());
+
+    tree.remove(1);
+    assert(tree.isEmpty());
+    assert(tree.validate());
+
+    std::cout << "✓ Empty buffered tree test passed" << std::endl;
+}
+
+void testMessagesAreVisibleBeforeFlush() {
+    BufferedBPlusTree<int, std::string> tree(4, 64);
+    for (int i = 0; i < 40; i++) {
+        tree.insert(i, "v" + std::to_string(i));
+    }
+    assert(tree.height() > 1);
+    assert(tree.pendingMessages() > 0);
+
+    // Overwrite and remove while the originals may still sit in a buffer
+    tree.insert(3, "three");
+    tree.remove(7);
+    tree.remove(100);
+    tree.upsert(9, [](std::string& s) { s += "!"; });
+    tree.upsert(50, [](std::string& s) { s = "new"; });
+
+    std::string value;
+    assert(tree.search(3, value) && value == "three");
+    assert(!tree.contains(7));
+    assert(tree.search(9, value) && value == "v9!");
+    assert(tree.search(50, value) && value == "new");
+    assert(tree.validate());
+
+    auto rows = tree.rangeQuery(5, 10);
+    assert(rows.size() == 5);
+    assert(rows[0].first == 5 && rows[1].first == 6 && rows[2].first == 8);
+    assert(rows[3].second == "v9!");
+
+    size_t before = tree.pendingMessages();
+    assert(before > 0);
+    assert(tree.size() == 40);
+    assert(tree.pendingMessages() == 0);
+    assert(tree.search(9, value) && value == "v9!");
+    assert(tree.validate());
+
+    std::cout << "✓ Buffered messages visibility test passed" << std::endl;
+}
+
+void testUpsertFolding() {
+    BufferedBPlusTree<int, int> counts(4, 8);
+    for (int round = 0; round < 50; round++) {
+        for (int key = 0; key < 30; key++) {
+            counts.upsert(key, [](int& n) { ++n; });
+        }
+        int value = 0;
+        assert(counts.search(round % 30, value) && value == round + 1);
+    }
+    counts.remove(4);
+    counts.upsert(4, [](int& n) { n += 10; });
+    counts.insert(5, 100);
+    counts.upsert(5, [](int& n) { n *= 2; });
+
+    std::map<int, int> expected;
+    for (int key = 0; key < 30; key++) expected[key] = 50;
+    expected[4] = 10;
+    expected[5] = 200;
+    assertMatches(counts, expected);
+    assert(counts.size() == 30);
+
+    std::cout << "✓ Upsert folding test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    for (size_t order : {3u, 4u, 5u, 8u, 32u}) {
+        for (size_t capacity : {1u, 4u, 0u}) {
+            BufferedBPlusTree<int, int> tree(order, capacity);
+            std::map<int, int> expected;
+            std::mt19937 rng(static_cast<unsigned>(order * 31 + capacity));
+            std::uniform_int_distribution<int> dist(0, 2000);
+
+            for (int i = 0; i < 6000; i++) {
+                int key = dist(rng);
+                switch (rng() % 4) {
+                case 0:
+                    tree.remove(key);
+                    expected.erase(key);
+                    break;
+                case 1:
+                    tree.upsert(key, [i](int& n) { n += i; });
+                    expected[key] += i;
+                    break;
+                default:
+                    tree.insert(key, i);
+                    expected[key] = i;
+                    break;
+                }
+                if (i % 997 == 0) {
+                    assertMatches(tree, expected);
+                    int lo = dist(rng);
+                    auto rows = tree.rangeQuery(lo, lo + 150);
+                    auto it = expected.lower_bound(lo);
+                    for (const auto& row : rows) {
+                        assert(it != expected.end() && row.first == it->first && row.second == it->second);
+                        ++it;
+                    }
+                    assert(it == expected.upper_bound(lo + 150));
+                }
+            }
+            assertMatches(tree, expected);
+
+            // Remove everything so merges run all the way up to the root
+            for (const auto& entry : std::map<int, int>(expected)) {
+                tree.remove(entry.first);
+            }
+            assert(tree.validate());
+            assert(tree.isEmpty());
+            assert(tree.height() == 0);
+        }
+    }
+
+    std::cout << "✓ Randomized buffered tree test passed" << std::endl;
+}
+
+void testFlushBatchesAndClear() {
+    BufferedBPlusTree<int, int> tree(8);
+    for (int i = 0; i < 20000; i++) {
+        tree.insert((i * 7919) % 20000, i);
+    }
+    assert(tree.validate());
+    assert(tree.flushCount() > 0);
+
+    tree.flush();
+    assert(tree.pendingMessages() == 0);
+    assert(tree.size() == 20000);
+    assert(tree.validate());
+
+    tree.clear();
+    assert(tree.isEmpty());
+    assert(tree.validate());
+    tree.insert(1, 1);
+    assert(tree.size() == 1);
+
+    std::cout << "✓ Flush and clear test passed" << std::endl;
+}
+
+void testBufferedPerformanceComparison() {
+    const int NUM_ELEMENTS = 100000;
+    std::vector<int> keys(NUM_ELEMENTS);
+    for (int i = 0; i < NUM_ELEMENTS; i++) keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+
+    // Measure random inserts into the regular tree
+    auto start1 = std::chrono::high_resolution_clock::now();
+    BPlusTree<int, int> plain(64);
+    for (int key : keys) {
+        plain.insert(key, key);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto plainTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure random inserts through message buffers, including the final flush
+    auto start2 = std::chrono::high_resolution_clock::now();
+    BufferedBPlusTree<int, int> buffered(64);
+    for (int key : keys) {
+        buffered.insert(key, key);
+    }
+    buffered.flush();
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto bufferedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(buffered.size() == plain.size());
+    assert(buffered.validate());
+
+    std::cout << "✓ Buffered performance comparison test passed" << std::endl;
+    std::cout << "  BPlusTree inserts: " << plainTime << "ms, Buffered inserts: "
+              << bufferedTime << "ms (" << buffered.flushCount() << " batches)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running buffered tree tests..." << std::endl;
+
+    testEmptyTree();
+    testMessagesAreVisibleBeforeFlush();
+    testUpsertFolding();
+    testRandomizedAgainstMap();
+    testFlushBatchesAndClear();
+    testBufferedPerformanceComparison();
+
+    std::cout << "\n✓ All buffered tree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Checks both scan directions and the node counts against the reference map
+template<typename Tree, typename Map>
+void assertMatches(const Tree& tree, const Map& expected) {
+    assert(tree.validate());
+    auto it = expected.begin();
+    for (auto entry = tree.begin(); entry != tree.end(); ++entry, ++it) {
+        assert(it != expected.end());
+        assert(entry->first == it->first && entry->second == it->second);
+    }
+    assert(it == expected.end());
+
+    // Reverse iteration follows the prev links of the copied leaves
+    auto back = expected.rbegin();
+    for (auto entry = tree.rbegin(); entry != tree.rend(); ++entry, ++back) {
+        assert(back != expected.rend());
+        assert(entry->first == back->first);
+    }
+    assert(back == expected.rend());
+}
+
+void testEmptyAndSmallTrees() {
+    BPlusTree<int, int> empty(8);
+    auto copy = empty.clone();
+    assert(copy.isEmpty());
+    assert(copy.validate());
+    copy.insert(1, 1);
+    assert(empty.isEmpty());
+
+    BPlusTree<int, int> single(4);
+    single.insert(7, 70);
+    auto singleCopy = single.clone();
+    assert(singleCopy.height() == 1);
+    assertMatches(singleCopy, std::map<int, int>{{7, 70}});
+
+    std::cout << "✓ Empty and small tree clone test passed" << std::endl;
+}
+
+void testCloneMatchesAndIsIndependent() {
+    for (size_t order : {3u, 4u, 16u, 64u}) {
+        for (size_t threads : {1u, 4u}) {
+            BPlusTree<int, int> tree(order);
+            std::map<int, int> expected;
+            std::mt19937 rng(static_cast<unsigned>(order + threads));
+            std::uniform_int_distribution<int> dist(0, 20000);
+            for (int i = 0; i < 20000; i++) {
+                int key = dist(rng);
+                if (rng() % 4 == 0) {
+                    tree.remove(key);
+                    expected.erase(key);
+                } else {
+                    tree.insert(key, i);
+                    expected[key] = i;
+                }
+            }
+            tree.setPrefetchDistance(5);
+
+            auto copy = tree.clone(threads);
+            assertMatches(copy, expected);
+            assert(copy.height() == tree.height());
+            assert(copy.statistics().leafNodeCount == tree.statistics().leafNodeCount);
+            assert(copy.statistics().internalNodeCount == tree.statistics().internalNodeCount);
+            assert(copy.statistics().insertCount == 0);
+            assert(copy.averageLeafFillFactor() == tree.averageLeafFillFactor());
+            assert(copy.getPrefetchDistance() == 5);
+
+            // Changes to either tree stay in that tree
+            std::map<int, int> copyExpected = expected;
+            for (int i = 0; i < 5000; i++) {
+                int key = dist(rng);
+                if (i % 2) {
+                    copy.remove(key);
+                    copyExpected.erase(key);
+                } else {
+                    copy.insert(key, -i);
+                    copyExpected[key] = -i;
+                }
+                tree.insert(key + 30000, i);
+                expected[key + 30000] = i;
+            }
+            assertMatches(copy, copyExpected);
+            assertMatches(tree, expected);
+
+            // Draining the clone merges its nodes up to the root
+            for (const auto& entry : copyExpected) {
+                assert(copy.remove(entry.first));
+            }
+            assert(copy.isEmpty() && copy.validate());
+            assertMatches(tree, expected);
+        }
+    }
+
+    std::cout << "✓ Clone matches and is independent test passed" << std::endl;
+}
+
+void testCloneWithSnapshotAndStrings() {
+    BPlusTree<int, std::string> tree(8);
+    std::map<int, std::string> expected;
+    for (int i = 0; i < 3000; i++) {
+        tree.insert(i, "value-" + std::to_string(i));
+        expected[i] = "value-" + std::to_string(i);
+    }
+
+    // A live snapshot shares nodes with the tree; the clone shares none
+    auto snap = tree.snapshot();
+    for (int i = 0; i < 3000; i += 3) {
+        tree.insert(i, "changed");
+        expected[i] = "changed";
+    }
+    auto copy = tree.clone(2);
+    snap.release();
+    tree.insert(1, "after");
+    assertMatches(copy, expected);
+    expected[1] = "after";
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Clone with snapshot and strings test passed" << std::endl;
+}
+
+void testClonePerformanceComparison() {
+    const int NUM_ELEMENTS = 2000000;
+    BPlusTree<int, int> tree(64);
+    std::vector<int> keys(NUM_ELEMENTS);
+    for (int i = 0; i < NUM_ELEMENTS; i++) keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(4));
+    for (int key : keys) {
+        tree.insert(key, key);
+    }
+
+    // Copy by re-inserting every entry
+    auto start1 = std::chrono::high_resolution_clock::now();
+    {
+        BPlusTree<int, int> copy(64);
+        for (auto it = tree.begin(); it != tree.end(); ++it) {
+            copy.insert(it->first, it->second);
+        }
+        assert(copy.statistics().leafNodeCount > 0);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto insertTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Copy through bulkLoad of the sorted entries
+    auto start2 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::pair<int, int>> entries;
+        entries.reserve(NUM_ELEMENTS);
+        for (auto it = tree.begin(); it != tree.end(); ++it) {
+            entries.emplace_back(it->first, it->second);
+        }
+        BPlusTree<int, int> copy(64);
+        copy.bulkLoad(std::move(entries));
+        assert(copy.statistics().leafNodeCount > 0);
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto bulkTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    // Structural clone
+    auto start3 = std::chrono::high_resolution_clock::now();
+    size_t leaves = 0;
+    {
+        auto copy = tree.clone();
+        leaves = copy.statistics().leafNodeCount;
+    }
+    auto end3 = std::chrono::high_resolution_clock::now();
+    auto cloneTime = std::chrono::duration_cast<std::chrono::milliseconds>(end3 - start3).count();
+    assert(leaves == tree.statistics().leafNodeCount);
+
+    auto start4 = std::chrono::high_resolution_clock::now();
+    {
+        auto copy = tree.clone(4);
+        assert(copy.statistics().leafNodeCount == leaves);
+    }
+    auto end4 = std::chrono::high_resolution_clock::now();
+    auto parallelTime = std::chrono::duration_cast<std::chrono::milliseconds>(end4 - start4).count();
+
+    std::cout << "✓ Clone performance comparison test passed" << std::endl;
+    std::cout << "  Copying 2M entries (destruction included): re-insert " << insertTime << "ms, bulkLoad "
+              << bulkTime << "ms, clone() " << cloneTime << "ms, clone(4) " << parallelTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running clone tests..." << std::endl;
+
+    testEmptyAndSmallTrees();
+    testCloneMatchesAndIsIndependent();
+    testCloneWithSnapshotAndStrings();
+    testClonePerformanceComparison();
+
+    std::cout << "\n✓ All clone tests passed!" << std::endl;
+    return 0;
+}
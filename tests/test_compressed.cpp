@@ -0,0 +1,268 @@
+#include "../include/CompressedBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Checks a full scan against the reference map
+template<typename Tree, typename Map>
+void assertMatches(const Tree& tree, const Map& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto it = expected.begin();
+    tree.forEach([&](const typename Map::key_type& key, const typename Map::mapped_type& value) {
+        assert(it != expected.end());
+        assert(key == it->first && value == it->second);
+        ++it;
+    });
+    assert(it == expected.end());
+}
+
+void testLeafCodec() {
+    std::mt19937 rng(1);
+    for (size_t n : {1u, 2u, 7u, 63u, 300u}) {
+        // Integer keys with small, large and negative deltas
+        std::vector<int64_t> keys(n);
+        std::vector<int32_t> values(n);
+        int64_t key = -1000000;
+        for (size_t i = 0; i < n; i++) {
+            key += 1 + static_cast<int64_t>(rng() % (i % 5 == 0 ? 1000000 : 3));
+            keys[i] = key;
+            values[i] = static_cast<int32_t>(i % 3 == 0 ? rng() : i);
+        }
+        std::vector<unsigned char> blob;
+        detail::LeafCodec<int64_t, int32_t>::encode(keys.data(), values.data(), n, blob);
+        std::vector<int64_t> keysOut(n);
+        std::vector<int32_t> valuesOut(n);
+        detail::LeafCodec<int64_t, int32_t>::decode(blob, n, keysOut.data(), valuesOut.data());
+        assert(keysOut == keys && valuesOut == values);
+
+        // Keys that are not integers go through LZ with the values
+        std::vector<double> doubles(n);
+        for (size_t i = 0; i < n; i++) doubles[i] = static_cast<double>(keys[i]) / 4;
+        blob.clear();
+        detail::LeafCodec<double, int32_t>::encode(doubles.data(), values.data(), n, blob);
+        std::vector<double> doublesOut(n);
+        detail::LeafCodec<double, int32_t>::decode(blob, n, doublesOut.data(), valuesOut.data());
+        assert(doublesOut == doubles && valuesOut == values);
+    }
+
+    // Extremes of the key range and long runs
+    std::vector<uint64_t> wide = {0, 1, UINT64_MAX - 1, UINT64_MAX};
+    std::vector<uint64_t> zeros(4, 0);
+    std::vector<unsigned char> blob;
+    detail::LeafCodec<uint64_t, uint64_t>::encode(wide.data(), zeros.data(), wide.size(), blob);
+    std::vector<uint64_t> wideOut(4), zerosOut(4, 1);
+    detail::LeafCodec<uint64_t, uint64_t>::decode(blob, 4, wideOut.data(), zerosOut.data());
+    assert(wideOut == wide && zerosOut == zeros);
+
+    std::vector<unsigned char> text(5000, 'a');
+    for (size_t i = 0; i < text.size(); i += 97) text[i] = static_cast<unsigned char>(i);
+    blob.clear();
+    detail::lzCompress(text.data(), text.size(), blob);
+    assert(blob.size() < text.size() / 10);
+    std::vector<unsigned char> textOut(text.size());
+    detail::lzDecompress(blob.data(), blob.size(), textOut.data());
+    assert(textOut == text);
+
+    std::cout << "✓ Leaf codec test passed" << std::endl;
+}
+
+void testBasicOperations() {
+    CompressedBPlusTree<int, int> tree(8);
+    assert(tree.isEmpty());
+    assert(tree.validate());
+    assert(tree.compressColdLeaves() == 0);
+    assert(tree.compressionRatio() == 1.0);
+
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i, i * 10);
+    }
+    assert(tree.size() == 1000);
+    assert(tree.height() > 2);
+    assert(tree.validate());
+
+    // New leaves count as accessed, so the first pass compresses nothing
+    assert(tree.compressColdLeaves() == 0);
+    size_t packed = tree.compressColdLeaves();
+    assert(packed == tree.leafCount());
+    assert(tree.compressedLeafCount() == packed);
+    assert(tree.compressionRatio() > 1.0);
+    assert(tree.validate());
+
+    // A point access decompresses just that leaf
+    int value = 0;
+    assert(tree.search(500, value) && value == 5000);
+    assert(tree.decompressionCount() == 1);
+    assert(tree.compressedLeafCount() == packed - 1);
+
+    // Scans decode into scratch space and leave leaves compressed
+    auto rows = tree.rangeQuery(100, 199);
+    assert(rows.size() == 100);
+    for (int i = 0; i < 100; i++) {
+        assert(rows[i].first == 100 + i && rows[i].second == (100 + i) * 10);
+    }
+    assert(tree.compressedLeafCount() == packed - 1);
+    assert(tree.decompressionCount() > 1);
+
+    // The accessed leaf survives the next pass, then goes cold again
+    assert(tree.compressColdLeaves() == 0);
+    assert(tree.compressColdLeaves() == 1);
+
+    tree.insert(500, -1);
+    tree.insert(1000, 1);
+    assert(!tree.contains(2000));
+    assert(tree.remove(10));
+    assert(!tree.remove(10));
+    assert(tree.size() == 1000);
+    assert(tree.validate());
+
+    tree.decompressAll();
+    assert(tree.compressedLeafCount() == 0);
+    assert(tree.compressedBytes() == 0);
+    assert(tree.validate());
+
+    tree.clear();
+    assert(tree.isEmpty() && tree.validate());
+
+    std::cout << "✓ Basic compressed tree operations test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    for (size_t order : {3u, 4u, 16u, 64u}) {
+        CompressedBPlusTree<int, int> tree(order);
+        std::map<int, int> expected;
+        std::mt19937 rng(static_cast<unsigned>(order));
+        std::uniform_int_distribution<int> dist(-3000, 3000);
+
+        for (int i = 0; i < 20000; i++) {
+            int key = dist(rng);
+            if (rng() % 3 == 0) {
+                assert(tree.remove(key) == (expected.erase(key) == 1));
+            } else {
+                tree.insert(key, i);
+                expected[key] = i;
+            }
+            // Frequent passes so that splits and merges meet compressed neighbours
+            if (i % 500 == 0) {
+                tree.compressColdLeaves();
+            }
+            if (i % 4999 == 0) {
+                assertMatches(tree, expected);
+            }
+        }
+        assertMatches(tree, expected);
+        assert(tree.compressionCount() > 0);
+        assert(tree.decompressionCount() > 0);
+
+        tree.compressColdLeaves();
+        tree.compressColdLeaves();
+        assertMatches(tree, expected);
+
+        for (const auto& entry : expected) {
+            int value = 0;
+            assert(tree.search(entry.first, value) && value == entry.second);
+        }
+
+        // Drain the tree so merges run up to the root
+        tree.compressColdLeaves();
+        tree.compressColdLeaves();
+        for (const auto& entry : expected) {
+            assert(tree.remove(entry.first));
+        }
+        assert(tree.isEmpty());
+        assert(tree.height() == 0);
+        assert(tree.leafCount() == 0);
+        assert(tree.validate());
+    }
+
+    std::cout << "✓ Randomized compressed tree test passed" << std::endl;
+}
+
+void testIncompressibleLeavesStayRaw() {
+    // Two random entries per leaf: the encoding overhead outweighs any saving
+    CompressedBPlusTree<uint64_t, uint64_t> tree(3);
+    std::mt19937_64 rng(9);
+    std::map<uint64_t, uint64_t> expected;
+    for (int i = 0; i < 2000; i++) {
+        uint64_t key = rng();
+        uint64_t value = rng();
+        tree.insert(key, value);
+        expected[key] = value;
+    }
+    tree.compressColdLeaves();
+    tree.compressColdLeaves();
+    // Leaves whose encoding is not smaller keep their arrays
+    assert(tree.compressedLeafCount() == 0);
+    assert(tree.compressionCount() == 0);
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Incompressible leaves test passed" << std::endl;
+}
+
+void testCompressionPerformanceComparison() {
+    const uint32_t NUM_KEYS = 1000000;
+    CompressedBPlusTree<uint32_t, uint32_t> tree(64);
+    for (uint32_t i = 0; i < NUM_KEYS; i++) {
+        tree.insert(i * 4, i / 3);
+    }
+    size_t rawMemory = tree.leafMemoryUsage();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    tree.compressColdLeaves();
+    tree.compressColdLeaves();
+    auto end = std::chrono::high_resolution_clock::now();
+    auto compressTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    size_t packedMemory = tree.leafMemoryUsage();
+    double ratio = tree.compressionRatio();
+    assert(tree.compressedLeafCount() == tree.leafCount());
+    assert(packedMemory * 3 < rawMemory);
+
+    // Random lookups: the first touch of each leaf decompresses it
+    std::vector<uint32_t> probes(200000);
+    std::mt19937 rng(4);
+    for (auto& probe : probes) probe = static_cast<uint32_t>(rng() % NUM_KEYS) * 4;
+    auto lookups = [&]() {
+        auto begin = std::chrono::high_resolution_clock::now();
+        uint32_t value = 0;
+        for (uint32_t probe : probes) {
+            bool found = tree.search(probe, value);
+            assert(found && value == probe / 4 / 3);
+            (void)found;
+        }
+        auto finish = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(finish - begin).count();
+    };
+    auto coldTime = lookups();
+    size_t decompressed = tree.decompressionCount();
+    auto hotTime = lookups();
+    assert(tree.decompressionCount() == decompressed);
+    assert(tree.validate());
+
+    std::cout << "✓ Compression performance comparison test passed" << std::endl;
+    std::cout << "  Leaf memory: " << rawMemory / 1024 << " KiB raw, " << packedMemory / 1024
+              << " KiB compressed (entries " << ratio << "x smaller, compressed in "
+              << compressTime << "ms)" << std::endl;
+    std::cout << "  200K lookups on cold leaves: " << coldTime << "ms (" << decompressed
+              << " decompressions), on hot leaves: " << hotTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running compressed tree tests..." << std::endl;
+
+    testLeafCodec();
+    testBasicOperations();
+    testRandomizedAgainstMap();
+    testIncompressibleLeavesStayRaw();
+    testCompressionPerformanceComparison();
+
+    std::cout << "\n✓ All compressed tree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,365 @@
+#include "../include/DelegatedBPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+using namespace bptree;
+
+void testMpscRing() {
+    detail::MpscRing<int> ring(5);
+    assert(ring.capacity() == 8);
+    assert(ring.empty());
+
+    for (int i = 0; i < 8; i++) {
+        assert(ring.tryPush(int(i)));
+    }
+    assert(!ring.tryPush(8));  // Full
+
+    int value = -1;
+    for (int i = 0; i < 8; i++) {
+        assert(ring.tryPop(value) && value == i);
+    }
+    assert(!ring.tryPop(value));
+
+    // Several producers, one consumer: every value arrives exactly once,
+    // and each producer's values arrive in order
+    const int PRODUCERS = 3;
+    const int PER_PRODUCER = 20000;
+    detail::MpscRing<int> shared(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&shared, p]() {
+            for (int i = 0; i < PER_PRODUCER; i++) {
+                while (!shared.tryPush(p * PER_PRODUCER + i)) std::this_thread::yield();
+            }
+        });
+    }
+    std::vector<int> last(PRODUCERS, -1);
+    int received = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!shared.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / PER_PRODUCER;
+        assert(value % PER_PRODUCER == last[producer] + 1);
+        last[producer] = value % PER_PRODUCER;
+        received++;
+    }
+    for (auto& thread : producers) thread.join();
+
+    std::cout << "✓ MPSC ring test passed" << std::endl;
+}
+
+void testSearchBatch() {
+    BPlusTree<int, int> tree(4);
+    for (int i = 0; i < 1000; i += 2) {
+        tree.insert(i, i * 10);
+    }
+
+    std::vector<int> keys;
+    for (int i = -3; i < 1005; i++) keys.push_back(i);
+
+    tree.resetStatistics();
+    size_t calls = 0;
+    tree.searchBatch(keys.begin(), keys.end(), [&](const int& key, const int* value) {
+        assert(key == keys[calls]);
+        bool expected = key >= 0 && key < 1000 && key % 2 == 0;
+        assert((value != nullptr) == expected);
+        if (value) assert(*value == key * 10);
+        calls++;
+    });
+    assert(calls == keys.size());
+    assert(tree.statistics().searchCount == keys.size());
+    assert(tree.statistics().searchHitCount == 500);
+
+    // Unsorted keys are still answered correctly
+    std::mt19937 rng(7);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    size_t hits = 0;
+    tree.searchBatch(keys.begin(), keys.end(), [&](const int& key, const int* value) {
+        if (value) {
+            assert(*value == key * 10);
+            hits++;
+        }
+    });
+    assert(hits == 500);
+
+    // Empty tree
+    BPlusTree<int, int> empty(4);
+    calls = 0;
+    empty.searchBatch(keys.begin(), keys.end(), [&](const int&, const int* value) {
+        assert(value == nullptr);
+        calls++;
+    });
+    assert(calls == keys.size());
+
+    std::cout << "✓ Search batch test passed" << std::endl;
+}
+
+void testDelegatedBasics() {
+    DelegatedBPlusTree<int, std::string> tree({500}, 4);
+    assert(tree.partitionCount() == 2);
+
+    std::vector<std::future<void>> inserts;
+    for (int i = 0; i < 1000; i++) {
+        inserts.push_back(tree.insert(i, std::to_string(i)));
+    }
+    for (auto& done : inserts) done.get();
+    assert(tree.size() == 1000);
+
+    auto hit = tree.search(750);
+    auto miss = tree.search(5000);
+    assert(hit.get() == std::optional<std::string>("750"));
+    assert(!miss.get().has_value());
+
+    // Requests for the same key keep their submission order within a batch
+    auto removed = tree.remove(10);
+    auto removedAgain = tree.remove(10);
+    auto gone = tree.search(10);
+    tree.insert(10, "again");
+    auto back = tree.search(10);
+    assert(removed.get());
+    assert(!removedAgain.get());
+    assert(!gone.get().has_value());
+    assert(back.get() == std::optional<std::string>("again"));
+
+    // Callbacks run on the owner thread
+    std::promise<std::string> seen;
+    tree.search(600, [&seen](const std::string* value) { seen.set_value(value ? *value : "missing"); });
+    assert(seen.get_future().get() == "600");
+    std::promise<bool> removedByCallback;
+    tree.remove(601, [&removedByCallback](bool result) { removedByCallback.set_value(result); });
+    assert(removedByCallback.get_future().get());
+
+    // Range queries are stitched across partitions
+    auto rows = tree.rangeQuery(495, 505);
+    assert(rows.size() == 11);
+    for (size_t i = 0; i < rows.size(); i++) {
+        assert(rows[i].first == 495 + static_cast<int>(i));
+    }
+
+    auto height = tree.execute(1, [](DelegatedBPlusTree<int, std::string>::tree_type& t) { return t.height(); });
+    assert(height.get() > 1);
+
+    bool threw = false;
+    try {
+        tree.execute(2, [](DelegatedBPlusTree<int, std::string>::tree_type&) {});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    assert(tree.requestCount() > 1000);
+    assert(tree.batchCount() > 0 && tree.batchCount() <= tree.requestCount());
+
+    std::cout << "✓ Delegated tree basics test passed" << std::endl;
+}
+
+void testConcurrentProducers() {
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 5000;
+    DelegatedBPlusTree<int, int> tree({5000, 10000, 15000}, 16, 128);
+
+    std::vector<std::thread> producers;
+    std::atomic<int> mismatches{0};
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&tree, &mismatches, p]() {
+            std::mt19937 rng(p);
+            std::vector<std::future<std::optional<int>>> lookups;
+            for (int i = 0; i < PER_PRODUCER; i++) {
+                int key = static_cast<int>(rng() % (PRODUCERS * PER_PRODUCER));
+                tree.insert(key, key);
+                if (i % 4 == 0) tree.remove(key);
+                if (i % 16 == 0) lookups.push_back(tree.search(key));
+            }
+            for (auto& lookup : lookups) {
+                // Other producers may have touched the key since, but values never tear
+                auto value = lookup.get();
+                if (value && *value < 0) mismatches++;
+            }
+        });
+    }
+    for (auto& thread : producers) thread.join();
+    tree.flush();
+    assert(mismatches.load() == 0);
+
+    // Replaying with one producer gives a known final state
+    DelegatedBPlusTree<int, int> replay({5000, 10000, 15000}, 16, 128, 8);
+    std::map<int, int> expected;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 20000);
+        if (rng() % 3 == 0) {
+            replay.remove(key);
+            expected.erase(key);
+        } else {
+            replay.insert(key, i);
+            expected[key] = i;
+        }
+    }
+    auto rows = replay.rangeQuery(0, 20000);
+    assert(rows.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        assert(row.first == it->first && row.second == it->second);
+        ++it;
+    }
+
+    std::cout << "✓ Concurrent producers test passed" << std::endl;
+}
+
+// Value whose copies throw while armed if it is negative
+struct Fragile {
+    static std::atomic<bool> armed;
+    int value = 0;
+
+    Fragile() = default;
+    explicit Fragile(int v) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value) { check(); }
+    Fragile& operator=(const Fragile& other) {
+        value = other.value;
+        check();
+        return *this;
+    }
+    Fragile(Fragile&&) noexcept = default;
+    Fragile& operator=(Fragile&&) noexcept = default;
+
+    void check() const {
+        if (value < 0 && armed.load()) throw std::runtime_error("poisoned copy");
+    }
+};
+std::atomic<bool> Fragile::armed(false);
+
+void testFailuresReachFutures() {
+    using Tree = DelegatedBPlusTree<int, Fragile>;
+    Tree tree({}, 4);
+    for (int i = 0; i < 20; i++) tree.insert(i, Fragile(i == 5 ? -5 : i)).get();
+
+    // Hold the owner so the requests below are served as one batch
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    tree.execute(0, [opened](Tree::tree_type&) { opened.wait(); });
+    auto poisonedLookup = tree.search(5);
+    auto lookup = tree.search(6);
+    auto removal = tree.remove(6);
+    auto poisonedInsert = tree.insert(30, Fragile(-30));
+    auto insert = tree.insert(31, Fragile(31));
+    Fragile::armed = true;
+    gate.set_value();
+
+    // Each failing request gets its own exception; the rest of the batch is served
+    auto throws = [](auto& future) {
+        try {
+            future.get();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    assert(throws(poisonedLookup));
+    assert(throws(poisonedInsert));
+    assert(lookup.get()->value == 6);
+    assert(removal.get());
+    insert.get();
+
+    // The owner thread survived
+    Fragile::armed = false;
+    assert(tree.search(5).get()->value == -5);
+    assert(!tree.search(30).get().has_value());
+    assert(tree.search(31).get()->value == 31);
+    assert(tree.size() == 20);
+
+    std::cout << "✓ Failures reach futures test passed" << std::endl;
+}
+
+void testDestructorDrainsQueue() {
+    std::atomic<int> applied{0};
+    {
+        DelegatedBPlusTree<int, int> tree({}, 8);
+        for (int i = 0; i < 2000; i++) {
+            tree.insert(i, i, [&applied]() { applied++; });
+        }
+    }
+    assert(applied.load() == 2000);
+
+    std::cout << "✓ Destructor drains queue test passed" << std::endl;
+}
+
+void testDelegatedPerformanceComparison() {
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 25000;
+
+    DelegatedBPlusTree<int, int> delegated({PER_PRODUCER, 2 * PER_PRODUCER, 3 * PER_PRODUCER}, 64);
+    std::atomic<long> delegatedHits{0};
+    auto start1 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; p++) {
+            producers.emplace_back([&delegated, &delegatedHits, p]() {
+                for (int i = 0; i < PER_PRODUCER; i++) {
+                    delegated.insert(p * PER_PRODUCER + i, i, []() {});
+                    delegated.search(i, [&delegatedHits](const int* value) {
+                        if (value) delegatedHits++;
+                    });
+                }
+            });
+        }
+        for (auto& thread : producers) thread.join();
+        delegated.flush();
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto delegatedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    BPlusTree<int, int> shared(64);
+    std::mutex sharedMutex;
+    std::atomic<long> sharedHits{0};
+    auto start2 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; p++) {
+            producers.emplace_back([&shared, &sharedMutex, &sharedHits, p]() {
+                int value = 0;
+                for (int i = 0; i < PER_PRODUCER; i++) {
+                    std::lock_guard<std::mutex> lock(sharedMutex);
+                    shared.insert(p * PER_PRODUCER + i, i);
+                    if (shared.search(i, value)) sharedHits++;
+                }
+            });
+        }
+        for (auto& thread : producers) thread.join();
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto sharedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(delegated.size() == shared.size());
+    double averageBatch = static_cast<double>(delegated.requestCount()) / delegated.batchCount();
+
+    std::cout << "✓ Delegated performance comparison test passed" << std::endl;
+    std::cout << "  Delegated (" << delegated.partitionCount() << " owners, avg batch " << averageBatch
+              << "): " << delegatedTime << "ms, Mutex-guarded tree: " << sharedTime << "ms ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running delegated tree tests..." << std::endl;
+
+    testMpscRing();
+    testSearchBatch();
+    testDelegatedBasics();
+    testConcurrentProducers();
+    testFailuresReachFutures();
+    testDestructorDrainsQueue();
+    testDelegatedPerformanceComparison();
+
+    std::cout << "\n✓ All delegated tree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,349 @@
+#include "../include/DiskBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace bptree;
+
+// Helper to generate a unique temp filename
+std::string getTempFilename() {
+    static int counter = 0;
+    return "test_disk_" + std::to_string(counter++) + ".db";
+}
+
+// Helper to clean up temp files
+void removeFile(const std::string& filename) {
+    std::remove(filename.c_str());
+}
+
+// Checks a full scan against the reference map
+template<typename Tree>
+void assertMatches(const Tree& tree, const std::map<int, int>& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& entry : tree) {
+        assert(it != expected.end());
+        assert(entry.first == it->first && entry.second == it->second);
+        ++it;
+    }
+    assert(it == expected.end());
+}
+
+void testEmptyTree() {
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<int, int> tree(filename);
+        assert(tree.isEmpty());
+        assert(tree.size() == 0);
+        assert(tree.height() == 0);
+        assert(tree.getPageSize() == DEFAULT_PAGE_SIZE);
+        assert(tree.validate());
+        assert(tree.begin() == tree.end());
+
+        int value = 0;
+        assert(!tree.search(1, value));
+        assert(!tree.remove(1));
+        assert(tree.rangeQuery(0, 100).empty());
+    }
+    removeFile(filename);
+
+    std::cout << "✓ Empty disk tree test passed" << std::endl;
+}
+
+void testBasicOperations() {
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<int, int> tree(filename, 0, 128);
+        assert(tree.leafCapacity() == 13);
+        assert(tree.internalCapacity() == 12);
+
+        for (int i = 0; i < 500; i++) {
+            tree.insert(i * 2, i);
+        }
+        assert(tree.size() == 500);
+        assert(tree.height() > 2);
+        assert(tree.validate());
+
+        int value = 0;
+        assert(tree.search(200, value) && value == 100);
+        assert(!tree.contains(201));
+        tree.insert(200, -1);
+        assert(tree.search(200, value) && value == -1);
+        assert(tree.size() == 500);
+
+        auto rows = tree.rangeQuery(11, 21);
+        assert(rows.size() == 5);
+        assert(rows.front().first == 12 && rows.back().first == 20);
+
+        auto it = tree.lower_bound(33);
+        assert(it != tree.end() && it->first == 34);
+        it = tree.upper_bound(34);
+        assert(it->first == 36);
+        --it;
+        assert(it->first == 34);
+        assert(tree.lower_bound(5000) == tree.end());
+
+        auto last = tree.end();
+        --last;
+        assert(last->first == 998);
+
+        for (int i = 0; i < 500; i += 2) {
+            assert(tree.remove(i * 2));
+        }
+        assert(!tree.remove(0));
+        assert(tree.size() == 250);
+        assert(tree.validate());
+    }
+    removeFile(filename);
+
+    std::cout << "✓ Basic disk tree operations test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    for (size_t pageSize : {64u, 128u, 512u}) {
+        std::string filename = getTempFilename();
+        {
+            // The smallest budget, so most page accesses evict another page
+            DiskBPlusTree<int, int> tree(filename, 0, pageSize);
+            std::map<int, int> expected;
+            std::mt19937 rng(static_cast<unsigned>(pageSize));
+            std::uniform_int_distribution<int> dist(0, 5000);
+
+            for (int i = 0; i < 20000; i++) {
+                int key = dist(rng);
+                if (rng() % 3 == 0) {
+                    assert(tree.remove(key) == (expected.erase(key) == 1));
+                } else {
+                    tree.insert(key, i);
+                    expected[key] = i;
+                }
+                if (i % 4999 == 0) {
+                    assertMatches(tree, expected);
+                }
+            }
+            assertMatches(tree, expected);
+            assert(tree.statistics().pageEvictionCount > 0);
+            assert(tree.statistics().pageWriteCount > 0);
+
+            // Drain the tree so merges run up to the root
+            for (const auto& entry : expected) {
+                assert(tree.remove(entry.first));
+            }
+            assert(tree.isEmpty());
+            assert(tree.height() == 0);
+            assert(tree.validate());
+            assert(tree.statistics().leafNodeCount == 0);
+            assert(tree.statistics().internalNodeCount == 0);
+        }
+        removeFile(filename);
+    }
+
+    std::cout << "✓ Randomized disk tree test passed" << std::endl;
+}
+
+void testReopenAndReusePages() {
+    std::string filename = getTempFilename();
+    std::map<int, int> expected;
+    size_t pagesAfterLoad = 0;
+    {
+        DiskBPlusTree<int, int> tree(filename, 0, 256);
+        for (int i = 0; i < 3000; i++) {
+            tree.insert(i, i * 3);
+            expected[i] = i * 3;
+        }
+        pagesAfterLoad = tree.statistics().totalNodeCount();
+    }
+
+    {
+        // The page size comes from the file, not the argument
+        DiskBPlusTree<int, int> tree(filename, 1 << 20, 4096);
+        assert(tree.getPageSize() == 256);
+        assert(tree.statistics().totalNodeCount() == pagesAfterLoad);
+        assertMatches(tree, expected);
+
+        for (int i = 0; i < 3000; i += 3) {
+            assert(tree.remove(i));
+            expected.erase(i);
+        }
+        tree.flush();
+    }
+
+    long sizeBefore = 0;
+    {
+        FILE* file = std::fopen(filename.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        sizeBefore = std::ftell(file);
+        std::fclose(file);
+    }
+
+    {
+        // Freed pages are reused before the file grows
+        DiskBPlusTree<int, int> tree(filename, 0);
+        assertMatches(tree, expected);
+        for (int i = 0; i < 3000; i += 3) {
+            tree.insert(i, -i);
+            expected[i] = -i;
+        }
+        assertMatches(tree, expected);
+    }
+
+    {
+        FILE* file = std::fopen(filename.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        assert(std::ftell(file) <= sizeBefore);
+        std::fclose(file);
+    }
+
+    {
+        DiskBPlusTree<int, int> tree(filename);
+        assertMatches(tree, expected);
+        tree.clear();
+        assert(tree.isEmpty());
+        tree.insert(1, 1);
+    }
+    {
+        DiskBPlusTree<int, int> tree(filename);
+        assert(tree.size() == 1);
+        assert(tree.validate());
+    }
+    removeFile(filename);
+
+    std::cout << "✓ Reopen and page reuse test passed" << std::endl;
+}
+
+void testIncompatibleFiles() {
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<int, int> tree(filename);
+        tree.insert(1, 2);
+    }
+
+    bool threw = false;
+    try {
+        DiskBPlusTree<int64_t, int> wrongKey(filename);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+    removeFile(filename);
+
+    {
+        FILE* file = std::fopen(filename.c_str(), "wb");
+        std::fputs("this is not a tree file", file);
+        std::fclose(file);
+    }
+    threw = false;
+    try {
+        DiskBPlusTree<int, int> garbage(filename);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    removeFile(filename);
+
+    threw = false;
+    try {
+        DiskBPlusTree<int, int> tiny(filename, 0, 24);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    removeFile(filename);
+
+    std::cout << "✓ Incompatible files test passed" << std::endl;
+}
+
+void testHitRateFollowsMemoryBudget() {
+    const int NUM_KEYS = 100000;
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<int, int> tree(filename, 1 << 20);
+        for (int i = 0; i < NUM_KEYS; i++) {
+            tree.insert(i, i);
+        }
+        tree.flush();
+    }
+
+    double smallRate = 0;
+    double largeRate = 0;
+    for (size_t budget : {size_t(64) << 10, size_t(8) << 20}) {
+        DiskBPlusTree<int, int> tree(filename, budget);
+        std::mt19937 rng(3);
+        for (int i = 0; i < 50000; i++) {
+            int value = 0;
+            int key = static_cast<int>(rng() % NUM_KEYS);
+            assert(tree.search(key, value) && value == key);
+        }
+        (budget < (size_t(1) << 20) ? smallRate : largeRate) = tree.statistics().pageHitRate();
+    }
+    // 8 MiB holds the whole file, 64 KiB only its upper levels
+    assert(largeRate > smallRate);
+    assert(largeRate > 0.9);
+    removeFile(filename);
+
+    std::cout << "✓ Hit rate test passed (64 KiB: " << smallRate << ", 8 MiB: "
+              << largeRate << ")" << std::endl;
+}
+
+void testDiskPerformanceComparison() {
+    const int NUM_ELEMENTS = 200000;
+    std::vector<int> keys(NUM_ELEMENTS);
+    for (int i = 0; i < NUM_ELEMENTS; i++) keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+
+    // Measure random inserts into the in-memory tree
+    auto start1 = std::chrono::high_resolution_clock::now();
+    BPlusTree<int, int> memory(128);
+    for (int key : keys) {
+        memory.insert(key, key);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto memoryTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure random inserts into a disk tree with a quarter of the data in memory
+    std::string filename = getTempFilename();
+    auto start2 = std::chrono::high_resolution_clock::now();
+    double hitRate = 0;
+    {
+        DiskBPlusTree<int, int> disk(filename, NUM_ELEMENTS * 2 * sizeof(int) / 4);
+        for (int key : keys) {
+            disk.insert(key, key);
+        }
+        disk.flush();
+        hitRate = disk.statistics().pageHitRate();
+        assert(disk.size() == memory.size());
+        assert(disk.validate());
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto diskTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    removeFile(filename);
+
+    std::cout << "✓ Disk performance comparison test passed" << std::endl;
+    std::cout << "  BPlusTree inserts: " << memoryTime << "ms, DiskBPlusTree inserts: "
+              << diskTime << "ms (hit rate " << hitRate << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "Running disk tree tests..." << std::endl;
+
+    testEmptyTree();
+    testBasicOperations();
+    testRandomizedAgainstMap();
+    testReopenAndReusePages();
+    testIncompatibleFiles();
+    testHitRateFollowsMemoryBudget();
+    testDiskPerformanceComparison();
+
+    std::cout << "\n✓ All disk tree tests passed!" << std::endl;
+    return 0;
+}
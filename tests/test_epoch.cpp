@@ -0,0 +1,295 @@
+#include "../include/BPlusTree.h"
+#include "../include/EpochReclamation.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+using namespace bptree;
+
+namespace {
+
+std::atomic<int> liveObjects{0};
+
+struct Tracked {
+    int magic = 0x5eed;
+    Tracked() { liveObjects++; }
+    ~Tracked() { magic = 0; liveObjects--; }
+};
+
+void reclaimTracked(void* object, void*) {
+    delete static_cast<Tracked*>(object);
+}
+
+} // namespace
+
+void testRetireAndReclaim() {
+    {
+        EpochManager epochs(8);
+        EpochManager::Participant* self = epochs.registerThread();
+
+        for (int i = 0; i < 100; i++) {
+            epochs.retire(*self, new Tracked(), &reclaimTracked);
+        }
+        // Batched collection has already reclaimed the older retirements
+        assert(epochs.reclaimedCount() > 0);
+        assert(epochs.pendingCount() + epochs.reclaimedCount() == 100);
+
+        epochs.synchronize(*self);
+        assert(epochs.pendingCount() == 0);
+        assert(liveObjects.load() == 0);
+        epochs.unregisterThread(self);
+    }
+    assert(liveObjects.load() == 0);
+
+    std::cout << "✓ Retire and reclaim test passed" << std::endl;
+}
+
+void testPinnedReaderBlocksReclamation() {
+    EpochManager epochs(1);
+    EpochManager::Participant* writer = epochs.registerThread();
+    EpochManager::Participant* reader = epochs.registerThread();
+
+    {
+        std::optional<EpochManager::Guard> guard;
+        guard.emplace(epochs, *reader);
+        {
+            // Nested guards keep the outer pin
+            EpochManager::Guard inner = epochs.pin(*reader);
+        }
+        epochs.retire(*writer, new Tracked(), &reclaimTracked);
+        for (int i = 0; i < 10; i++) {
+            epochs.collect(*writer);
+        }
+        assert(epochs.pendingCount() == 1);
+        assert(liveObjects.load() == 1);
+    }
+
+    epochs.synchronize(*writer);
+    assert(epochs.pendingCount() == 0);
+    assert(liveObjects.load() == 0);
+
+    bool threw = false;
+    {
+        EpochManager::Guard guard(epochs, *writer);
+        try {
+            epochs.synchronize(*writer);
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+    }
+    assert(threw);
+
+    epochs.unregisterThread(reader);
+    epochs.unregisterThread(writer);
+
+    std::cout << "✓ Pinned reader blocks reclamation test passed" << std::endl;
+}
+
+void testUnregisterHandsOverLimbo() {
+    {
+        EpochManager epochs(1000);
+        EpochManager::Participant* leaving = epochs.registerThread();
+        EpochManager::Participant* staying = epochs.registerThread();
+        for (int i = 0; i < 10; i++) {
+            epochs.retire(*leaving, new Tracked(), &reclaimTracked);
+        }
+        epochs.unregisterThread(leaving);
+        assert(epochs.pendingCount() == 10);
+
+        // Another participant's collections reclaim the orphans
+        for (int i = 0; i < 4; i++) {
+            epochs.collect(*staying);
+        }
+        assert(epochs.pendingCount() == 0);
+
+        // Whatever is left at destruction is reclaimed too
+        epochs.retire(*staying, new Tracked(), &reclaimTracked);
+    }
+    assert(liveObjects.load() == 0);
+
+    std::cout << "✓ Unregister hands over limbo test passed" << std::endl;
+}
+
+void testConcurrentReaders() {
+    EpochManager epochs(16);
+    std::atomic<Tracked*> shared{new Tracked()};
+    std::atomic<bool> done{false};
+    std::atomic<long> reads{0};
+
+    auto reader = [&]() {
+        EpochManager::Participant* self = epochs.registerThread();
+        while (!done.load()) {
+            EpochManager::Guard guard(epochs, *self);
+            Tracked* current = shared.load();
+            assert(current->magic == 0x5eed);
+            reads++;
+        }
+        epochs.unregisterThread(self);
+    };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back(reader);
+    }
+
+    // Replace the shared object repeatedly; readers may still hold the old one
+    EpochManager::Participant* writer = epochs.registerThread();
+    for (int i = 0; i < 20000; i++) {
+        Tracked* old = shared.exchange(new Tracked());
+        epochs.retire(*writer, old, &reclaimTracked);
+    }
+    // On a single core the readers may not have been scheduled yet
+    while (reads.load() == 0) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    epochs.synchronize(*writer);
+    epochs.unregisterThread(writer);
+    delete shared.load();
+    assert(epochs.pendingCount() == 0);
+    assert(liveObjects.load() == 0);
+    assert(reads.load() > 0);
+
+    std::cout << "✓ Concurrent epoch readers test passed" << std::endl;
+}
+
+void testTreeIntegration() {
+    EpochManager epochs;
+    BPlusTree<int, int> tree(4);
+    tree.setEpochManager(&epochs);
+    assert(tree.epochManager() == &epochs);
+
+    for (int i = 0; i < 2000; i++) {
+        tree.insert(i, i);
+    }
+    for (int i = 0; i < 1000; i++) {
+        tree.remove(i);
+    }
+
+    // Merged nodes went through the manager instead of being freed directly
+    assert(tree.validate());
+    assert(tree.size() == 1000);
+    assert(epochs.pendingCount() + epochs.reclaimedCount() > 0);
+
+    // Bulk operations retire the whole previous tree
+    std::vector<std::pair<int, int>> data = {{1, 1}, {2, 2}, {3, 3}};
+    tree.bulkLoad(data);
+    assert(tree.size() == 3);
+
+    // Moving the tree keeps it attached
+    BPlusTree<int, int> moved(std::move(tree));
+    assert(moved.epochManager() == &epochs);
+    assert(tree.epochManager() == nullptr);
+    moved.remove(1);
+    moved.remove(2);
+
+    moved.setEpochManager(nullptr);
+    assert(epochs.pendingCount() == 0);
+    assert(moved.validate());
+
+    std::cout << "✓ Tree epoch integration test passed" << std::endl;
+}
+
+void testMoveWhileReaderPinned() {
+    EpochManager epochs;
+    EpochManager::Participant* reader = epochs.registerThread();
+    {
+        BPlusTree<int, int> tree(4);
+        tree.setEpochManager(&epochs);
+        for (int i = 0; i < 500; i++) tree.insert(i, i);
+
+        // Nodes retired while the reader is pinned cannot be reclaimed yet
+        std::optional<EpochManager::Guard> guard;
+        guard.emplace(epochs, *reader);
+        for (int i = 0; i < 400; i++) tree.remove(i);
+        assert(epochs.pendingCount() > 0);
+
+        // Moves hand the retired nodes over instead of waiting for the reader
+        BPlusTree<int, int> moved(std::move(tree));
+        std::vector<BPlusTree<int, int>> trees;
+        trees.push_back(std::move(moved));
+        trees.reserve(16);
+        BPlusTree<int, int> other(4);
+        std::swap(trees[0], other);
+        assert(other.epochManager() == &epochs && other.size() == 100);
+        other.remove(450);
+        assert(other.validate());
+
+        // Once the reader leaves, the new owner reclaims everything
+        guard.reset();
+        other.setEpochManager(nullptr);
+        assert(epochs.pendingCount() == 0);
+    }
+    epochs.unregisterThread(reader);
+
+    std::cout << "✓ Move while reader pinned test passed" << std::endl;
+}
+
+void testEpochOverheadComparison() {
+    const int NUM_ELEMENTS = 100000;
+
+    auto workload = [](BPlusTree<int, int>& tree) {
+        for (int i = 0; i < NUM_ELEMENTS; i++) {
+            tree.insert(i, i);
+        }
+        for (int i = 0; i < NUM_ELEMENTS; i++) {
+            tree.remove(i);
+        }
+    };
+
+    // Measure the default path (immediate frees)
+    BPlusTree<int, int> plain(16);
+    auto start1 = std::chrono::high_resolution_clock::now();
+    workload(plain);
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto plainTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure with epoch-based deferred frees
+    EpochManager epochs;
+    BPlusTree<int, int> deferred(16);
+    deferred.setEpochManager(&epochs);
+    auto start2 = std::chrono::high_resolution_clock::now();
+    workload(deferred);
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto epochTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    deferred.setEpochManager(nullptr);
+
+    // Measure pin/unpin cost
+    EpochManager::Participant* self = epochs.registerThread();
+    auto start3 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 1000000; i++) {
+        EpochManager::Guard guard(epochs, *self);
+    }
+    auto end3 = std::chrono::high_resolution_clock::now();
+    auto pinTime = std::chrono::duration_cast<std::chrono::microseconds>(end3 - start3).count();
+    epochs.unregisterThread(self);
+
+    assert(plain.isEmpty() && deferred.isEmpty());
+
+    std::cout << "✓ Epoch overhead comparison test passed" << std::endl;
+    std::cout << "  Immediate frees: " << plainTime << "ms, Epoch-deferred frees: " << epochTime
+              << "ms, 1M pin/unpin: " << pinTime << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "Running epoch reclamation tests..." << std::endl;
+
+    testRetireAndReclaim();
+    testPinnedReaderBlocksReclamation();
+    testUnregisterHandsOverLimbo();
+    testConcurrentReaders();
+    testTreeIntegration();
+    testMoveWhileReaderPinned();
+    testEpochOverheadComparison();
+
+    std::cout << "\n✓ All epoch reclamation tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Exact count of keys in [low, high], from the reference map
+size_t exactCount(const std::map<int, int>& expected, int low, int high) {
+    if (high < low) return 0;
+    return static_cast<size_t>(std::distance(expected.lower_bound(low), expected.upper_bound(high)));
+}
+
+void testEmptyAndSmallTrees() {
+    BPlusTree<int, int> tree(4);
+    RangeEstimate empty = tree.estimateRange(0, 100);
+    assert(empty.count == 0 && empty.minCount == 0 && empty.maxCount == 0);
+    assert(empty.selectivity == 0.0);
+
+    // A single leaf is always counted exactly
+    tree.insert(10, 1);
+    tree.insert(20, 2);
+    assert(tree.estimateCount(0, 100) == 2);
+    assert(tree.estimateCount(10, 10) == 1);
+    assert(tree.estimateCount(11, 19) == 0);
+    assert(tree.estimateCount(20, 10) == 0);
+    RangeEstimate half = tree.estimateRange(0, 15);
+    assert(half.count == 1 && half.minCount == 1 && half.maxCount == 1);
+    assert(half.selectivity == 0.5);
+
+    std::cout << "✓ Empty and small tree estimate test passed" << std::endl;
+}
+
+void testBoundsAlwaysHold() {
+    for (size_t order : {3u, 4u, 7u, 32u}) {
+        BPlusTree<int, int> tree(order);
+        std::map<int, int> expected;
+        std::mt19937 rng(static_cast<unsigned>(order));
+        std::uniform_int_distribution<int> dist(0, 20000);
+        for (int i = 0; i < 20000; i++) {
+            int key = dist(rng);
+            if (rng() % 4 == 0) {
+                tree.remove(key);
+                expected.erase(key);
+            } else {
+                tree.insert(key, i);
+                expected[key] = i;
+            }
+        }
+        assert(tree.validate());
+        size_t height = tree.height();
+
+        for (int probe = 0; probe < 200; probe++) {
+            int low = dist(rng);
+            int high = low + static_cast<int>(rng() % (probe % 2 ? 20000 : 300));
+            size_t truth = exactCount(expected, low, high);
+            for (size_t refine = 0; refine <= height; refine++) {
+                RangeEstimate estimate = tree.estimateRange(low, high, refine);
+                assert(estimate.minCount <= truth && truth <= estimate.maxCount);
+                assert(estimate.minCount <= estimate.count && estimate.count <= estimate.maxCount);
+                assert(estimate.selectivity >= 0.0 && estimate.selectivity <= 1.0);
+            }
+            // Refining down to the leaves counts every key
+            RangeEstimate exact = tree.estimateRange(low, high, height);
+            assert(exact.count == truth && exact.minCount == truth && exact.maxCount == truth);
+        }
+    }
+
+    std::cout << "✓ Estimate bounds test passed" << std::endl;
+}
+
+void testRefinementNarrowsBounds() {
+    BPlusTree<int, int> tree(8);
+    for (int i = 0; i < 100000; i++) {
+        tree.insert(i, i);
+    }
+    size_t previous = SIZE_MAX;
+    for (size_t refine = 0; refine <= tree.height(); refine++) {
+        RangeEstimate estimate = tree.estimateRange(1000, 90000, refine);
+        assert(estimate.maxCount - estimate.minCount <= previous);
+        previous = estimate.maxCount - estimate.minCount;
+    }
+    assert(previous == 0);
+
+    // Uniform fill extrapolates well even without refinement
+    RangeEstimate coarse = tree.estimateRange(1000, 90000);
+    assert(std::fabs(static_cast<double>(coarse.count) - 89001.0) / 89001.0 < 0.1);
+    assert(std::fabs(coarse.selectivity - 0.89) < 0.1);
+
+    std::cout << "✓ Estimate refinement test passed" << std::endl;
+}
+
+void testEstimatePerformanceComparison() {
+    // Skewed data: a dense cluster, a long sparse tail and a region thinned by
+    // deletions, so that leaf fill and fanout vary across the tree
+    const int NUM_KEYS = 1000000;
+    BPlusTree<int, int> tree(64);
+    std::map<int, int> expected;
+    std::mt19937 rng(8);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        int key = static_cast<int>(std::pow(u, 3.0) * 50000000.0);
+        tree.insert(key, i);
+        expected[key] = i;
+    }
+    for (auto it = expected.lower_bound(100000); it != expected.end() && it->first < 2000000;) {
+        if (rng() % 10 != 0) {
+            tree.remove(it->first);
+            it = expected.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    assert(tree.validate());
+
+    std::vector<std::pair<int, int>> ranges(1000);
+    for (auto& range : ranges) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        range.first = static_cast<int>(std::pow(u, 3.0) * 50000000.0);
+        range.second = range.first + static_cast<int>(rng() % 2000000);
+    }
+    std::vector<size_t> truth;
+    for (const auto& range : ranges) {
+        truth.push_back(exactCount(expected, range.first, range.second));
+    }
+
+    // Mean relative error over ranges holding at least 1000 keys
+    auto measure = [&](size_t refine, double& meanError, long long& micros) {
+        double errorSum = 0.0;
+        size_t counted = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < ranges.size(); i++) {
+            RangeEstimate estimate = tree.estimateRange(ranges[i].first, ranges[i].second, refine);
+            assert(estimate.minCount <= truth[i] && truth[i] <= estimate.maxCount);
+            if (truth[i] >= 1000) {
+                errorSum += std::fabs(static_cast<double>(estimate.count) - static_cast<double>(truth[i])) /
+                            static_cast<double>(truth[i]);
+                counted++;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        meanError = counted ? errorSum / static_cast<double>(counted) : 0.0;
+    };
+    double error0, error1;
+    long long time0, time1;
+    measure(0, error0, time0);
+    measure(1, error1, time1);
+    assert(error0 < 0.5);
+    assert(error1 <= error0 + 0.05);
+
+    // Counting the same ranges by walking the leaves
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t scanned = 0;
+    for (const auto& range : ranges) {
+        for (auto it = tree.lower_bound(range.first); it != tree.end() && it->first <= range.second; ++it) {
+            scanned++;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto scanTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    size_t total = 0;
+    for (size_t count : truth) total += count;
+    assert(scanned == total);
+
+    std::cout << "✓ Estimate performance comparison test passed" << std::endl;
+    std::cout << "  1000 ranges on skewed data: mean error " << error0 * 100 << "% in " << time0
+              << "us (refine 0), " << error1 * 100 << "% in " << time1 << "us (refine 1); "
+              << "exact leaf scan " << scanTime << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "Running range estimate tests..." << std::endl;
+
+    testEmptyAndSmallTrees();
+    testBoundsAlwaysHold();
+    testRefinementNarrowsBounds();
+    testEstimatePerformanceComparison();
+
+    std::cout << "\n✓ All range estimate tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include "../include/FrozenBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace bptree;
+
+using Frozen = FrozenBPlusTree<int, int>;
+
+// Helper to generate a unique temp filename
+std::string getTempFilename() {
+    static int counter = 0;
+    return "test_frozen_" + std::to_string(counter++) + ".frz";
+}
+
+// Helper to clean up temp files
+void removeFile(const std::string& filename) {
+    std::remove(filename.c_str());
+}
+
+// Checks every read path of a frozen tree against the reference map
+void assertMatches(const Frozen& frozen, const std::map<int, int>& expected) {
+    assert(frozen.validate());
+    assert(frozen.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& entry : frozen) {
+        assert(it != expected.end());
+        assert(entry.first == it->first && entry.second == it->second);
+        ++it;
+    }
+    assert(it == expected.end());
+    assert(static_cast<size_t>(frozen.end() - frozen.begin()) == expected.size());
+
+    // Probe present keys, gaps and both ends
+    int low = expected.empty() ? 0 : expected.begin()->first - 2;
+    int high = expected.empty() ? 0 : expected.rbegin()->first + 2;
+    for (int key = low; key <= high; ++key) {
+        auto want = expected.lower_bound(key);
+        auto got = frozen.lower_bound(key);
+        if (want == expected.end()) {
+            assert(got == frozen.end());
+        } else {
+            assert(got != frozen.end() && got->first == want->first && got->second == want->second);
+        }
+
+        auto wantUpper = expected.upper_bound(key);
+        auto gotUpper = frozen.upper_bound(key);
+        assert((wantUpper == expected.end()) == (gotUpper == frozen.end()));
+        if (wantUpper != expected.end()) assert(gotUpper->first == wantUpper->first);
+
+        int value = 0;
+        bool present = expected.count(key) == 1;
+        assert(frozen.search(key, value) == present);
+        assert(frozen.contains(key) == present);
+        assert((frozen.find(key) != frozen.end()) == present);
+        if (present) assert(value == expected.at(key));
+    }
+}
+
+void testEmptyTree() {
+    FrozenBPlusTree<int, int> frozen;
+    assert(frozen.isEmpty());
+    assert(frozen.height() == 0);
+    assert(frozen.begin() == frozen.end());
+    assert(frozen.lower_bound(5) == frozen.end());
+    assert(frozen.rangeQuery(0, 10).empty());
+    assert(frozen.validate());
+
+    BPlusTree<int, int> tree(4);
+    auto built = Frozen::build(tree);
+    assert(built.isEmpty());
+    assertMatches(built, {});
+
+    std::cout << "✓ Empty frozen tree test passed" << std::endl;
+}
+
+void testBuildFromTree() {
+    for (size_t nodeKeys : {1u, 4u, 5u, 64u}) {
+        for (int n : {1, 4, 5, 17, 64, 65, 1000, 4097}) {
+            BPlusTree<int, int> tree(5);
+            std::map<int, int> expected;
+            for (int i = 0; i < n; i++) {
+                tree.insert(i * 3, -i);
+                expected[i * 3] = -i;
+            }
+            auto frozen = Frozen::build(tree, nodeKeys);
+            assert(frozen.nodeKeys() == std::max<size_t>(nodeKeys, Frozen::MIN_NODE_KEYS));
+            assertMatches(frozen, expected);
+        }
+    }
+
+    // Height grows one level per factor of nodeKeys
+    std::vector<std::pair<int, int>> sorted;
+    for (int i = 0; i < 4 * 4 * 4; i++) sorted.emplace_back(i, i);
+    assert(Frozen::build(sorted, 4).height() == 3);
+    sorted.emplace_back(1000, 0);
+    assert(Frozen::build(sorted, 4).height() == 4);
+
+    bool threw = false;
+    try {
+        Frozen::build(std::vector<std::pair<int, int>>{{2, 0}, {1, 0}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Build from tree test passed" << std::endl;
+}
+
+void testRangeAndIterators() {
+    std::vector<std::pair<int, int>> sorted;
+    for (int i = 0; i < 10000; i++) sorted.emplace_back(i * 2, i);
+    auto frozen = Frozen::build(sorted, 16);
+
+    auto rows = frozen.rangeQuery(101, 120);
+    assert(rows.size() == 10);
+    assert(rows.front().first == 102 && rows.back().first == 120);
+    assert(frozen.rangeQuery(120, 101).empty());
+    assert(frozen.rangeQuery(-10, -1).empty());
+    assert(frozen.rangeQuery(19998, 50000).size() == 1);
+
+    // Random access and reverse traversal
+    auto it = frozen.lower_bound(500);
+    assert(it->first == 500 && it[3].first == 506);
+    assert((it + 10)->second == 260);
+    --it;
+    assert((*it).first == 498);
+    auto last = frozen.end() - 1;
+    assert(last->first == 19998);
+    assert(std::distance(frozen.begin(), frozen.end()) == 10000);
+    assert(std::is_sorted(frozen.begin(), frozen.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; }));
+
+    size_t visited = 0;
+    frozen.forEach([&](const int& key, const int& value) {
+        assert(key == value * 2);
+        visited++;
+    });
+    assert(visited == 10000);
+
+    std::cout << "✓ Frozen range and iterator test passed" << std::endl;
+}
+
+void testSaveLoadAndBlob() {
+    std::string filename = getTempFilename();
+    std::map<int, int> expected;
+    BPlusTree<int, int> tree(32);
+    std::mt19937 rng(2);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 100000);
+        tree.insert(key, i);
+        expected[key] = i;
+    }
+    auto frozen = Frozen::build(tree, 32);
+    frozen.save(filename);
+
+    auto loaded = Frozen::loadFromFile(filename);
+    assertMatches(loaded, expected);
+    assert(loaded.memoryUsage() == frozen.memoryUsage());
+
+    // The blob is position independent, so a byte copy is a working tree
+    std::vector<unsigned char> bytes(frozen.data(), frozen.data() + frozen.memoryUsage());
+    auto copy = Frozen::fromBlob(bytes.data(), bytes.size());
+    assertMatches(copy, expected);
+
+    // Wrong value size
+    bool threw = false;
+    try {
+        FrozenBPlusTree<int, int64_t>::loadFromFile(filename);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Truncated and corrupted blobs
+    threw = false;
+    try {
+        Frozen::fromBlob(bytes.data(), bytes.size() - 1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    bytes[0] ^= 0xff;
+    threw = false;
+    try {
+        Frozen::fromBlob(bytes.data(), bytes.size());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    removeFile(filename);
+
+    // An empty tree round-trips too
+    Frozen().save(filename);
+    assert(Frozen::loadFromFile(filename).isEmpty());
+    removeFile(filename);
+
+    std::cout << "✓ Frozen save/load and blob test passed" << std::endl;
+}
+
+void testFrozenPerformanceComparison() {
+    const int NUM_ELEMENTS = 1000000;
+    BPlusTree<int, int> tree(64);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        tree.insert(i * 2, i);
+    }
+    auto frozen = Frozen::build(tree);
+
+    // Node objects plus their key, value and child arrays (maxKeys + 1 slots each)
+    const auto& stats = tree.statistics();
+    size_t slots = 64;  // order 64: maxKeys + 1 key slots
+    size_t treeBytes = stats.leafNodeCount * (sizeof(LeafNode<int, int>) + slots * 2 * sizeof(int)) +
+                       stats.internalNodeCount * (sizeof(InternalNode<int, int>) + slots * sizeof(int) +
+                                                  (slots + 2) * sizeof(void*));
+    double frozenPerEntry = static_cast<double>(frozen.memoryUsage()) / NUM_ELEMENTS;
+    assert(frozenPerEntry < 2 * sizeof(int) * 1.05);
+
+    std::vector<int> probes(1000000);
+    std::mt19937 rng(6);
+    for (auto& probe : probes) probe = static_cast<int>(rng() % (2 * NUM_ELEMENTS));
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    size_t hits1 = 0;
+    for (int probe : probes) {
+        int value;
+        hits1 += tree.search(probe, value);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto treeTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    size_t hits2 = 0;
+    for (int probe : probes) {
+        int value;
+        hits2 += frozen.search(probe, value);
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto frozenTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    assert(hits1 == hits2);
+
+    std::cout << "✓ Frozen performance comparison test passed" << std::endl;
+    std::cout << "  Memory per entry: BPlusTree ~" << static_cast<double>(treeBytes) / NUM_ELEMENTS
+              << " bytes, FrozenBPlusTree " << frozenPerEntry << " bytes" << std::endl;
+    std::cout << "  1M random searches: BPlusTree " << treeTime << "ms, FrozenBPlusTree "
+              << frozenTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running frozen tree tests..." << std::endl;
+
+    testEmptyTree();
+    testBuildFromTree();
+    testRangeAndIterators();
+    testSaveLoadAndBlob();
+    testFrozenPerformanceComparison();
+
+    std::cout << "\n✓ All frozen tree tests passed!" << std::endl;
+    return 0;
+}
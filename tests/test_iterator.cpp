@@ -355,6 +355,44 @@ void testLargeTreeIteration() {
     std::cout << "✓ Large tree iteration test passed" << std::endl;
 }
 
+void testLowerUpperBound() {
+    BPlusTree<int, std::string> tree(4);
+    for (int i = 0; i < 100; i += 10) {
+        tree.insert(i, "v" + std::to_string(i));
+    }
+
+    // Exact match
+    auto it = tree.lower_bound(30);
+    assert(it != tree.end() && it->first == 30);
+    it = tree.upper_bound(30);
+    assert(it != tree.end() && it->first == 40);
+
+    // Between keys, including across leaf boundaries
+    for (int k = 1; k < 90; k++) {
+        int expected = (k + 9) / 10 * 10;
+        assert(tree.lower_bound(k)->first == expected);
+        assert(tree.upper_bound(k)->first == (k % 10 == 0 ? k + 10 : expected));
+    }
+
+    // Before the first and past the last key
+    assert(tree.lower_bound(-5)->first == 0);
+    assert(tree.lower_bound(91) == tree.end());
+    assert(tree.upper_bound(90) == tree.end());
+
+    // Const versions and iteration from the bound
+    const auto& constTree = tree;
+    int count = 0;
+    for (auto cit = constTree.lower_bound(45); cit != constTree.end(); ++cit) {
+        count++;
+    }
+    assert(count == 5);
+
+    BPlusTree<int, int> empty(4);
+    assert(empty.lower_bound(1) == empty.end());
+
+    std::cout << "✓ lower_bound/upper_bound test passed" << std::endl;
+}
+
 int main() {
     std::cout << "Running B+ Tree Iterator Tests..." << std::endl;
     std::cout << "=================================" << std::endl;
@@ -374,6 +412,7 @@ int main() {
     testIteratorAfterModification();
     testIteratorDereference();
     testLargeTreeIteration();
+    testLowerUpperBound();
 
     std::cout << "=================================" << std::endl;
     std::cout << "All iterator tests passed!" << std::endl;
@@ -0,0 +1,278 @@
+#include "../include/LatchFreeBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace bptree;
+
+void testBasicOperations() {
+    LatchFreeBPlusTree<int, std::string> tree(4, 4);
+    assert(tree.isEmpty());
+
+    assert(tree.insert(1, "one"));
+    assert(tree.insert(2, "two"));
+    assert(!tree.insert(1, "uno"));
+    assert(tree.size() == 2);
+
+    std::string value;
+    assert(tree.search(1, value) && value == "uno");
+    assert(tree.search(2, value) && value == "two");
+    assert(!tree.search(3, value));
+
+    assert(tree.remove(2));
+    assert(!tree.remove(2));
+    assert(!tree.contains(2));
+    assert(tree.size() == 1);
+    assert(tree.validate());
+
+    std::cout << "✓ Latch-free basic operations test passed" << std::endl;
+}
+
+void testSplitsAndConsolidation() {
+    LatchFreeBPlusTree<int, int> tree(8, 4);
+    for (int i = 0; i < 2000; i++) {
+        tree.insert((i * 7919) % 2000, i);
+    }
+    assert(tree.size() == 2000);
+    assert(tree.validate());
+    assert(tree.splitCount() > 0);
+    assert(tree.consolidationCount() > 0);
+
+    auto rows = tree.rangeQuery(100, 199);
+    assert(rows.size() == 100);
+    for (size_t i = 0; i < rows.size(); i++) {
+        assert(rows[i].first == static_cast<int>(100 + i));
+    }
+    assert(tree.rangeQuery(5000, 6000).empty());
+    assert(tree.rangeQuery(10, 5).empty());
+
+    std::cout << "✓ Latch-free splits and consolidation test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    LatchFreeBPlusTree<int, int> tree(6, 3);
+    std::map<int, int> expected;
+
+    for (int i = 0; i < 20000; i++) {
+        int key = dist(rng);
+        if (rng() % 3 == 0) {
+            assert(tree.remove(key) == (expected.erase(key) == 1));
+        } else {
+            assert(tree.insert(key, i) == (expected.count(key) == 0));
+            expected[key] = i;
+        }
+    }
+
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto rows = tree.rangeQuery(0, 3000);
+    assert(rows.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        assert(row.first == it->first && row.second == it->second);
+        ++it;
+    }
+
+    std::cout << "✓ Latch-free randomized test passed" << std::endl;
+}
+
+void testConcurrentInserts() {
+    const int THREADS = 8;
+    const int PER_THREAD = 5000;
+    LatchFreeBPlusTree<int, int> tree(16);
+
+    // Interleaved keys make every thread hit the same pages
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&tree, t]() {
+            for (int i = 0; i < PER_THREAD; i++) {
+                tree.insert(i * THREADS + t, t);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    assert(tree.size() == static_cast<size_t>(THREADS * PER_THREAD));
+    assert(tree.validate());
+    for (int key = 0; key < THREADS * PER_THREAD; key++) {
+        int value = -1;
+        assert(tree.search(key, value));
+        assert(value == key % THREADS);
+    }
+
+    std::cout << "✓ Concurrent inserts test passed" << std::endl;
+}
+
+void testConcurrentMixedWorkload() {
+    const int THREADS = 6;
+    LatchFreeBPlusTree<int, int> tree(8, 4);
+
+    // Stable keys are never touched by writers and must always be visible
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i * 10, i);
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&tree, t]() {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            for (int i = 0; i < 5000; i++) {
+                int key = static_cast<int>(rng() % 1000) * 10 + 1 + t;
+                if (rng() % 2) {
+                    tree.insert(key, t);
+                } else {
+                    tree.remove(key);
+                }
+            }
+        });
+    }
+    std::thread reader([&tree, &done]() {
+        while (!done.load()) {
+            for (int i = 0; i < 1000; i += 37) {
+                int value = -1;
+                assert(tree.search(i * 10, value) && value == i);
+            }
+            auto rows = tree.rangeQuery(0, 500);
+            assert(!rows.empty() && rows.front().first == 0);
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+
+    assert(tree.validate());
+    for (int i = 0; i < 1000; i++) {
+        assert(tree.contains(i * 10));
+    }
+
+    std::cout << "✓ Concurrent mixed workload test passed" << std::endl;
+}
+
+void testThreadRegistrationsAreReleased() {
+    size_t before = detail::threadRegistrations().size();
+
+    // Trees this thread used and destroyed leave no registration behind
+    for (int i = 0; i < 100; i++) {
+        LatchFreeBPlusTree<int, int> shortLived(4);
+        shortLived.insert(i, i);
+        assert(detail::threadRegistrations().size() <= before + 1);
+    }
+
+    // Threads that used the tree and exited are no longer scanned
+    LatchFreeBPlusTree<int, int> tree(4);
+    for (int round = 0; round < 5; round++) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&tree, round, t]() {
+                tree.insert(round * 4 + t, t);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        assert(tree.registeredThreadCount() == 0);
+    }
+    assert(tree.contains(19));
+    assert(tree.registeredThreadCount() == 1);
+    assert(tree.size() == 20 && tree.validate());
+
+    // A thread that outlives the tree still exits cleanly
+    std::thread survivor;
+    std::atomic<bool> used{false};
+    std::atomic<bool> release{false};
+    {
+        LatchFreeBPlusTree<int, int> doomed(4);
+        survivor = std::thread([&doomed, &used, &release]() {
+            doomed.insert(1, 1);
+            used = true;
+            while (!release.load()) std::this_thread::yield();
+        });
+        while (!used.load()) std::this_thread::yield();
+    }
+    release = true;
+    survivor.join();
+
+    std::cout << "✓ Thread registration cleanup test passed" << std::endl;
+}
+
+void testHotLeafPerformanceComparison() {
+    const int THREADS = 8;
+    const int PER_THREAD = 50000;
+
+    // Skewed workload: all threads update a small hot key range
+    auto hotKey = [](std::mt19937& rng) { return static_cast<int>(rng() % 256); };
+
+    LatchFreeBPlusTree<int, int> latchFree(64);
+    auto start1 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                for (int i = 0; i < PER_THREAD; i++) {
+                    latchFree.insert(hotKey(rng), i);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto latchFreeTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    BPlusTree<int, int> locked(64);
+    std::mutex treeMutex;
+    auto start2 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                for (int i = 0; i < PER_THREAD; i++) {
+                    int key = hotKey(rng);
+                    std::lock_guard<std::mutex> lock(treeMutex);
+                    locked.insert(key, i);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto lockedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(latchFree.validate());
+    assert(latchFree.size() == locked.size());
+
+    std::cout << "✓ Hot leaf performance comparison test passed" << std::endl;
+    std::cout << "  Latch-free deltas: " << latchFreeTime << "ms, Mutex-guarded tree: " << lockedTime
+              << "ms (" << THREADS << " threads, " << latchFree.casRetryCount() << " CAS retries)"
+              << std::endl;
+}
+
+int main() {
+    std::cout << "Running latch-free tree tests..." << std::endl;
+
+    testBasicOperations();
+    testSplitsAndConsolidation();
+    testRandomizedAgainstMap();
+    testConcurrentInserts();
+    testConcurrentMixedWorkload();
+    testThreadRegistrationsAreReleased();
+    testHotLeafPerformanceComparison();
+
+    std::cout << "\n✓ All latch-free tree tests passed!" << std::endl;
+    return 0;
+}
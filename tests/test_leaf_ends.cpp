@@ -0,0 +1,199 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <utility>
+
+using namespace bptree;
+
+// Checks the O(1) ends of a tree against the reference map
+void assertEnds(const BPlusTree<int, int>& tree, const std::map<int, int>& expected) {
+    assert(tree.validate());
+    if (expected.empty()) {
+        assert(tree.begin() == tree.end());
+        assert(tree.rbegin() == tree.rend());
+        return;
+    }
+    assert(tree.front().first == expected.begin()->first && tree.front().second == expected.begin()->second);
+    assert(tree.back().first == expected.rbegin()->first && tree.back().second == expected.rbegin()->second);
+    assert(tree.begin()->first == expected.begin()->first);
+    assert(tree.rbegin()->first == expected.rbegin()->first);
+    auto last = tree.end();
+    --last;
+    assert(last->first == expected.rbegin()->first);
+}
+
+void testEndsFollowUpdates() {
+    for (size_t order : {3u, 4u, 16u}) {
+        BPlusTree<int, int> tree(order);
+        std::map<int, int> expected;
+        assertEnds(tree, expected);
+
+        // Growing at both ends splits the first and last leaves repeatedly
+        for (int i = 0; i < 500; i++) {
+            tree.insert(i, i);
+            tree.insert(-i - 1, i);
+            expected[i] = i;
+            expected[-i - 1] = i;
+            assertEnds(tree, expected);
+        }
+
+        // Shrinking from both ends merges them away again
+        std::mt19937 rng(static_cast<unsigned>(order));
+        while (!expected.empty()) {
+            int key = rng() % 3 == 0 ? expected.rbegin()->first :
+                      rng() % 2 == 0 ? expected.begin()->first :
+                      std::next(expected.begin(), static_cast<long>(rng() % expected.size()))->first;
+            assert(tree.remove(key));
+            expected.erase(key);
+            assertEnds(tree, expected);
+        }
+        assert(tree.isEmpty());
+
+        tree.insert(7, 70);
+        expected[7] = 70;
+        assertEnds(tree, expected);
+    }
+
+    std::cout << "✓ Leaf ends follow updates test passed" << std::endl;
+}
+
+void testEndsAfterRebuilds() {
+    std::vector<std::pair<int, int>> data;
+    std::map<int, int> expected;
+    for (int i = 0; i < 1000; i++) {
+        data.emplace_back(i * 2, i);
+        expected[i * 2] = i;
+    }
+    BPlusTree<int, int> tree(5);
+    tree.bulkLoad(data.begin(), data.end());
+    assertEnds(tree, expected);
+
+    // splitAt hands the upper leaves to a new tree
+    auto upper = tree.splitAt(1000);
+    std::map<int, int> expectedUpper(expected.lower_bound(1000), expected.end());
+    expected.erase(expected.lower_bound(1000), expected.end());
+    assertEnds(tree, expected);
+    assertEnds(upper, expectedUpper);
+
+    // mergeFrom rebuilds from both chains and empties the source
+    tree.mergeFrom(std::move(upper));
+    expected.insert(expectedUpper.begin(), expectedUpper.end());
+    assertEnds(tree, expected);
+    assertEnds(upper, {});
+
+    // Clones and moves carry their own ends
+    auto copy = tree.clone();
+    assertEnds(copy, expected);
+    BPlusTree<int, int> moved(std::move(copy));
+    assertEnds(moved, expected);
+    assertEnds(copy, {});
+    copy = std::move(moved);
+    assertEnds(copy, expected);
+    assertEnds(moved, {});
+
+    // An empty bulk load clears the tree
+    std::vector<std::pair<int, int>> none;
+    copy.bulkLoad(none.begin(), none.end());
+    assertEnds(copy, {});
+
+    std::cout << "✓ Leaf ends after rebuilds test passed" << std::endl;
+}
+
+void testEndsWithSnapshots() {
+    BPlusTree<int, int> tree(4);
+    std::map<int, int> expected;
+    for (int i = 0; i < 200; i++) {
+        tree.insert(i, i);
+        expected[i] = i;
+    }
+
+    // Writing the first and last leaves copies them while the snapshot shares them
+    auto snap = tree.snapshot();
+    tree.insert(0, -1);
+    tree.insert(199, -1);
+    expected[0] = expected[199] = -1;
+    assertEnds(tree, expected);
+    tree.insert(-5, 0);
+    tree.insert(500, 0);
+    expected[-5] = expected[500] = 0;
+    assertEnds(tree, expected);
+    assert(snap.rangeQuery(0, 0).front().second == 0);
+    snap.release();
+
+    auto again = tree.snapshot();
+    for (int i = 0; i < 200; i++) {
+        tree.remove(i);
+        expected.erase(i);
+    }
+    assertEnds(tree, expected);
+    again.release();
+
+    std::cout << "✓ Leaf ends with snapshots test passed" << std::endl;
+}
+
+void testLeafEndsPerformanceComparison() {
+    const int NUM_ELEMENTS = 1000000;
+    BPlusTree<int, int> tree(64);
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < NUM_ELEMENTS; i++) data.emplace_back(i, i);
+    tree.bulkLoad(data.begin(), data.end());
+
+    // The idiomatic loop re-evaluates end() on every step
+    auto start1 = std::chrono::high_resolution_clock::now();
+    long long sum1 = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        sum1 += it->second;
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto idiomaticTime = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1).count();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    long long sum2 = 0;
+    for (auto it = tree.begin(), last = tree.end(); it != last; ++it) {
+        sum2 += it->second;
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto hoistedTime = std::chrono::duration_cast<std::chrono::microseconds>(end2 - start2).count();
+    assert(sum1 == sum2);
+
+    // Ends against a root-to-leaf descent for the same entries
+    const int CALLS = 1000000;
+    auto start3 = std::chrono::high_resolution_clock::now();
+    long long ends = 0;
+    for (int i = 0; i < CALLS; i++) {
+        ends += tree.front().first + tree.back().first;
+    }
+    auto end3 = std::chrono::high_resolution_clock::now();
+    auto endsTime = std::chrono::duration_cast<std::chrono::microseconds>(end3 - start3).count();
+
+    auto start4 = std::chrono::high_resolution_clock::now();
+    long long descents = 0;
+    for (int i = 0; i < CALLS; i++) {
+        descents += tree.lower_bound(0)->first + tree.lower_bound(NUM_ELEMENTS - 1)->first;
+    }
+    auto end4 = std::chrono::high_resolution_clock::now();
+    auto descentTime = std::chrono::duration_cast<std::chrono::microseconds>(end4 - start4).count();
+    assert(ends == descents);
+
+    std::cout << "✓ Leaf ends performance comparison test passed" << std::endl;
+    std::cout << "  Full scan of 1M: end() per step " << idiomaticTime << "us, hoisted end() "
+              << hoistedTime << "us" << std::endl;
+    std::cout << "  1M front()+back(): " << endsTime << "us vs two descents " << descentTime << "us"
+              << std::endl;
+}
+
+int main() {
+    std::cout << "Running leaf ends tests..." << std::endl;
+
+    testEndsFollowUpdates();
+    testEndsAfterRebuilds();
+    testEndsWithSnapshots();
+    testLeafEndsPerformanceComparison();
+
+    std::cout << "\n✓ All leaf ends tests passed!" << std::endl;
+    return 0;
+}
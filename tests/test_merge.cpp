@@ -0,0 +1,304 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+
+using namespace bptree;
+
+// Checks that the tree holds exactly the entries of the reference map
+template<typename Tree>
+void assertMatches(const Tree& tree, const std::map<int, int>& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto it = expected.begin();
+    for (auto entry : tree) {
+        assert(it != expected.end());
+        assert(entry.first == it->first);
+        assert(entry.second == it->second);
+        ++it;
+    }
+    assert(it == expected.end());
+}
+
+void testMergeIntoEmpty() {
+    BPlusTree<int, int> tree(4);
+    BPlusTree<int, int> other(4);
+    std::map<int, int> expected;
+    for (int i = 0; i < 50; i++) {
+        other.insert(i, i * 2);
+        expected[i] = i * 2;
+    }
+
+    tree.mergeFrom(std::move(other));
+
+    assertMatches(tree, expected);
+    assert(other.isEmpty());
+    assert(other.statistics().leafNodeCount == 0);
+    assert(other.statistics().internalNodeCount == 0);
+
+    std::cout << "✓ Merge into empty tree test passed" << std::endl;
+}
+
+void testMergeEmptyOther() {
+    BPlusTree<int, int> tree(4);
+    BPlusTree<int, int> other(4);
+    std::map<int, int> expected;
+    for (int i = 0; i < 20; i++) {
+        tree.insert(i, i);
+        expected[i] = i;
+    }
+
+    tree.mergeFrom(std::move(other));
+
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Merge empty tree test passed" << std::endl;
+}
+
+void testMergeInterleaved() {
+    BPlusTree<int, int> tree(5);
+    BPlusTree<int, int> other(5);
+    std::map<int, int> expected;
+    for (int i = 0; i < 200; i += 2) {
+        tree.insert(i, i);
+        expected[i] = i;
+    }
+    for (int i = 1; i < 200; i += 2) {
+        other.insert(i, -i);
+        expected[i] = -i;
+    }
+
+    tree.mergeFrom(std::move(other));
+
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Interleaved merge test passed" << std::endl;
+}
+
+void testMergeConflictPolicies() {
+    BPlusTree<int, std::string> keep(4);
+    BPlusTree<int, std::string> overwrite(4);
+    BPlusTree<int, std::string> delta1(4);
+    BPlusTree<int, std::string> delta2(4);
+
+    for (int i = 0; i < 30; i++) {
+        keep.insert(i, "base");
+        overwrite.insert(i, "base");
+    }
+    for (int i = 20; i < 40; i++) {
+        delta1.insert(i, "delta");
+        delta2.insert(i, "delta");
+    }
+
+    keep.mergeFrom(std::move(delta1), ConflictPolicy::KEEP_EXISTING);
+    overwrite.mergeFrom(std::move(delta2), ConflictPolicy::OVERWRITE);
+
+    assert(keep.validate());
+    assert(overwrite.validate());
+    assert(keep.size() == 40);
+    assert(overwrite.size() == 40);
+
+    std::string value;
+    assert(keep.search(25, value) && value == "base");
+    assert(overwrite.search(25, value) && value == "delta");
+    assert(keep.search(35, value) && value == "delta");
+    assert(overwrite.search(5, value) && value == "base");
+
+    std::cout << "✓ Merge conflict policy test passed" << std::endl;
+}
+
+void testMergeDifferentOrders() {
+    BPlusTree<int, int> tree(3);
+    BPlusTree<int, int> other(16);
+    std::map<int, int> expected;
+    for (int i = 0; i < 100; i++) {
+        tree.insert(i * 3, i);
+        expected[i * 3] = i;
+    }
+    for (int i = 0; i < 100; i++) {
+        other.insert(i * 5, i + 1000);
+        expected[i * 5] = i + 1000;
+    }
+
+    tree.mergeFrom(std::move(other), ConflictPolicy::OVERWRITE);
+
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Merge with different orders test passed" << std::endl;
+}
+
+void testMergeTinyTrees() {
+    // Exercise the short-leaf repair with every small size combination
+    for (int n = 0; n < 12; n++) {
+        for (int m = 0; m < 12; m++) {
+            BPlusTree<int, int> tree(4);
+            BPlusTree<int, int> other(4);
+            std::map<int, int> expected;
+            for (int i = 0; i < n; i++) {
+                tree.insert(i * 2, i);
+                expected[i * 2] = i;
+            }
+            for (int i = 0; i < m; i++) {
+                other.insert(i * 3, i);
+                expected[i * 3] = i;
+            }
+
+            tree.mergeFrom(std::move(other));
+            assertMatches(tree, expected);
+        }
+    }
+
+    std::cout << "✓ Merge tiny trees test passed" << std::endl;
+}
+
+void testMergeRandomized() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 5000);
+
+    BPlusTree<int, int> tree(6);
+    BPlusTree<int, int> other(6);
+    std::map<int, int> expected;
+    for (int i = 0; i < 2000; i++) {
+        int k = dist(rng);
+        tree.insert(k, i);
+        expected[k] = i;
+    }
+    std::map<int, int> otherEntries;
+    for (int i = 0; i < 2000; i++) {
+        int k = dist(rng);
+        other.insert(k, -i);
+        otherEntries[k] = -i;
+    }
+    for (const auto& entry : otherEntries) {
+        expected[entry.first] = entry.second;
+    }
+
+    tree.mergeFrom(std::move(other), ConflictPolicy::OVERWRITE);
+
+    assertMatches(tree, expected);
+
+    // The merged tree must keep working with regular operations
+    for (int i = 0; i < 1000; i++) {
+        int k = dist(rng);
+        tree.remove(k);
+        expected.erase(k);
+    }
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Randomized merge test passed" << std::endl;
+}
+
+void testParallelMerge() {
+    for (size_t threads : {2u, 3u, 4u, 8u}) {
+        BPlusTree<int, int> tree(8);
+        BPlusTree<int, int> other(8);
+        std::map<int, int> expected;
+        for (int i = 0; i < 20000; i += 3) {
+            tree.insert(i, i);
+            expected[i] = i;
+        }
+        for (int i = 0; i < 20000; i += 7) {
+            other.insert(i, -i);
+            expected[i] = -i;
+        }
+
+        tree.mergeFrom(std::move(other), ConflictPolicy::OVERWRITE, threads);
+
+        assertMatches(tree, expected);
+        assert(other.isEmpty());
+    }
+
+    // More threads than leaves must still work
+    BPlusTree<int, int> small(4);
+    BPlusTree<int, int> smallOther(4);
+    small.insert(1, 1);
+    smallOther.insert(2, 2);
+    small.mergeFrom(std::move(smallOther), ConflictPolicy::OVERWRITE, 16);
+    assert(small.size() == 2);
+    assert(small.validate());
+
+    std::cout << "✓ Parallel merge test passed" << std::endl;
+}
+
+void testMergeNodeCounts() {
+    BPlusTree<int, int> tree(4);
+    BPlusTree<int, int> other(4);
+    for (int i = 0; i < 500; i++) {
+        tree.insert(i, i);
+        other.insert(i + 250, i);
+    }
+
+    tree.mergeFrom(std::move(other));
+
+    // Node counts must reflect only the rebuilt tree
+    size_t entries = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        entries++;
+    }
+    assert(entries == 750);
+    assert(tree.statistics().leafNodeCount > 0);
+    assert(tree.averageLeafFillFactor() > 0.5);
+    assert(other.statistics().leafNodeCount == 0);
+
+    std::cout << "✓ Merge node count test passed" << std::endl;
+}
+
+void testMergePerformanceComparison() {
+    const int NUM_ELEMENTS = 100000;
+
+    BPlusTree<int, int> base1(64);
+    BPlusTree<int, int> base2(64);
+    std::vector<std::pair<int, int>> baseData;
+    std::vector<std::pair<int, int>> deltaData;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        baseData.emplace_back(i * 2, i);
+        deltaData.emplace_back(i * 2 + 1, i);
+    }
+    base1.bulkLoad(baseData);
+    base2.bulkLoad(baseData);
+
+    BPlusTree<int, int> delta(64);
+    delta.bulkLoad(deltaData);
+
+    // Measure linear merge
+    auto start1 = std::chrono::high_resolution_clock::now();
+    base1.mergeFrom(std::move(delta));
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto mergeTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure element-wise inserts
+    auto start2 = std::chrono::high_resolution_clock::now();
+    for (const auto& pair : deltaData) {
+        base2.insert(pair.first, pair.second);
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto insertTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(base1.validate());
+    assert(base1.size() == base2.size());
+
+    std::cout << "✓ Merge performance comparison test passed" << std::endl;
+    std::cout << "  mergeFrom: " << mergeTime << "ms, Element-wise insert: " << insertTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running merge tests..." << std::endl;
+
+    testMergeIntoEmpty();
+    testMergeEmptyOther();
+    testMergeInterleaved();
+    testMergeConflictPolicies();
+    testMergeDifferentOrders();
+    testMergeTinyTrees();
+    testMergeRandomized();
+    testParallelMerge();
+    testMergeNodeCounts();
+    testMergePerformanceComparison();
+
+    std::cout << "\n✓ All merge tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include "../include/BPlusMultiMap.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <limits>
+#include <chrono>
+
+using namespace bptree;
+
+void testPostingListEncoding() {
+    PostingList<int> list;
+    assert(list.empty() && list.begin() == list.end());
+
+    std::vector<int> values = {5, 6, 7, 3, -100, std::numeric_limits<int>::max(), std::numeric_limits<int>::min(), 0};
+    for (int v : values) list.push_back(v);
+    assert(list.size() == values.size());
+    assert(std::vector<int>(list.begin(), list.end()) == values);
+
+    // Small deltas take one byte each and stay inline
+    PostingList<long long> ids;
+    for (long long id = 1000; id < 1010; id++) ids.push_back(id);
+    assert(ids.encodedBytes() == 2 + 9);
+    assert(ids.heapBytes() == 0);
+
+    // Longer lists spill to the heap and keep decoding correctly
+    PostingList<uint64_t> wide;
+    std::vector<uint64_t> expected;
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 200; i++) {
+        uint64_t v = rng();
+        wide.push_back(v);
+        expected.push_back(v);
+    }
+    assert(wide.heapBytes() > 0);
+    assert(std::vector<uint64_t>(wide.begin(), wide.end()) == expected);
+
+    // Copies and moves keep their contents
+    PostingList<uint64_t> copy = wide;
+    PostingList<int> moved = std::move(list);
+    assert(std::vector<uint64_t>(copy.begin(), copy.end()) == expected);
+    assert(std::vector<int>(moved.begin(), moved.end()) == values);
+
+    // erase() removes the first occurrence and re-encodes the rest
+    PostingList<short> dup;
+    for (short v : {1, 2, 1, 3}) dup.push_back(v);
+    assert(dup.erase(1));
+    assert((std::vector<short>(dup.begin(), dup.end()) == std::vector<short>{2, 1, 3}));
+    assert(!dup.erase(9));
+
+    // Non-integral values use a plain vector
+    PostingList<std::string> names;
+    names.push_back("a");
+    names.push_back("b");
+    assert(names.size() == 2 && *names.begin() == "a");
+
+    std::cout << "✓ Posting list encoding test passed" << std::endl;
+}
+
+void testMultiMapBasics() {
+    BPlusMultiMap<std::string, int> index(4);
+    index.insert("apple", 3);
+    index.insert("banana", 1);
+    index.insert("apple", 7);
+    index.insert("apple", 3);
+
+    assert(index.size() == 4);
+    assert(index.keyCount() == 2);
+    assert(index.count("apple") == 3);
+    assert(index.count("cherry") == 0);
+    assert(index.contains("banana") && !index.contains("cherry"));
+
+    auto range = index.equal_range("apple");
+    std::vector<int> apples(range.first, range.second);
+    assert((apples == std::vector<int>{3, 7, 3}));
+    auto none = index.equal_range("cherry");
+    assert(none.first == none.second);
+
+    assert(index.remove("apple", 3));
+    assert((index.values("apple") == std::vector<int>{7, 3}));
+    assert(!index.remove("apple", 42));
+    assert(index.remove("banana", 1));
+    assert(!index.contains("banana"));
+    assert(index.remove("apple") == 2);
+    assert(index.isEmpty() && index.keyCount() == 0);
+    assert(index.validate());
+
+    std::cout << "✓ Multimap basics test passed" << std::endl;
+}
+
+void testMultiMapAgainstStdMultimap() {
+    BPlusMultiMap<int, int> tree(5);
+    std::multimap<int, int> reference;
+    std::mt19937 rng(17);
+
+    for (int i = 0; i < 30000; i++) {
+        int key = static_cast<int>(rng() % 500);
+        int value = static_cast<int>(rng() % 50);
+        if (rng() % 5 == 0) {
+            // Remove the first matching pair, as std::multimap keeps insertion order too
+            bool removed = tree.remove(key, value);
+            auto range = reference.equal_range(key);
+            auto it = range.first;
+            while (it != range.second && it->second != value) ++it;
+            assert(removed == (it != range.second));
+            if (it != range.second) reference.erase(it);
+        } else {
+            tree.insert(key, value);
+            reference.emplace(key, value);
+        }
+    }
+
+    assert(tree.size() == reference.size());
+    assert(tree.validate());
+    for (int key = 0; key < 500; key++) {
+        assert(tree.count(key) == reference.count(key));
+    }
+
+    auto rows = tree.rangeQuery(100, 200);
+    std::vector<std::pair<int, int>> expected(reference.lower_bound(100), reference.upper_bound(200));
+    assert(rows == expected);
+
+    std::vector<std::pair<int, int>> all;
+    tree.forEach([&all](const int& key, const int& value) { all.emplace_back(key, value); });
+    std::vector<std::pair<int, int>> everything(reference.begin(), reference.end());
+    assert(all == everything);
+
+    std::cout << "✓ Multimap against std::multimap test passed" << std::endl;
+}
+
+void testMultiMapBulkLoad() {
+    std::vector<std::pair<int, long>> data;
+    for (int key = 0; key < 1000; key++) {
+        for (int d = 0; d < key % 4; d++) {
+            data.emplace_back(key, key * 100L + d);
+        }
+    }
+
+    BPlusMultiMap<int, long> tree(8);
+    tree.insert(-1, -1);
+    tree.bulkLoad(data.begin(), data.end());
+    assert(tree.size() == data.size());
+    assert(!tree.contains(-1));
+    assert(tree.count(7) == 3);
+    assert((tree.values(7) == std::vector<long>{700, 701, 702}));
+    assert(tree.count(8) == 0);
+    assert(tree.validate());
+
+    // Bulk-loaded posting lists accept further values
+    tree.insert(7, 5);
+    assert((tree.values(7) == std::vector<long>{700, 701, 702, 5}));
+
+    std::cout << "✓ Multimap bulk load test passed" << std::endl;
+}
+
+void testMultiMapPerformance() {
+    const int KEYS = 20000;
+    const int PER_KEY = 8;
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    BPlusMultiMap<int, int> multimap(64);
+    for (int d = 0; d < PER_KEY; d++) {
+        for (int key = 0; key < KEYS; key++) multimap.insert(key, key * PER_KEY + d);
+    }
+    size_t counted = 0;
+    for (int key = 0; key < KEYS; key++) counted += multimap.count(key);
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    BPlusTree<int, std::vector<int>> vectors(64);
+    for (int d = 0; d < PER_KEY; d++) {
+        for (int key = 0; key < KEYS; key++) {
+            std::vector<int> list;
+            vectors.search(key, list);
+            list.push_back(key * PER_KEY + d);
+            vectors.insert(key, list);
+        }
+    }
+    size_t counted2 = 0;
+    std::vector<int> list;
+    for (int key = 0; key < KEYS; key++) {
+        vectors.search(key, list);
+        counted2 += list.size();
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    assert(counted == counted2);
+
+    size_t encoded = 0;
+    for (auto it = multimap.postings().begin(); it != multimap.postings().end(); ++it) {
+        encoded += it->second.encodedBytes();
+    }
+
+    auto multimapTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+    auto vectorTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    std::cout << "✓ Multimap performance test passed" << std::endl;
+    std::cout << "  BPlusMultiMap: " << multimapTime << "ms (" << encoded << " encoded bytes), "
+              << "BPlusTree<K, vector<V>>: " << vectorTime << "ms (" << counted * sizeof(int) << " value bytes)"
+              << std::endl;
+}
+
+int main() {
+    std::cout << "Running multimap tests..." << std::endl;
+
+    testPostingListEncoding();
+    testMultiMapBasics();
+    testMultiMapAgainstStdMultimap();
+    testMultiMapBulkLoad();
+    testMultiMapPerformance();
+
+    std::cout << "\n✓ All multimap tests passed!" << std::endl;
+    return 0;
+}
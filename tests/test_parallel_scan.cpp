@@ -0,0 +1,178 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <stdexcept>
+
+using namespace bptree;
+
+void testParallelForEachRange() {
+    BPlusTree<int, int> tree(4);
+    for (int i = 0; i < 5000; i++) {
+        tree.insert(i * 3, i);
+    }
+
+    const int bounds[][2] = {{0, 14997}, {-100, 20000}, {7, 8}, {9, 9}, {100, 4000}, {14990, 30000}, {-5, -1}};
+    for (size_t threads : {1, 2, 3, 8}) {
+        for (const auto& range : bounds) {
+            std::vector<std::atomic<int>> seen(15000);
+            std::atomic<int> count{0};
+            tree.parallelForEach(range[0], range[1], [&](const int& key, const int& value) {
+                assert(key >= range[0] && key <= range[1]);
+                assert(value * 3 == key);
+                seen[key]++;
+                count++;
+            }, threads);
+
+            int expected = 0;
+            for (int k = 0; k < 15000; k += 3) {
+                bool inRange = k >= range[0] && k <= range[1];
+                assert(seen[k].load() == (inRange ? 1 : 0));
+                expected += inRange;
+            }
+            assert(count.load() == expected);
+        }
+    }
+
+    // Inverted and empty ranges
+    std::atomic<int> count{0};
+    tree.parallelForEach(10, 5, [&](const int&, const int&) { count++; }, 4);
+    BPlusTree<int, int> empty(4);
+    empty.parallelForEach([&](const int&, const int&) { count++; }, 4);
+    assert(count.load() == 0);
+
+    std::cout << "✓ Parallel forEach range test passed" << std::endl;
+}
+
+void testParallelForEachAfterRemovals() {
+    BPlusTree<int, std::string> tree(5);
+    std::map<int, std::string> expected;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 10000);
+        if (rng() % 3 == 0) {
+            tree.remove(key);
+            expected.erase(key);
+        } else {
+            tree.insert(key, std::to_string(key));
+            expected[key] = std::to_string(key);
+        }
+    }
+
+    std::mutex mutex;
+    std::map<int, std::string> collected;
+    tree.parallelForEach(2500, 7500, [&](const int& key, const std::string& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(collected.emplace(key, value).second);
+    }, 4);
+    std::map<int, std::string> inRange(expected.lower_bound(2500), expected.upper_bound(7500));
+    assert(collected == inRange);
+
+    std::cout << "✓ Parallel forEach after removals test passed" << std::endl;
+}
+
+void testParallelReduce() {
+    BPlusTree<int, long> tree(8);
+    for (int i = 1; i <= 10000; i++) {
+        tree.insert(i, i);
+    }
+
+    auto add = [](long acc, const int&, const long& value) { return acc + value; };
+    auto plus = [](long a, long b) { return a + b; };
+    for (size_t threads : {1, 2, 4, 16}) {
+        assert(tree.parallelReduce(0L, add, plus, threads) == 50005000L);
+        assert(tree.parallelReduce(101, 200, 0L, add, plus, threads) == 15050L);
+        assert(tree.parallelReduce(200, 101, 7L, add, plus, threads) == 7L);
+    }
+
+    // Partial results are combined in key order
+    BPlusTree<int, std::string> letters(4);
+    std::string alphabet;
+    for (int i = 0; i < 2000; i++) {
+        char c = static_cast<char>('a' + i % 26);
+        letters.insert(i, std::string(1, c));
+        alphabet += c;
+    }
+    std::string joined = letters.parallelReduce(
+        std::string(), [](std::string acc, const int&, const std::string& v) { return acc + v; },
+        [](std::string a, const std::string& b) { return a + b; }, 4);
+    assert(joined == alphabet);
+
+    // bool results avoid the std::vector<bool> pitfall
+    bool allPositive = tree.parallelReduce(
+        true, [](bool acc, const int&, const long& v) { return acc && v > 0; },
+        [](bool a, bool b) { return a && b; }, 4);
+    assert(allPositive);
+
+    std::cout << "✓ Parallel reduce test passed" << std::endl;
+}
+
+void testParallelExceptionPropagation() {
+    BPlusTree<int, int> tree(4);
+    for (int i = 0; i < 5000; i++) {
+        tree.insert(i, i);
+    }
+
+    bool threw = false;
+    try {
+        tree.parallelForEach([](const int& key, const int&) {
+            if (key == 4321) throw std::runtime_error("boom");
+        }, 4);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(tree.validate());
+
+    std::cout << "✓ Parallel exception propagation test passed" << std::endl;
+}
+
+void testParallelScanPerformance() {
+    const int N = 1000000;
+    BPlusTree<int, long> tree(128);
+    std::vector<std::pair<int, long>> data;
+    data.reserve(N);
+    for (int i = 0; i < N; i++) {
+        data.emplace_back(i, i % 1000);
+    }
+    tree.bulkLoad(data.begin(), data.end());
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    long sequential = 0;
+    for (const auto& row : tree.rangeQuery(0, N)) {
+        sequential += row.second;
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    long parallel = tree.parallelReduce(
+        0L, [](long acc, const int&, const long& v) { return acc + v; }, [](long a, long b) { return a + b; });
+    auto end2 = std::chrono::high_resolution_clock::now();
+
+    assert(sequential == parallel);
+    auto sequentialTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+    auto parallelTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    std::cout << "✓ Parallel scan performance test passed" << std::endl;
+    std::cout << "  rangeQuery sum: " << sequentialTime << "ms, parallelReduce: " << parallelTime << "ms ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running parallel scan tests..." << std::endl;
+
+    testParallelForEachRange();
+    testParallelForEachAfterRemovals();
+    testParallelReduce();
+    testParallelExceptionPropagation();
+    testParallelScanPerformance();
+
+    std::cout << "\n✓ All parallel scan tests passed!" << std::endl;
+    return 0;
+}
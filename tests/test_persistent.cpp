@@ -0,0 +1,245 @@
+#include "../include/PersistentBPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Checks that a version holds exactly the entries of the reference map
+template<typename Tree, typename Map>
+void assertMatches(const Tree& tree, const Map& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto it = expected.begin();
+    tree.forEach([&](const typename Map::key_type& key, const typename Map::mapped_type& value) {
+        assert(it != expected.end());
+        assert(key == it->first);
+        assert(value == it->second);
+        ++it;
+    });
+    assert(it == expected.end());
+}
+
+void testEmptyTree() {
+    PersistentBPlusTree<int, int> tree;
+    assert(tree.isEmpty());
+    assert(tree.size() == 0);
+    assert(tree.height() == 0);
+    assert(tree.validate());
+
+    int value = 0;
+    assert(!tree.search(1, value));
+    assert(tree.remove(1).isEmpty());
+    assert(tree.rangeQuery(0, 100).empty());
+
+    std::cout << "✓ Empty persistent tree test passed" << std::endl;
+}
+
+void testVersionsAreImmutable() {
+    PersistentBPlusTree<int, std::string> v0(4);
+    auto v1 = v0.insert(1, "one");
+    auto v2 = v1.insert(2, "two");
+    auto v3 = v2.insert(1, "uno");
+    auto v4 = v3.remove(2);
+
+    std::string value;
+    assert(v0.isEmpty());
+    assert(v1.size() == 1 && v1.search(1, value) && value == "one");
+    assert(v2.size() == 2 && v2.search(1, value) && value == "one");
+    assert(v3.size() == 2 && v3.search(1, value) && value == "uno");
+    assert(v4.size() == 1 && !v4.contains(2));
+    assert(v2.contains(2));
+
+    std::cout << "✓ Immutable versions test passed" << std::endl;
+}
+
+void testInsertSplits() {
+    PersistentBPlusTree<int, int> tree(4);
+    std::map<int, int> expected;
+    for (int i = 0; i < 1000; i++) {
+        int key = (i * 37) % 1000;
+        tree = tree.insert(key, i);
+        expected[key] = i;
+    }
+    assertMatches(tree, expected);
+    assert(tree.height() > 3);
+
+    auto rows = tree.rangeQuery(100, 109);
+    assert(rows.size() == 10);
+    assert(rows.front().first == 100 && rows.back().first == 109);
+
+    std::cout << "✓ Persistent insert with splits test passed" << std::endl;
+}
+
+void testRemoveRebalancing() {
+    for (size_t order : {3u, 4u, 5u, 8u}) {
+        PersistentBPlusTree<int, int> tree(order);
+        std::map<int, int> expected;
+        for (int i = 0; i < 500; i++) {
+            tree = tree.insert(i, i);
+            expected[i] = i;
+        }
+
+        // Remove from both ends and the middle to exercise borrow and merge
+        std::mt19937 rng(static_cast<unsigned>(order));
+        std::vector<int> keys;
+        for (int i = 0; i < 500; i++) keys.push_back(i);
+        std::shuffle(keys.begin(), keys.end(), rng);
+        for (size_t i = 0; i < keys.size(); i++) {
+            tree = tree.remove(keys[i]);
+            expected.erase(keys[i]);
+            if (i % 50 == 0) assertMatches(tree, expected);
+        }
+        assert(tree.isEmpty());
+        assert(tree.height() == 0);
+    }
+
+    std::cout << "✓ Persistent remove with rebalancing test passed" << std::endl;
+}
+
+void testHistoryRandomized() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 3000);
+
+    // Keep every version and check all of them at the end
+    std::vector<PersistentBPlusTree<int, int>> history(1, PersistentBPlusTree<int, int>(5));
+    std::vector<std::map<int, int>> states(1);
+
+    for (int i = 0; i < 3000; i++) {
+        int key = dist(rng);
+        std::map<int, int> state = states.back();
+        if (rng() % 3 == 0) {
+            history.push_back(history.back().remove(key));
+            state.erase(key);
+        } else {
+            history.push_back(history.back().insert(key, i));
+            state[key] = i;
+        }
+        states.push_back(std::move(state));
+    }
+
+    for (size_t v = 0; v < history.size(); v += 97) {
+        assertMatches(history[v], states[v]);
+    }
+    assertMatches(history.back(), states.back());
+
+    std::cout << "✓ Randomized version history test passed" << std::endl;
+}
+
+void testStructuralSharing() {
+    PersistentBPlusTree<int, int> base(16);
+    for (int i = 0; i < 10000; i++) {
+        base = base.insert(i, i);
+    }
+
+    size_t total = base.nodeCount();
+    auto updated = base.insert(5000, -1);
+    auto removed = base.remove(7000);
+
+    // Only the root-to-leaf path is new (plus a sibling when rebalancing)
+    assert(total - base.sharedNodeCount(updated) == base.height());
+    assert(total - base.sharedNodeCount(removed) <= 2 * base.height());
+    assert(base.sharedNodeCount(base.remove(-1)) == total);
+
+    // Forks are O(1) and fully shared
+    auto fork = base;
+    assert(fork.sharedNodeCount(base) == total);
+
+    std::cout << "✓ Structural sharing test passed" << std::endl;
+    std::cout << "  " << total << " nodes, update copied "
+              << (total - base.sharedNodeCount(updated)) << std::endl;
+}
+
+void testConcurrentReadersOfVersions() {
+    PersistentBPlusTree<int, int> base(8);
+    for (int i = 0; i < 5000; i++) {
+        base = base.insert(i, i);
+    }
+
+    // Readers and forks of a shared version need no synchronization
+    auto worker = [&base](int offset) {
+        auto mine = base;
+        for (int i = 0; i < 1000; i++) {
+            mine = mine.insert(10000 + offset * 1000 + i, i);
+            mine = mine.remove(i * 5 + offset);
+        }
+        assert(mine.validate());
+        assert(mine.size() == 5000);
+        int value = 0;
+        assert(base.search(offset, value) && value == offset);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(base.size() == 5000);
+    assert(base.validate());
+
+    std::cout << "✓ Concurrent version readers test passed" << std::endl;
+}
+
+void testPersistentPerformanceComparison() {
+    const int NUM_ELEMENTS = 20000;
+    const int NUM_VERSIONS = 200;
+
+    PersistentBPlusTree<int, int> base(64);
+    std::map<int, int> baseMap;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        base = base.insert(i, i);
+        baseMap[i] = i;
+    }
+
+    // Measure keeping every version by path copying
+    auto start1 = std::chrono::high_resolution_clock::now();
+    std::vector<PersistentBPlusTree<int, int>> versions;
+    auto current = base;
+    for (int i = 0; i < NUM_VERSIONS; i++) {
+        current = current.insert(i * 7, -i);
+        versions.push_back(current);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto persistentTime = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1).count();
+
+    // Measure keeping every version by deep copy
+    auto start2 = std::chrono::high_resolution_clock::now();
+    std::vector<std::map<int, int>> copies;
+    auto currentMap = baseMap;
+    for (int i = 0; i < NUM_VERSIONS; i++) {
+        currentMap[i * 7] = -i;
+        copies.push_back(currentMap);
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto copyTime = std::chrono::duration_cast<std::chrono::microseconds>(end2 - start2).count();
+
+    assert(versions.back().size() == copies.back().size());
+
+    std::cout << "✓ Persistent performance comparison test passed" << std::endl;
+    std::cout << "  Path-copied versions: " << persistentTime << "us, Deep-copied versions: "
+              << copyTime << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "Running persistent tree tests..." << std::endl;
+
+    testEmptyTree();
+    testVersionsAreImmutable();
+    testInsertSplits();
+    testRemoveRebalancing();
+    testHistoryRandomized();
+    testStructuralSharing();
+    testConcurrentReadersOfVersions();
+    testPersistentPerformanceComparison();
+
+    std::cout << "\n✓ All persistent tree tests passed!" << std::endl;
+    return 0;
+}
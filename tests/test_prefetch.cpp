@@ -0,0 +1,142 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Checks forward iteration and rangeQuery against the reference map
+void assertScansMatch(BPlusTree<int, int>& tree, const std::map<int, int>& expected) {
+    auto it = expected.begin();
+    for (auto entry = tree.begin(); entry != tree.end(); ++entry, ++it) {
+        assert(it != expected.end());
+        assert(entry->first == it->first && entry->second == it->second);
+    }
+    assert(it == expected.end());
+
+    const auto& constTree = tree;
+    size_t count = 0;
+    for (auto entry = constTree.begin(); entry != constTree.end(); entry++) count++;
+    assert(count == expected.size());
+
+    auto rows = tree.rangeQuery(-1000000, 1000000);
+    assert(rows.size() == expected.size());
+    assert(std::equal(rows.begin(), rows.end(), expected.begin(),
+                      [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+}
+
+void testPrefetchDistanceSetting() {
+    BPlusTree<int, int> tree(4);
+    assert(tree.getPrefetchDistance() == DEFAULT_PREFETCH_DISTANCE);
+    tree.setPrefetchDistance(8);
+    assert(tree.getPrefetchDistance() == 8);
+
+    // Moves carry the setting along
+    BPlusTree<int, int> moved(std::move(tree));
+    assert(moved.getPrefetchDistance() == 8);
+    BPlusTree<int, int> assigned(16);
+    assigned = std::move(moved);
+    assert(assigned.getPrefetchDistance() == 8);
+
+    std::cout << "✓ Prefetch distance setting test passed" << std::endl;
+}
+
+void testScansUnchangedByPrefetching() {
+    for (size_t order : {3u, 4u, 16u}) {
+        BPlusTree<int, int> tree(order);
+        std::map<int, int> expected;
+        std::mt19937 rng(static_cast<unsigned>(order));
+        std::uniform_int_distribution<int> dist(-5000, 5000);
+
+        // Splits and merges rewire next pointers and parents under the scans
+        for (int round = 0; round < 4; round++) {
+            for (int i = 0; i < 5000; i++) {
+                int key = dist(rng);
+                if (rng() % 3 == 0) {
+                    tree.remove(key);
+                    expected.erase(key);
+                } else {
+                    tree.insert(key, i);
+                    expected[key] = i;
+                }
+            }
+            for (size_t distance : {0u, 1u, 2u, 5u, 64u}) {
+                tree.setPrefetchDistance(distance);
+                assertScansMatch(tree, expected);
+            }
+        }
+
+        // Iterators keep working with a distance past the end of the tree
+        tree.setPrefetchDistance(1000);
+        auto it = tree.lower_bound(0);
+        auto want = expected.lower_bound(0);
+        for (; want != expected.end(); ++want, ++it) {
+            assert(it != tree.end() && it->first == want->first);
+        }
+        assert(it == tree.end());
+    }
+
+    std::cout << "✓ Scans unchanged by prefetching test passed" << std::endl;
+}
+
+void testPrefetchPerformanceComparison() {
+    // Random insertion order scatters the leaves across the heap, so every
+    // leaf boundary is a cache miss once the tree is larger than the cache
+    const int NUM_ELEMENTS = 3000000;
+    std::vector<int> keys(NUM_ELEMENTS);
+    for (int i = 0; i < NUM_ELEMENTS; i++) keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(9));
+    BPlusTree<int, int> tree(16);
+    for (int key : keys) {
+        tree.insert(key, key);
+    }
+    keys.clear();
+    keys.shrink_to_fit();
+
+    // Evicts the tree from every cache level between runs
+    std::vector<char> flush(256 << 20, 1);
+    long long sink = 0;
+    auto evict = [&]() {
+        for (size_t i = 0; i < flush.size(); i += 64) {
+            flush[i]++;
+            sink += flush[i];
+        }
+    };
+    auto scan = [&](size_t distance) {
+        tree.setPrefetchDistance(distance);
+        evict();
+        auto start = std::chrono::high_resolution_clock::now();
+        long long sum = 0;
+        auto last = tree.end();
+        for (auto it = tree.begin(); it != last; ++it) {
+            sum += it->second;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        assert(sum == static_cast<long long>(NUM_ELEMENTS) * (NUM_ELEMENTS - 1) / 2);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    };
+    auto plainTime = scan(0);
+    auto prefetchTime = scan(DEFAULT_PREFETCH_DISTANCE);
+    auto farTime = scan(8);
+    assert(sink > 0);
+
+    std::cout << "✓ Prefetch performance comparison test passed" << std::endl;
+    std::cout << "  Full scan of " << tree.statistics().leafNodeCount << " scattered leaves: no prefetch "
+              << plainTime << "ms, distance " << DEFAULT_PREFETCH_DISTANCE << " " << prefetchTime
+              << "ms, distance 8 " << farTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running prefetch tests..." << std::endl;
+
+    testPrefetchDistanceSetting();
+    testScansUnchangedByPrefetching();
+    testPrefetchPerformanceComparison();
+
+    std::cout << "\n✓ All prefetch tests passed!" << std::endl;
+    return 0;
+}
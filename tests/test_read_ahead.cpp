@@ -0,0 +1,226 @@
+#include "../include/DiskBPlusTree.h"
+#include "../include/PageIO.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace bptree;
+
+// Helper to generate a unique temp filename
+std::string getTempFilename() {
+    static int counter = 0;
+    return "test_read_ahead_" + std::to_string(counter++) + ".db";
+}
+
+// Helper to clean up temp files
+void removeFile(const std::string& filename) {
+    std::remove(filename.c_str());
+}
+
+// Backends to exercise; IO_URING only where the kernel allows it
+std::vector<IOBackend> availableBackends() {
+    std::vector<IOBackend> backends = {IOBackend::SYNC, IOBackend::THREAD_POOL, IOBackend::AUTO};
+    try {
+        detail::makePageReader(IOBackend::IO_URING, 8);
+        backends.push_back(IOBackend::IO_URING);
+    } catch (const std::runtime_error&) {
+        std::cout << "  (io_uring unavailable, skipping that backend)" << std::endl;
+    }
+    return backends;
+}
+
+void testPageReaders() {
+    const size_t PAGE = 512;
+    const size_t PAGES = 100;
+    std::string filename = getTempFilename();
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    assert(fd >= 0);
+    std::vector<char> page(PAGE);
+    for (size_t i = 0; i < PAGES; i++) {
+        std::fill(page.begin(), page.end(), static_cast<char>(i));
+        detail::writePage(fd, page.data(), PAGE, static_cast<off_t>(i * PAGE));
+    }
+
+    for (IOBackend backend : availableBackends()) {
+        auto reader = detail::makePageReader(backend, 8);
+        assert(backend == IOBackend::AUTO || reader->backend() == backend);
+
+        // More requests than the queue depth, in reverse order, plus one past the end
+        std::vector<char> buffer((PAGES + 1) * PAGE, 'x');
+        std::vector<detail::ReadRequest> requests;
+        for (size_t i = PAGES + 1; i-- > 0;) {
+            requests.push_back({fd, buffer.data() + i * PAGE, PAGE, static_cast<off_t>(i * PAGE)});
+        }
+        reader->readBatch(requests);
+        reader->readBatch({});
+
+        for (size_t i = 0; i < PAGES; i++) {
+            assert(buffer[i * PAGE] == static_cast<char>(i));
+            assert(buffer[i * PAGE + PAGE - 1] == static_cast<char>(i));
+        }
+        assert(buffer[PAGES * PAGE] == 0);
+    }
+    ::close(fd);
+
+    // A read on a closed descriptor must surface as an error
+    for (IOBackend backend : {IOBackend::SYNC, IOBackend::THREAD_POOL}) {
+        auto reader = detail::makePageReader(backend, 4);
+        std::vector<char> buffer(PAGE);
+        bool threw = false;
+        try {
+            reader->readBatch({{fd, buffer.data(), PAGE, 0}});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    removeFile(filename);
+
+    std::cout << "✓ Page reader backends test passed" << std::endl;
+}
+
+void testScansReadAhead() {
+    const int NUM_KEYS = 20000;
+    std::string filename = getTempFilename();
+    std::map<int, int> expected;
+    {
+        DiskBPlusTree<int, int> tree(filename, 0, 256);
+        for (int i = 0; i < NUM_KEYS; i++) {
+            tree.insert(i * 2, i);
+            expected[i * 2] = i;
+        }
+    }
+
+    for (IOBackend backend : availableBackends()) {
+        size_t missesWithout = 0;
+        for (size_t readAhead : {size_t(0), size_t(16)}) {
+            DiskBPlusTree<int, int> tree(filename, 64 * 256, 256, backend);
+            tree.setReadAhead(readAhead);
+            assert(tree.readAhead() == readAhead);
+
+            auto rows = tree.rangeQuery(-5, NUM_KEYS * 2);
+            assert(rows.size() == expected.size());
+            auto it = expected.begin();
+            for (const auto& row : rows) {
+                assert(row.first == it->first && row.second == it->second);
+                ++it;
+            }
+
+            if (readAhead == 0) {
+                assert(tree.statistics().pagePrefetchCount == 0);
+                missesWithout = tree.statistics().pageMissCount;
+            } else {
+                // Only the first leaf and the internal pages are read one at a time
+                assert(tree.statistics().pagePrefetchCount > 0);
+                assert(tree.statistics().pageMissCount * 4 < missesWithout);
+            }
+
+            // Forward iteration reads ahead too and sees the same entries
+            tree.resetStatistics();
+            it = expected.begin();
+            for (const auto& entry : tree) {
+                assert(entry.first == it->first && entry.second == it->second);
+                ++it;
+            }
+            assert(it == expected.end());
+            assert((tree.statistics().pagePrefetchCount > 0) == (readAhead > 0));
+        }
+    }
+    removeFile(filename);
+
+    std::cout << "✓ Scan read-ahead test passed" << std::endl;
+}
+
+void testReadAheadStopsAtRangeEnd() {
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<int, int> tree(filename, 0, 256);
+        for (int i = 0; i < 20000; i++) {
+            tree.insert(i, i);
+        }
+        assert(tree.validate());
+    }
+
+    DiskBPlusTree<int, int> tree(filename, 64 * 256, 256);
+    tree.setReadAhead(64);
+    size_t perLeaf = tree.leafCapacity() / 2;
+
+    // A short range must not pull in leaves past its end
+    auto rows = tree.rangeQuery(5000, static_cast<int>(5000 + 3 * perLeaf));
+    assert(rows.size() == 3 * perLeaf + 1);
+    assert(tree.statistics().pagePrefetchCount <= 5);
+
+    // Mutations between scans keep read-ahead correct
+    for (int i = 0; i < 20000; i += 3) {
+        assert(tree.remove(i));
+    }
+    tree.insert(-1, -1);
+    size_t seen = 0;
+    int previous = -2;
+    for (const auto& entry : tree) {
+        assert(entry.first > previous && entry.first % 3 != 0);
+        previous = entry.first;
+        seen++;
+    }
+    assert(seen == tree.size());
+    assert(tree.validate());
+    removeFile(filename);
+
+    std::cout << "✓ Read-ahead range limit test passed" << std::endl;
+}
+
+void testReadAheadPerformanceComparison() {
+    const uint64_t NUM_KEYS = 1000000;
+    std::string filename = getTempFilename();
+    {
+        DiskBPlusTree<uint64_t, uint64_t> tree(filename, 16 << 20);
+        for (uint64_t i = 0; i < NUM_KEYS; i++) {
+            tree.insert(i, i);
+        }
+    }
+
+    auto coldScan = [&](IOBackend backend, size_t readAhead, size_t& rows) {
+        // Drop the file from the OS page cache where the file system allows it
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+
+        DiskBPlusTree<uint64_t, uint64_t> tree(filename, 1 << 20, DEFAULT_PAGE_SIZE, backend);
+        tree.setReadAhead(readAhead);
+        auto start = std::chrono::high_resolution_clock::now();
+        rows = tree.rangeQuery(0, NUM_KEYS).size();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    };
+
+    size_t plainRows = 0;
+    size_t aheadRows = 0;
+    auto plainTime = coldScan(IOBackend::SYNC, 0, plainRows);
+    auto aheadTime = coldScan(IOBackend::AUTO, 32, aheadRows);
+    assert(plainRows == NUM_KEYS && aheadRows == NUM_KEYS);
+    removeFile(filename);
+
+    std::cout << "✓ Read-ahead performance comparison test passed" << std::endl;
+    std::cout << "  Cold scan without read-ahead: " << plainTime << "ms, with read-ahead: "
+              << aheadTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running read-ahead tests..." << std::endl;
+
+    testPageReaders();
+    testScansReadAhead();
+    testReadAheadStopsAtRangeEnd();
+    testReadAheadPerformanceComparison();
+
+    std::cout << "\n✓ All read-ahead tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace bptree;
+
+// Pearson chi-square statistic of observed counts against a uniform expectation
+double chiSquare(const std::map<int, size_t>& observed, size_t categories, size_t draws) {
+    double expected = static_cast<double>(draws) / static_cast<double>(categories);
+    double statistic = static_cast<double>(categories - observed.size()) * expected;
+    for (const auto& entry : observed) {
+        double diff = static_cast<double>(entry.second) - expected;
+        statistic += diff * diff / expected;
+    }
+    return statistic;
+}
+
+void testEmptyAndDegenerate() {
+    BPlusTree<int, int> tree(4);
+    std::mt19937 rng(1);
+    assert(tree.sample(10, rng).empty());
+    assert(tree.sampleRange(0, 100, 10, rng).empty());
+
+    tree.insert(5, 50);
+    auto one = tree.sample(20, rng);
+    assert(one.size() == 20);
+    for (const auto& entry : one) assert(entry.first == 5 && entry.second == 50);
+    assert(tree.sample(0, rng).empty());
+    assert(tree.sampleRange(6, 100, 3, rng).empty());
+    assert(tree.sampleRange(10, 0, 3, rng).empty());
+    assert(tree.sampleRange(5, 5, 3, rng).size() == 3);
+
+    std::cout << "✓ Empty and degenerate sampling test passed" << std::endl;
+}
+
+void testSamplesComeFromTheRange() {
+    for (size_t order : {3u, 4u, 16u}) {
+        BPlusTree<int, int> tree(order);
+        for (int i = 0; i < 5000; i++) {
+            tree.insert(i * 2, i);
+        }
+        std::mt19937 rng(static_cast<unsigned>(order));
+        auto all = tree.sample(1000, rng);
+        assert(all.size() == 1000);
+        for (const auto& entry : all) {
+            assert(entry.first % 2 == 0 && entry.second == entry.first / 2);
+        }
+        for (int probe = 0; probe < 200; probe++) {
+            int low = static_cast<int>(rng() % 10000) - 50;
+            int high = low + static_cast<int>(rng() % (probe % 2 ? 5000 : 40));
+            size_t inRange = tree.rangeQuery(low, high).size();
+            auto rows = tree.sampleRange(low, high, 50, rng);
+            assert(rows.size() == (inRange ? 50u : 0u));
+            for (const auto& entry : rows) {
+                assert(entry.first >= low && entry.first <= high);
+                assert(entry.second == entry.first / 2);
+            }
+        }
+    }
+
+    // The same seed gives the same sample
+    BPlusTree<int, int> tree(8);
+    for (int i = 0; i < 1000; i++) tree.insert(i, i);
+    std::mt19937 a(42), b(42);
+    assert(tree.sample(100, a) == tree.sample(100, b));
+
+    std::cout << "✓ Samples come from the range test passed" << std::endl;
+}
+
+void testUniformity() {
+    // Uneven node fill: dense on the left, thinned by deletions on the right
+    BPlusTree<int, int> tree(6);
+    std::vector<int> keys;
+    for (int i = 0; i < 4000; i++) {
+        tree.insert(i, i);
+    }
+    std::mt19937 rng(3);
+    for (int i = 2000; i < 4000; i++) {
+        if (rng() % 4 != 0) tree.remove(i);
+    }
+    for (auto it = tree.begin(); it != tree.end(); ++it) keys.push_back(it->first);
+    assert(tree.validate());
+
+    // Whole tree: 999-ish degrees of freedom, so 5 standard deviations is a safe bound
+    const size_t DRAWS = keys.size() * 100;
+    std::map<int, size_t> observed;
+    for (const auto& entry : tree.sample(DRAWS, rng)) observed[entry.first]++;
+    double df = static_cast<double>(keys.size() - 1);
+    assert(chiSquare(observed, keys.size(), DRAWS) < df + 5 * std::sqrt(2 * df));
+
+    // A range that straddles the dense and sparse halves
+    size_t inRange = tree.rangeQuery(1500, 2600).size();
+    observed.clear();
+    for (const auto& entry : tree.sampleRange(1500, 2600, inRange * 100, rng)) observed[entry.first]++;
+    df = static_cast<double>(inRange - 1);
+    assert(chiSquare(observed, inRange, inRange * 100) < df + 5 * std::sqrt(2 * df));
+
+    // Half the entries sit in each half, so half the samples should too
+    size_t left = 0;
+    auto rows = tree.sample(100000, rng);
+    for (const auto& entry : rows) left += entry.first < 2000;
+    double expectedLeft = 2000.0 / static_cast<double>(keys.size());
+    assert(std::fabs(static_cast<double>(left) / 100000.0 - expectedLeft) < 0.01);
+
+    std::cout << "✓ Sampling uniformity test passed" << std::endl;
+}
+
+void testSamplePerformanceComparison() {
+    const int NUM_ELEMENTS = 1000000;
+    const size_t K = 100000;
+    BPlusTree<int, int> tree(64);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        tree.insert(i * 7, i);
+    }
+    std::mt19937 rng(5);
+
+    // Reservoir sampling over a full scan
+    auto start1 = std::chrono::high_resolution_clock::now();
+    std::vector<std::pair<int, int>> reservoir;
+    size_t seen = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++seen) {
+        if (reservoir.size() < K) {
+            reservoir.emplace_back(it->first, it->second);
+        } else {
+            size_t slot = std::uniform_int_distribution<size_t>(0, seen)(rng);
+            if (slot < K) reservoir[slot] = {it->first, it->second};
+        }
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto scanTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // One descent per sample
+    auto start2 = std::chrono::high_resolution_clock::now();
+    size_t single = 0;
+    for (size_t i = 0; i < K; i++) {
+        single += tree.sample(1, rng).size();
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto singleTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    // Batched descents
+    auto start3 = std::chrono::high_resolution_clock::now();
+    auto batch = tree.sample(K, rng);
+    auto end3 = std::chrono::high_resolution_clock::now();
+    auto batchTime = std::chrono::duration_cast<std::chrono::milliseconds>(end3 - start3).count();
+    assert(single == K && batch.size() == K && reservoir.size() == K);
+
+    std::cout << "✓ Sample performance comparison test passed" << std::endl;
+    std::cout << "  100K samples of 1M entries: reservoir scan " << scanTime << "ms, one at a time "
+              << singleTime << "ms, batched " << batchTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running sampling tests..." << std::endl;
+
+    testEmptyAndDegenerate();
+    testSamplesComeFromTheRange();
+    testUniformity();
+    testSamplePerformanceComparison();
+
+    std::cout << "\n✓ All sampling tests passed!" << std::endl;
+    return 0;
+}
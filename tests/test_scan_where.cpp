@@ -0,0 +1,244 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <stdexcept>
+
+using namespace bptree;
+
+// Ordered value type that opts into zone maps
+struct Score {
+    int points = 0;
+    bool operator<(const Score& other) const { return points < other.points; }
+    bool operator==(const Score& other) const { return points == other.points; }
+};
+
+namespace bptree {
+template<> struct ZoneMapTraits<Score> : std::true_type {};
+}
+
+void testScanPredicate() {
+    auto between = ScanPredicate<int>::between(10, 20);
+    assert(between.matches(10) && between.matches(20) && !between.matches(21) && !between.matches(9));
+    assert(between.mayMatchRange(0, 10) && between.mayMatchRange(20, 30) && !between.mayMatchRange(21, 30));
+
+    assert(ScanPredicate<int>::less(5).matches(4) && !ScanPredicate<int>::less(5).matches(5));
+    assert(ScanPredicate<int>::lessEqual(5).matches(5));
+    assert(ScanPredicate<int>::greater(5).matches(6) && !ScanPredicate<int>::greater(5).matches(5));
+    assert(ScanPredicate<int>::greaterEqual(5).matches(5));
+    assert(ScanPredicate<int>::equal(5).matches(5) && !ScanPredicate<int>::equal(5).matches(6));
+    assert(ScanPredicate<int>::notEqual(5).matches(6) && !ScanPredicate<int>::notEqual(5).matches(5));
+    assert(!ScanPredicate<int>::notEqual(5).mayMatchRange(5, 5));
+    assert(!ScanPredicate<int>::greater(9).mayMatchRange(0, 9));
+    assert(!ScanPredicate<int>::less(0).mayMatchRange(0, 9));
+    assert(ScanPredicate<int>::any().matches(123));
+
+    std::vector<double> data = {1.5, -2.0, 3.25, 7.0, 0.0};
+    std::vector<unsigned char> mask(data.size(), 1);
+    ScanPredicate<double>::greaterEqual(1.5).evaluate(data.data(), data.size(), mask.data());
+    assert((mask == std::vector<unsigned char>{1, 0, 1, 1, 0}));
+
+    std::cout << "✓ Scan predicate test passed" << std::endl;
+}
+
+void testScanWhereMatchesFilteredRangeQuery() {
+    BPlusTree<int, int> tree(6);
+    std::map<int, int> reference;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 10000);
+        if (rng() % 4 == 0) {
+            tree.remove(key);
+            reference.erase(key);
+        } else {
+            int value = static_cast<int>(rng() % 1000);
+            tree.insert(key, value);
+            reference[key] = value;
+        }
+    }
+    assert(tree.validate());
+
+    std::vector<ScanPredicate<int>> keyPredicates = {
+        ScanPredicate<int>::any(), ScanPredicate<int>::greater(5000), ScanPredicate<int>::notEqual(42)};
+    std::vector<ScanPredicate<int>> valuePredicates = {
+        ScanPredicate<int>::any(), ScanPredicate<int>::less(100), ScanPredicate<int>::between(400, 410),
+        ScanPredicate<int>::equal(999), ScanPredicate<int>::greaterEqual(2000)};
+
+    for (const auto& keyPredicate : keyPredicates) {
+        for (const auto& valuePredicate : valuePredicates) {
+            for (auto bounds : {std::make_pair(0, 9999), std::make_pair(1234, 4321), std::make_pair(-50, 60)}) {
+                std::vector<std::pair<int, int>> expected;
+                for (auto it = reference.lower_bound(bounds.first);
+                     it != reference.end() && it->first <= bounds.second; ++it) {
+                    if (keyPredicate.matches(it->first) && valuePredicate.matches(it->second)) {
+                        expected.push_back(*it);
+                    }
+                }
+
+                std::vector<std::pair<int, int>> actual;
+                size_t count = tree.scanWhere(bounds.first, bounds.second, keyPredicate, valuePredicate,
+                                              [&actual](const int& key, const int& value) {
+                                                  actual.emplace_back(key, value);
+                                              });
+                assert(count == actual.size());
+                assert(actual == expected);
+            }
+        }
+    }
+
+    // Empty and inverted ranges
+    size_t calls = 0;
+    auto sink = [&calls](const int&, const int&) { calls++; };
+    tree.scanWhere(500, 100, ScanPredicate<int>::any(), ScanPredicate<int>::any(), sink);
+    BPlusTree<int, int> empty(4);
+    empty.scanWhere(0, 100, ScanPredicate<int>::any(), ScanPredicate<int>::any(), sink);
+    assert(calls == 0);
+
+    std::cout << "✓ scanWhere matches filtered rangeQuery test passed" << std::endl;
+}
+
+void testZoneMapsFollowUpdates() {
+    BPlusTree<int, int> tree(4);
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i, i);
+    }
+    assert(tree.validate());
+
+    // Overwrites widen the zone of the leaf they land in
+    tree.insert(500, 1000000);
+    size_t hits = tree.scanWhere(0, 999, ScanPredicate<int>::any(), ScanPredicate<int>::greater(999999),
+                                 [](const int& key, const int&) { assert(key == 500); });
+    assert(hits == 1);
+
+    // Removing every other key merges and redistributes leaves
+    for (int i = 0; i < 1000; i += 2) {
+        tree.remove(i);
+    }
+    assert(tree.validate());
+    hits = tree.scanWhere(0, 999, ScanPredicate<int>::any(), ScanPredicate<int>::between(100, 199),
+                          [](const int& key, const int& value) { assert(key == value && key % 2 == 1); });
+    assert(hits == 50);
+
+    // Bulk-built, merged and split trees keep valid zone maps too
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 500; i++) data.emplace_back(i, -i);
+    BPlusTree<int, int> bulk(5);
+    bulk.bulkLoad(data.begin(), data.end());
+    BPlusTree<int, int> other(5);
+    for (int i = 250; i < 750; i++) other.insert(i, i);
+    bulk.mergeFrom(std::move(other));
+    BPlusTree<int, int> upper = bulk.splitAt(300);
+    assert(bulk.validate() && upper.validate());
+    assert(bulk.scanWhere(0, 1000, ScanPredicate<int>::any(), ScanPredicate<int>::greater(0),
+                          [](const int&, const int&) {}) == 50);
+    assert(upper.scanWhere(0, 1000, ScanPredicate<int>::any(), ScanPredicate<int>::less(0),
+                           [](const int&, const int&) {}) == 0);
+
+    // Values without operator< have no zone map but can still be scanned
+    struct Opaque { int id; };
+    BPlusTree<int, Opaque> opaque(4);
+    for (int i = 0; i < 100; i++) opaque.insert(i, Opaque{i});
+    size_t seen = opaque.scanWhere(10, 19, ScanPredicate<int>::any(), ScanPredicate<Opaque>::any(),
+                                   [](const int& key, const Opaque& value) { assert(key == value.id); });
+    assert(seen == 10);
+    assert(opaque.validate());
+    bool threw = false;
+    try {
+        opaque.scanWhere(0, 99, ScanPredicate<int>::any(), ScanPredicate<Opaque>::equal(Opaque{1}),
+                         [](const int&, const Opaque&) {});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Zone maps follow updates test passed" << std::endl;
+}
+
+void testZoneMapsAreOptIn() {
+    static_assert(LeafNode<int, int>::HAS_ZONE_MAP, "Arithmetic values keep zone maps by default");
+    static_assert(!LeafNode<int, std::string>::HAS_ZONE_MAP, "Other values do not unless opted in");
+    static_assert(LeafNode<int, Score>::HAS_ZONE_MAP, "ZoneMapTraits opts a type in");
+
+    // Without zone maps value predicates still filter, they just cannot skip leaves
+    BPlusTree<int, std::string> names(8);
+    for (int i = 0; i < 500; i++) names.insert(i, "name" + std::to_string(1000 + i));
+    size_t hits = names.scanWhere(0, 499, ScanPredicate<int>::any(),
+                                  ScanPredicate<std::string>::greaterEqual("name1490"),
+                                  [](const int& key, const std::string&) { assert(key >= 490); });
+    assert(hits == 10);
+    assert(names.statistics().zoneMapSkipCount == 0);
+    assert(names.validate());
+
+    BPlusTree<int, Score> scores(8);
+    for (int i = 0; i < 500; i++) scores.insert(i, Score{i});
+    hits = scores.scanWhere(0, 499, ScanPredicate<int>::any(), ScanPredicate<Score>::greaterEqual(Score{490}),
+                            [](const int& key, const Score& value) { assert(key == value.points); });
+    assert(hits == 10);
+    assert(scores.statistics().zoneMapSkipCount > 0);
+    assert(scores.validate());
+
+    std::cout << "✓ Zone maps are opt-in test passed" << std::endl;
+}
+
+void testSelectiveScanSkipsLeaves() {
+    // Values grow with keys, so each leaf covers a narrow value band
+    BPlusTree<int, int> tree(64);
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 100000; i++) data.emplace_back(i, i / 10);
+    tree.bulkLoad(data.begin(), data.end());
+
+    size_t leaves = tree.statistics().leafNodeCount;
+    tree.resetStatistics();
+    size_t hits = tree.scanWhere(0, 100000, ScanPredicate<int>::any(), ScanPredicate<int>::between(5000, 5009),
+                                 [](const int& key, const int& value) { assert(value == key / 10); });
+    assert(hits == 100);
+    assert(tree.statistics().zoneMapSkipCount >= leaves - 4);
+
+    std::cout << "✓ Selective scan skips leaves test passed" << std::endl;
+}
+
+void testScanWherePerformance() {
+    const int N = 1000000;
+    BPlusTree<int, int> tree(128);
+    std::vector<std::pair<int, int>> data;
+    data.reserve(N);
+    for (int i = 0; i < N; i++) data.emplace_back(i, i % 1000);
+    tree.bulkLoad(data.begin(), data.end());
+
+    auto start1 = std::chrono::high_resolution_clock::now();
+    size_t filtered = 0;
+    for (const auto& row : tree.rangeQuery(0, N)) {
+        if (row.second < 10) filtered++;
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    size_t scanned = tree.scanWhere(0, N, ScanPredicate<int>::any(), ScanPredicate<int>::less(10),
+                                    [](const int&, const int&) {});
+    auto end2 = std::chrono::high_resolution_clock::now();
+    assert(filtered == scanned);
+
+    auto rangeTime = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1).count();
+    auto scanTime = std::chrono::duration_cast<std::chrono::microseconds>(end2 - start2).count();
+
+    std::cout << "✓ scanWhere performance test passed" << std::endl;
+    std::cout << "  rangeQuery + filter: " << rangeTime << "us, scanWhere: " << scanTime << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "Running filtered scan tests..." << std::endl;
+
+    testScanPredicate();
+    testScanWhereMatchesFilteredRangeQuery();
+    testZoneMapsFollowUpdates();
+    testZoneMapsAreOptIn();
+    testSelectiveScanSkipsLeaves();
+    testScanWherePerformance();
+
+    std::cout << "\n✓ All filtered scan tests passed!" << std::endl;
+    return 0;
+}
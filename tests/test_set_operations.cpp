@@ -0,0 +1,209 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+#include <cstdint>
+#include <chrono>
+
+using namespace bptree;
+
+void testIntersectEmpty() {
+    BPlusTree<int, int> a(4);
+    BPlusTree<int, int> b(4);
+    for (int i = 0; i < 10; i++) {
+        a.insert(i, i);
+    }
+
+    size_t calls = 0;
+    a.intersect(b, [&calls](const int&, const int&, const int&) { calls++; });
+    b.intersect(a, [&calls](const int&, const int&, const int&) { calls++; });
+    assert(calls == 0);
+    assert(a.intersect(b).isEmpty());
+
+    std::cout << "✓ Intersect with empty tree test passed" << std::endl;
+}
+
+void testIntersectBasic() {
+    BPlusTree<int, std::string> a(4);
+    BPlusTree<int, std::string> b(4);
+    for (int i = 0; i < 100; i += 2) {
+        a.insert(i, "a" + std::to_string(i));
+    }
+    for (int i = 0; i < 100; i += 3) {
+        b.insert(i, "b" + std::to_string(i));
+    }
+
+    std::vector<int> keys;
+    a.intersect(b, [&keys](const int& key, const std::string& av, const std::string& bv) {
+        assert(av == "a" + std::to_string(key));
+        assert(bv == "b" + std::to_string(key));
+        keys.push_back(key);
+    });
+
+    std::vector<int> expected;
+    for (int i = 0; i < 100; i += 6) {
+        expected.push_back(i);
+    }
+    assert(keys == expected);
+
+    BPlusTree<int, std::string> result = a.intersect(b);
+    assert(result.validate());
+    assert(result.size() == expected.size());
+    std::string value;
+    assert(result.search(12, value) && value == "a12");
+
+    std::cout << "✓ Basic intersect test passed" << std::endl;
+}
+
+void testIntersectDisjointRanges() {
+    BPlusTree<int, int> a(4);
+    BPlusTree<int, int> b(4);
+    for (int i = 0; i < 500; i++) {
+        a.insert(i, i);
+        b.insert(i + 1000, i);
+    }
+
+    assert(a.intersect(b).isEmpty());
+    assert(b.intersect(a).isEmpty());
+
+    std::cout << "✓ Disjoint intersect test passed" << std::endl;
+}
+
+void testDifferenceBasic() {
+    BPlusTree<int, int> a(4);
+    BPlusTree<int, int> b(4);
+    for (int i = 0; i < 100; i++) {
+        a.insert(i, i * 10);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        b.insert(i, 0);
+    }
+
+    std::vector<int> keys;
+    a.difference(b, [&keys](const int& key, const int& value) {
+        assert(value == key * 10);
+        keys.push_back(key);
+    });
+
+    std::vector<int> expected;
+    for (int i = 0; i < 100; i++) {
+        if (i % 3 != 0) expected.push_back(i);
+    }
+    assert(keys == expected);
+
+    BPlusTree<int, int> result = a.difference(b);
+    assert(result.validate());
+    assert(result.size() == expected.size());
+
+    // Subtracting an empty tree keeps everything, subtracting from empty gives nothing
+    BPlusTree<int, int> empty(4);
+    assert(a.difference(empty).size() == 100);
+    assert(empty.difference(a).isEmpty());
+
+    std::cout << "✓ Basic difference test passed" << std::endl;
+}
+
+void testRandomizedAgainstStdSet() {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 20; round++) {
+        std::uniform_int_distribution<int> dist(0, 2000);
+        size_t sizeA = static_cast<size_t>(rng() % 800);
+        size_t sizeB = static_cast<size_t>(rng() % 800);
+
+        BPlusTree<int, int> a(3 + static_cast<size_t>(round % 6));
+        BPlusTree<int, int> b(4 + static_cast<size_t>(round % 9));
+        std::set<int> setA;
+        std::set<int> setB;
+        for (size_t i = 0; i < sizeA; i++) {
+            int k = dist(rng);
+            a.insert(k, k);
+            setA.insert(k);
+        }
+        for (size_t i = 0; i < sizeB; i++) {
+            int k = dist(rng);
+            b.insert(k, -k);
+            setB.insert(k);
+        }
+
+        std::vector<int> inter;
+        a.intersect(b, [&inter](const int& key, const int&, const int&) { inter.push_back(key); });
+        std::vector<int> expectedInter;
+        std::set_intersection(setA.begin(), setA.end(), setB.begin(), setB.end(),
+                              std::back_inserter(expectedInter));
+        assert(inter == expectedInter);
+
+        std::vector<int> diff;
+        a.difference(b, [&diff](const int& key, const int&) { diff.push_back(key); });
+        std::vector<int> expectedDiff;
+        std::set_difference(setA.begin(), setA.end(), setB.begin(), setB.end(),
+                            std::back_inserter(expectedDiff));
+        assert(diff == expectedDiff);
+    }
+
+    std::cout << "✓ Randomized set operation test passed" << std::endl;
+}
+
+void testSkewedIntersectPerformance() {
+    const uint64_t LARGE = 1000000;
+
+    std::vector<std::pair<uint64_t, int>> largeData;
+    for (uint64_t i = 0; i < LARGE; i++) {
+        largeData.emplace_back(i * 2, 0);
+    }
+    BPlusTree<uint64_t, int> large(64);
+    large.bulkLoad(std::move(largeData));
+
+    BPlusTree<uint64_t, int> small(64);
+    for (uint64_t i = 0; i < 100; i++) {
+        small.insert(i * 19997, 1);
+    }
+
+    // Leapfrog intersection
+    size_t matches = 0;
+    auto start1 = std::chrono::high_resolution_clock::now();
+    large.intersect(small, [&matches](const uint64_t&, const int&, const int&) { matches++; });
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto leapTime = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1).count();
+
+    // Linear co-iteration for comparison
+    size_t linearMatches = 0;
+    auto start2 = std::chrono::high_resolution_clock::now();
+    auto itA = large.begin();
+    auto itB = small.begin();
+    while (itA != large.end() && itB != small.end()) {
+        if (itA->first < itB->first) {
+            ++itA;
+        } else if (itB->first < itA->first) {
+            ++itB;
+        } else {
+            linearMatches++;
+            ++itA;
+            ++itB;
+        }
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto linearTime = std::chrono::duration_cast<std::chrono::microseconds>(end2 - start2).count();
+
+    assert(matches == linearMatches);
+    assert(matches == 50);  // Only even multiples of 19997 are present
+
+    std::cout << "✓ Skewed intersect performance test passed" << std::endl;
+    std::cout << "  Leapfrog: " << leapTime << "us, Linear co-iteration: " << linearTime << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "Running set operation tests..." << std::endl;
+
+    testIntersectEmpty();
+    testIntersectBasic();
+    testIntersectDisjointRanges();
+    testDifferenceBasic();
+    testRandomizedAgainstStdSet();
+    testSkewedIntersectPerformance();
+
+    std::cout << "\n✓ All set operation tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,269 @@
+#include "../include/ShardedBPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace bptree;
+
+void testSplitAt() {
+    for (int cut : {-5, 0, 1, 37, 250, 499, 500, 1000}) {
+        BPlusTree<int, int> tree(4);
+        for (int i = 0; i < 500; i++) {
+            tree.insert(i, i * 2);
+        }
+
+        BPlusTree<int, int> upper = tree.splitAt(cut);
+        assert(tree.validate());
+        assert(upper.validate());
+
+        size_t lowerCount = static_cast<size_t>(std::max(0, std::min(cut, 500)));
+        assert(tree.size() == lowerCount);
+        assert(upper.size() == 500 - lowerCount);
+        for (auto entry : tree) assert(entry.first < cut);
+        for (auto entry : upper) assert(entry.first >= cut && entry.second == entry.first * 2);
+
+        tree.insert(cut, 0);
+        upper.insert(1000 + cut, 0);
+        assert(tree.validate() && upper.validate());
+
+        // The reinserted cut key is a duplicate unless it fell outside the data
+        tree.mergeFrom(std::move(upper));
+        assert(tree.size() == (cut >= 0 && cut < 500 ? 501u : 502u));
+        assert(tree.validate());
+    }
+
+    // Splitting while a snapshot is live must not disturb the snapshot
+    BPlusTree<int, int> tree(5);
+    for (int i = 0; i < 300; i++) tree.insert(i, i);
+    auto snap = tree.snapshot();
+    BPlusTree<int, int> upper = tree.splitAt(123);
+    upper.insert(1000, 1);
+    upper.remove(200);
+    tree.remove(5);
+    assert(snap.size() == 300);
+    assert(snap.rangeQuery(120, 130).size() == 11);
+    assert(tree.size() == 122 && upper.size() == 177);
+    snap.release();
+
+    std::cout << "✓ splitAt test passed" << std::endl;
+}
+
+void testShardedBasics() {
+    ShardedBPlusTree<int, std::string> tree({100, 200, 300}, 4);
+    assert(tree.shardCount() == 4);
+    assert(tree.isEmpty());
+
+    for (int i = 0; i < 400; i++) {
+        tree.insert(i, std::to_string(i));
+    }
+    assert(tree.size() == 400);
+    for (size_t s = 0; s < 4; s++) {
+        assert(tree.shardSize(s) == 100);
+    }
+
+    std::string value;
+    assert(tree.search(150, value) && value == "150");
+    assert(tree.remove(150));
+    assert(!tree.contains(150));
+    assert(!tree.remove(150));
+
+    // Ranges spanning shard boundaries come back stitched in key order
+    auto rows = tree.rangeQuery(95, 305);
+    assert(rows.size() == 210);
+    for (size_t i = 1; i < rows.size(); i++) {
+        assert(rows[i - 1].first < rows[i].first);
+    }
+    assert(tree.rangeQuery(300, 200).empty());
+
+    bool threw = false;
+    try {
+        tree.shardSize(4);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Sharded tree basics test passed" << std::endl;
+}
+
+void testSplitAndJoinShards() {
+    ShardedBPlusTree<int, int> tree({}, 6);
+    std::map<int, int> expected;
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i, -i);
+        expected[i] = -i;
+    }
+
+    tree.splitShard(0, 500);
+    tree.splitShard(0, 250);
+    tree.splitShard(2, 750);
+    assert(tree.shardCount() == 4);
+    assert((tree.partitions() == std::vector<int>{250, 500, 750}));
+    assert(tree.shardSize(1) == 250);
+
+    bool threw = false;
+    try {
+        tree.splitShard(1, 600);  // Outside [250, 500)
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    tree.joinShards(1);
+    assert(tree.shardCount() == 3);
+    assert((tree.partitions() == std::vector<int>{250, 750}));
+
+    // Shard entry counts follow overwrites, removals, splits and joins
+    tree.insert(300, -300);
+    assert(!tree.remove(5000));
+    assert(tree.shardSize(0) == 250 && tree.shardSize(1) == 500 && tree.shardSize(2) == 250);
+    assert(tree.size() == 1000);
+
+    auto rows = tree.rangeQuery(0, 999);
+    assert(rows.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        assert(row.first == it->first && row.second == it->second);
+        ++it;
+    }
+
+    std::cout << "✓ Split and join shards test passed" << std::endl;
+}
+
+void testRebalance() {
+    ShardedBPlusTree<int, int> tree({1000, 2000, 3000}, 16);
+
+    // Skewed ingest: almost everything lands in the last shard
+    for (int i = 0; i < 100; i++) tree.insert(i, i);
+    for (int i = 3000; i < 11000; i++) tree.insert(i, i);
+
+    size_t rounds = tree.rebalance();
+    assert(rounds > 0);
+    assert(tree.shardCount() == 4);
+    assert(tree.size() == 8100);
+
+    size_t largest = 0;
+    for (size_t s = 0; s < tree.shardCount(); s++) {
+        largest = std::max(largest, tree.shardSize(s));
+    }
+    assert(largest <= 2 * 8100 / 4 + 1);
+
+    int value = 0;
+    assert(tree.search(50, value) && value == 50);
+    assert(tree.search(10999, value) && value == 10999);
+    assert(tree.rangeQuery(0, 20000).size() == 8100);
+
+    std::cout << "✓ Rebalance test passed" << std::endl;
+}
+
+void testConcurrentWritersAndRebalance() {
+    const int THREADS = 4;
+    const int PER_THREAD = 5000;
+    ShardedBPlusTree<int, int> tree({5000, 10000, 15000}, 32);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&tree, t]() {
+            for (int i = 0; i < PER_THREAD; i++) {
+                int key = t * PER_THREAD + i;
+                tree.insert(key, key);
+                if (i % 3 == 0) tree.remove(key);
+            }
+        });
+    }
+    std::thread maintenance([&tree, &done]() {
+        while (!done.load()) {
+            tree.rebalance();
+            auto rows = tree.rangeQuery(4990, 5010);
+            for (size_t i = 1; i < rows.size(); i++) {
+                assert(rows[i - 1].first < rows[i].first);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    maintenance.join();
+
+    size_t expected = 0;
+    for (int key = 0; key < THREADS * PER_THREAD; key++) {
+        bool present = (key % PER_THREAD) % 3 != 0;
+        assert(tree.contains(key) == present);
+        expected += present;
+    }
+    assert(tree.size() == expected);
+    assert(tree.rangeQuery(0, THREADS * PER_THREAD).size() == expected);
+
+    std::cout << "✓ Concurrent writers and rebalance test passed" << std::endl;
+}
+
+void testShardedPerformanceComparison() {
+    const int THREADS = 4;
+    const int PER_THREAD = 50000;
+
+    // Each thread writes its own key range
+    ShardedBPlusTree<int, int> sharded({PER_THREAD, 2 * PER_THREAD, 3 * PER_THREAD}, 64);
+    auto start1 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([&sharded, t]() {
+                for (int i = 0; i < PER_THREAD; i++) {
+                    sharded.insert(t * PER_THREAD + i, i);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto shardedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    BPlusTree<int, int> single(64);
+    std::mutex singleMutex;
+    auto start2 = std::chrono::high_resolution_clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([&single, &singleMutex, t]() {
+                for (int i = 0; i < PER_THREAD; i++) {
+                    std::lock_guard<std::mutex> lock(singleMutex);
+                    single.insert(t * PER_THREAD + i, i);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto singleTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(sharded.size() == single.size());
+
+    std::cout << "✓ Sharded performance comparison test passed" << std::endl;
+    std::cout << "  Sharded (" << THREADS << " shards): " << shardedTime << "ms, Single mutex-guarded tree: "
+              << singleTime << "ms (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running sharded tree tests..." << std::endl;
+
+    testSplitAt();
+    testShardedBasics();
+    testSplitAndJoinShards();
+    testRebalance();
+    testConcurrentWritersAndRebalance();
+    testShardedPerformanceComparison();
+
+    std::cout << "\n✓ All sharded tree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,244 @@
+#include "../include/SmallBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <new>
+#include <random>
+#include <chrono>
+#include <memory>
+
+using namespace bptree;
+
+// Global allocation counters, so the benchmark can report heap usage
+static size_t g_allocations = 0;
+static size_t g_allocatedBytes = 0;
+
+void* operator new(std::size_t size) {
+    g_allocations++;
+    g_allocatedBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using Small = SmallBPlusTree<int, int, 8>;
+
+// Checks every read path of a small tree against the reference map
+void assertMatches(const Small& tree, const std::map<int, int>& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    assert(tree.isEmpty() == expected.empty());
+    auto it = expected.begin();
+    tree.forEach([&](const int& key, const int& value) {
+        assert(it != expected.end());
+        assert(key == it->first && value == it->second);
+        ++it;
+    });
+    assert(it == expected.end());
+    for (int key = -1; key <= 41; key++) {
+        int value = 0;
+        bool present = expected.count(key) == 1;
+        assert(tree.search(key, value) == present);
+        assert(tree.contains(key) == present);
+        if (present) assert(value == expected.at(key) && *tree.find(key) == value);
+    }
+    auto rows = tree.rangeQuery(5, 30);
+    auto want = expected.lower_bound(5);
+    for (const auto& row : rows) {
+        assert(want != expected.end() && row.first == want->first && row.second == want->second);
+        ++want;
+    }
+    assert(want == expected.upper_bound(30));
+}
+
+void testInlineOperations() {
+    Small tree(4);
+    assert(tree.isInline() && tree.isEmpty() && tree.promotedTree() == nullptr);
+
+    // Nothing allocates while the entries fit inline
+    size_t before = g_allocations;
+    for (int key : {5, 1, 8, 3, 7, 2, 6, 4}) {
+        tree.insert(key, key * 10);
+    }
+    tree.insert(3, -3);
+    assert(tree.remove(1) && !tree.remove(1) && !tree.remove(100));
+    assert(tree.isInline());
+    assert(g_allocations == before);
+
+    std::map<int, int> expected = {{2, 20}, {3, -3}, {4, 40}, {5, 50}, {6, 60}, {7, 70}, {8, 80}};
+    assertMatches(tree, expected);
+    assert(tree.rangeQuery(30, 5).empty());
+
+    std::cout << "✓ Inline operations test passed" << std::endl;
+}
+
+void testPromotionAndDemotion() {
+    Small tree(4);
+    std::map<int, int> expected;
+    for (int key = 0; key < 8; key++) {
+        tree.insert(key, key);
+        expected[key] = key;
+    }
+    assert(tree.isInline());
+
+    // The ninth distinct key promotes, wherever it sorts
+    tree.insert(-1, -1);
+    expected[-1] = -1;
+    assert(!tree.isInline() && tree.promotedTree()->validate());
+    assertMatches(tree, expected);
+    for (int key = 8; key < 40; key++) {
+        tree.insert(key, key);
+        expected[key] = key;
+    }
+    assertMatches(tree, expected);
+
+    // Stays promoted until at most half the inline capacity remains
+    int key = 39;
+    while (expected.size() > 5) {
+        assert(tree.remove(key));
+        expected.erase(key--);
+        assert(!tree.isInline());
+        assertMatches(tree, expected);
+    }
+    assert(tree.remove(key));
+    expected.erase(key);
+    assert(tree.isInline());
+    assertMatches(tree, expected);
+
+    // Growing back to the capacity does not promote again
+    for (int k = 20; k < 24; k++) {
+        tree.insert(k, k);
+        expected[k] = k;
+    }
+    assert(tree.isInline() && tree.size() == 8);
+    assertMatches(tree, expected);
+
+    tree.clear();
+    assert(tree.isInline() && tree.isEmpty());
+    assertMatches(tree, {});
+
+    std::cout << "✓ Promotion and demotion test passed" << std::endl;
+}
+
+void testRandomAgainstMap() {
+    std::mt19937 rng(74);
+    for (int round = 0; round < 200; round++) {
+        Small tree(3 + round % 5);
+        std::map<int, int> expected;
+        for (int op = 0; op < 300; op++) {
+            int key = static_cast<int>(rng() % 41);
+            if (rng() % 3 == 0) {
+                assert(tree.remove(key) == (expected.erase(key) == 1));
+            } else {
+                tree.insert(key, op);
+                expected[key] = op;
+            }
+            assert(tree.validate() && tree.size() == expected.size());
+        }
+        assertMatches(tree, expected);
+    }
+
+    std::cout << "✓ Random operations against std::map test passed" << std::endl;
+}
+
+void testMoveAndStrings() {
+    SmallBPlusTree<std::string, std::string, 4> strings;
+    for (int i = 0; i < 4; i++) {
+        strings.insert("key" + std::to_string(i), std::string(40, static_cast<char>('a' + i)));
+    }
+    auto moved = std::move(strings);
+    assert(strings.isEmpty() && strings.validate());
+    assert(moved.size() == 4 && moved.isInline());
+    assert(*moved.find("key2") == std::string(40, 'c'));
+
+    moved.insert("key9", "promoted");
+    assert(!moved.isInline() && moved.size() == 5);
+    SmallBPlusTree<std::string, std::string, 4> target;
+    target.insert("old", "value");
+    target = std::move(moved);
+    assert(target.size() == 5 && !target.isInline() && !target.contains("old"));
+    assert(*target.find("key9") == "promoted");
+    assert(moved.isEmpty() && moved.isInline());
+
+    // Vectors of small trees relocate by moving
+    std::vector<Small> trees(3);
+    for (int i = 0; i < 3; i++) trees[i].insert(i, i);
+    trees.resize(100);
+    for (int i = 0; i < 3; i++) assert(trees[i].size() == 1 && trees[i].contains(i));
+
+    std::cout << "✓ Move and string payload test passed" << std::endl;
+}
+
+void testSmallPerformanceComparison() {
+    // Many session-sized maps of 1 to 7 entries each
+    const int NUM_TREES = 200000;
+    std::mt19937 rng(7);
+    std::vector<int> sizes(NUM_TREES);
+    for (auto& n : sizes) n = 1 + static_cast<int>(rng() % 7);
+
+    size_t allocations1 = g_allocations, bytes1 = g_allocatedBytes;
+    auto start1 = std::chrono::high_resolution_clock::now();
+    std::vector<std::unique_ptr<BPlusTree<int, int>>> plain;
+    plain.reserve(NUM_TREES);
+    for (int t = 0; t < NUM_TREES; t++) {
+        plain.emplace_back(new BPlusTree<int, int>(32));
+        for (int k = 0; k < sizes[t]; k++) plain.back()->insert(k * 7, t);
+    }
+    size_t hits1 = 0;
+    for (int t = 0; t < NUM_TREES; t++) {
+        int value;
+        for (int k = 0; k < 8; k++) hits1 += plain[t]->search(k * 7, value);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    allocations1 = g_allocations - allocations1;
+    bytes1 = g_allocatedBytes - bytes1;
+    auto plainTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+    plain.clear();
+    plain.shrink_to_fit();
+
+    size_t allocations2 = g_allocations, bytes2 = g_allocatedBytes;
+    auto start2 = std::chrono::high_resolution_clock::now();
+    std::vector<Small> small;
+    small.reserve(NUM_TREES);
+    for (int t = 0; t < NUM_TREES; t++) {
+        small.emplace_back(32);
+        for (int k = 0; k < sizes[t]; k++) small.back().insert(k * 7, t);
+    }
+    size_t hits2 = 0;
+    for (int t = 0; t < NUM_TREES; t++) {
+        int value;
+        for (int k = 0; k < 8; k++) hits2 += small[t].search(k * 7, value);
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    allocations2 = g_allocations - allocations2;
+    bytes2 = g_allocatedBytes - bytes2;
+    auto smallTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    assert(hits1 == hits2);
+    assert(allocations2 * 10 < allocations1);
+    assert(bytes2 * 2 < bytes1);
+
+    std::cout << "✓ Small tree performance comparison test passed" << std::endl;
+    std::cout << "  " << NUM_TREES << " trees of 1-7 entries: BPlusTree " << allocations1 << " allocations, "
+              << bytes1 / NUM_TREES << " bytes/tree, " << plainTime << "ms; SmallBPlusTree " << allocations2
+              << " allocations, " << bytes2 / NUM_TREES << " bytes/tree, " << smallTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running small tree tests..." << std::endl;
+
+    testInlineOperations();
+    testPromotionAndDemotion();
+    testRandomAgainstMap();
+    testMoveAndStrings();
+    testSmallPerformanceComparison();
+
+    std::cout << "\n✓ All small tree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+using namespace bptree;
+
+// Checks that a snapshot holds exactly the entries of the reference map
+void assertSnapshotMatches(const BPlusTree<int, int>::snapshot_type& snap,
+                           const std::map<int, int>& expected) {
+    assert(snap.size() == expected.size());
+    auto rows = snap.rangeQuery(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    assert(rows.size() == expected.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        assert(row.first == it->first);
+        assert(row.second == it->second);
+        ++it;
+    }
+    for (const auto& entry : expected) {
+        int value = 0;
+        assert(snap.search(entry.first, value));
+        assert(value == entry.second);
+    }
+}
+
+void testEmptySnapshot() {
+    BPlusTree<int, int> tree(4);
+    auto snap = tree.snapshot();
+    assert(snap.isEmpty());
+    assert(snap.size() == 0);
+
+    tree.insert(1, 1);
+    int value = 0;
+    assert(!snap.search(1, value));
+    assert(snap.rangeQuery(0, 10).empty());
+
+    std::cout << "✓ Empty snapshot test passed" << std::endl;
+}
+
+void testSnapshotIsolation() {
+    BPlusTree<int, int> tree(4);
+    std::map<int, int> expected;
+    for (int i = 0; i < 200; i++) {
+        tree.insert(i, i);
+        expected[i] = i;
+    }
+
+    auto snap = tree.snapshot();
+
+    // Inserts, splits, removals and merges after the snapshot must stay invisible
+    for (int i = 200; i < 400; i++) {
+        tree.insert(i, i);
+    }
+    for (int i = 0; i < 300; i += 2) {
+        tree.remove(i);
+    }
+
+    assert(tree.validate());
+    assert(tree.size() == 250);
+    assertSnapshotMatches(snap, expected);
+    assert(tree.statistics().cowCopyCount > 0);
+
+    auto rows = snap.rangeQuery(10, 19);
+    assert(rows.size() == 10);
+    assert(rows.front().first == 10 && rows.back().first == 19);
+
+    std::cout << "✓ Snapshot isolation test passed" << std::endl;
+}
+
+void testMultipleSnapshots() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 2000);
+
+    BPlusTree<int, int> tree(5);
+    std::map<int, int> current;
+    std::vector<BPlusTree<int, int>::snapshot_type> snaps;
+    std::vector<std::map<int, int>> states;
+
+    for (int round = 0; round < 6; round++) {
+        for (int i = 0; i < 500; i++) {
+            int k = dist(rng);
+            if (rng() % 3 == 0) {
+                tree.remove(k);
+                current.erase(k);
+            } else if (current.count(k) == 0) {
+                tree.insert(k, round);
+                current[k] = round;
+            }
+        }
+        snaps.push_back(tree.snapshot());
+        states.push_back(current);
+    }
+
+    // Release snapshots out of order while writing
+    for (size_t s : {2u, 0u, 5u}) {
+        snaps[s].release();
+        assert(snaps[s].isEmpty());
+        tree.remove(dist(rng));
+    }
+
+    for (size_t s : {1u, 3u, 4u}) {
+        assertSnapshotMatches(snaps[s], states[s]);
+        assert(snaps[s].version() == s);
+    }
+    assert(tree.validate());
+
+    std::cout << "✓ Multiple snapshots test passed" << std::endl;
+}
+
+void testSnapshotReclamation() {
+    BPlusTree<int, int> tree(4);
+    BPlusTree<int, int> reference(4);
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i, i);
+        reference.insert(i, i);
+    }
+
+    {
+        auto snap = tree.snapshot();
+        for (int i = 0; i < 1000; i += 3) {
+            tree.remove(i);
+            reference.remove(i);
+        }
+        assert(snap.size() == 1000);
+    }
+
+    // Once the snapshot is gone, writes go back to updating nodes in place
+    tree.insert(5000, 0);
+    reference.insert(5000, 0);
+    size_t copies = tree.statistics().cowCopyCount;
+    tree.insert(5001, 0);
+    reference.insert(5001, 0);
+    assert(tree.statistics().cowCopyCount == copies);
+
+    assert(tree.validate());
+    assert(tree.size() == reference.size());
+    // Copies replace nodes one for one, so the shape matches an unshared tree
+    assert(tree.statistics().leafNodeCount == reference.statistics().leafNodeCount);
+    assert(tree.statistics().internalNodeCount == reference.statistics().internalNodeCount);
+
+    std::cout << "✓ Snapshot reclamation test passed" << std::endl;
+}
+
+void testSnapshotWithBulkOperations() {
+    BPlusTree<int, int> tree(8);
+    std::map<int, int> expected;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 500; i++) {
+        data.emplace_back(i, i);
+        expected[i] = i;
+    }
+    tree.bulkLoad(data);
+
+    auto snap = tree.snapshot();
+
+    BPlusTree<int, int> delta(8);
+    for (int i = 250; i < 750; i++) {
+        delta.insert(i, -i);
+    }
+    tree.mergeFrom(std::move(delta));
+    assert(tree.size() == 750);
+    assert(tree.validate());
+    assertSnapshotMatches(snap, expected);
+
+    std::vector<std::pair<int, int>> replacement = {{1, 1}, {2, 2}};
+    tree.bulkLoad(replacement);
+    assert(tree.size() == 2);
+    assertSnapshotMatches(snap, expected);
+
+    std::cout << "✓ Snapshot with bulk operations test passed" << std::endl;
+}
+
+void testConcurrentReaders() {
+    BPlusTree<int, int> tree(16);
+    std::map<int, int> expected;
+    for (int i = 0; i < 20000; i++) {
+        tree.insert(i, i);
+        expected[i] = i;
+    }
+
+    auto snap = tree.snapshot();
+    std::atomic<bool> done{false};
+    std::atomic<int> scans{0};
+
+    auto reader = [&]() {
+        while (!done.load()) {
+            auto rows = snap.rangeQuery(0, 19999);
+            assert(rows.size() == 20000);
+            int value = 0;
+            assert(snap.search(12345, value) && value == 12345);
+            scans++;
+        }
+    };
+    std::thread r1(reader);
+    std::thread r2(reader);
+
+    // The writer never waits for the readers
+    for (int i = 0; i < 20000; i += 2) {
+        tree.remove(i);
+    }
+    for (int i = 20000; i < 30000; i++) {
+        tree.insert(i, i);
+    }
+    done = true;
+    r1.join();
+    r2.join();
+
+    assert(scans.load() >= 2);
+    assert(tree.validate());
+    assert(tree.size() == 20000);
+    assertSnapshotMatches(snap, expected);
+
+    std::cout << "✓ Concurrent snapshot readers test passed" << std::endl;
+}
+
+void testSnapshotPerformanceComparison() {
+    const int NUM_ELEMENTS = 100000;
+
+    BPlusTree<int, int> plain(64);
+    BPlusTree<int, int> versioned(64);
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        data.emplace_back(i * 2, i);
+    }
+    plain.bulkLoad(data);
+    versioned.bulkLoad(data);
+
+    // Measure writes without snapshots
+    auto start1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        plain.insert(i * 2 + 1, i);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto plainTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure writes while a snapshot is live, replaced every 1000 operations
+    auto start2 = std::chrono::high_resolution_clock::now();
+    BPlusTree<int, int>::snapshot_type snap;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (i % 1000 == 0) {
+            snap = versioned.snapshot();
+        }
+        versioned.insert(i * 2 + 1, i);
+    }
+    snap.release();
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto versionedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    assert(versioned.validate());
+    assert(versioned.size() == plain.size());
+
+    std::cout << "✓ Snapshot performance comparison test passed" << std::endl;
+    std::cout << "  Plain inserts: " << plainTime << "ms, With periodic snapshots: "
+              << versionedTime << "ms (" << versioned.statistics().cowCopyCount
+              << " node copies)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running snapshot tests..." << std::endl;
+
+    testEmptySnapshot();
+    testSnapshotIsolation();
+    testMultipleSnapshots();
+    testSnapshotReclamation();
+    testSnapshotWithBulkOperations();
+    testConcurrentReaders();
+    testSnapshotPerformanceComparison();
+
+    std::cout << "\n✓ All snapshot tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <chrono>
+
+using namespace bptree;
+
+// Value type that counts how often it is copied and constructed
+struct Tracked {
+    static int copies;
+    static int constructions;
+    std::string text;
+
+    Tracked() = default;
+    Tracked(const std::string& s, int repeat) : text() {
+        constructions++;
+        for (int i = 0; i < repeat; i++) text += s;
+    }
+    Tracked(const Tracked& other) : text(other.text) { copies++; }
+    Tracked(Tracked&&) noexcept = default;
+    Tracked& operator=(const Tracked& other) {
+        text = other.text;
+        copies++;
+        return *this;
+    }
+    Tracked& operator=(Tracked&&) noexcept = default;
+};
+
+int Tracked::copies = 0;
+int Tracked::constructions = 0;
+
+void testUpsertCounts() {
+    BPlusTree<std::string, int> counts(4);
+    std::vector<std::string> words = {"b", "a", "c", "a", "b", "a", "d"};
+    for (const auto& word : words) {
+        counts.upsert(word, [](int& count) { ++count; });
+    }
+
+    int value = 0;
+    assert(counts.search("a", value) && value == 3);
+    assert(counts.search("b", value) && value == 2);
+    assert(counts.search("c", value) && value == 1);
+    assert(counts.search("d", value) && value == 1);
+    assert(counts.size() == 4);
+
+    // upsert reports whether it inserted
+    assert(counts.upsert("e", [](int& count) { count = 10; }));
+    assert(!counts.upsert("e", [](int& count) { count += 5; }));
+    assert(counts.search("e", value) && value == 15);
+
+    // update never inserts
+    assert(counts.update("a", [](int& count) { count *= 2; }));
+    assert(!counts.update("zzz", [](int& count) { count = 1; }));
+    assert(counts.search("a", value) && value == 6);
+    assert(!counts.search("zzz", value));
+
+    // A throwing function leaves no new key behind and keeps existing values
+    bool threw = false;
+    try {
+        counts.upsert("f", [](int&) { throw std::runtime_error("boom"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(!counts.search("f", value));
+    assert(counts.size() == 5);
+    assert(counts.validate());
+
+    std::cout << "✓ Upsert counts test passed" << std::endl;
+}
+
+void testEmplaceFamily() {
+    BPlusTree<int, Tracked> tree(4);
+
+    // try_emplace constructs only when the key is absent
+    Tracked::constructions = 0;
+    auto result = tree.try_emplace(1, "ab", 2);
+    assert(result.second);
+    assert(result.first->first == 1 && result.first->second.text == "abab");
+    result = tree.try_emplace(1, "xy", 3);
+    assert(!result.second);
+    assert(result.first->second.text == "abab");
+    assert(Tracked::constructions == 1);
+
+    // insert_or_assign assigns over an existing key
+    result = tree.insert_or_assign(1, Tracked("z", 1));
+    assert(!result.second && result.first->second.text == "z");
+    result = tree.insert_or_assign(2, Tracked("y", 2));
+    assert(result.second && result.first->second.text == "yy");
+
+    // emplace builds the pair first, like std::map::emplace
+    auto emplaced = tree.emplace(3, Tracked("q", 1));
+    assert(emplaced.second && emplaced.first->second.text == "q");
+    emplaced = tree.emplace(3, Tracked("r", 1));
+    assert(!emplaced.second && emplaced.first->second.text == "q");
+
+    // None of the above copied a value
+    Tracked::copies = 0;
+    for (int i = 10; i < 200; i++) {
+        tree.insert(int(i), Tracked(std::to_string(i), 1));
+        tree.try_emplace(i + 1000, std::to_string(i), 2);
+        tree.insert_or_assign(i, Tracked(std::to_string(i), 3));
+    }
+    assert(Tracked::copies == 0);
+    assert(tree.validate());
+
+    Tracked found;
+    assert(tree.search(150, found) && found.text == "150150150");
+    assert(tree.search(1150, found) && found.text == "150150");
+
+    // Returned iterators walk on through the tree, across splits
+    auto it = tree.try_emplace(55, "", 0).first;
+    assert(it->first == 55);
+    ++it;
+    assert(it->first == 56);
+
+    std::cout << "✓ Emplace family test passed" << std::endl;
+}
+
+void testUpsertAgainstStdMap() {
+    BPlusTree<int, long long> tree(5);
+    std::map<int, long long> reference;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> keyDist(0, 2000);
+
+    for (int i = 0; i < 20000; i++) {
+        int key = keyDist(rng);
+        switch (rng() % 5) {
+            case 0:
+                tree.upsert(key, [i](long long& v) { v += i; });
+                reference[key] += i;
+                break;
+            case 1: {
+                bool inserted = tree.try_emplace(key, static_cast<long long>(i)).second;
+                assert(inserted == reference.try_emplace(key, i).second);
+                break;
+            }
+            case 2: {
+                bool inserted = tree.insert_or_assign(key, static_cast<long long>(-i)).second;
+                assert(inserted == reference.insert_or_assign(key, -i).second);
+                break;
+            }
+            case 3: {
+                bool updated = tree.update(key, [](long long& v) { v *= 3; });
+                auto found = reference.find(key);
+                assert(updated == (found != reference.end()));
+                if (found != reference.end()) found->second *= 3;
+                break;
+            }
+            default:
+                assert(tree.remove(key) == (reference.erase(key) == 1));
+                break;
+        }
+    }
+
+    assert(tree.validate());
+    std::vector<std::pair<int, long long>> expected(reference.begin(), reference.end());
+    std::vector<std::pair<int, long long>> actual(tree.begin(), tree.end());
+    assert(actual == expected);
+
+    std::cout << "✓ Upsert against std::map test passed" << std::endl;
+}
+
+void testUpsertKeepsZoneMapsAndSnapshots() {
+    BPlusTree<int, int> tree(8);
+    for (int i = 0; i < 500; i++) tree.insert(i, i);
+
+    auto snap = tree.snapshot();
+    for (int i = 0; i < 500; i += 3) {
+        tree.upsert(i, [](int& v) { v += 100000; });
+    }
+    tree.insert_or_assign(7, -50);
+    tree.update(8, [](int& v) { v = 777777; });
+
+    // Zone maps were widened, so value-filtered scans still see the new values
+    assert(tree.validate());
+    size_t large = tree.scanWhere(0, 499, ScanPredicate<int>::any(), ScanPredicate<int>::greater(99999),
+                                  [](const int&, const int&) {});
+    assert(large == 167 + 1);  // every third key, plus key 8
+    size_t negative = tree.scanWhere(0, 499, ScanPredicate<int>::any(), ScanPredicate<int>::less(0),
+                                     [](const int&, const int&) {});
+    assert(negative == 1);
+
+    // The snapshot still sees the original values
+    int value = 0;
+    assert(snap.search(3, value) && value == 3);
+    assert(snap.search(7, value) && value == 7);
+    assert(snap.search(8, value) && value == 8);
+    assert(tree.search(8, value) && value == 777777);
+    snap.release();
+
+    std::cout << "✓ Upsert zone map and snapshot test passed" << std::endl;
+}
+
+void testThrowingFunctionKeepsZoneMaps() {
+    BPlusTree<int, int> tree(8);
+    for (int i = 0; i < 100; i++) tree.insert(i, i);
+
+    // A function that writes the value and then throws still leaves it covered
+    auto writeThenThrow = [](int newValue) {
+        return [newValue](int& v) {
+            v = newValue;
+            throw std::runtime_error("after write");
+        };
+    };
+    bool threw = false;
+    try {
+        tree.upsert(10, writeThenThrow(500000));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        tree.update(50, writeThenThrow(-500000));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    assert(tree.validate());
+    size_t large = tree.scanWhere(0, 99, ScanPredicate<int>::any(), ScanPredicate<int>::greater(99999),
+                                  [](const int&, const int&) {});
+    size_t negative = tree.scanWhere(0, 99, ScanPredicate<int>::any(), ScanPredicate<int>::less(0),
+                                     [](const int&, const int&) {});
+    assert(large == 1 && negative == 1);
+
+    std::cout << "✓ Throwing upsert function zone map test passed" << std::endl;
+}
+
+void testUpsertPerformance() {
+    const int operations = 200000;
+    std::mt19937 rng(3);
+    std::vector<int> keys(operations);
+    for (int& key : keys) key = static_cast<int>(rng() % 20000);
+
+    BPlusTree<int, int> twoDescents(64);
+    auto start1 = std::chrono::high_resolution_clock::now();
+    for (int key : keys) {
+        int count = 0;
+        twoDescents.search(key, count);
+        twoDescents.insert(key, count + 1);
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+
+    BPlusTree<int, int> oneDescent(64);
+    auto start2 = std::chrono::high_resolution_clock::now();
+    for (int key : keys) {
+        oneDescent.upsert(key, [](int& count) { ++count; });
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::pair<int, int>> a(twoDescents.begin(), twoDescents.end());
+    std::vector<std::pair<int, int>> b(oneDescent.begin(), oneDescent.end());
+    assert(a == b);
+
+    auto searchInsertTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+    auto upsertTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+    std::cout << "✓ Upsert performance test passed" << std::endl;
+    std::cout << "  search + insert: " << searchInsertTime << "ms, upsert: " << upsertTime << "ms ("
+              << operations << " counter increments)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running upsert tests..." << std::endl;
+
+    testUpsertCounts();
+    testEmplaceFamily();
+    testUpsertAgainstStdMap();
+    testUpsertKeepsZoneMapsAndSnapshots();
+    testThrowingFunctionKeepsZoneMaps();
+    testUpsertPerformance();
+
+    std::cout << "\n✓ All upsert tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include "../include/ValueLogBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace bptree;
+
+// A 2 KiB value, large enough that moving it dominates node operations
+struct Blob {
+    char bytes[2048];
+
+    Blob() { std::memset(bytes, 0, sizeof(bytes)); }
+    explicit Blob(int seed) {
+        for (size_t i = 0; i < sizeof(bytes); i++) {
+            bytes[i] = static_cast<char>(seed + static_cast<int>(i));
+        }
+    }
+    bool operator==(const Blob& other) const {
+        return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+};
+
+// Helper to generate a unique temp filename
+std::string getTempFilename() {
+    static int counter = 0;
+    return "test_value_log_" + std::to_string(counter++) + ".dat";
+}
+
+// Helper to clean up temp files
+void removeFile(const std::string& filename) {
+    std::remove(filename.c_str());
+}
+
+// Checks a full scan against the reference map
+void assertMatches(const ValueLogBPlusTree<int, Blob>& tree, const std::map<int, int>& expected) {
+    assert(tree.validate());
+    assert(tree.size() == expected.size());
+    auto it = expected.begin();
+    tree.forEach([&](const int& key, const Blob& value) {
+        assert(it != expected.end());
+        assert(key == it->first && value == Blob(it->second));
+        ++it;
+    });
+    assert(it == expected.end());
+}
+
+void testBasicOperations() {
+    ValueLogBPlusTree<int, Blob> tree(4, 8);
+    assert(tree.isEmpty());
+    assert(tree.size() == 0);
+    assert(tree.find(1) == nullptr);
+    assert(!tree.remove(1));
+    assert(tree.validate());
+
+    for (int i = 0; i < 100; i++) {
+        tree.insert(i, Blob(i));
+    }
+    assert(tree.size() == 100);
+    assert(!tree.isEmpty());
+    assert(tree.segmentCount() == 13);
+
+    Blob value;
+    assert(tree.search(42, value) && value == Blob(42));
+    assert(tree.contains(99) && !tree.contains(100));
+    const Blob* found = tree.find(7);
+    assert(found != nullptr && *found == Blob(7));
+
+    // Overwrites append a new record and leave the old one dead
+    tree.insert(42, Blob(-42));
+    assert(tree.size() == 100);
+    assert(tree.search(42, value) && value == Blob(-42));
+    assert(tree.garbageRatio() > 0.0);
+
+    auto rows = tree.rangeQuery(10, 14);
+    assert(rows.size() == 5);
+    assert(rows.front().first == 10 && rows.front().second == Blob(10));
+    assert(rows.back().first == 14);
+
+    assert(tree.remove(42));
+    assert(!tree.contains(42));
+    assert(tree.size() == 99);
+    assert(tree.validate());
+
+    tree.clear();
+    assert(tree.isEmpty() && tree.size() == 0 && tree.segmentCount() == 0);
+    tree.insert(1, Blob(1));
+    assert(tree.validate());
+
+    bool threw = false;
+    try {
+        ValueLogBPlusTree<int, Blob> bad(4, 8, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Basic value log operations test passed" << std::endl;
+}
+
+void testIndexHoldsHandles() {
+    ValueLogBPlusTree<int, Blob> tree(16, 64);
+    for (int i = 0; i < 1000; i++) {
+        tree.insert(i, Blob(i));
+    }
+    // The index leaves carry 8-byte handles, never the values themselves
+    static_assert(std::is_same<ValueLogBPlusTree<int, Blob>::index_type,
+                               BPlusTree<int, uint64_t>>::value, "index must map keys to handles");
+    assert(tree.keyIndex().validate());
+    size_t entries = 0;
+    for (auto it = tree.keyIndex().begin(); it != tree.keyIndex().end(); ++it) {
+        assert(it->first == static_cast<int>(entries));
+        entries++;
+    }
+    assert(entries == 1000);
+
+    std::cout << "✓ Index holds handles test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    ValueLogBPlusTree<int, Blob> tree(8, 32, 0.3);
+    std::map<int, int> expected;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> dist(0, 800);
+
+    for (int i = 0; i < 20000; i++) {
+        int key = dist(rng);
+        if (rng() % 3 == 0) {
+            assert(tree.remove(key) == (expected.erase(key) == 1));
+        } else {
+            tree.insert(key, Blob(i));
+            expected[key] = i;
+        }
+        if (i % 4999 == 0) {
+            assertMatches(tree, expected);
+        }
+    }
+    assertMatches(tree, expected);
+    assert(tree.relocationCount() > 0);
+
+    // Automatic collection keeps the log within reach of the threshold
+    assert(tree.garbageRatio() < 0.6);
+
+    // Drain everything; emptied segments are freed as they die
+    for (const auto& entry : expected) {
+        assert(tree.remove(entry.first));
+    }
+    assert(tree.isEmpty());
+    assert(tree.segmentCount() <= 1);
+    assert(tree.validate());
+
+    std::cout << "✓ Randomized value log test passed" << std::endl;
+}
+
+void testCompaction() {
+    ValueLogBPlusTree<int, Blob> tree(8, 16, 1.0);
+    std::map<int, int> expected;
+    for (int i = 0; i < 320; i++) {
+        tree.insert(i, Blob(i));
+        expected[i] = i;
+    }
+    assert(tree.segmentCount() == 20);
+
+    // Leave a quarter of every segment live; a threshold of 1.0 never triggers on its own
+    for (int i = 0; i < 320; i++) {
+        if (i % 4 != 0) {
+            assert(tree.remove(i));
+            expected.erase(i);
+        }
+    }
+    assert(tree.relocationCount() == 0);
+    assert(tree.segmentCount() == 20);
+    assert(tree.garbageRatio() == 0.75);
+
+    size_t moved = tree.compact();
+    assert(moved >= 76 && moved <= 80);
+    assert(tree.relocationCount() == moved);
+    assert(tree.segmentCount() <= 6);
+    assert(tree.garbageRatio() < 0.2);
+    assertMatches(tree, expected);
+
+    // Nothing left to move out of the sealed segments
+    tree.compact();
+    assert(tree.garbageRatio() < 0.2);
+    assertMatches(tree, expected);
+
+    std::cout << "✓ Value log compaction test passed" << std::endl;
+}
+
+void testSaveLoad() {
+    std::string filename = getTempFilename();
+    std::map<int, int> expected;
+    {
+        ValueLogBPlusTree<int, Blob> tree(8, 32);
+        for (int i = 0; i < 2000; i++) {
+            tree.insert((i * 7919) % 2000, Blob(i));
+            expected[(i * 7919) % 2000] = i;
+        }
+        for (int i = 0; i < 2000; i += 5) {
+            tree.insert(i, Blob(-i));
+            expected[i] = -i;
+        }
+        tree.save(filename);
+    }
+
+    ValueLogBPlusTree<int, Blob> loaded(8, 32);
+    loaded.insert(-1, Blob(-1));
+    loaded.load(filename);
+    assertMatches(loaded, expected);
+    assert(loaded.garbageRatio() == 0.0);
+    assert(loaded.segmentCount() == (2000 + 31) / 32);
+
+    // Updates keep working after a load
+    loaded.insert(3, Blob(3));
+    expected[3] = 3;
+    assertMatches(loaded, expected);
+
+    // The file holds one header, the values and one (key, position) pair per entry
+    FILE* file = std::fopen(filename.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    long bytes = std::ftell(file);
+    std::fclose(file);
+    assert(bytes == static_cast<long>(16 + 2000 * (sizeof(Blob) + sizeof(int) + sizeof(uint64_t))));
+
+    // Corrupt file
+    file = std::fopen(filename.c_str(), "wb");
+    std::fputs("not a value log", file);
+    std::fclose(file);
+    bool threw = false;
+    try {
+        loaded.load(filename);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assertMatches(loaded, expected);
+    removeFile(filename);
+
+    std::cout << "✓ Value log save/load test passed" << std::endl;
+}
+
+void testValueLogPerformanceComparison() {
+    const int NUM_ELEMENTS = 100000;
+    std::vector<int> keys(NUM_ELEMENTS);
+    for (int i = 0; i < NUM_ELEMENTS; i++) keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+    Blob blob(1);
+
+    // Measure random inserts with values stored in the leaves
+    auto start1 = std::chrono::high_resolution_clock::now();
+    {
+        BPlusTree<int, Blob> inline_tree(32);
+        for (int key : keys) {
+            inline_tree.insert(key, blob);
+        }
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    auto inlineTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+    // Measure random inserts with values in the log
+    auto start2 = std::chrono::high_resolution_clock::now();
+    {
+        ValueLogBPlusTree<int, Blob> separated(32);
+        for (int key : keys) {
+            separated.insert(key, blob);
+        }
+        assert(separated.size() == static_cast<size_t>(NUM_ELEMENTS));
+    }
+    auto end2 = std::chrono::high_resolution_clock::now();
+    auto separatedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+    std::cout << "✓ Value log performance comparison test passed" << std::endl;
+    std::cout << "  2 KiB values, BPlusTree: " << inlineTime << "ms, ValueLogBPlusTree: "
+              << separatedTime << "ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Running value log tests..." << std::endl;
+
+    testBasicOperations();
+    testIndexHoldsHandles();
+    testRandomizedAgainstMap();
+    testCompaction();
+    testSaveLoad();
+    testValueLogPerformanceComparison();
+
+    std::cout << "\n✓ All value log tests passed!" << std::endl;
+    return 0;
+}
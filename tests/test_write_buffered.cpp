@@ -0,0 +1,367 @@
+#include "../include/WriteBufferedBPlusTree.h"
+#include "../include/BPlusTree.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace bptree;
+
+// Checks that a range query over the whole key space matches the reference map
+template<typename Tree>
+void assertMatches(const Tree& tree, const std::map<int, int>& expected, int lo, int hi) {
+    auto rows = tree.rangeQuery(lo, hi);
+    auto it = expected.lower_bound(lo);
+    for (const auto& row : rows) {
+        assert(it != expected.end());
+        assert(row.first == it->first && row.second == it->second);
+        ++it;
+    }
+    assert(it == expected.upper_bound(hi));
+}
+
+void testMergedWith() {
+    BPlusTree<int, std::string> tree(4);
+    for (int i = 0; i < 50; i += 2) {
+        tree.insert(i, "old" + std::to_string(i));
+    }
+
+    std::map<int, std::optional<std::string>> changes;
+    changes[-1] = "first";
+    changes[4] = "four";
+    changes[6] = std::nullopt;
+    changes[7] = "seven";
+    changes[33] = std::nullopt;  // Not present
+    changes[100] = "last";
+
+    std::string value;
+    auto merged = tree.mergedWith(changes.begin(), changes.end());
+    assert(merged.validate());
+    assert(tree.size() == 25);
+    assert(tree.search(6, value) && !tree.search(7, value));
+
+    assert(merged.size() == 27);
+    assert(merged.search(-1, value) && value == "first");
+    assert(merged.search(4, value) && value == "four");
+    assert(!merged.search(6, value));
+    assert(merged.search(7, value) && value == "seven");
+    assert(merged.search(8, value) && value == "old8");
+    assert(merged.search(100, value) && value == "last");
+
+    // Merging into an empty tree and removing everything
+    BPlusTree<int, std::string> empty(4);
+    auto filled = empty.mergedWith(changes.begin(), changes.end());
+    assert(filled.size() == 4 && filled.validate());
+
+    std::vector<std::pair<int, std::optional<std::string>>> wipe;
+    for (int i = 0; i < 50; i += 2) wipe.emplace_back(i, std::nullopt);
+    auto cleared = tree.mergedWith(wipe.begin(), wipe.end());
+    assert(cleared.isEmpty() && cleared.validate());
+
+    std::cout << "✓ mergedWith test passed" << std::endl;
+}
+
+void testApplyBatch() {
+    for (bool sorted : {true, false}) {
+        BPlusTree<int, int> tree(5);
+        std::map<int, int> expected;
+        for (int i = 0; i < 3000; i += 3) {
+            tree.insert(i, i);
+            expected[i] = i;
+        }
+        auto snap = tree.snapshot();
+
+        std::mt19937 rng(sorted ? 5 : 6);
+        std::vector<std::pair<int, std::optional<int>>> changes;
+        for (int i = 0; i < 2000; i++) {
+            int key = static_cast<int>(rng() % 3200);
+            changes.emplace_back(key, rng() % 3 == 0 ? std::nullopt : std::optional<int>(-i));
+        }
+        if (sorted) {
+            std::stable_sort(changes.begin(), changes.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+        }
+
+        // Changes apply in input order and report whether the key was there
+        size_t index = 0;
+        tree.applyBatch(changes.begin(), changes.end(), [&](bool existed) {
+            const auto& change = changes[index++];
+            assert(existed == (expected.count(change.first) == 1));
+            if (change.second) {
+                expected[change.first] = *change.second;
+            } else {
+                expected.erase(change.first);
+            }
+        });
+        assert(index == changes.size());
+        assert(tree.validate());
+        std::vector<std::pair<int, int>> rows(tree.begin(), tree.end());
+        std::vector<std::pair<int, int>> reference(expected.begin(), expected.end());
+        assert(rows == reference);
+
+        // The snapshot still sees the tree as it was
+        int value = 0;
+        assert(snap.size() == 1000);
+        assert(snap.search(2997, value) && value == 2997);
+        snap.release();
+    }
+
+    // Pointers work as changes too, and a batch may empty the tree
+    BPlusTree<int, int> tree(4);
+    int one = 1;
+    std::vector<std::pair<int, const int*>> fill = {{1, &one}, {2, &one}, {3, &one}};
+    std::vector<std::pair<int, const int*>> clear = {{1, nullptr}, {2, nullptr}, {3, nullptr}};
+    tree.applyBatch(fill.begin(), fill.end());
+    assert(tree.size() == 3);
+    tree.applyBatch(clear.begin(), clear.end());
+    assert(tree.isEmpty() && tree.validate());
+
+    std::cout << "✓ applyBatch test passed" << std::endl;
+}
+
+void testBufferedWritesAreVisible() {
+    for (MergeMode mode : {MergeMode::FOREGROUND, MergeMode::BACKGROUND}) {
+        WriteBufferedBPlusTree<int, int> tree(4, 16, mode);
+        assert(tree.bufferCapacity() == 16);
+        assert(tree.bufferedCount() == 0);
+        assert(tree.rangeQuery(0, 10).empty());
+
+        for (int i = 0; i < 10; i++) {
+            tree.insert(i, i * 10);
+        }
+        assert(tree.bufferedCount() == 10);
+        assert(tree.mergeCount() == 0);
+
+        tree.remove(3);
+        tree.insert(5, 55);
+        int value = 0;
+        assert(!tree.contains(3));
+        assert(tree.search(5, value) && value == 55);
+        assert(tree.search(9, value) && value == 90);
+
+        auto rows = tree.rangeQuery(2, 6);
+        assert(rows.size() == 4);
+        assert(rows[0].first == 2 && rows[1].first == 4 && rows[2].second == 55);
+
+        tree.flush();
+        assert(tree.bufferedCount() == 0);
+        assert(tree.mergeCount() == 1);
+        assert(tree.size() == 9);
+        assert(tree.validate());
+
+        // A tombstone must hide the merged entry until it is merged itself
+        tree.remove(5);
+        assert(!tree.contains(5));
+        assert(tree.rangeQuery(5, 5).empty());
+        tree.flush();
+        assert(!tree.contains(5));
+        assert(tree.size() == 8);
+    }
+
+    std::cout << "✓ Buffered writes visibility test passed" << std::endl;
+}
+
+void testRandomizedAgainstMap() {
+    for (MergeMode mode : {MergeMode::FOREGROUND, MergeMode::BACKGROUND}) {
+        for (size_t capacity : {2u, 7u, 256u}) {
+            WriteBufferedBPlusTree<int, int> tree(5, capacity, mode);
+            std::map<int, int> expected;
+            std::mt19937 rng(static_cast<unsigned>(capacity * 3 + (mode == MergeMode::BACKGROUND)));
+            std::uniform_int_distribution<int> dist(0, 3000);
+
+            for (int i = 0; i < 5000; i++) {
+                int key = dist(rng);
+                if (rng() % 3 == 0) {
+                    tree.remove(key);
+                    expected.erase(key);
+                } else {
+                    tree.insert(key, i);
+                    expected[key] = i;
+                }
+                if (i % 499 == 0) {
+                    int lo = dist(rng);
+                    assertMatches(tree, expected, lo, lo + 200);
+                    int value = 0;
+                    auto it = expected.find(key);
+                    assert(tree.search(key, value) == (it != expected.end()));
+                    if (it != expected.end()) assert(value == it->second);
+                }
+            }
+            assertMatches(tree, expected, 0, 3000);
+            assert(tree.size() == expected.size());
+            assert(tree.validate());
+        }
+    }
+
+    std::cout << "✓ Randomized write-buffered tree test passed" << std::endl;
+}
+
+// Value whose copies throw while armed if it is poisoned, so a merge can be made to fail
+struct FragileValue {
+    static std::atomic<bool> armed;
+    int value = 0;
+
+    FragileValue() = default;
+    explicit FragileValue(int v) : value(v) {}
+    FragileValue(const FragileValue& other) : value(other.value) { check(); }
+    FragileValue& operator=(const FragileValue& other) {
+        value = other.value;
+        check();
+        return *this;
+    }
+    FragileValue(FragileValue&&) noexcept = default;
+    FragileValue& operator=(FragileValue&&) noexcept = default;
+
+    void check() const {
+        if (value < 0 && armed.load()) throw std::runtime_error("poisoned copy");
+    }
+};
+std::atomic<bool> FragileValue::armed(false);
+
+void testFailedMergeIsRetried() {
+    for (MergeMode mode : {MergeMode::FOREGROUND, MergeMode::BACKGROUND}) {
+        WriteBufferedBPlusTree<int, FragileValue> tree(4, 4, mode);
+        tree.insert(0, FragileValue(-1));
+        FragileValue::armed = true;
+
+        // The merge that copies the poisoned value fails; the caller sees it
+        bool threw = false;
+        try {
+            for (int i = 1; i < 4; i++) tree.insert(i, FragileValue(i));
+            tree.flush();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        // Still failing: a flush() retries the merge itself rather than wait forever
+        threw = false;
+        try {
+            tree.flush();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        FragileValue::armed = false;
+
+        // The write that fills the next run and flush() both complete
+        for (int i = 4; i < 8; i++) tree.insert(i, FragileValue(i));
+        tree.flush();
+        assert(tree.bufferedCount() == 0);
+        assert(tree.size() == 8);
+        FragileValue value;
+        assert(tree.search(0, value) && value.value == -1);
+        assert(tree.search(7, value) && value.value == 7);
+        assert(tree.validate());
+    }
+
+    std::cout << "✓ Failed merge retry test passed" << std::endl;
+}
+
+void testConcurrentReadersDuringMerges() {
+    const int NUM_KEYS = 40000;
+    WriteBufferedBPlusTree<int, int> tree(16, 1024, MergeMode::BACKGROUND);
+    std::atomic<int> written(0);
+    std::atomic<bool> done(false);
+
+    // Keys below the published watermark must always be found
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&, r] {
+            std::mt19937 rng(static_cast<unsigned>(r));
+            while (!done.load()) {
+                int limit = written.load();
+                if (limit == 0) continue;
+                int key = static_cast<int>(rng() % static_cast<unsigned>(limit));
+                int value = -1;
+                assert(tree.search(key, value) && value == key * 2);
+                auto rows = tree.rangeQuery(key, key + 10);
+                assert(!rows.empty() && rows[0].first == key);
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (int i = 0; i < NUM_KEYS; i++) {
+        tree.insert(i, i * 2);
+        written.store(i + 1);
+    }
+    done.store(true);
+    for (auto& reader : readers) reader.join();
+
+    assert(tree.mergeCount() > 0);
+    assert(tree.size() == static_cast<size_t>(NUM_KEYS));
+    assert(tree.validate());
+
+    std::cout << "✓ Concurrent readers during merges test passed" << std::endl;
+}
+
+void testWriteBufferedPerformanceComparison() {
+    const int NUM_WRITES = 50000;
+
+    // The same number of random writes into a tree and into one 16 times larger
+    for (int preload : {50000, 800000}) {
+        std::vector<int> keys(static_cast<size_t>(preload));
+        for (int i = 0; i < preload; i++) keys[static_cast<size_t>(i)] = i * 2 + 1;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(11));
+        keys.resize(NUM_WRITES);
+
+        BPlusTree<int, int> plain(64);
+        WriteBufferedBPlusTree<int, int> buffered(64, 1 << 12, MergeMode::FOREGROUND);
+        for (int i = 0; i < preload; i++) {
+            plain.insert(i * 2, i);
+            buffered.insert(i * 2, i);
+        }
+        buffered.flush();
+
+        // Measure random inserts into the regular tree
+        auto start1 = std::chrono::high_resolution_clock::now();
+        for (int key : keys) {
+            plain.insert(key, key);
+        }
+        auto end1 = std::chrono::high_resolution_clock::now();
+        auto plainTime = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+        // Measure random inserts through the write buffer, merges and the final flush included
+        size_t mergesBefore = buffered.mergeCount();
+        auto start2 = std::chrono::high_resolution_clock::now();
+        for (int key : keys) {
+            buffered.insert(key, key);
+        }
+        buffered.flush();
+        auto end2 = std::chrono::high_resolution_clock::now();
+        auto bufferedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count();
+
+        assert(buffered.size() == plain.size());
+        assert(buffered.validate());
+
+        std::cout << "  " << preload << " entries + " << NUM_WRITES << " writes: BPlusTree inserts "
+                  << plainTime << "ms, Write-buffered inserts " << bufferedTime << "ms ("
+                  << buffered.mergeCount() - mergesBefore << " merges)" << std::endl;
+    }
+
+    std::cout << "✓ Write-buffered performance comparison test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running write-buffered tree tests..." << std::endl;
+
+    testMergedWith();
+    testApplyBatch();
+    testBufferedWritesAreVisible();
+    testRandomizedAgainstMap();
+    testFailedMergeIsRetried();
+    testConcurrentReadersDuringMerges();
+    testWriteBufferedPerformanceComparison();
+
+    std::cout << "\n✓ All write-buffered tree tests passed!" << std::endl;
+    return 0;
+}